@@ -162,3 +162,13 @@ UNIT_TEST(CeilLog)
   TEST_EQUAL(31, bits::FloorLog(0xFFFFFFFF), ());
   TEST_EQUAL(63, bits::FloorLog(0xFFFFFFFFFFFFFFFF), ());
 }
+
+UNIT_TEST(CountTrailingZeros)
+{
+  TEST_EQUAL(0, bits::CountTrailingZeros(0x1), ());
+  TEST_EQUAL(1, bits::CountTrailingZeros(0x2), ());
+  TEST_EQUAL(0, bits::CountTrailingZeros(0x3), ());
+  TEST_EQUAL(4, bits::CountTrailingZeros(0xF0), ());
+  TEST_EQUAL(33, bits::CountTrailingZeros(0xAAAAAAAA00000000), ());
+  TEST_EQUAL(63, bits::CountTrailingZeros(0x8000000000000000), ());
+}
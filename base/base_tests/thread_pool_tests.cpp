@@ -126,3 +126,62 @@ UNIT_TEST(ThreadPool_EmptyTest)
   threads::Sleep(100);
   pool.Stop();
 }
+
+namespace
+{
+  class OrderTestTask : public threads::IRoutine
+  {
+  public:
+    OrderTestTask(int id, std::vector<int> & order, Condition & cond)
+      : m_id(id), m_order(order), m_cond(cond)
+    {
+    }
+
+    virtual void Do()
+    {
+      std::lock_guard lock(m_cond.m);
+      m_order.push_back(m_id);
+    }
+
+    int GetId() const { return m_id; }
+
+  private:
+    int m_id;
+    std::vector<int> & m_order;
+    Condition & m_cond;
+  };
+}
+
+UNIT_TEST(ThreadPool_SortQueueTest)
+{
+  int finishCounter = 0;
+  Condition cond;
+  std::vector<int> order;
+  base::thread_pool::routine::ThreadPool pool(1, std::bind(&JoinFinishFunction, std::placeholders::_1,
+                                        std::ref(finishCounter), std::ref(cond)));
+
+  {
+    // The only thread is blocked by the first task until all the tasks are pushed and sorted.
+    std::unique_lock lock(cond.m);
+    for (int i = 0; i < TASK_COUNT; ++i)
+      pool.PushBack(new OrderTestTask(i, order, cond));
+
+    pool.SortQueue([](threads::IRoutine const * l, threads::IRoutine const * r)
+    {
+      return static_cast<OrderTestTask const *>(l)->GetId() % 2 <
+             static_cast<OrderTestTask const *>(r)->GetId() % 2;
+    });
+  }
+
+  while(true)
+  {
+    std::unique_lock lock(cond.m);
+    if (finishCounter == TASK_COUNT)
+      break;
+    cond.cv.wait(lock);
+  }
+
+  // Even tasks go first, the first task may be taken before sorting but it is even anyway.
+  std::vector<int> const expected = {0, 2, 4, 6, 8, 1, 3, 5, 7, 9};
+  TEST_EQUAL(order, expected, ());
+}
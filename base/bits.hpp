@@ -94,6 +94,23 @@ namespace bits
   // Will be implemented when needed.
   uint64_t PopCount(uint64_t const * p, uint64_t n);
 
+  // Returns the index of the least significant set bit. |x| must not be zero.
+  inline uint32_t CountTrailingZeros(uint64_t x) noexcept
+  {
+    ASSERT_NOT_EQUAL(x, 0, ());
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+    uint32_t result = 0;
+    while ((x & 1) == 0)
+    {
+      x >>= 1;
+      ++result;
+    }
+    return result;
+#endif
+  }
+
   template <typename T> T RoundLastBitsUpAndShiftRight(T x, T bits)
   {
     return (x & ((1 << bits) - 1)) ? (x >> bits) + 1 : (x >> bits);
@@ -78,6 +78,11 @@ public:
     m_tasks.PushFront(routine);
   }
 
+  void SortQueue(TLessRoutineFn const & less)
+  {
+    m_tasks.ProcessList([&less](std::list<threads::IRoutine *> & tasks) { tasks.sort(less); });
+  }
+
   threads::IRoutine * PopFront()
   {
     return m_tasks.Front(true);
@@ -129,6 +134,11 @@ void ThreadPool::PushFront(threads::IRoutine * routine)
   m_impl->PushFront(routine);
 }
 
+void ThreadPool::SortQueue(TLessRoutineFn const & less)
+{
+  m_impl->SortQueue(less);
+}
+
 void ThreadPool::Stop()
 {
   m_impl->Stop();
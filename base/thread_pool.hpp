@@ -16,6 +16,7 @@ namespace base::thread_pool
 namespace routine
 {
 typedef std::function<void(threads::IRoutine *)> TFinishRoutineFn;
+typedef std::function<bool(threads::IRoutine const *, threads::IRoutine const *)> TLessRoutineFn;
 
 class ThreadPool
 {
@@ -26,6 +27,8 @@ public:
   // ThreadPool will not delete routine. You can delete it in finish_routine_fn if need
   void PushBack(threads::IRoutine * routine);
   void PushFront(threads::IRoutine * routine);
+  // Reorders routines which wait for execution, the order of equal routines is preserved.
+  void SortQueue(TLessRoutineFn const & less);
   void Stop();
 
 private:
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -84,6 +85,22 @@ void CheckUnion(vector<uint64_t> & setBits1, coding::CompressedBitVector::Storag
   TEST_EQUAL(resultStrategy, cbv3->GetStorageStrategy(), ());
   CheckUnion(setBits1, setBits2, *cbv3);
 }
+
+vector<uint64_t> MakeRandomBits(mt19937 & rng, size_t count, uint64_t maxBit)
+{
+  uniform_int_distribution<uint64_t> distribution(0, maxBit);
+  set<uint64_t> bits;
+  while (bits.size() < count)
+    bits.insert(distribution(rng));
+  return vector<uint64_t>(bits.begin(), bits.end());
+}
+
+vector<uint64_t> GetBits(coding::CompressedBitVector const & cbv)
+{
+  vector<uint64_t> bits;
+  coding::CompressedBitVectorEnumerator::ForEach(cbv, [&bits](uint64_t bit) { bits.push_back(bit); });
+  return bits;
+}
 }  // namespace
 
 UNIT_TEST(CompressedBitVector_Intersect1)
@@ -472,3 +489,42 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(CompressedBitVector_RandomOps)
+{
+  using coding::CompressedBitVector;
+  using coding::CompressedBitVectorBuilder;
+
+  mt19937 rng(0 /* seed */);
+  // Pairs of (number of set bits, max bit) to get dense and sparse vectors of different lengths
+  // and vectors whose sizes differ enough for the galloping intersection.
+  vector<pair<size_t, uint64_t>> const kShapes = {
+      {0, 0}, {1, 10}, {5, 1000}, {40, 100000}, {300, 1000}, {2000, 4000}, {3000, 100000}};
+
+  for (auto const & [countA, maxBitA] : kShapes)
+  {
+    for (auto const & [countB, maxBitB] : kShapes)
+    {
+      auto setBitsA = MakeRandomBits(rng, countA, maxBitA);
+      auto setBitsB = MakeRandomBits(rng, countB, maxBitB);
+      auto const cbvA = CompressedBitVectorBuilder::FromBitPositions(setBitsA);
+      auto const cbvB = CompressedBitVectorBuilder::FromBitPositions(setBitsB);
+
+      vector<uint64_t> expected;
+      Intersect(setBitsA, setBitsB, expected);
+      TEST_EQUAL(GetBits(*CompressedBitVector::Intersect(*cbvA, *cbvB)), expected,
+                 (countA, maxBitA, countB, maxBitB));
+
+      expected.clear();
+      Subtract(setBitsA, setBitsB, expected);
+      TEST_EQUAL(GetBits(*CompressedBitVector::Subtract(*cbvA, *cbvB)), expected,
+                 (countA, maxBitA, countB, maxBitB));
+
+      expected.clear();
+      Union(setBitsA, setBitsB, expected);
+      auto const united = CompressedBitVector::Union(*cbvA, *cbvB);
+      TEST_EQUAL(GetBits(*united), expected, (countA, maxBitA, countB, maxBitB));
+      TEST_EQUAL(united->PopCount(), expected.size(), ());
+    }
+  }
+}
@@ -67,4 +67,17 @@ UNIT_TEST(VarRecordReader_Simple)
                                                          {4, longString},
                                                          {6 + longStringSize, "defg"}};
   TEST_EQUAL(forEachCalls, expectedForEachCalls, ());
+
+  vector<uint8_t> buffer;
+  recordReader.ReadRecord(4, buffer);
+  TEST_EQUAL(string(buffer.begin(), buffer.end()), longString, ());
+  recordReader.ReadRecord(0, buffer);
+  TEST_EQUAL(string(buffer.begin(), buffer.end()), "abc", ());
+
+  forEachCalls.clear();
+  recordReader.ForEachRecord(buffer, [&](uint32_t pos)
+  {
+    forEachCalls.emplace_back(pos, string(buffer.begin(), buffer.end()));
+  });
+  TEST_EQUAL(forEachCalls, expectedForEachCalls, ());
 }
@@ -13,18 +13,99 @@ using std::make_unique, std::max, std::min, std::unique_ptr, std::vector;
 
 namespace
 {
+// The word loops below have no branches and no calls inside, so the compiler vectorizes them
+// with the SIMD instructions of the target (SSE2/AVX2 on x86, NEON on ARM).
+void AndGroups(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    res[i] = a[i] & b[i];
+}
+
+void AndNotGroups(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    res[i] = a[i] & ~b[i];
+}
+
+void OrGroups(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    res[i] = a[i] | b[i];
+}
+
+// Copies to |res| the positions from |positions| which are set (or not set, when |isSet| is false)
+// in |groups|. The positions are written unconditionally and the output pointer is advanced
+// by the tested bit, so there are no mispredicted branches on random data.
+void FilterPositions(vector<uint64_t> const & groups, SparseCBV const & positions, bool isSet,
+                     vector<uint64_t> & res)
+{
+  res.resize(positions.PopCount());
+  uint64_t const numBits = groups.size() * DenseCBV::kBlockSize;
+  uint64_t const flip = isSet ? 0 : 1;
+
+  size_t size = 0;
+  auto it = positions.Begin();
+  for (; it != positions.End() && *it < numBits; ++it)
+  {
+    uint64_t const pos = *it;
+    res[size] = pos;
+    size += ((groups[pos / DenseCBV::kBlockSize] >> (pos % DenseCBV::kBlockSize)) & 1) ^ flip;
+  }
+
+  // Positions beyond |groups| are not set.
+  if (!isSet)
+  {
+    for (; it != positions.End(); ++it)
+      res[size++] = *it;
+  }
+  res.resize(size);
+}
+
+// Intersection of sorted |small| and |large| for |large| much longer than |small|: every element
+// of |small| is looked up with an exponential search starting after the previous match,
+// which takes O(|small| * log(|large| / |small|)) instead of O(|small| + |large|) of the merge.
+void GallopingIntersection(vector<uint64_t>::const_iterator smallBegin,
+                           vector<uint64_t>::const_iterator smallEnd,
+                           vector<uint64_t>::const_iterator largeBegin,
+                           vector<uint64_t>::const_iterator largeEnd, vector<uint64_t> & res)
+{
+  auto lo = largeBegin;
+  for (auto it = smallBegin; it != smallEnd && lo != largeEnd; ++it)
+  {
+    uint64_t const value = *it;
+
+    size_t step = 1;
+    auto hi = lo;
+    while (hi != largeEnd && *hi < value)
+    {
+      lo = hi + 1;
+      hi = static_cast<size_t>(largeEnd - hi) > step ? hi + step : largeEnd;
+      step *= 2;
+    }
+
+    lo = lower_bound(lo, hi, value);
+    if (lo != largeEnd && *lo == value)
+    {
+      res.push_back(value);
+      ++lo;
+    }
+  }
+}
+
 struct IntersectOp
 {
+  // The merge is faster than galloping unless the sizes differ at least this many times.
+  static size_t constexpr kGallopingRatio = 16;
+
   IntersectOp() {}
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    vector<uint64_t> resGroups(min(groupsA.size(), groupsB.size()));
+    AndGroups(groupsA.data(), groupsB.data(), resGroups.data(), resGroups.size());
     return coding::CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -33,12 +114,7 @@ struct IntersectOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
-    {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
-        resPos.push_back(pos);
-    }
+    FilterPositions(a.GetBitGroups(), b, true /* isSet */, resPos);
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
 
@@ -52,7 +128,22 @@ struct IntersectOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    auto const sizeA = a.PopCount();
+    auto const sizeB = b.PopCount();
+    if (sizeA * kGallopingRatio <= sizeB)
+    {
+      resPos.reserve(sizeA);
+      GallopingIntersection(a.Begin(), a.End(), b.Begin(), b.End(), resPos);
+    }
+    else if (sizeB * kGallopingRatio <= sizeA)
+    {
+      resPos.reserve(sizeB);
+      GallopingIntersection(b.Begin(), b.End(), a.Begin(), a.End(), resPos);
+    }
+    else
+    {
+      set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    }
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
 };
@@ -64,11 +155,12 @@ struct SubtractOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    // Groups of |a| beyond |b| are kept as is.
+    vector<uint64_t> resGroups(groupsA);
+    AndNotGroups(groupsA.data(), groupsB.data(), resGroups.data(),
+                 min(groupsA.size(), groupsB.size()));
     return CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -104,10 +196,7 @@ struct SubtractOp
                                                      coding::DenseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    copy_if(a.Begin(), a.End(), back_inserter(resPos), [&](uint64_t bit)
-            {
-              return !b.GetBit(bit);
-            });
+    FilterPositions(b.GetBitGroups(), a, false /* isSet */, resPos);
     return CompressedBitVectorBuilder::FromBitPositions(std::move(resPos));
   }
 
@@ -127,24 +216,14 @@ struct UnionOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-
-    size_t commonSize = min(sizeA, sizeB);
-    size_t resultSize = max(sizeA, sizeB);
-    vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    auto const & longer = groupsA.size() >= groupsB.size() ? groupsA : groupsB;
+    auto const & shorter = groupsA.size() >= groupsB.size() ? groupsB : groupsA;
+
+    // Groups of the longer vector beyond the shorter one are kept as is.
+    vector<uint64_t> resGroups(longer);
+    OrGroups(longer.data(), shorter.data(), resGroups.data(), shorter.size());
     return CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -168,6 +247,8 @@ struct UnionOp
           resPos.push_back(*j);
           ++j;
         }
+        if (j < b.End() && *j == va)
+          ++j;
         resPos.push_back(va);
       };
       a.ForEach(merge);
@@ -448,18 +529,22 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     popCount += bits::PopCount(bitGroups[i]);
 
   if (DenseEnough(popCount, maxBit))
-    return DenseCBV::BuildFromBitGroups(std::move(bitGroups));
+  {
+    // The pop count is already known, so DenseCBV::BuildFromBitGroups() is not used.
+    unique_ptr<DenseCBV> cbv(new DenseCBV());
+    cbv->m_popCount = popCount;
+    cbv->m_bitGroups = std::move(bitGroups);
+    return cbv;
+  }
 
   vector<uint64_t> setBits;
+  setBits.reserve(static_cast<size_t>(popCount));
   for (size_t i = 0; i < bitGroups.size(); ++i)
   {
-    for (size_t j = 0; j < kBlockSize; ++j)
-    {
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
-    }
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + bits::CountTrailingZeros(group));
   }
-  return make_unique<SparseCBV>(setBits);
+  return make_unique<SparseCBV>(std::move(setBits));
 }
 
 std::string DebugPrint(CompressedBitVector::StorageStrategy strat)
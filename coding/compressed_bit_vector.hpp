@@ -5,6 +5,7 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/control_flow.hpp"
 #include "base/ref_counted.hpp"
 
@@ -102,6 +103,7 @@ public:
   static std::unique_ptr<DenseCBV> BuildFromBitGroups(std::vector<uint64_t> && bitGroups);
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
+  std::vector<uint64_t> const & GetBitGroups() const { return m_bitGroups; }
 
   template <typename Fn>
   void ForEach(Fn && f) const
@@ -109,13 +111,10 @@ public:
     base::ControlFlowWrapper<Fn> wrapper(std::forward<Fn>(f));
     for (size_t i = 0; i < m_bitGroups.size(); ++i)
     {
-      for (size_t j = 0; j < kBlockSize; ++j)
+      for (uint64_t group = m_bitGroups[i]; group != 0; group &= group - 1)
       {
-        if (((m_bitGroups[i] >> j) & 1) > 0)
-        {
-          if (wrapper(kBlockSize * i + j) == base::ControlFlow::Break)
-            return;
-        }
+        if (wrapper(kBlockSize * i + bits::CountTrailingZeros(group)) == base::ControlFlow::Break)
+          return;
       }
     }
   }
@@ -5,6 +5,8 @@
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 
+#include "base/logging.hpp"
+
 #include <cstring>
 #include <sstream>
 
@@ -284,6 +286,29 @@ void FilesMappingContainer::Handle::Unmap()
   }
 }
 
+void FilesMappingContainer::Handle::Advise(Advice advice) const
+{
+  if (!IsValid())
+    return;
+
+#ifndef OMIM_OS_WINDOWS
+  int adv = MADV_NORMAL;
+  switch (advice)
+  {
+  case Advice::Normal: adv = MADV_NORMAL; break;
+  case Advice::Random: adv = MADV_RANDOM; break;
+  case Advice::Sequential: adv = MADV_SEQUENTIAL; break;
+  case Advice::WillNeed: adv = MADV_WILLNEED; break;
+  }
+
+  // |m_origBase| is aligned by page size as madvise() requires.
+  if (madvise(const_cast<char *>(m_origBase), static_cast<size_t>(m_origSize), adv) != 0)
+    LOG(LWARNING, ("madvise error:", strerror(errno)));
+#else
+  UNUSED_VALUE(advice);
+#endif
+}
+
 void FilesMappingContainer::Handle::Reset()
 {
   m_base = m_origBase = 0;
@@ -150,6 +150,15 @@ public:
   void Open(std::string const & fName);
   void Close();
 
+  /// Expected access pattern of mapped memory, see madvise().
+  enum class Advice
+  {
+    Normal,
+    Random,
+    Sequential,
+    WillNeed
+  };
+
   class Handle
   {
   public:
@@ -170,6 +179,9 @@ public:
 
     void Unmap();
 
+    /// Hints the OS how the mapped memory is going to be read. Does nothing on Windows.
+    void Advise(Advice advice) const;
+
     bool IsValid() const { return (m_base != 0); }
     uint64_t GetSize() const { return m_size; }
 
@@ -0,0 +1,262 @@
+#include "testing/testing.hpp"
+
+#include "drape/glyph_manager.hpp"
+#include "drape/glyph_raster_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace glyph_raster_cache_tests
+{
+using namespace dp;
+using namespace std;
+
+string const kCacheFile = "glyph_raster_cache_test.bin";
+string const kFingerprint = "test";
+
+GlyphRasterCache::Key MakeKey(uint32_t glyphId, uint32_t sdfScale)
+{
+  GlyphRasterCache::Key key;
+  key.m_font = "font.ttf";
+  key.m_glyphId = glyphId;
+  key.m_size = 22;
+  key.m_sdfScale = sdfScale;
+  key.m_sdfBorder = kSdfBorder;
+  return key;
+}
+
+GlyphRasterCache::Glyph MakeGlyph(uint32_t width, uint32_t height, uint8_t fill)
+{
+  GlyphRasterCache::Glyph glyph;
+  glyph.m_xAdvance = 10.5f;
+  glyph.m_xOffset = -1.25f;
+  glyph.m_yOffset = 2.0f;
+  glyph.m_width = width;
+  glyph.m_height = height;
+  glyph.m_pitch = width;
+  glyph.m_data.assign(width * height, fill);
+  return glyph;
+}
+
+void TestEqual(GlyphRasterCache::Glyph const & lhs, GlyphRasterCache::Glyph const & rhs)
+{
+  TEST_EQUAL(lhs.m_xAdvance, rhs.m_xAdvance, ());
+  TEST_EQUAL(lhs.m_yAdvance, rhs.m_yAdvance, ());
+  TEST_EQUAL(lhs.m_xOffset, rhs.m_xOffset, ());
+  TEST_EQUAL(lhs.m_yOffset, rhs.m_yOffset, ());
+  TEST_EQUAL(lhs.m_width, rhs.m_width, ());
+  TEST_EQUAL(lhs.m_height, rhs.m_height, ());
+  TEST_EQUAL(lhs.m_pitch, rhs.m_pitch, ());
+  TEST_EQUAL(lhs.m_data, rhs.m_data, ());
+}
+
+UNIT_TEST(GlyphRasterCache_SaveLoad)
+{
+  string const path = GetPlatform().WritablePathForFile(kCacheFile);
+  base::DeleteFileX(path);
+  SCOPE_GUARD(deleteFile, [&path]() { base::DeleteFileX(path); });
+
+  auto const glyph1 = MakeGlyph(5, 7, 1);
+  auto const glyph2 = MakeGlyph(3, 2, 2);
+  auto const space = MakeGlyph(0, 0, 0);
+  {
+    GlyphRasterCache cache(path, kFingerprint);
+    TEST_EQUAL(cache.GetNumLoadedGlyphs(), 0, ());
+
+    GlyphRasterCache::Glyph glyph;
+    TEST(!cache.Find(MakeKey(1, 4), glyph), ());
+
+    cache.Add(MakeKey(1, 4), glyph1);
+    cache.Add(MakeKey(1, 0), glyph2);
+    cache.Add(MakeKey(32, 4), space);
+    // Glyphs are not replaced.
+    cache.Add(MakeKey(1, 4), glyph2);
+    TEST_EQUAL(cache.GetNumGlyphs(), 3, ());
+
+    TEST(cache.Find(MakeKey(1, 4), glyph), ());
+    TestEqual(glyph, glyph1);
+    TEST_EQUAL(cache.GetStats().m_hits, 1, ());
+    TEST_EQUAL(cache.GetStats().m_misses, 1, ());
+  }
+
+  GlyphRasterCache cache(path, kFingerprint);
+  TEST_EQUAL(cache.GetNumLoadedGlyphs(), 3, ());
+
+  GlyphRasterCache::Glyph glyph;
+  TEST(cache.Find(MakeKey(1, 4), glyph), ());
+  TestEqual(glyph, glyph1);
+  TEST(cache.Find(MakeKey(1, 0), glyph), ());
+  TestEqual(glyph, glyph2);
+  TEST(cache.Find(MakeKey(32, 4), glyph), ());
+  TestEqual(glyph, space);
+  TEST(!cache.Find(MakeKey(2, 4), glyph), ());
+
+  // New glyphs are saved together with the loaded ones.
+  cache.Add(MakeKey(2, 4), glyph2);
+  TEST(cache.Save(), ());
+  TEST_EQUAL(GlyphRasterCache(path, kFingerprint).GetNumLoadedGlyphs(), 4, ());
+}
+
+UNIT_TEST(GlyphRasterCache_BrokenFile)
+{
+  string const path = GetPlatform().WritablePathForFile(kCacheFile);
+  SCOPE_GUARD(deleteFile, [&path]() { base::DeleteFileX(path); });
+
+  {
+    GlyphRasterCache cache(path, kFingerprint);
+    cache.Add(MakeKey(1, 4), MakeGlyph(16, 16, 1));
+  }
+
+  uint64_t size = 0;
+  TEST(base::GetFileSize(path, size), ());
+  {
+    // Truncated image of the last glyph.
+    auto data = base::ReadFile(path);
+    data.resize(size - 10);
+    FileWriter writer(path);
+    writer.Write(data.data(), data.size());
+  }
+
+  GlyphRasterCache cache(path, kFingerprint);
+  TEST_EQUAL(cache.GetNumLoadedGlyphs(), 0, ());
+  GlyphRasterCache::Glyph glyph;
+  TEST(!cache.Find(MakeKey(1, 4), glyph), ());
+}
+
+UNIT_TEST(GlyphRasterCache_Fingerprint)
+{
+  string const path = GetPlatform().WritablePathForFile(kCacheFile);
+  SCOPE_GUARD(deleteFile, [&path]() { base::DeleteFileX(path); });
+
+  {
+    GlyphRasterCache cache(path, kFingerprint);
+    cache.Add(MakeKey(1, 4), MakeGlyph(5, 5, 1));
+  }
+  TEST_EQUAL(GlyphRasterCache(path, kFingerprint).GetNumLoadedGlyphs(), 1, ());
+
+  {
+    // Glyphs rasterized with other fonts or parameters are discarded.
+    GlyphRasterCache cache(path, "other");
+    TEST_EQUAL(cache.GetNumLoadedGlyphs(), 0, ());
+    GlyphRasterCache::Glyph glyph;
+    TEST(!cache.Find(MakeKey(1, 4), glyph), ());
+    cache.Add(MakeKey(2, 4), MakeGlyph(5, 5, 2));
+  }
+  TEST_EQUAL(GlyphRasterCache(path, kFingerprint).GetNumLoadedGlyphs(), 0, ());
+  TEST_EQUAL(GlyphRasterCache(path, "other").GetNumLoadedGlyphs(), 1, ());
+
+  GlyphManager::Params params;
+  GetPlatform().GetFontNames(params.m_fonts);
+  TEST(!params.m_fonts.empty(), ());
+  auto const fingerprint = GlyphManager::GetRasterCacheFingerprint(params);
+  params.m_sdfScale *= 2;
+  TEST_NOT_EQUAL(fingerprint, GlyphManager::GetRasterCacheFingerprint(params), ());
+  params.m_sdfScale /= 2;
+  TEST_EQUAL(fingerprint, GlyphManager::GetRasterCacheFingerprint(params), ());
+  params.m_fonts.pop_back();
+  TEST_NOT_EQUAL(fingerprint, GlyphManager::GetRasterCacheFingerprint(params), ());
+}
+
+UNIT_TEST(GlyphRasterCache_MaxBytes)
+{
+  string const path = GetPlatform().WritablePathForFile(kCacheFile);
+  SCOPE_GUARD(deleteFile, [&path]() { base::DeleteFileX(path); });
+
+  GlyphRasterCache cache(path, kFingerprint, 1000 /* maxBytes */);
+  for (uint32_t i = 0; i < 10; ++i)
+    cache.Add(MakeKey(i, 4), MakeGlyph(10, 10, 1));
+  TEST_GREATER(cache.GetNumGlyphs(), 0, ());
+  TEST_LESS(cache.GetNumGlyphs(), 10, ());
+}
+
+// Measures generation of glyphs of the first frames in CJK and Arabic regions
+// with a cold and with a warm cache.
+UNIT_TEST(GlyphRasterCache_ColdAndWarm)
+{
+  string const path = GetPlatform().WritablePathForFile(kCacheFile);
+  base::DeleteFileX(path);
+  SCOPE_GUARD(deleteFile, [&path]() { base::DeleteFileX(path); });
+
+  GlyphManager::Params args;
+  args.m_uniBlocks = "unicode_blocks.txt";
+  args.m_whitelist = "fonts_whitelist.txt";
+  args.m_blacklist = "fonts_blacklist.txt";
+  GetPlatform().GetFontNames(args.m_fonts);
+
+  auto const text = strings::MakeUniString(
+      "東京都千代田区丸の内一丁目北京市朝阳区建国门外大街서울특별시중구세종대로"
+      "القاهرةشارعالتحريرميدانطلعتحرب");
+
+  auto const generate = [&](vector<GlyphManager::Glyph> & glyphs) {
+    args.m_rasterCache =
+        make_shared<GlyphRasterCache>(path, GlyphManager::GetRasterCacheFingerprint(args));
+    GlyphManager mng(args);
+
+    base::Timer timer;
+    for (auto const c : text)
+    {
+      auto glyph = mng.GetGlyph(c, GlyphManager::kDynamicGlyphSize);
+      if (!glyph.m_isCached)
+      {
+        auto generated = GlyphManager::GenerateGlyph(glyph, mng.GetSdfScale());
+        glyph.m_image.Destroy();
+        mng.CacheGeneratedGlyph(generated);
+        glyph = generated;
+      }
+      glyphs.push_back(glyph);
+    }
+    double const seconds = timer.ElapsedSeconds();
+    args.m_rasterCache.reset();
+    return seconds;
+  };
+
+  vector<GlyphManager::Glyph> cold;
+  vector<GlyphManager::Glyph> warm;
+  SCOPE_GUARD(destroyGlyphs, [&]() {
+    for (auto & g : cold)
+      g.m_image.Destroy();
+    for (auto & g : warm)
+      g.m_image.Destroy();
+  });
+
+  double const coldSeconds = generate(cold);
+  double const warmSeconds = generate(warm);
+  LOG(LINFO, ("Glyphs:", text.size(), "cold cache:", coldSeconds, "s, warm cache:", warmSeconds,
+              "s"));
+
+  TEST_EQUAL(cold.size(), warm.size(), ());
+  for (size_t i = 0; i < cold.size(); ++i)
+  {
+    auto const & c = cold[i];
+    auto const & w = warm[i];
+    if (!c.m_metrics.m_isValid)
+      continue;
+
+    TEST(w.m_isCached, (c.m_code));
+    TEST_EQUAL(c.m_metrics.m_xAdvance, w.m_metrics.m_xAdvance, ());
+    TEST_EQUAL(c.m_metrics.m_xOffset, w.m_metrics.m_xOffset, ());
+    TEST_EQUAL(c.m_metrics.m_yOffset, w.m_metrics.m_yOffset, ());
+    TEST_EQUAL(c.m_image.m_width, w.m_image.m_width, ());
+    TEST_EQUAL(c.m_image.m_height, w.m_image.m_height, ());
+    TEST_EQUAL(c.m_image.m_data == nullptr, w.m_image.m_data == nullptr, ());
+    if (c.m_image.m_data == nullptr)
+      continue;
+
+    size_t const size = c.m_image.m_width * c.m_image.m_height;
+    TEST(equal(c.m_image.m_data->begin(), c.m_image.m_data->begin() + size,
+               w.m_image.m_data->begin()), (c.m_code));
+  }
+}
+}  // namespace glyph_raster_cache_tests
@@ -121,7 +121,13 @@ ref_ptr<Texture::ResourceInfo> GlyphIndex::MapResource(GlyphKey const & key, boo
   GlyphGenerator::GlyphGenerationData data;
   auto result = MapResource(key, newResource, data);
   if (result != nullptr && newResource)
-    m_generator->GenerateGlyph(make_ref(this), data.m_rect, data.m_glyph);
+  {
+    // Glyphs from the raster cache are ready for uploading.
+    if (data.m_glyph.m_isCached)
+      OnCompleteGlyphGeneration({std::move(data)});
+    else
+      m_generator->GenerateGlyph(make_ref(this), data.m_rect, data.m_glyph);
+  }
   return result;
 }
 
@@ -129,6 +135,7 @@ std::vector<ref_ptr<Texture::ResourceInfo>> GlyphIndex::MapResources(std::vector
                                                                      bool & hasNewResources)
 {
   GlyphGenerator::GlyphGenerationDataArray dataArray;
+  GlyphGenerator::GlyphGenerationDataArray cachedDataArray;
   dataArray.reserve(keys.size());
 
   std::vector<ref_ptr<Texture::ResourceInfo>> info;
@@ -142,10 +149,18 @@ std::vector<ref_ptr<Texture::ResourceInfo>> GlyphIndex::MapResources(std::vector
     auto result = MapResource(glyphKey, newResource, data);
     hasNewResources |= newResource;
     if (result != nullptr && newResource)
-      dataArray.push_back(std::move(data));
+    {
+      if (data.m_glyph.m_isCached)
+        cachedDataArray.push_back(std::move(data));
+      else
+        dataArray.push_back(std::move(data));
+    }
     info.push_back(std::move(result));
   }
 
+  if (!cachedDataArray.empty())
+    OnCompleteGlyphGeneration(std::move(cachedDataArray));
+
   if (!dataArray.empty())
     m_generator->GenerateGlyphs(make_ref(this), std::move(dataArray));
 
@@ -213,6 +228,9 @@ size_t GlyphIndex::GetPendingNodesCount()
 
 void GlyphIndex::OnCompleteGlyphGeneration(GlyphGenerator::GlyphGenerationDataArray && glyphs)
 {
+  for (auto const & g : glyphs)
+    m_mng->CacheGeneratedGlyph(g.m_glyph);
+
   std::lock_guard<std::mutex> lock(m_mutex);
   for (auto & g : glyphs)
     m_pendingNodes.emplace_back(g.m_rect, g.m_glyph);
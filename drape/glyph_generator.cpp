@@ -1,9 +1,18 @@
 #include "drape/glyph_generator.hpp"
 
+#include <algorithm>
 #include <iterator>
 
 namespace dp
 {
+namespace
+{
+// Glyphs of one text are generated by a single task, bigger requests are split between
+// DrapeRoutine workers.
+size_t constexpr kMinBatchSize = 16;
+size_t constexpr kMaxBatchesCount = 4;
+}  // namespace
+
 GlyphGenerator::GlyphGenerator(uint32_t sdfScale)
   : m_sdfScale(sdfScale)
 {}
@@ -76,18 +85,34 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   std::swap(m_queue, queue);
   m_glyphsCounter += queue.size();
 
-  // Generate glyphs on the separate thread.
-  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue));
-  auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
+  // Generate glyphs on the worker threads. Big batches (e.g. the first frames in CJK regions)
+  // are split to be generated in parallel.
+  size_t const batchSize = std::max(kMinBatchSize, (queue.size() + kMaxBatchesCount - 1) /
+                                                       kMaxBatchesCount);
+  for (size_t begin = 0; begin < queue.size(); begin += batchSize)
   {
-    generateTask->Run(m_sdfScale);
-    OnTaskFinished(listener, generateTask);
-  });
-
-  if (result)
-    m_activeTasks.Add(std::move(generateTask), std::move(result));
-  else
-    generateTask->DestroyAllGlyphs();
+    auto const end = std::min(begin + batchSize, queue.size());
+    GlyphGenerationDataArray batch(std::make_move_iterator(queue.begin() + begin),
+                                   std::make_move_iterator(queue.begin() + end));
+
+    auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(batch));
+    auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
+    {
+      generateTask->Run(m_sdfScale);
+      OnTaskFinished(listener, generateTask);
+    });
+
+    if (result)
+    {
+      m_activeTasks.Add(std::move(generateTask), std::move(result));
+    }
+    else
+    {
+      generateTask->DestroyAllGlyphs();
+      ASSERT_GREATER_OR_EQUAL(m_glyphsCounter, end - begin, ());
+      m_glyphsCounter -= end - begin;
+    }
+  }
 }
 
 void GlyphGenerator::OnTaskFinished(ref_ptr<Listener> listener,
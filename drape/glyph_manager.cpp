@@ -1,5 +1,7 @@
 #include "drape/glyph_manager.hpp"
 
+#include "drape/glyph_raster_cache.hpp"
+
 #include "platform/platform.hpp"
 
 #include "coding/reader.hpp"
@@ -350,9 +352,25 @@ struct GlyphManager::Impl
   TUniBlocks m_blocks;
   TUniBlockIter m_lastUsedBlock;
   std::vector<std::unique_ptr<Font>> m_fonts;
+  // File names of |m_fonts|.
+  std::vector<std::string> m_fontNames;
 
   uint32_t m_baseGlyphHeight;
   uint32_t m_sdfScale;
+
+  std::shared_ptr<GlyphRasterCache> m_rasterCache;
+
+  GlyphRasterCache::Key MakeRasterCacheKey(int fontIndex, strings::UniChar code, int fixedSize) const
+  {
+    bool const isSdf = fixedSize < 0;
+    GlyphRasterCache::Key key;
+    key.m_font = m_fontNames[fontIndex];
+    key.m_glyphId = code;
+    key.m_size = isSdf ? m_baseGlyphHeight : static_cast<uint32_t>(fixedSize);
+    key.m_sdfScale = isSdf ? m_sdfScale : 0;
+    key.m_sdfBorder = kSdfBorder;
+    return key;
+  }
 };
 
 GlyphManager::GlyphManager(GlyphManager::Params const & params)
@@ -360,6 +378,7 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
 {
   m_impl->m_baseGlyphHeight = params.m_baseGlyphHeight;
   m_impl->m_sdfScale = params.m_sdfScale;
+  m_impl->m_rasterCache = params.m_rasterCache;
 
   using TFontAndBlockName = std::pair<std::string, std::string>;
   using TFontLst = buffer_vector<TFontAndBlockName, 64>;
@@ -405,6 +424,7 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
     {
       m_impl->m_fonts.emplace_back(std::make_unique<Font>(params.m_sdfScale, GetPlatform().GetReader(fontName),
                                                           m_impl->m_library));
+      m_impl->m_fontNames.push_back(fontName);
       m_impl->m_fonts.back()->GetCharcodes(charCodes);
     }
     catch(RootException const & e)
@@ -588,6 +608,34 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint, int fi
   if (fontIndex == kInvalidFont)
     return GetInvalidGlyph(fixedHeight);
 
+  if (m_impl->m_rasterCache != nullptr)
+  {
+    GlyphRasterCache::Glyph cached;
+    if (m_impl->m_rasterCache->Find(m_impl->MakeRasterCacheKey(fontIndex, unicodePoint, fixedHeight),
+                                    cached))
+    {
+      Glyph glyph;
+      glyph.m_metrics = GlyphMetrics{cached.m_xAdvance, cached.m_yAdvance, cached.m_xOffset,
+                                     cached.m_yOffset, true /* isValid */};
+
+      SharedBufferManager::shared_buffer_ptr_t data;
+      if (!cached.m_data.empty())
+      {
+        data = SharedBufferManager::instance().reserveSharedBuffer(
+            base::NextPowOf2(static_cast<uint32_t>(cached.m_data.size())));
+        std::copy(cached.m_data.begin(), cached.m_data.end(), data->begin());
+      }
+      glyph.m_image = GlyphImage{cached.m_width, cached.m_height, 0 /* bitmapRows */,
+                                 0 /* bitmapPitch */, data};
+
+      glyph.m_fontIndex = fontIndex;
+      glyph.m_code = unicodePoint;
+      glyph.m_fixedSize = fixedHeight < 0 ? kDynamicGlyphSize : fixedHeight;
+      glyph.m_isCached = true;
+      return glyph;
+    }
+  }
+
   auto const & f = m_impl->m_fonts[fontIndex];
   bool const isSdf = fixedHeight < 0;
   Glyph glyph = f->GetGlyph(unicodePoint, isSdf ? m_impl->m_baseGlyphHeight : fixedHeight, isSdf);
@@ -595,6 +643,14 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint, int fi
   return glyph;
 }
 
+// static
+std::string GlyphManager::GetRasterCacheFingerprint(Params const & params)
+{
+  std::ostringstream os;
+  os << "drape sdf " << params.m_sdfScale << " " << kSdfBorder << " " << params.m_baseGlyphHeight;
+  return GlyphRasterCache::MakeFingerprint(params.m_fonts, os.str());
+}
+
 // static
 GlyphManager::Glyph GlyphManager::GenerateGlyph(Glyph const & glyph, uint32_t sdfScale)
 {
@@ -638,6 +694,36 @@ GlyphManager::Glyph GlyphManager::GenerateGlyph(Glyph const & glyph, uint32_t sd
   return glyph;
 }
 
+void GlyphManager::CacheGeneratedGlyph(Glyph const & glyph) const
+{
+  if (m_impl->m_rasterCache == nullptr || glyph.m_isCached || !glyph.m_metrics.m_isValid)
+    return;
+
+  ASSERT_GREATER_OR_EQUAL(glyph.m_fontIndex, 0, ());
+  ASSERT_LESS(glyph.m_fontIndex, static_cast<int>(m_impl->m_fonts.size()), ());
+
+  GlyphRasterCache::Glyph cached;
+  cached.m_xAdvance = glyph.m_metrics.m_xAdvance;
+  cached.m_yAdvance = glyph.m_metrics.m_yAdvance;
+  cached.m_xOffset = glyph.m_metrics.m_xOffset;
+  cached.m_yOffset = glyph.m_metrics.m_yOffset;
+  cached.m_width = glyph.m_image.m_width;
+  cached.m_height = glyph.m_image.m_height;
+  if (glyph.m_image.m_data != nullptr)
+  {
+    cached.m_pitch = glyph.m_image.m_width;
+
+    // Generated image buffers are rounded up to the power of 2.
+    auto const & data = *glyph.m_image.m_data;
+    size_t const size = static_cast<size_t>(cached.m_pitch) * cached.m_height;
+    ASSERT_LESS_OR_EQUAL(size, data.size(), ());
+    cached.m_data.assign(data.begin(), data.begin() + size);
+  }
+
+  m_impl->m_rasterCache->Add(
+      m_impl->MakeRasterCacheKey(glyph.m_fontIndex, glyph.m_code, glyph.m_fixedSize), cached);
+}
+
 void GlyphManager::MarkGlyphReady(Glyph const & glyph)
 {
   ASSERT_GREATER_OR_EQUAL(glyph.m_fontIndex, 0, ());
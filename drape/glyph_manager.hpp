@@ -3,6 +3,7 @@
 #include "base/shared_buffer_manager.hpp"
 #include "base/string_utils.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <functional>
@@ -11,6 +12,7 @@ namespace dp
 {
 uint32_t constexpr kSdfBorder = 4;
 
+class GlyphRasterCache;
 struct UnicodeBlock;
 
 class GlyphManager
@@ -28,6 +30,9 @@ public:
 
     uint32_t m_baseGlyphHeight = 22;
     uint32_t m_sdfScale = 4;
+
+    // Generated glyphs are taken from and stored to this cache when it's set.
+    std::shared_ptr<GlyphRasterCache> m_rasterCache;
   };
 
   struct GlyphMetrics
@@ -71,6 +76,8 @@ public:
     int m_fontIndex;
     strings::UniChar m_code;
     int m_fixedSize;
+    // The image is taken from the raster cache and is already generated.
+    bool m_isCached = false;
   };
 
   explicit GlyphManager(Params const & params);
@@ -88,6 +95,13 @@ public:
 
   static Glyph GenerateGlyph(Glyph const & glyph, uint32_t sdfScale);
 
+  // Returns the fingerprint of glyphs which GlyphManager with |params| puts to the raster cache.
+  static std::string GetRasterCacheFingerprint(Params const & params);
+
+  // Stores the glyph returned by GenerateGlyph() in the raster cache.
+  // Can be called from any thread.
+  void CacheGeneratedGlyph(Glyph const & glyph) const;
+
 private:
   int GetFontIndex(strings::UniChar unicodePoint);
   // Immutable version can be called from any thread and doesn't require internal synchronization.
@@ -0,0 +1,297 @@
+#include "drape/glyph_raster_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+
+namespace dp
+{
+namespace
+{
+uint32_t constexpr kFileTag = 0x43524c47;  // "GLRC"
+uint32_t constexpr kFileVersion = 2;
+
+// Size of an entry except its font name and image.
+size_t constexpr kEntryOverhead = 64;
+
+template <typename Sink>
+void WriteFloat(Sink & sink, float f)
+{
+  static_assert(sizeof(f) == sizeof(uint32_t));
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(f));
+  WriteToSink(sink, bits);
+}
+
+template <typename Source>
+float ReadFloat(Source & src)
+{
+  auto const bits = ReadPrimitiveFromSource<uint32_t>(src);
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+}  // namespace
+
+bool GlyphRasterCache::Key::operator<(Key const & rhs) const
+{
+  return std::tie(m_font, m_glyphId, m_size, m_sdfScale, m_sdfBorder, m_flags) <
+         std::tie(rhs.m_font, rhs.m_glyphId, rhs.m_size, rhs.m_sdfScale, rhs.m_sdfBorder,
+                  rhs.m_flags);
+}
+
+bool GlyphRasterCache::Key::operator==(Key const & rhs) const
+{
+  return std::tie(m_font, m_glyphId, m_size, m_sdfScale, m_sdfBorder, m_flags) ==
+         std::tie(rhs.m_font, rhs.m_glyphId, rhs.m_size, rhs.m_sdfScale, rhs.m_sdfBorder,
+                  rhs.m_flags);
+}
+
+GlyphRasterCache::GlyphRasterCache(std::string const & fileName, std::string const & fingerprint,
+                                   size_t maxBytes)
+  : m_fileName(fileName), m_fingerprint(fingerprint), m_maxBytes(maxBytes)
+{
+  Load();
+}
+
+GlyphRasterCache::~GlyphRasterCache()
+{
+  Save();
+}
+
+bool GlyphRasterCache::Find(Key const & key, Glyph & glyph) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+  {
+    ++m_misses;
+    return false;
+  }
+
+  auto const & entry = it->second;
+  glyph = entry.m_glyph;
+  if (entry.m_mappedData != nullptr)
+    glyph.m_data.assign(entry.m_mappedData, entry.m_mappedData + entry.m_mappedSize);
+  ++m_hits;
+  return true;
+}
+
+void GlyphRasterCache::Add(Key const & key, Glyph const & glyph)
+{
+  ASSERT_LESS_OR_EQUAL(static_cast<size_t>(glyph.m_pitch) * glyph.m_height, glyph.m_data.size(),
+                       ());
+
+  size_t const bytes = key.m_font.size() + glyph.m_data.size() + kEntryOverhead;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_bytes + bytes > m_maxBytes)
+    return;
+
+  Entry entry;
+  entry.m_glyph = glyph;
+  if (m_entries.emplace(key, std::move(entry)).second)
+  {
+    m_bytes += bytes;
+    m_hasNewGlyphs = true;
+  }
+}
+
+bool GlyphRasterCache::Save()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_hasNewGlyphs)
+    return true;
+
+  bool const saved = base::WriteToTempAndRenameToFile(m_fileName, [this](std::string const & path)
+  {
+    try
+    {
+      FileWriter writer(path);
+      WriteToSink(writer, kFileTag);
+      WriteToSink(writer, kFileVersion);
+      rw::Write(writer, m_fingerprint);
+      WriteToSink(writer, static_cast<uint32_t>(m_entries.size()));
+      for (auto const & [key, entry] : m_entries)
+      {
+        rw::Write(writer, key.m_font);
+        WriteToSink(writer, key.m_glyphId);
+        WriteToSink(writer, key.m_size);
+        WriteToSink(writer, key.m_sdfScale);
+        WriteToSink(writer, key.m_sdfBorder);
+        WriteToSink(writer, key.m_flags);
+
+        auto const & glyph = entry.m_glyph;
+        WriteFloat(writer, glyph.m_xAdvance);
+        WriteFloat(writer, glyph.m_yAdvance);
+        WriteFloat(writer, glyph.m_xOffset);
+        WriteFloat(writer, glyph.m_yOffset);
+        WriteToSink(writer, glyph.m_width);
+        WriteToSink(writer, glyph.m_height);
+        WriteToSink(writer, glyph.m_pitch);
+
+        if (entry.m_mappedData != nullptr)
+        {
+          WriteToSink(writer, entry.m_mappedSize);
+          writer.Write(entry.m_mappedData, entry.m_mappedSize);
+        }
+        else
+        {
+          WriteToSink(writer, static_cast<uint32_t>(glyph.m_data.size()));
+          writer.Write(glyph.m_data.data(), glyph.m_data.size());
+        }
+      }
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't write glyph cache", path, e.Msg()));
+      return false;
+    }
+    return true;
+  });
+
+  // The mapping of the replaced file remains valid, so loaded entries are not touched.
+  if (saved)
+    m_hasNewGlyphs = false;
+  return saved;
+}
+
+size_t GlyphRasterCache::GetNumGlyphs() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+GlyphRasterCache::Stats GlyphRasterCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  return stats;
+}
+
+// static
+std::string GlyphRasterCache::MakeFingerprint(std::vector<std::string> fonts,
+                                              std::string const & rasterParams)
+{
+  auto const & pl = GetPlatform();
+  std::ostringstream os;
+  os << pl.Version() << ";" << rasterParams;
+
+  std::sort(fonts.begin(), fonts.end());
+  for (auto const & font : fonts)
+  {
+    os << ";" << font << ":";
+    try
+    {
+      os << pl.GetReader(font)->Size();
+    }
+    catch (RootException const &)
+    {
+      os << "-";
+    }
+  }
+  return os.str();
+}
+
+void GlyphRasterCache::Load()
+{
+  uint64_t size = 0;
+  if (!Platform::GetFileSizeByFullPath(m_fileName, size) || size == 0)
+    return;
+
+  std::map<Key, Entry> entries;
+  size_t bytes = 0;
+  try
+  {
+    m_file = std::make_unique<MmapReader>(m_fileName, MmapReader::Advice::Sequential);
+    uint8_t const * data = m_file->Data();
+
+    MemReaderWithExceptions reader(data, static_cast<size_t>(m_file->Size()));
+    ReaderSource<MemReaderWithExceptions> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kFileTag ||
+        ReadPrimitiveFromSource<uint32_t>(src) != kFileVersion)
+    {
+      LOG(LWARNING, ("Glyph cache", m_fileName, "has an unsupported format."));
+      m_file.reset();
+      return;
+    }
+
+    std::string fingerprint;
+    rw::Read(src, fingerprint);
+    if (fingerprint != m_fingerprint)
+    {
+      // Fonts or rasterization parameters have changed, all the glyphs are stale.
+      LOG(LINFO, ("Glyph cache", m_fileName, "is outdated."));
+      m_file.reset();
+      return;
+    }
+
+    auto const count = ReadPrimitiveFromSource<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      Key key;
+      rw::Read(src, key.m_font);
+      key.m_glyphId = ReadPrimitiveFromSource<uint32_t>(src);
+      key.m_size = ReadPrimitiveFromSource<uint32_t>(src);
+      key.m_sdfScale = ReadPrimitiveFromSource<uint32_t>(src);
+      key.m_sdfBorder = ReadPrimitiveFromSource<uint32_t>(src);
+      key.m_flags = ReadPrimitiveFromSource<uint32_t>(src);
+
+      Entry entry;
+      auto & glyph = entry.m_glyph;
+      glyph.m_xAdvance = ReadFloat(src);
+      glyph.m_yAdvance = ReadFloat(src);
+      glyph.m_xOffset = ReadFloat(src);
+      glyph.m_yOffset = ReadFloat(src);
+      glyph.m_width = ReadPrimitiveFromSource<uint32_t>(src);
+      glyph.m_height = ReadPrimitiveFromSource<uint32_t>(src);
+      glyph.m_pitch = ReadPrimitiveFromSource<uint32_t>(src);
+
+      entry.m_mappedSize = ReadPrimitiveFromSource<uint32_t>(src);
+      if (entry.m_mappedSize > src.Size() ||
+          static_cast<uint64_t>(glyph.m_pitch) * glyph.m_height > entry.m_mappedSize)
+      {
+        MYTHROW(Reader::SizeException, ("Bad glyph", key));
+      }
+      entry.m_mappedData = data + src.Pos();
+      src.Skip(entry.m_mappedSize);
+
+      bytes += key.m_font.size() + entry.m_mappedSize + kEntryOverhead;
+      entries.emplace(std::move(key), std::move(entry));
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't load glyph cache", m_fileName, e.Msg()));
+    m_file.reset();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries = std::move(entries);
+  m_bytes = bytes;
+  m_numLoaded = m_entries.size();
+  LOG(LINFO, ("Glyph cache", m_fileName, "is loaded, glyphs:", m_numLoaded));
+}
+
+std::string DebugPrint(GlyphRasterCache::Key const & key)
+{
+  std::ostringstream os;
+  os << "GlyphRasterCache::Key [ " << key.m_font << ", " << key.m_glyphId << ", " << key.m_size
+     << ", " << key.m_sdfScale << ", " << key.m_sdfBorder << ", " << key.m_flags << " ]";
+  return os.str();
+}
+}  // namespace dp
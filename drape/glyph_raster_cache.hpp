@@ -0,0 +1,127 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class MmapReader;
+
+namespace dp
+{
+// Persistent cache of rasterized glyphs. Rasterization with FreeType and sdf generation
+// are the most expensive parts of text rendering, so glyphs generated once are kept in a file
+// and are reused on the next start. The file is memory-mapped and indexed at construction,
+// so the cached glyphs are available since the first frame.
+//
+// The file header keeps a fingerprint of everything the images depend on besides their keys:
+// the app version, the font files and the rasterization parameters. A file with another
+// fingerprint is discarded as a whole. Fingerprints of drape and software_renderer differ,
+// so every renderer needs its own file and its own instance.
+//
+// *NOTE* This class is thread-safe.
+class GlyphRasterCache
+{
+public:
+  static size_t constexpr kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+    bool operator==(Key const & rhs) const;
+
+    // Name of the font file.
+    std::string m_font;
+    // Unicode code point or glyph index, depending on the renderer.
+    uint32_t m_glyphId = 0;
+    // Pixel size of the rasterized glyph.
+    uint32_t m_size = 0;
+    // Sdf parameters, zeros for plain bitmaps.
+    uint32_t m_sdfScale = 0;
+    uint32_t m_sdfBorder = 0;
+    // Renderer-specific kind of the image.
+    uint32_t m_flags = 0;
+  };
+
+  struct Glyph
+  {
+    float m_xAdvance = 0.0f;
+    float m_yAdvance = 0.0f;
+    float m_xOffset = 0.0f;
+    float m_yOffset = 0.0f;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    // Row size of |m_data| in bytes.
+    uint32_t m_pitch = 0;
+    std::vector<uint8_t> m_data;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  // Loads glyphs saved to |fileName| before with the same |fingerprint|.
+  // A missing, broken or outdated file means an empty cache.
+  GlyphRasterCache(std::string const & fileName, std::string const & fingerprint,
+                   size_t maxBytes = kDefaultMaxBytes);
+  // Saves new glyphs.
+  ~GlyphRasterCache();
+
+  bool Find(Key const & key, Glyph & glyph) const;
+  // Glyphs which are already cached or don't fit into the size limit are ignored.
+  void Add(Key const & key, Glyph const & glyph);
+
+  // Writes all glyphs to the file, does nothing when there are no new glyphs.
+  bool Save();
+
+  size_t GetNumGlyphs() const;
+  // Returns the number of glyphs loaded from the file.
+  size_t GetNumLoadedGlyphs() const { return m_numLoaded; }
+  Stats GetStats() const;
+
+  // Makes a fingerprint from the app version, names and sizes of |fonts| and |rasterParams|,
+  // which describe the rasterization settings of a renderer.
+  static std::string MakeFingerprint(std::vector<std::string> fonts,
+                                     std::string const & rasterParams);
+
+private:
+  struct Entry
+  {
+    Glyph m_glyph;
+    // Image of a loaded glyph points to the mapped file, |m_glyph.m_data| is empty then.
+    uint8_t const * m_mappedData = nullptr;
+    uint32_t m_mappedSize = 0;
+  };
+
+  void Load();
+
+  std::string const m_fileName;
+  std::string const m_fingerprint;
+  size_t const m_maxBytes;
+
+  std::unique_ptr<MmapReader> m_file;
+  size_t m_numLoaded = 0;
+
+  mutable std::mutex m_mutex;
+  // Guarded by |m_mutex|.
+  std::map<Key, Entry> m_entries;
+  size_t m_bytes = 0;
+  bool m_hasNewGlyphs = false;
+
+  mutable std::atomic<uint64_t> m_hits{0};
+  mutable std::atomic<uint64_t> m_misses{0};
+
+  DISALLOW_COPY_AND_MOVE(GlyphRasterCache);
+};
+
+std::string DebugPrint(GlyphRasterCache::Key const & key);
+}  // namespace dp
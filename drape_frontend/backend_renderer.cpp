@@ -14,6 +14,7 @@
 #include "drape_frontend/user_mark_shapes.hpp"
 #include "drape_frontend/visual_params.hpp"
 
+#include "drape/glyph_raster_cache.hpp"
 #include "drape/support_manager.hpp"
 #include "drape/texture_manager.hpp"
 
@@ -24,12 +25,18 @@
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 using namespace std::placeholders;
 
 namespace df
 {
+namespace
+{
+char const kGlyphRasterCacheFile[] = "glyphs.cache";
+}  // namespace
+
 BackendRenderer::BackendRenderer(Params && params)
   : BaseRenderer(ThreadsCommutator::ResourceUploadThread, params)
   , m_model(params.m_model)
@@ -234,6 +241,9 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         batcher->SetBatcherHash(tileKey.GetHashValue(BatcherBucket::Default));
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
+#endif
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+        DrapeMeasurer::Instance().StartTileBatching();
 #endif
         for (drape_ptr<MapShape> const & shape : msg->GetShapes())
         {
@@ -242,6 +252,9 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         }
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().EndShapesGeneration(static_cast<uint32_t>(msg->GetShapes().size()));
+#endif
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+        DrapeMeasurer::Instance().EndTileBatching();
 #endif
       }
       break;
@@ -258,6 +271,9 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
+#endif
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+        DrapeMeasurer::Instance().StartTileBatching();
 #endif
         OverlayBatcher batcher(tileKey);
         for (drape_ptr<MapShape> const & shape : msg->GetShapes())
@@ -274,6 +290,9 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().EndOverlayShapesGeneration(
               static_cast<uint32_t>(msg->GetShapes().size()));
+#endif
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+        DrapeMeasurer::Instance().EndTileBatching();
 #endif
       }
       break;
@@ -680,6 +699,7 @@ void BackendRenderer::ReleaseResources()
   m_trafficGenerator.reset();
 
   m_texMng->Release();
+  m_glyphRasterCache.reset();
 
   // Here m_context can be nullptr, so call the method
   // for the context from the factory.
@@ -707,6 +727,9 @@ void BackendRenderer::OnContextDestroy()
   m_batchersPool.reset();
   m_metalineManager->Stop();
   m_texMng->Release();
+  // The application may be killed in background.
+  if (m_glyphRasterCache != nullptr)
+    m_glyphRasterCache->Save();
   m_overlays.clear();
   m_trafficGenerator->ClearContextDependentResources();
 
@@ -743,7 +766,7 @@ void BackendRenderer::InitContextDependentResources()
   // Increase this value for big features.
   uint32_t constexpr kBatchSize = 5000;
 
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
+  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(GetReadingThreadsCount(),
                                                std::bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
                                                kBatchSize, kBatchSize);
   m_trafficGenerator->Init();
@@ -764,6 +787,13 @@ void BackendRenderer::InitContextDependentResources()
   params.m_glyphMngParams.m_sdfScale = VisualParams::Instance().GetGlyphSdfScale();
   params.m_glyphMngParams.m_baseGlyphHeight = VisualParams::Instance().GetGlyphBaseSize();
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+  if (m_glyphRasterCache == nullptr)
+  {
+    m_glyphRasterCache = std::make_shared<dp::GlyphRasterCache>(
+        GetPlatform().TmpPathForFile(kGlyphRasterCacheFile),
+        dp::GlyphManager::GetRasterCacheFingerprint(params.m_glyphMngParams));
+  }
+  params.m_glyphMngParams.m_rasterCache = m_glyphRasterCache;
   if (m_arrow3dCustomDecl.has_value())
   {
     params.m_arrowTexturePath = m_arrow3dCustomDecl->m_arrowMeshTexturePath;
@@ -21,6 +21,7 @@
 
 namespace dp
 {
+class GlyphRasterCache;
 class GraphicsContextFactory;
 class TextureManager;
 }  // namespace dp
@@ -133,6 +134,9 @@ private:
 
   gui::TWidgetsInitInfo m_lastWidgetsInfo;
 
+  // Outlives texture managers to keep generated glyphs between contexts.
+  std::shared_ptr<dp::GlyphRasterCache> m_glyphRasterCache;
+
   std::optional<Arrow3dCustomDecl> m_arrow3dCustomDecl;
   Arrow3d::PreloadedData m_arrow3dPreloadedData;
 
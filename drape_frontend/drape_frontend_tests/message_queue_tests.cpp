@@ -0,0 +1,220 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/message_queue.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace message_queue_tests
+{
+using namespace df;
+using namespace std;
+
+class TestMessage : public Message
+{
+public:
+  TestMessage(Type type, int id) : m_type(type), m_id(id) {}
+
+  Type GetType() const override { return m_type; }
+
+  Type const m_type;
+  int const m_id;
+  chrono::steady_clock::time_point const m_postTime = chrono::steady_clock::now();
+};
+
+void Push(MessageQueue & queue, Message::Type type, int id, MessagePriority priority)
+{
+  queue.PushMessage(make_unique_dp<TestMessage>(type, id), priority);
+}
+
+vector<int> PopAll(MessageQueue & queue)
+{
+  vector<int> ids;
+  while (auto msg = queue.PopMessage(false /* waitForMessage */))
+    ids.push_back(static_cast<TestMessage const *>(msg.get())->m_id);
+  return ids;
+}
+
+UNIT_TEST(MessageQueue_Priorities)
+{
+  MessageQueue queue;
+  TEST(queue.PopMessage(false /* waitForMessage */) == nullptr, ());
+
+  Push(queue, Message::Type::FlushTile, 1, MessagePriority::Normal);
+  Push(queue, Message::Type::FlushTile, 2, MessagePriority::Low);
+  Push(queue, Message::Type::FlushTile, 3, MessagePriority::Normal);
+  Push(queue, Message::Type::UpdateReadManager, 4, MessagePriority::UberHighSingleton);
+  Push(queue, Message::Type::Invalidate, 5, MessagePriority::High);
+  // The second singleton of the same type is dropped.
+  Push(queue, Message::Type::UpdateReadManager, 6, MessagePriority::UberHighSingleton);
+  Push(queue, Message::Type::FlushTile, 7, MessagePriority::Low);
+
+  vector<int> const expected = {4, 5, 1, 3, 2, 7};
+  TEST_EQUAL(PopAll(queue), expected, ());
+}
+
+UNIT_TEST(MessageQueue_Filtering)
+{
+  MessageQueue queue;
+  auto const filter = [](ref_ptr<Message> msg)
+  {
+    return msg->GetType() == Message::Type::FlushTile;
+  };
+
+  Push(queue, Message::Type::FlushTile, 1, MessagePriority::Normal);
+  Push(queue, Message::Type::Invalidate, 2, MessagePriority::Normal);
+  queue.EnableMessageFiltering(filter);
+  Push(queue, Message::Type::FlushTile, 3, MessagePriority::Low);
+  Push(queue, Message::Type::Invalidate, 4, MessagePriority::Normal);
+  queue.DisableMessageFiltering();
+  Push(queue, Message::Type::FlushTile, 5, MessagePriority::Normal);
+  TEST_EQUAL(PopAll(queue), vector<int>({2, 4, 5}), ());
+
+  Push(queue, Message::Type::FlushTile, 6, MessagePriority::Normal);
+  Push(queue, Message::Type::Invalidate, 7, MessagePriority::Normal);
+  queue.InstantFilter(filter);
+  Push(queue, Message::Type::FlushTile, 8, MessagePriority::Normal);
+  TEST_EQUAL(PopAll(queue), vector<int>({7, 8}), ());
+}
+
+UNIT_TEST(MessageQueue_CancelWait)
+{
+  MessageQueue queue;
+  atomic<bool> done = false;
+  // Waiting is cancelled only if it has already started, so cancel it until the wait ends.
+  thread canceller([&queue, &done]()
+  {
+    while (!done)
+    {
+      this_thread::sleep_for(chrono::milliseconds(1));
+      queue.CancelWait();
+    }
+  });
+  TEST(queue.PopMessage(true /* waitForMessage */) == nullptr, ());
+  done = true;
+  canceller.join();
+}
+
+// Posts a mix of messages similar to the tiles streaming from several threads and measures
+// how long messages stay in the queue. The order of Normal messages of every producer
+// must be preserved.
+UNIT_TEST(MessageQueue_MultipleProducers)
+{
+  int constexpr kProducersCount = 4;
+  int constexpr kMessagesCount = 20000;
+
+  MessageQueue queue;
+  vector<thread> producers;
+  for (int p = 0; p < kProducersCount; ++p)
+  {
+    producers.emplace_back([&queue, p]()
+    {
+      for (int i = 0; i < kMessagesCount; ++i)
+      {
+        int const id = p * kMessagesCount + i;
+        if (i % 50 == 0)
+          Push(queue, Message::Type::UpdateReadManager, id, MessagePriority::UberHighSingleton);
+        else if (i % 20 == 0)
+          Push(queue, Message::Type::Invalidate, id, MessagePriority::High);
+        else if (i % 10 == 0)
+          Push(queue, Message::Type::FlushOverlays, id, MessagePriority::Low);
+        else
+          Push(queue, Message::Type::FlushTile, id, MessagePriority::Normal);
+
+        // Let the consumer fall asleep sometimes.
+        if (i % 1000 == 0)
+          this_thread::sleep_for(chrono::microseconds(200));
+      }
+      Push(queue, Message::Type::FinishReading, p, MessagePriority::Normal);
+    });
+  }
+
+  vector<int> lastNormalIds(kProducersCount, -1);
+  size_t normalCount = 0;
+  chrono::nanoseconds totalLatency(0);
+  chrono::nanoseconds maxLatency(0);
+  size_t popped = 0;
+  int finishedProducers = 0;
+  while (true)
+  {
+    bool const finished = finishedProducers == kProducersCount;
+    auto msg = queue.PopMessage(!finished /* waitForMessage */);
+    if (msg == nullptr)
+    {
+      if (finished)
+        break;
+      continue;
+    }
+
+    auto const & m = *static_cast<TestMessage const *>(msg.get());
+    if (m.m_type == Message::Type::FinishReading)
+    {
+      ++finishedProducers;
+      continue;
+    }
+
+    auto const latency = chrono::steady_clock::now() - m.m_postTime;
+    totalLatency += latency;
+    maxLatency = max(maxLatency, chrono::duration_cast<chrono::nanoseconds>(latency));
+    ++popped;
+
+    if (m.m_type == Message::Type::FlushTile)
+    {
+      auto & last = lastNormalIds[m.m_id / kMessagesCount];
+      TEST_LESS(last, m.m_id, ());
+      last = m.m_id;
+      ++normalCount;
+    }
+  }
+
+  for (auto & p : producers)
+    p.join();
+
+  TEST_EQUAL(normalCount, kProducersCount * kMessagesCount * 9 / 10, ());
+  TEST_GREATER(popped, normalCount, ());
+
+  using namespace chrono;
+  LOG(LINFO, ("Messages:", popped, "average latency:",
+              duration_cast<microseconds>(totalLatency).count() / popped, "us, max latency:",
+              duration_cast<microseconds>(maxLatency).count(), "us"));
+}
+
+// Measures how fast the waiting consumer (the frame thread) wakes up on a new message.
+UNIT_TEST(MessageQueue_WakeupLatency)
+{
+  int constexpr kMessagesCount = 500;
+
+  MessageQueue queue;
+  thread producer([&queue]()
+  {
+    for (int i = 0; i < kMessagesCount; ++i)
+    {
+      this_thread::sleep_for(chrono::microseconds(100));
+      Push(queue, Message::Type::FlushTile, i, MessagePriority::Normal);
+    }
+  });
+
+  vector<chrono::nanoseconds> latencies;
+  while (latencies.size() < kMessagesCount)
+  {
+    auto msg = queue.PopMessage(true /* waitForMessage */);
+    if (msg == nullptr)
+      continue;
+    auto const & m = *static_cast<TestMessage const *>(msg.get());
+    latencies.push_back(chrono::steady_clock::now() - m.m_postTime);
+  }
+  producer.join();
+
+  sort(latencies.begin(), latencies.end());
+  using namespace chrono;
+  LOG(LINFO, ("Wakeup latency, median:",
+              duration_cast<microseconds>(latencies[latencies.size() / 2]).count(), "us, p99:",
+              duration_cast<microseconds>(latencies[latencies.size() * 99 / 100]).count(), "us"));
+}
+}  // namespace message_queue_tests
@@ -43,6 +43,7 @@ void DrapeMeasurer::Start()
     std::lock_guard<std::mutex> lock(m_tilesMutex);
     m_tilesReadInfo.clear();
   }
+  m_totalTileBatchTime = steady_clock::duration::zero();
 #endif
 
 #if defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM)
@@ -340,75 +341,119 @@ std::string DrapeMeasurer::TileStatistic::ToString() const
   std::ostringstream ss;
   ss << " ----- Tiles read statistic report ----- \n";
   ss << " Tile read time, ms = " << m_tileReadTimeInMs << "\n";
+  ss << " Tile waiting time, ms = " << m_tileWaitingTimeInMs << "\n";
+  ss << " Tile index read time, ms = " << m_tileIndexReadTimeInMs << "\n";
+  ss << " Tile decode time, ms = " << m_tileDecodeTimeInMs << "\n";
+  ss << " Tile batch time, ms = " << m_tileBatchTimeInMs << "\n";
   ss << " Tiles count = " << m_totalTilesCount << "\n";
   ss << " ----- Tiles read statistic report ----- \n";
 
   return ss.str();
 }
 
-void DrapeMeasurer::StartTileReading()
+std::shared_ptr<DrapeMeasurer::TileReadInfo> DrapeMeasurer::GetTileReadInfo(bool create)
+{
+  threads::ThreadID tid = threads::GetCurrentThreadID();
+  std::lock_guard<std::mutex> lock(m_tilesMutex);
+  auto const it = m_tilesReadInfo.find(tid);
+  if (it != m_tilesReadInfo.end())
+    return it->second;
+  if (!create)
+    return nullptr;
+
+  auto tileInfo = std::make_shared<TileReadInfo>();
+  m_tilesReadInfo.insert(make_pair(tid, tileInfo));
+  return tileInfo;
+}
+
+void DrapeMeasurer::StartTileReading(std::chrono::steady_clock::time_point const & requestTime)
 {
   if (!m_isEnabled)
     return;
 
-  threads::ThreadID tid = threads::GetCurrentThreadID();
-  std::shared_ptr<TileReadInfo> tileInfo;
-  {
-    std::lock_guard<std::mutex> lock(m_tilesMutex);
-    auto const it = m_tilesReadInfo.find(tid);
-    if (it != m_tilesReadInfo.end())
-    {
-      tileInfo = it->second;
-    }
-    else
-    {
-      tileInfo = std::make_shared<TileReadInfo>();
-      m_tilesReadInfo.insert(make_pair(tid, tileInfo));
-    }
-  }
-
+  auto tileInfo = GetTileReadInfo(true /* create */);
   auto const currentTime = std::chrono::steady_clock::now();
   tileInfo->m_startTileReadTime = currentTime;
+  tileInfo->m_endTileIndexReadTime = currentTime;
+  tileInfo->m_totalTileWaitingTime += currentTime - requestTime;
 }
 
-void DrapeMeasurer::EndTileReading()
+void DrapeMeasurer::EndTileIndexReading()
 {
   if (!m_isEnabled)
     return;
 
   auto const currentTime = std::chrono::steady_clock::now();
+  auto tileInfo = GetTileReadInfo(false /* create */);
+  if (tileInfo == nullptr)
+    return;
 
-  threads::ThreadID tid = threads::GetCurrentThreadID();
-  std::shared_ptr<TileReadInfo> tileInfo;
-  {
-    std::lock_guard<std::mutex> lock(m_tilesMutex);
-    auto const it = m_tilesReadInfo.find(tid);
-    if (it != m_tilesReadInfo.end())
-      tileInfo = it->second;
-    else
-      return;
-  }
+  tileInfo->m_endTileIndexReadTime = currentTime;
+  tileInfo->m_totalTileIndexReadTime += currentTime - tileInfo->m_startTileReadTime;
+}
+
+void DrapeMeasurer::EndTileReading()
+{
+  if (!m_isEnabled)
+    return;
+
+  auto const currentTime = std::chrono::steady_clock::now();
+  auto tileInfo = GetTileReadInfo(false /* create */);
+  if (tileInfo == nullptr)
+    return;
 
-  auto passedTime = currentTime - tileInfo->m_startTileReadTime;
-  tileInfo->m_totalTileReadTime += passedTime;
+  tileInfo->m_totalTileReadTime += currentTime - tileInfo->m_startTileReadTime;
+  tileInfo->m_totalTileDecodeTime += currentTime - tileInfo->m_endTileIndexReadTime;
   ++tileInfo->m_totalTilesCount;
 }
 
+void DrapeMeasurer::StartTileBatching()
+{
+  if (!m_isEnabled)
+    return;
+
+  m_startTileBatchTime = std::chrono::steady_clock::now();
+}
+
+void DrapeMeasurer::EndTileBatching()
+{
+  if (!m_isEnabled)
+    return;
+
+  auto const passedTime = std::chrono::steady_clock::now() - m_startTileBatchTime;
+  std::lock_guard<std::mutex> lock(m_tilesMutex);
+  m_totalTileBatchTime += passedTime;
+}
+
 DrapeMeasurer::TileStatistic DrapeMeasurer::GetTileStatistic()
 {
   using namespace std::chrono;
+  auto const toMs = [](nanoseconds const & t)
+  {
+    return static_cast<uint32_t>(duration_cast<milliseconds>(t).count());
+  };
+
   TileStatistic statistic;
   {
     std::lock_guard<std::mutex> lock(m_tilesMutex);
     for (auto const & it : m_tilesReadInfo)
     {
-      statistic.m_tileReadTimeInMs +=
-          static_cast<uint32_t>(duration_cast<milliseconds>(it.second->m_totalTileReadTime).count());
+      statistic.m_tileReadTimeInMs += toMs(it.second->m_totalTileReadTime);
+      statistic.m_tileWaitingTimeInMs += toMs(it.second->m_totalTileWaitingTime);
+      statistic.m_tileIndexReadTimeInMs += toMs(it.second->m_totalTileIndexReadTime);
+      statistic.m_tileDecodeTimeInMs += toMs(it.second->m_totalTileDecodeTime);
       statistic.m_totalTilesCount += it.second->m_totalTilesCount;
     }
+    statistic.m_tileBatchTimeInMs = toMs(m_totalTileBatchTime);
   }
   if (statistic.m_totalTilesCount > 0)
+  {
     statistic.m_tileReadTimeInMs /= statistic.m_totalTilesCount;
+    statistic.m_tileWaitingTimeInMs /= statistic.m_totalTilesCount;
+    statistic.m_tileIndexReadTimeInMs /= statistic.m_totalTilesCount;
+    statistic.m_tileDecodeTimeInMs /= statistic.m_totalTilesCount;
+    statistic.m_tileBatchTimeInMs /= statistic.m_totalTilesCount;
+  }
 
   return statistic;
 }
@@ -54,12 +54,24 @@ public:
     std::string ToString() const;
 
     uint32_t m_totalTilesCount = 0;
+    // Average times per tile.
     uint32_t m_tileReadTimeInMs = 0;
+    // Time from the tile request to the start of reading.
+    uint32_t m_tileWaitingTimeInMs = 0;
+    // Reading of the feature index and decoding of features with the shapes generation.
+    uint32_t m_tileIndexReadTimeInMs = 0;
+    uint32_t m_tileDecodeTimeInMs = 0;
+    // Batching of the tile shapes on the backend thread.
+    uint32_t m_tileBatchTimeInMs = 0;
   };
 
-  void StartTileReading();
+  void StartTileReading(std::chrono::steady_clock::time_point const & requestTime);
+  void EndTileIndexReading();
   void EndTileReading();
 
+  void StartTileBatching();
+  void EndTileBatching();
+
   TileStatistic GetTileStatistic();
 #endif
 
@@ -157,11 +169,21 @@ private:
   struct TileReadInfo
   {
     std::chrono::time_point<std::chrono::steady_clock> m_startTileReadTime;
+    std::chrono::time_point<std::chrono::steady_clock> m_endTileIndexReadTime;
     std::chrono::nanoseconds m_totalTileReadTime;
+    std::chrono::nanoseconds m_totalTileWaitingTime;
+    std::chrono::nanoseconds m_totalTileIndexReadTime;
+    std::chrono::nanoseconds m_totalTileDecodeTime;
     uint32_t m_totalTilesCount = 0;
   };
+  std::shared_ptr<TileReadInfo> GetTileReadInfo(bool create);
+
   std::map<threads::ThreadID, std::shared_ptr<TileReadInfo>> m_tilesReadInfo;
   std::mutex m_tilesMutex;
+
+  // Batching happens on the backend thread only.
+  std::chrono::time_point<std::chrono::steady_clock> m_startTileBatchTime;
+  std::chrono::nanoseconds m_totalTileBatchTime;
 #endif
 
   std::chrono::time_point<std::chrono::steady_clock> m_startFrameRenderTime;
@@ -295,6 +295,8 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       }
       UpdateCanBeDeletedStatus();
 
+      if (!m_firstTilesReady)
+        LOG(LINFO, ("Time to the first frame with overlays:", m_firstTilesTimer.ElapsedSeconds(), "s"));
       m_firstTilesReady = true;
       if (m_firstLaunchAnimationTriggered)
       {
@@ -2313,6 +2315,7 @@ void FrontendRenderer::OnContextDestroy()
 void FrontendRenderer::OnContextCreate()
 {
   LOG(LINFO, ("On context create."));
+  m_firstTilesTimer.Reset();
 
   m_context = make_ref(m_contextFactory->GetDrawContext());
   m_contextFactory->WaitForInitialization(m_context.get());
@@ -412,6 +412,8 @@ private:
   drape_ptr<ScenarioManager> m_scenarioManager;
 
   bool m_firstTilesReady = false;
+  // Measures time to the first frame with texts since the context creation.
+  base::Timer m_firstTilesTimer;
   bool m_firstLaunchAnimationTriggered = false;
   bool m_firstLaunchAnimationInterrupted = false;
 
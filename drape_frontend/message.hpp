@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 namespace df
 {
+enum class MessagePriority;
+
 class Message
 {
 public:
@@ -109,6 +112,13 @@ public:
   virtual Type GetType() const { return Type::Unknown; }
   virtual bool IsGraphicsContextDependent() const { return false; }
   virtual bool ContainsRenderState() const { return false; }
+
+private:
+  friend class MessageQueue;
+
+  // Links of the intrusive MessageQueue inbox, so posting a message allocates nothing.
+  std::atomic<Message *> m_next{nullptr};
+  MessagePriority m_priority{};
 };
 
 enum class MessagePriority
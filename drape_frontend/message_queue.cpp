@@ -3,10 +3,15 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 MessageQueue::MessageQueue()
-  : m_isWaiting(false)
+  : m_head(&m_stub)
+  , m_tail(&m_stub)
+  , m_inboxSize(0)
+  , m_isWaiting(false)
 {}
 
 MessageQueue::~MessageQueue()
@@ -18,11 +23,13 @@ MessageQueue::~MessageQueue()
 drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
-  if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
+  ProcessInbox();
+  if (waitForMessage && IsEmptyImpl())
   {
-    m_isWaiting = true;
-    m_condition.wait(lock, [this]() { return !m_isWaiting; });
-    m_isWaiting = false;
+    lock.unlock();
+    WaitForMessage();
+    lock.lock();
+    ProcessInbox();
   }
 
   drape_ptr<Message> msg;
@@ -41,11 +48,77 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  ASSERT(message != nullptr, ());
+  message->m_priority = priority;
+  // The message is owned by the queue until it is popped from the inbox.
+  PushToInbox(message.release());
+  ++m_inboxSize;
+
+  if (m_isWaiting)
+  {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    CancelWaitImpl();
+  }
+}
+
+void MessageQueue::PushToInbox(Message * message)
+{
+  message->m_next.store(nullptr, std::memory_order_relaxed);
+  Message * prev = m_head.exchange(message, std::memory_order_acq_rel);
+  // The consumer can't go further |prev| until it is linked.
+  prev->m_next.store(message, std::memory_order_release);
+}
+
+Message * MessageQueue::PopFromInbox()
+{
+  Message * tail = m_tail;
+  Message * next = tail->m_next.load(std::memory_order_acquire);
+  if (tail == &m_stub)
+  {
+    if (next == nullptr)
+      return nullptr;
+    m_tail = next;
+    tail = next;
+    next = next->m_next.load(std::memory_order_acquire);
+  }
 
-  if (m_filter != nullptr && m_filter(make_ref(message)))
-    return;
+  if (next != nullptr)
+  {
+    m_tail = next;
+    --m_inboxSize;
+    return tail;
+  }
+
+  if (tail != m_head.load(std::memory_order_acquire))
+    return nullptr;
 
+  // |tail| is the last message, the stub is pushed to leave the inbox in a valid state.
+  PushToInbox(&m_stub);
+
+  next = tail->m_next.load(std::memory_order_acquire);
+  if (next != nullptr)
+  {
+    m_tail = next;
+    --m_inboxSize;
+    return tail;
+  }
+  return nullptr;
+}
+
+void MessageQueue::ProcessInbox()
+{
+  while (Message * m = PopFromInbox())
+  {
+    auto const priority = m->m_priority;
+    drape_ptr<Message> message(m);
+    if (m_filter != nullptr && m_filter(make_ref(message)))
+      continue;
+    InsertMessage(std::move(message), priority);
+  }
+}
+
+void MessageQueue::InsertMessage(drape_ptr<Message> && message, MessagePriority priority)
+{
   switch (priority)
   {
   case MessagePriority::Normal:
@@ -86,8 +159,6 @@ void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority pr
   default:
     ASSERT(false, ("Unknown message priority type"));
   }
-
-  CancelWaitImpl();
 }
 
 void MessageQueue::FilterMessagesImpl()
@@ -115,12 +186,15 @@ void MessageQueue::EnableMessageFiltering(FilterMessageFn && filter)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
   m_filter = std::move(filter);
+  ProcessInbox();
   FilterMessagesImpl();
 }
 
 void MessageQueue::DisableMessageFiltering()
 {
   std::lock_guard<std::mutex> lock(m_mutex);
+  // Messages posted while the filter was enabled must be filtered.
+  ProcessInbox();
   m_filter = nullptr;
 }
 
@@ -128,28 +202,45 @@ void MessageQueue::InstantFilter(FilterMessageFn && filter)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
   CHECK(m_filter == nullptr, ());
+  ProcessInbox();
   m_filter = std::move(filter);
   FilterMessagesImpl();
   m_filter = nullptr;
 }
 
+bool MessageQueue::IsEmptyImpl() const
+{
+  return m_messages.empty() && m_lowPriorityMessages.empty() && m_inboxSize <= 0;
+}
+
 #ifdef DEBUG_MESSAGE_QUEUE
 bool MessageQueue::IsEmpty() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.empty() && m_lowPriorityMessages.empty();
+  return IsEmptyImpl();
 }
 
 size_t MessageQueue::GetSize() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.size() + m_lowPriorityMessages.size();
+  return m_messages.size() + m_lowPriorityMessages.size() +
+         static_cast<size_t>(std::max(m_inboxSize.load(), 0));
 }
 #endif
 
+void MessageQueue::WaitForMessage()
+{
+  std::unique_lock<std::mutex> lock(m_waitMutex);
+  // Producers check |m_isWaiting| after they increase |m_inboxSize|, so either the message is
+  // seen here or the producer wakes the consumer up.
+  m_isWaiting = true;
+  m_condition.wait(lock, [this]() { return !m_isWaiting || m_inboxSize > 0; });
+  m_isWaiting = false;
+}
+
 void MessageQueue::CancelWait()
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  std::lock_guard<std::mutex> lock(m_waitMutex);
   CancelWaitImpl();
 }
 
@@ -164,6 +255,9 @@ void MessageQueue::CancelWaitImpl()
 
 void MessageQueue::ClearQuery()
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  while (Message * m = PopFromInbox())
+    drape_ptr<Message> message(m);
   m_messages.clear();
   m_lowPriorityMessages.clear();
 }
@@ -5,13 +5,21 @@
 #include "drape/drape_diagnostics.hpp"
 #include "drape/pointers.hpp"
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <mutex>
 
 namespace df
 {
+// Messages are posted from many threads and are processed by the only renderer thread.
+// Posting does not take locks: messages are linked into an intrusive lock-free MPSC inbox
+// (Vyukov's queue). The consumer moves them to the priority ordered queues when it pops.
+//
+// *NOTE* PushMessage() and CancelWait() may be called from any thread, PopMessage() is
+// called from the renderer thread only.
 class MessageQueue
 {
 public:
@@ -35,12 +43,35 @@ public:
 #endif
 
 private:
+  // Lock-free part, Vyukov's intrusive MPSC queue.
+  void PushToInbox(Message * message);
+  // Returns nullptr when the inbox is empty or a producer has not linked its message yet.
+  // Must be called under |m_mutex|.
+  Message * PopFromInbox();
+
+  // Must be called under |m_mutex|.
+  void ProcessInbox();
+  void InsertMessage(drape_ptr<Message> && message, MessagePriority priority);
   void FilterMessagesImpl();
+  bool IsEmptyImpl() const;
+
+  void WaitForMessage();
   void CancelWaitImpl();
 
-  mutable std::mutex m_mutex;
+  // Inbox. |m_head| is the last pushed message, |m_tail| is the next one to pop.
+  std::atomic<Message *> m_head;
+  Message * m_tail;
+  Message m_stub;
+  // Number of messages in the inbox. It is increased after a message is linked, so it may be
+  // negative for a moment.
+  std::atomic<int32_t> m_inboxSize;
+
+  std::mutex m_waitMutex;
   std::condition_variable m_condition;
-  bool m_isWaiting;
+  std::atomic<bool> m_isWaiting;
+
+  // Guards the inbox consumer side and the fields below. Producers never take it.
+  mutable std::mutex m_mutex;
   using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
   std::deque<TMessageNode> m_messages;
   std::deque<drape_ptr<Message>> m_lowPriorityMessages;
@@ -8,11 +8,17 @@
 
 #include <algorithm>
 #include <functional>
+#include <thread>
 
 namespace df
 {
 namespace
 {
+uint8_t constexpr kMinReadingThreadsCount = 2;
+uint8_t constexpr kMaxReadingThreadsCount = 6;
+// UI, frontend and backend threads.
+uint8_t constexpr kBusyThreadsCount = 3;
+
 struct LessCoverageCell
 {
   bool operator()(std::shared_ptr<TileInfo> const & l,
@@ -35,6 +41,19 @@ struct LessCoverageCell
 };
 }  // namespace
 
+uint8_t GetReadingThreadsCount()
+{
+  static uint8_t const count = []()
+  {
+    auto const cores = std::thread::hardware_concurrency();
+    if (cores <= kBusyThreadsCount + kMinReadingThreadsCount)
+      return kMinReadingThreadsCount;
+    return static_cast<uint8_t>(std::min<unsigned>(cores - kBusyThreadsCount,
+                                                   kMaxReadingThreadsCount));
+  }();
+  return count;
+}
+
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
                                              std::shared_ptr<TileInfo> const & r) const
 {
@@ -65,7 +84,7 @@ void ReadManager::Start()
 
   ASSERT_EQUAL(m_counter, 0, ());
 
-  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(kReadingThreadsCount,
+  m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(GetReadingThreadsCount(),
                               std::bind(&ReadManager::OnTaskFinished, this, std::placeholders::_1));
 }
 
@@ -181,6 +200,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
 
+  SortTasksByPriority(screen);
   m_currentViewport = screen;
 }
 
@@ -226,6 +246,28 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
   return (oldScale != newScale) || !m_currentViewport.GlobalRect().IsIntersect(screen.GlobalRect());
 }
 
+void ReadManager::SortTasksByPriority(ScreenBase const & screen)
+{
+  if (m_pool == nullptr)
+    return;
+
+  m2::PointD const center = screen.GetOrg();
+  m_pool->SortQueue([&center](threads::IRoutine const * l, threads::IRoutine const * r)
+  {
+    bool const lCancelled = l->IsCancelled();
+    bool const rCancelled = r->IsCancelled();
+    if (lCancelled != rCancelled)
+      return lCancelled;
+    if (lCancelled)
+      return false;
+
+    auto const & lKey = static_cast<ReadMWMTask const *>(l)->GetTileKey();
+    auto const & rKey = static_cast<ReadMWMTask const *>(r)->GetTileKey();
+    return lKey.GetGlobalRect().Center().SquaredLength(center) <
+           rKey.GetGlobalRect().Center().SquaredLength(center);
+  });
+}
+
 void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<dp::TextureManager> texMng,
                                          ref_ptr<MetalineManager> metalineMng)
@@ -27,7 +27,8 @@ namespace df
 class MapDataProvider;
 class MetalineManager;
 
-uint8_t constexpr kReadingThreadsCount = 2;
+// Returns the number of tile reading threads, it depends on the number of CPU cores.
+uint8_t GetReadingThreadsCount();
 
 class ReadManager
 {
@@ -66,6 +67,9 @@ public:
 private:
   void OnTaskFinished(threads::IRoutine * task);
   bool MustDropAllTiles(ScreenBase const & screen) const;
+  // Cancelled tiles go first to be dropped immediately, then tiles closer to the center of
+  // the screen are read earlier.
+  void SortTasksByPriority(ScreenBase const & screen);
 
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
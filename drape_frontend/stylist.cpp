@@ -358,6 +358,7 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
     return false;
 
   Classificator const & cl = classif();
+  auto const & rules = drule::rules();
 
   uint32_t mainOverlayType = 0;
   if (types.Size() == 1)
@@ -369,7 +370,7 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
     int overlaysMaxPriority = std::numeric_limits<int>::min();
     for (uint32_t t : types)
     {
-      int const priority = cl.GetObject(t)->GetMaxOverlaysPriority();
+      int const priority = rules.GetMaxOverlaysPriority(t);
       if (priority > overlaysMaxPriority)
       {
         overlaysMaxPriority = priority;
@@ -382,13 +383,17 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
   auto const geomType = types.GetGeomType();
 
   drule::KeysT keys;
+  bool hasSelectors = false;
   for (uint32_t t : types)
   {
-    drule::KeysT typeKeys;
-    cl.GetObject(t)->GetSuitable(zoomLevel, geomType, typeKeys);
+    auto const typeKeys = rules.GetSuitableKeys(t, zoomLevel, geomType);
+    if (typeKeys.empty())
+      continue;
+
+    hasSelectors |= typeKeys.HasSelectors();
     bool const hasHatching = hatchingChecker(t);
 
-    for (auto & k : typeKeys)
+    for (auto k : typeKeys)
     {
       // Take overlay drules from the main type only.
       if (t == mainOverlayType || !IsTypeOf(k, Caption | Symbol | Shield | PathText))
@@ -400,7 +405,9 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
     }
   }
 
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
+  // Only conditional rules are evaluated per feature, the rest are taken as is.
+  if (hasSelectors)
+    feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
 
   if (keys.empty())
     return false;
@@ -458,16 +465,16 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
       {
         // Use building-address' caption drule to display house numbers.
         static auto const addressType = cl.GetTypeByPath({"building", "address"});
-        drule::KeysT addressKeys;
-        cl.GetObject(addressType)->GetSuitable(zoomLevel, geomType, addressKeys);
+        auto const addressKeys = rules.GetSuitableKeys(addressType, zoomLevel, geomType);
         if (!addressKeys.empty())
         {
           // A caption drule exists for this zoom level.
-          ASSERT(addressKeys.size() == 1 && addressKeys[0].m_type == drule::caption,
+          auto const & addressKey = *addressKeys.begin();
+          ASSERT(addressKeys.end() - addressKeys.begin() == 1 && addressKey.m_type == drule::caption,
                  ("building-address should contain a caption drule only"));
-          drule::BaseRule const * const dRule = drule::rules().Find(addressKeys[0]);
+          drule::BaseRule const * const dRule = rules.Find(addressKey);
           ASSERT(dRule != nullptr, ());
-          aggregator.m_rules.push_back({ dRule, static_cast<float>(addressKeys[0].m_priority), false });
+          aggregator.m_rules.push_back({ dRule, static_cast<float>(addressKey.m_priority), false });
         }
       }
     }
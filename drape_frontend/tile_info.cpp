@@ -23,6 +23,7 @@ namespace df
 TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
   : m_context(std::move(engineContext))
   , m_isCanceled(false)
+  , m_requestTime(std::chrono::steady_clock::now())
 {}
 
 m2::RectD TileInfo::GetGlobalRect() const
@@ -56,7 +57,7 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
-  DrapeMeasurer::Instance().StartTileReading();
+  DrapeMeasurer::Instance().StartTileReading(m_requestTime);
 #endif
   m_context->BeginReadTile();
 
@@ -65,6 +66,9 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
 
   ReadFeatureIndex(model);
   ThrowIfCancelled();
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+  DrapeMeasurer::Instance().EndTileIndexReading();
+#endif
 
   m_context->GetMetalineManager()->Update(m_mwms);
 
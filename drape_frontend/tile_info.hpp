@@ -10,6 +10,7 @@
 #include "base/macros.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <set>
 #include <vector>
 
@@ -47,6 +48,8 @@ private:
   std::vector<FeatureID> m_featureInfo;
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
+  // Time of the tile request, used to measure how long the tile waits for reading.
+  std::chrono::steady_clock::time_point const m_requestTime;
 
   DISALLOW_COPY_AND_MOVE(TileInfo);
 };
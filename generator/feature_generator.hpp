@@ -59,5 +59,5 @@ public:
   uint32_t Collect(FeatureBuilder const & f) override;
 };
 
-uint32_t CheckedFilePosCast(FileWriter const & f);
+uint32_t CheckedFilePosCast(Writer const & f);
 }  // namespace feature
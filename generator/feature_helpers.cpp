@@ -3,13 +3,11 @@
 
 #include "indexer/feature_visibility.hpp"
 
-#include "base/stl_helpers.hpp"
-
-#include <algorithm>
+#include <utility>
 
 namespace feature
 {
-CalculateMidPoints::CalculateMidPoints()
+CalculateMidPoints::CalculateMidPoints(CellAndOffsetFn && fn) : m_cellAndOffsetFn(std::move(fn))
 {
   m_minDrawableScaleFn = [](FeatureBuilder const & fb)
   {
@@ -35,7 +33,7 @@ void CalculateMidPoints::operator()(FeatureBuilder const & ft, uint64_t pos)
   if (minScale != -1)
   {
     uint64_t const order = (static_cast<uint64_t>(minScale) << 59) | (pointAsInt64 >> 5);
-    m_vec.emplace_back(order, pos);
+    m_cellAndOffsetFn({order, pos});
   }
 }
 
@@ -56,9 +54,4 @@ m2::PointD CalculateMidPoints::GetCenter() const
 
   return m_midAll / m_allCount;
 }
-
-void CalculateMidPoints::Sort()
-{
-  std::sort(m_vec.begin(), m_vec.end(), base::LessBy(&CellAndOffset::first));
-}
 }  // namespace feature
@@ -25,17 +25,16 @@ class CalculateMidPoints
 {
 public:
   using CellAndOffset = std::pair<uint64_t, uint64_t>;
+  using CellAndOffsetFn = std::function<void(CellAndOffset const &)>;
   using MinDrawableScaleFn = std::function<int (FeatureBuilder const & fb)>;
 
-  CalculateMidPoints();
+  // Cells and offsets of visible features are passed to |fn|, features are sorted by them in mwm.
+  explicit CalculateMidPoints(CellAndOffsetFn && fn);
 
   void operator()(FeatureBuilder const & ft, uint64_t pos);
   bool operator()(m2::PointD const & p);
 
   m2::PointD GetCenter() const;
-  std::vector<CellAndOffset> const & GetVector() const { return m_vec; }
-
-  void Sort();
 
 private:
   m2::PointD m_midLoc;
@@ -44,7 +43,7 @@ private:
   size_t m_allCount = 0;
   uint8_t m_coordBits = serial::GeometryCodingParams().GetCoordBits();
   MinDrawableScaleFn m_minDrawableScaleFn;
-  std::vector<CellAndOffset> m_vec;
+  CellAndOffsetFn m_cellAndOffsetFn;
 };
 
 template <typename Point>
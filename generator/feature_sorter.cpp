@@ -21,18 +21,26 @@
 #include "platform/mwm_version.hpp"
 #include "platform/platform.hpp"
 
+#include "coding/file_sort.hpp"
 #include "coding/files_container.hpp"
 #include "coding/internal/file_data.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/succinct_mapper.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include "defines.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <memory>
@@ -146,10 +154,39 @@ public:
 
   void SetBounds(m2::RectD bounds) { m_bounds = bounds; }
 
-  uint32_t operator()(FeatureBuilder & fb)
+  // Simplified and encoded geometry of a feature which is not written yet.
+  struct EncodedFeature
   {
-    GeometryHolder holder([this](int i) -> FileWriter & { return *m_geoFile[i]; },
-                          [this](int i) -> FileWriter & { return *m_trgFile[i]; }, fb, m_header);
+    FeatureBuilder m_fb;
+    FeatureBuilder::SupportingData m_data;
+    // Encoded outer geometry and triangles by scale indexes.
+    std::vector<std::vector<uint8_t>> m_geometry;
+    std::vector<std::vector<uint8_t>> m_triangles;
+    bool m_isValid = false;
+  };
+
+  // Simplifies, tesselates and encodes geometry of all scales. Geometry offsets are relative
+  // to the feature's buffers until Commit(). Doesn't change the collector, so features
+  // may be encoded in parallel.
+  EncodedFeature Encode(FeatureBuilder && srcFb) const
+  {
+    EncodedFeature res;
+    res.m_fb = std::move(srcFb);
+    auto & fb = res.m_fb;
+
+    size_t const scalesCount = m_header.GetScalesCount();
+    res.m_geometry.resize(scalesCount);
+    res.m_triangles.resize(scalesCount);
+    std::vector<MemWriter<std::vector<uint8_t>>> geoWriters;
+    std::vector<MemWriter<std::vector<uint8_t>>> trgWriters;
+    for (size_t i = 0; i < scalesCount; ++i)
+    {
+      geoWriters.emplace_back(res.m_geometry[i]);
+      trgWriters.emplace_back(res.m_triangles[i]);
+    }
+
+    GeometryHolder holder([&geoWriters](int i) -> Writer & { return geoWriters[i]; },
+                          [&trgWriters](int i) -> Writer & { return trgWriters[i]; }, fb, m_header);
 
     bool const isLine = fb.IsLine();
     bool const isArea = fb.IsArea();
@@ -234,13 +271,27 @@ public:
       }
     }
 
+    res.m_data = std::move(holder.GetBuffer());
+    res.m_isValid = fb.PreSerializeAndRemoveUselessNamesForMwm(res.m_data);
+    return res;
+  }
+
+  // Appends encoded geometry to the sections and writes the feature.
+  // Features must be committed in the mwm order.
+  uint32_t Commit(EncodedFeature & feature)
+  {
+    auto & data = feature.m_data;
+    // Geometry is written even for invalid features like it was written by one pass before.
+    AppendGeometry(feature.m_geometry, data.m_ptsMask, data.m_ptsOffset, m_geoFile);
+    AppendGeometry(feature.m_triangles, data.m_trgMask, data.m_trgOffset, m_trgFile);
+
     uint32_t featureId = kInvalidFeatureId;
-    auto & buffer = holder.GetBuffer();
-    if (fb.PreSerializeAndRemoveUselessNamesForMwm(buffer))
+    if (feature.m_isValid)
     {
-      fb.SerializeForMwm(buffer, m_header.GetDefGeometryCodingParams());
+      auto & fb = feature.m_fb;
+      fb.SerializeForMwm(data, m_header.GetDefGeometryCodingParams());
 
-      featureId = WriteFeatureBase(buffer.m_buffer, fb);
+      featureId = WriteFeatureBase(data.m_buffer, fb);
 
       fb.GetAddressData().SerializeForMwmTmp(*m_addrFile);
 
@@ -271,6 +322,31 @@ private:
 
   bool IsCountry() const { return m_header.GetType() == feature::DataHeader::MapType::Country; }
 
+  // |offsets| are stored for scales of |mask| from the upper one, every scale buffer
+  // is written once, so its offset is zero.
+  static void AppendGeometry(std::vector<std::vector<uint8_t>> const & buffers, uint8_t mask,
+                             FeatureBuilder::Offsets & offsets, TmpFiles & files)
+  {
+    size_t j = 0;
+    for (int i = static_cast<int>(buffers.size()) - 1; i >= 0; --i)
+    {
+      if ((mask & (1 << i)) == 0)
+        continue;
+
+      CHECK_LESS(j, offsets.size(), ());
+      auto & offset = offsets[j++];
+      if (offset == feature::kGeomOffsetFallback)
+        continue;
+
+      CHECK_EQUAL(offset, 0, ());
+      auto & file = *files[i];
+      offset = feature::CheckedFilePosCast(file);
+      CHECK(offset != feature::kGeomOffsetFallback, ());
+      file.Write(buffers[i].data(), buffers[i].size());
+    }
+    CHECK_EQUAL(j, offsets.size(), ());
+  }
+
   static void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in, Points & out)
   {
     if (isCoast)
@@ -304,21 +380,161 @@ private:
   DISALLOW_COPY_AND_MOVE(FeaturesCollector2);
 };
 
+namespace
+{
+// Max number of features read from .mwm.tmp at once.
+size_t constexpr kMaxFeaturesBatchSize = 4096;
+// Number of features encoded by one task.
+size_t constexpr kEncodingChunkSize = 64;
+
+// Offsets of features in .mwm.tmp in the order of features in mwm.
+// Without a memory budget the order is calculated in memory. Otherwise sorted runs of
+// the order keys are merged with FileSorter into a temporary file which is read sequentially.
+class SortedFeatureOffsets
+{
+public:
+  using CellAndOffset = CalculateMidPoints::CellAndOffset;
+
+  SortedFeatureOffsets(std::string const & tmpFilePrefix, uint64_t memoryBudget)
+  {
+    if (memoryBudget == 0)
+      return;
+
+    m_offsetsFileName = tmpFilePrefix + ".offsets" EXTENSION_TMP;
+    m_offsetsWriter = std::make_unique<FileWriter>(m_offsetsFileName);
+    m_sink.m_writer = m_offsetsWriter.get();
+    m_sorter = std::make_unique<Sorter>(static_cast<size_t>(memoryBudget),
+                                        tmpFilePrefix + ".runs" EXTENSION_TMP, m_sink);
+  }
+
+  ~SortedFeatureOffsets()
+  {
+    m_offsetsSrc.reset();
+    m_offsetsReader.reset();
+    m_sorter.reset();
+    m_offsetsWriter.reset();
+    if (!m_offsetsFileName.empty())
+      Platform::RemoveFileIfExists(m_offsetsFileName);
+  }
+
+  void Add(CellAndOffset const & cellAndOffset)
+  {
+    if (m_sorter)
+      m_sorter->Add(cellAndOffset);
+    else
+      m_offsets.push_back(cellAndOffset);
+  }
+
+  // Features with the same order key are sorted by offsets, so the order doesn't depend
+  // on the memory budget.
+  void Sort()
+  {
+    if (!m_sorter)
+    {
+      std::sort(m_offsets.begin(), m_offsets.end());
+      return;
+    }
+
+    m_sorter->SortAndFinish();
+    m_sorter.reset();
+    m_offsetsWriter.reset();
+
+    m_offsetsReader = std::make_unique<FileReader>(m_offsetsFileName);
+    m_offsetsSrc = std::make_unique<ReaderSource<FileReader>>(*m_offsetsReader);
+  }
+
+  // Returns false when there are no more features.
+  bool GetNext(uint64_t & offset)
+  {
+    if (m_offsetsSrc)
+    {
+      if (m_offsetsSrc->Size() == 0)
+        return false;
+      offset = ReadPrimitiveFromSource<uint64_t>(*m_offsetsSrc);
+      return true;
+    }
+
+    if (m_next == m_offsets.size())
+      return false;
+    offset = m_offsets[m_next++].second;
+    return true;
+  }
+
+private:
+  struct OffsetsSink
+  {
+    void operator()(CellAndOffset const & cellAndOffset) const
+    {
+      WriteToSink(*m_writer, cellAndOffset.second);
+    }
+
+    FileWriter * m_writer = nullptr;
+  };
+
+  using Sorter = FileSorter<CellAndOffset, OffsetsSink>;
+
+  std::vector<CellAndOffset> m_offsets;
+  size_t m_next = 0;
+
+  std::string m_offsetsFileName;
+  std::unique_ptr<FileWriter> m_offsetsWriter;
+  OffsetsSink m_sink;
+  std::unique_ptr<Sorter> m_sorter;
+  std::unique_ptr<FileReader> m_offsetsReader;
+  std::unique_ptr<ReaderSource<FileReader>> m_offsetsSrc;
+};
+
+// Reads the next features in the mwm order, no more than |maxBytes| of serialized features
+// except the case when the first feature is larger.
+std::vector<FeatureBuilder> ReadFeaturesBatch(FileReader const & reader,
+                                              SortedFeatureOffsets & offsets, uint64_t maxBytes)
+{
+  std::vector<FeatureBuilder> batch;
+  uint64_t bytes = 0;
+  uint64_t offset = 0;
+  while (batch.size() < kMaxFeaturesBatchSize && (batch.empty() || bytes < maxBytes) &&
+         offsets.GetNext(offset))
+  {
+    ReaderSource<FileReader> src(reader);
+    src.Skip(offset);
+
+    batch.emplace_back();
+    ReadFromSourceRawFormat(src, batch.back());
+    bytes += src.Pos() - offset;
+  }
+  return batch;
+}
+}  // namespace
+
 bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const & name,
-                           feature::DataHeader::MapType mapType)
+                           feature::DataHeader::MapType mapType, size_t threadsCount)
 {
+  CHECK_GREATER(threadsCount, 0, ());
+
   std::string const srcFilePath = info.GetTmpFileName(name);
   std::string const dataFilePath = info.GetTargetFileName(name);
 
+  // A half of the budget is used for sorting and the rest is for two batches of features:
+  // the one which is processed and the next one which is read meanwhile.
+  uint64_t const memoryBudget = info.m_geometryMemoryBudget;
+  uint64_t const maxBatchBytes =
+      memoryBudget == 0 ? std::numeric_limits<uint64_t>::max() : memoryBudget / 4;
+  uint64_t const sortingBudget = memoryBudget == 0 ? 0 : std::max<uint64_t>(memoryBudget / 2, 1);
+  SortedFeatureOffsets offsets(info.GetTmpFileName(name, DATA_FILE_EXTENSION_TMP ".sort"),
+                               sortingBudget);
+
   LOG(LINFO, ("Calculating middle points"));
   // Store cellIds for middle points.
-  CalculateMidPoints midPoints;
+  CalculateMidPoints midPoints([&offsets](CalculateMidPoints::CellAndOffset const & cellAndOffset) {
+    offsets.Add(cellAndOffset);
+  });
   ForEachFeatureRawFormat(srcFilePath, [&midPoints](FeatureBuilder const & fb, uint64_t pos) {
     midPoints(fb, pos);
   });
 
   // Sort features by their middle point.
-  midPoints.Sort();
+  LOG(LINFO, ("Sorting features, memory budget:", memoryBudget, "bytes"));
+  offsets.Sort();
 
   // Store sorted features.
   {
@@ -350,16 +566,52 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const
       SCOPE_GUARD(_, [&]() { Platform::RemoveFileIfExists(info.GetTargetFileName(name, FEATURES_FILE_TAG)); });
       LOG(LINFO, ("Simplifying and filtering geometry for all geom levels"));
       FeaturesCollector2 collector(name, info, header, regionData, info.m_versionDate);
-      for (auto const & point : midPoints.GetVector())
+
+      // The next batch is read while the current one is processed.
+      base::thread_pool::computational::ThreadPool readingPool(1 /* threadCount */);
+      auto const readBatch = [&reader, &offsets, maxBatchBytes]() {
+        return ReadFeaturesBatch(reader, offsets, maxBatchBytes);
+      };
+
+      // Features are encoded by chunks on the worker threads and committed in the same order,
+      // no more than two chunks per thread are kept in memory.
+      base::thread_pool::computational::ThreadPool encodingPool(threadsCount);
+      std::deque<std::future<std::vector<FeaturesCollector2::EncodedFeature>>> encodedChunks;
+      auto const commitFrontChunk = [&collector, &encodedChunks]() {
+        for (auto & feature : encodedChunks.front().get())
+          collector.Commit(feature);
+        encodedChunks.pop_front();
+      };
+
+      auto nextBatch = readingPool.Submit(readBatch);
+      while (true)
       {
-        ReaderSource<FileReader> src(reader);
-        src.Skip(point.second);
+        auto batch = nextBatch.get();
+        if (batch.empty())
+          break;
 
-        FeatureBuilder fb;
-        ReadFromSourceRawFormat(src, fb);
-        collector(fb);
+        nextBatch = readingPool.Submit(readBatch);
+        for (size_t i = 0; i < batch.size(); i += kEncodingChunkSize)
+        {
+          if (encodedChunks.size() >= 2 * threadsCount)
+            commitFrontChunk();
+
+          std::vector<FeatureBuilder> chunk(
+              std::make_move_iterator(batch.begin() + i),
+              std::make_move_iterator(batch.begin() + std::min(i + kEncodingChunkSize, batch.size())));
+          encodedChunks.push_back(encodingPool.Submit([&collector, chunk = std::move(chunk)]() mutable {
+            std::vector<FeaturesCollector2::EncodedFeature> encoded;
+            encoded.reserve(chunk.size());
+            for (auto & fb : chunk)
+              encoded.push_back(collector.Encode(std::move(fb)));
+            return encoded;
+          }));
+        }
       }
 
+      while (!encodedChunks.empty())
+        commitFrontChunk();
+
       LOG(LINFO, ("Writing features' data to", dataFilePath));
 
       // Update bounds with the limit rect corresponding to region borders.
@@ -18,6 +18,7 @@
 
 #include "base/file_name_utils.hpp"
 #include "base/thread_pool_computational.hpp"
+#include "base/timer.hpp"
 
 #include <utility>
 #include <vector>
@@ -89,73 +90,137 @@ void CountryFinalProcessor::SetMiniRoundabouts(std::string const & filename)
 
 void CountryFinalProcessor::SetIsolinesDir(std::string const & dir) { m_isolinesPath = dir; }
 
+void CountryFinalProcessor::SetStagesTrace(bool enabled) { m_stagesTrace = enabled; }
+
 void CountryFinalProcessor::Process()
 {
-  Order();
+  base::Timer timer;
+
+  // Routing city boundaries don't depend on .mwm.tmp files, so they are processed
+  // along with the first per-country stage.
+  {
+    ThreadPool pool(1);
+    if (!m_routingCityBoundariesCollectorFilename.empty())
+    {
+      pool.SubmitWork([this]() {
+        RunStage("RoutingCityBoundaries", [this]() { ProcessRoutingCityBoundaries(); });
+      });
+    }
+
+    ProcessCountries({{"Order", [this](auto const & name, auto const & path) { Order(name, path); }}});
+  }
 
-  if (!m_routingCityBoundariesCollectorFilename.empty())
-    ProcessRoutingCityBoundaries();
+  // These stages move features between countries, so they need all countries to be ready.
   if (!m_citiesAreasTmpFilename.empty() || !m_citiesFilename.empty())
-    ProcessCities();
+    RunStage("Cities", [this]() { ProcessCities(); });
   if (!m_coastlineGeomFilename.empty())
-    ProcessCoastline();
+    RunStage("Coastline", [this]() { ProcessCoastline(); });
+  // Mini-roundabouts are built before fake nodes are added.
   if (!m_miniRoundaboutsFilename.empty())
-    ProcessRoundabouts();
+  {
+    auto const roundabouts = ReadDataMiniRoundabout(m_miniRoundaboutsFilename);
+    ProcessCountries({{"Roundabouts", [&](auto const & name, auto const & path) {
+      ProcessRoundabouts(roundabouts, name, path);
+    }}});
+  }
   if (!m_fakeNodesFilename.empty())
-    AddFakeNodes();
+    RunStage("FakeNodes", [this]() { AddFakeNodes(); });
+
+  // The rest of the stages touch only their own country. They are chained per country, so
+  // a thread that is done with a small country picks up the next one instead of waiting
+  // for the biggest country to finish every stage.
+  std::vector<CountryStage> stages;
+  std::unique_ptr<IsolineFeaturesGenerator> isolinesGenerator;
   if (!m_isolinesPath.empty())
-    AddIsolines();
+  {
+    // For generated isolines must be built isolines_info section based on the same
+    // binary isolines file.
+    isolinesGenerator = std::make_unique<IsolineFeaturesGenerator>(m_isolinesPath);
+    stages.emplace_back("Isolines", [&](auto const & name, auto const & path) {
+      AddIsolines(*isolinesGenerator, name, path);
+    });
+  }
+
+  stages.emplace_back("DropProhibitedSpeedCameras", [this](auto const & name, auto const & path) {
+    DropProhibitedSpeedCameras(name, path);
+  });
+  stages.emplace_back("BuildingParts", [this](auto const & name, auto const & path) {
+    ProcessBuildingParts(name, path);
+  });
+  stages.emplace_back("Finish", [this](auto const & name, auto const & path) { Finish(name, path); });
+  ProcessCountries(stages);
 
-  DropProhibitedSpeedCameras();
-  ProcessBuildingParts();
-  Finish();
+  if (m_stagesTrace)
+  {
+    LOG(LINFO, ("Countries final processing took", timer.ElapsedSeconds(), "s"));
+    m_trace.Log();
+  }
 }
 
-void CountryFinalProcessor::Order()
+void CountryFinalProcessor::RunStage(std::string const & stage, std::function<void()> const & fn)
 {
-  ForEachMwmTmp(
-      m_temporaryMwmPath,
-      [&](auto const & country, auto const & path) {
-        if (!IsCountry(country))
-          return;
-
-        auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
-        generator::Order(fbs);
-
-        FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path);
-        for (auto const & fb : fbs)
-          writer.Write(fb);
-      },
-      m_threadsCount);
+  base::Timer timer;
+  fn();
+  m_trace.AddStage(stage, timer.ElapsedSeconds());
 }
 
-void CountryFinalProcessor::ProcessRoundabouts()
+void CountryFinalProcessor::ProcessCountries(std::vector<CountryStage> const & stages)
 {
-  auto roundabouts = ReadDataMiniRoundabout(m_miniRoundaboutsFilename);
-  ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & name, auto const & path) {
-    if (!IsCountry(name))
-      return;
+  std::string pipelineName;
+  for (auto const & stage : stages)
+    pipelineName += (pipelineName.empty() ? "" : "+") + stage.first;
 
-    MiniRoundaboutTransformer transformer(roundabouts.GetData(), *m_affiliations);
+  RunStage(pipelineName, [&]() {
+    ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & country, auto const & path) {
+      if (!IsCountry(country))
+        return;
+
+      base::Timer countryTimer;
+      for (auto const & [stageName, fn] : stages)
+      {
+        base::Timer timer;
+        fn(country, path);
+        m_trace.AddCountryStage(stageName, country, timer.ElapsedSeconds());
+      }
 
-    RegionData data;
+      if (stages.size() > 1)
+        m_trace.AddCountryStage(pipelineName, country, countryTimer.ElapsedSeconds());
+    }, m_threadsCount);
+  });
+}
 
-    if (ReadRegionData(name, data))
-      transformer.SetLeftHandTraffic(data.Get(RegionData::Type::RD_DRIVING) == "l");
+void CountryFinalProcessor::Order(std::string const & /* name */, std::string const & path)
+{
+  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
+  generator::Order(fbs);
 
-    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
-    ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
-        if (routing::IsRoad(fb.GetTypes()) && roundabouts.RoadExists(fb))
-          transformer.AddRoad(std::move(fb));
-        else
-          writer.Write(fb);
-    });
+  FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path);
+  for (auto const & fb : fbs)
+    writer.Write(fb);
+}
 
-    // Adds new way features generated from mini-roundabout nodes with those nodes ids.
-    // Transforms points on roads to connect them with these new roundabout junctions.
-    for (auto const & fb : transformer.ProcessRoundabouts())
-      writer.Write(fb);
-  }, m_threadsCount);
+void CountryFinalProcessor::ProcessRoundabouts(MiniRoundaboutData const & roundabouts,
+                                               std::string const & name, std::string const & path)
+{
+  MiniRoundaboutTransformer transformer(roundabouts.GetData(), *m_affiliations);
+
+  RegionData data;
+
+  if (ReadRegionData(name, data))
+    transformer.SetLeftHandTraffic(data.Get(RegionData::Type::RD_DRIVING) == "l");
+
+  FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
+      if (routing::IsRoad(fb.GetTypes()) && roundabouts.RoadExists(fb))
+        transformer.AddRoad(std::move(fb));
+      else
+        writer.Write(fb);
+  });
+
+  // Adds new way features generated from mini-roundabout nodes with those nodes ids.
+  // Transforms points on roads to connect them with these new roundabout junctions.
+  for (auto const & fb : transformer.ProcessRoundabouts())
+    writer.Write(fb);
 }
 
 bool DoesBuildingConsistOfParts(FeatureBuilder const & fbBuilding,
@@ -193,52 +258,41 @@ bool DoesBuildingConsistOfParts(FeatureBuilder const & fbBuilding,
   return bg::area(partsWithinBuilding) >= 0.9 * bg::area(building);
 }
 
-void CountryFinalProcessor::ProcessBuildingParts()
+void CountryFinalProcessor::ProcessBuildingParts(std::string const & /* name */,
+                                                 std::string const & path)
 {
   static auto const & classificator = classif();
   static auto const buildingClassifType = classificator.GetTypeByPath({"building"});
   static auto const buildingPartClassifType = classificator.GetTypeByPath({"building:part"});
   static auto const buildingWithPartsClassifType = classificator.GetTypeByPath({"building", "has_parts"});
 
-  ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & name, auto const & path) {
-    if (!IsCountry(name))
-      return;
+  // All "building:part" features in MWM
+  m4::Tree<FeatureBuilder> buildingPartsKDTree;
 
-    // All "building:part" features in MWM
-    m4::Tree<FeatureBuilder> buildingPartsKDTree;
-
-    ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
-      if (fb.IsArea() && fb.HasType(buildingPartClassifType))
-        buildingPartsKDTree.Add(fb);
-    });
-
-    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
-    ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
-      if (fb.IsArea() &&
-          fb.HasType(buildingClassifType) &&
-          DoesBuildingConsistOfParts(fb, buildingPartsKDTree))
-      {
-        fb.AddType(buildingWithPartsClassifType);
-        fb.GetParams().FinishAddingTypes();
-      }
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
+    if (fb.IsArea() && fb.HasType(buildingPartClassifType))
+      buildingPartsKDTree.Add(fb);
+  });
 
-      writer.Write(fb);
-    });
-  }, m_threadsCount);
+  FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto && fb, auto /* pos */) {
+    if (fb.IsArea() &&
+        fb.HasType(buildingClassifType) &&
+        DoesBuildingConsistOfParts(fb, buildingPartsKDTree))
+    {
+      fb.AddType(buildingWithPartsClassifType);
+      fb.GetParams().FinishAddingTypes();
+    }
+
+    writer.Write(fb);
+  });
 }
 
-void CountryFinalProcessor::AddIsolines()
+void CountryFinalProcessor::AddIsolines(IsolineFeaturesGenerator const & isolinesGenerator,
+                                        std::string const & name, std::string const & path)
 {
-  // For generated isolines must be built isolines_info section based on the same
-  // binary isolines file.
-  IsolineFeaturesGenerator isolineFeaturesGenerator(m_isolinesPath);
-  ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & name, auto const & path) {
-    if (!IsCountry(name))
-      return;
-
-    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, FileWriter::Op::OP_APPEND);
-    isolineFeaturesGenerator.GenerateIsolines(name, [&](auto const & fb) { writer.Write(fb); });
-  }, m_threadsCount);
+  FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, FileWriter::Op::OP_APPEND);
+  isolinesGenerator.GenerateIsolines(name, [&](auto const & fb) { writer.Write(fb); });
 }
 
 void CountryFinalProcessor::ProcessRoutingCityBoundaries()
@@ -293,40 +347,30 @@ void CountryFinalProcessor::AddFakeNodes()
   AppendToMwmTmp(fbs, *m_affiliations, m_temporaryMwmPath, m_threadsCount);
 }
 
-void CountryFinalProcessor::DropProhibitedSpeedCameras()
+void CountryFinalProcessor::DropProhibitedSpeedCameras(std::string const & name,
+                                                       std::string const & path)
 {
   static auto const speedCameraType = classif().GetTypeByPath({"highway", "speed_camera"});
-  ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & country, auto const & path) {
-    if (!IsCountry(country))
-      return;
+  if (!routing::AreSpeedCamerasProhibited(platform::CountryFile(name)))
+    return;
 
-    if (!routing::AreSpeedCamerasProhibited(platform::CountryFile(country)))
+  FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto const & fb, auto /* pos */) {
+    // Removing point features with speed cameras type from geometry index for some countries.
+    if (fb.IsPoint() && fb.HasType(speedCameraType))
       return;
 
-    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, true /* mangleName */);
-    ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(path, [&](auto const & fb, auto /* pos */) {
-      // Removing point features with speed cameras type from geometry index for some countries.
-      if (fb.IsPoint() && fb.HasType(speedCameraType))
-        return;
-
-      writer.Write(fb);
-    });
-  }, m_threadsCount);
+    writer.Write(fb);
+  });
 }
 
-void CountryFinalProcessor::Finish()
+void CountryFinalProcessor::Finish(std::string const & /* name */, std::string const & path)
 {
-  ForEachMwmTmp(m_temporaryMwmPath, [&](auto const & country, auto const & path) {
-    if (!IsCountry(country))
-      return;
-
-    auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
-    generator::Order(fbs);
-
-    FeatureBuilderWriter<> writer(path);
-    for (auto const & fb : fbs)
-      writer.Write(fb);
+  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
+  generator::Order(fbs);
 
-  }, m_threadsCount);
+  FeatureBuilderWriter<> writer(path);
+  for (auto const & fb : fbs)
+    writer.Write(fb);
 }
 }  // namespace generator
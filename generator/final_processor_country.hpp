@@ -1,11 +1,14 @@
 #pragma once
 
 #include "generator/final_processor_interface.hpp"
+#include "generator/final_processor_utils.hpp"
 #include "generator/place_processor.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace feature
@@ -15,6 +18,9 @@ class AffiliationInterface;
 
 namespace generator
 {
+class IsolineFeaturesGenerator;
+class MiniRoundaboutData;
+
 class CountryFinalProcessor : public FinalProcessorIntermediateMwmInterface
 {
 public:
@@ -29,6 +35,8 @@ public:
   void SetFakeNodes(std::string const & filename);
   void SetMiniRoundabouts(std::string const & filename);
   void SetIsolinesDir(std::string const & dir);
+  // Logs wall and critical path (the slowest country) time of each processing stage.
+  void SetStagesTrace(bool enabled);
 
   void DumpCitiesBoundaries(std::string const & filename);
   void DumpRoutingCitiesBoundaries(std::string const & collectorFilename,
@@ -38,16 +46,27 @@ public:
   void Process() override;
 
 private:
-  void Order();
+  // Stage which is applied to a country with (name, path to .mwm.tmp).
+  using CountryStage =
+      std::pair<std::string, std::function<void(std::string const &, std::string const &)>>;
+
+  void RunStage(std::string const & stage, std::function<void()> const & fn);
+  // Runs |stages| one after another for each country, countries are processed in parallel.
+  void ProcessCountries(std::vector<CountryStage> const & stages);
+
   void ProcessRoutingCityBoundaries();
   void ProcessCities();
   void ProcessCoastline();
-  void ProcessRoundabouts();
   void AddFakeNodes();
-  void AddIsolines();
-  void DropProhibitedSpeedCameras();
-  void Finish();
-  void ProcessBuildingParts();
+
+  void Order(std::string const & name, std::string const & path);
+  void ProcessRoundabouts(MiniRoundaboutData const & roundabouts, std::string const & name,
+                          std::string const & path);
+  void AddIsolines(IsolineFeaturesGenerator const & isolinesGenerator, std::string const & name,
+                   std::string const & path);
+  void DropProhibitedSpeedCameras(std::string const & name, std::string const & path);
+  void ProcessBuildingParts(std::string const & name, std::string const & path);
+  void Finish(std::string const & name, std::string const & path);
 
   bool IsCountry(std::string const & filename);
 
@@ -70,5 +89,8 @@ private:
   std::unique_ptr<feature::AffiliationInterface> m_affiliations;
 
   size_t m_threadsCount;
+
+  bool m_stagesTrace = false;
+  StagesTrace m_trace;
 };
 }  // namespace generator
@@ -2,6 +2,7 @@
 
 #include "indexer/feature_data.hpp"
 
+#include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
@@ -151,4 +152,80 @@ std::vector<std::vector<std::string>> GetAffiliations(std::vector<FeatureBuilder
 
   return resultAffiliations;
 }
+
+Platform::FilesList GetMwmTmpFilesBiggestFirst(std::string const & temporaryMwmPath)
+{
+  Platform::FilesList fileList;
+  Platform::GetFilesByExt(temporaryMwmPath, DATA_FILE_EXTENSION_TMP, fileList);
+
+  std::vector<std::pair<uint64_t, std::string>> sizeToFile;
+  sizeToFile.reserve(fileList.size());
+  for (auto & filename : fileList)
+  {
+    uint64_t size = 0;
+    Platform::GetFileSizeByFullPath(base::JoinPath(temporaryMwmPath, filename), size);
+    sizeToFile.emplace_back(size, std::move(filename));
+  }
+
+  // Ties are ordered by name to keep the scheduling order reproducible.
+  std::sort(std::begin(sizeToFile), std::end(sizeToFile), [](auto const & lhs, auto const & rhs) {
+    return std::tie(rhs.first, lhs.second) < std::tie(lhs.first, rhs.second);
+  });
+
+  fileList.clear();
+  base::Transform(sizeToFile, std::back_inserter(fileList), base::RetrieveSecond());
+  return fileList;
+}
+
+void StagesTrace::AddStage(std::string const & stage, double seconds)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  GetStageInfo(stage).m_wallSeconds += seconds;
+}
+
+void StagesTrace::AddCountryStage(std::string const & stage, std::string const & country,
+                                  double seconds)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto & info = GetStageInfo(stage);
+  info.m_totalCountriesSeconds += seconds;
+  if (seconds > info.m_criticalPathSeconds)
+  {
+    info.m_criticalPathSeconds = seconds;
+    info.m_criticalPathCountry = country;
+  }
+}
+
+StagesTrace::StageInfo & StagesTrace::GetStageInfo(std::string const & stage)
+{
+  auto it = std::find_if(std::begin(m_stages), std::end(m_stages),
+                         [&](auto const & p) { return p.first == stage; });
+  if (it == std::end(m_stages))
+    it = m_stages.emplace(std::end(m_stages), stage, StageInfo());
+
+  return it->second;
+}
+
+std::vector<std::pair<std::string, StagesTrace::StageInfo>> StagesTrace::GetStages() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stages;
+}
+
+void StagesTrace::Log() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto const & [stage, info] : m_stages)
+  {
+    if (info.m_criticalPathCountry.empty())
+    {
+      LOG(LINFO, ("Stage", stage, "wall time:", info.m_wallSeconds, "s"));
+      continue;
+    }
+
+    LOG(LINFO, ("Stage", stage, "wall time:", info.m_wallSeconds, "s, total countries time:",
+                info.m_totalCountriesSeconds, "s, critical path:", info.m_criticalPathSeconds,
+                "s (", info.m_criticalPathCountry, ")"));
+  }
+}
 }  // namespace generator
@@ -18,8 +18,10 @@
 
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace generator
@@ -57,11 +59,14 @@ private:
   size_t m_threadsCount;
 };
 
+// Returns names of .mwm.tmp files from |temporaryMwmPath| ordered by size, the biggest first.
+// Big countries are scheduled first, so they don't start last and stall the whole pass.
+Platform::FilesList GetMwmTmpFilesBiggestFirst(std::string const & temporaryMwmPath);
+
 template <typename ToDo>
 void ForEachMwmTmp(std::string const & temporaryMwmPath, ToDo && toDo, size_t threadsCount = 1)
 {
-  Platform::FilesList fileList;
-  Platform::GetFilesByExt(temporaryMwmPath, DATA_FILE_EXTENSION_TMP, fileList);
+  auto const fileList = GetMwmTmpFilesBiggestFirst(temporaryMwmPath);
   base::thread_pool::computational::ThreadPool pool(threadsCount);
   for (auto const & filename : fileList)
   {
@@ -104,6 +109,36 @@ std::vector<std::vector<std::string>> AppendToMwmTmp(std::vector<feature::Featur
   return affiliations;
 }
 
+// Collects timings of final processing stages. For the stages which run per country,
+// the slowest country is the critical path: the stage can't finish faster than it.
+class StagesTrace
+{
+public:
+  struct StageInfo
+  {
+    double m_wallSeconds = 0.0;
+    double m_totalCountriesSeconds = 0.0;
+    double m_criticalPathSeconds = 0.0;
+    std::string m_criticalPathCountry;
+  };
+
+  void AddStage(std::string const & stage, double seconds);
+  void AddCountryStage(std::string const & stage, std::string const & country, double seconds);
+
+  // Returns stages in order of their first appearance.
+  std::vector<std::pair<std::string, StageInfo>> GetStages() const;
+
+  void Log() const;
+
+private:
+  // Must be called under |m_mutex|.
+  StageInfo & GetStageInfo(std::string const & stage);
+
+  mutable std::mutex m_mutex;
+  // Stages in order of their first appearance.
+  std::vector<std::pair<std::string, StageInfo>> m_stages;
+};
+
 bool Less(feature::FeatureBuilder const & lhs, feature::FeatureBuilder const & rhs);
 
 // Ordering for stable features order in final processors.
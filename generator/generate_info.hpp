@@ -19,7 +19,8 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Packed
   };
 
   enum class OsmSourceType
@@ -62,6 +63,10 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Approximate limit of memory used for sorting and reading features in GenerateFinalFeatures(),
+  // in bytes. Zero means that the features order is calculated in memory.
+  uint64_t m_geometryMemoryBudget = 0;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -71,6 +76,7 @@ struct GenerateInfo
   bool m_failOnCoasts = false;
   bool m_preloadCache = false;
   bool m_verbose = false;
+  bool m_schedulerTrace = false;
 
   GenerateInfo() = default;
 
@@ -92,6 +98,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::Packed;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+#include "generator/generator_tests_support/test_with_custom_mwms.hpp"
+
+#include "indexer/feature_impl.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace feature_sorter_tests
+{
+using namespace generator::tests_support;
+using namespace std;
+
+void AddFeatures(TestMwmBuilder & builder)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(0.0, 0.1);
+  auto const randomPoint = [&]() { return m2::PointD(coord(rng), coord(rng)); };
+
+  for (size_t i = 0; i < 300; ++i)
+  {
+    string const name = "Feature " + strings::to_string(i);
+    m2::PointD const p = randomPoint();
+    switch (i % 4)
+    {
+    case 0: builder.Add(TestPOI(p, name, "en")); break;
+    case 1:
+      builder.Add(TestBuilding(m2::RectD(p, p + m2::PointD(1e-4, 1e-4)), name,
+                               strings::to_string(i), "" /* street */, "en"));
+      break;
+    case 2:
+    {
+      vector<m2::PointD> points = {p};
+      for (size_t j = 0; j < 50; ++j)
+        points.push_back(points.back() + (randomPoint() - m2::PointD(0.05, 0.05)) * 0.01);
+      builder.Add(TestStreet(points, name, "en"));
+      break;
+    }
+    case 3: builder.Add(TestSquare(m2::RectD(p, p + m2::PointD(0.01, 0.01)), name, "en")); break;
+    }
+  }
+}
+
+string ReadSection(FilesContainerR const & cont, string const & tag)
+{
+  string data;
+  cont.GetReader(tag).ReadAsString(data);
+  return data;
+}
+
+// Sections written by GenerateFinalFeatures() don't depend on the memory budget
+// and the number of threads.
+UNIT_CLASS_TEST(TestWithCustomMwms, FeatureSorter_MemoryBudgetAndThreads)
+{
+  auto const referenceId = BuildCountry("reference", [](TestMwmBuilder & builder) {
+    AddFeatures(builder);
+  });
+  auto const streamingId = BuildCountry("streaming", [](TestMwmBuilder & builder) {
+    builder.SetGeometryMemoryBudget(1024);
+    AddFeatures(builder);
+  });
+  auto const parallelId = BuildCountry("parallel", [](TestMwmBuilder & builder) {
+    builder.SetGeometryMemoryBudget(64 * 1024);
+    builder.SetThreadsCount(4);
+    AddFeatures(builder);
+  });
+
+  auto const getPath = [](MwmSet::MwmId const & id) {
+    return id.GetInfo()->GetLocalFile().GetPath(MapFileType::Map);
+  };
+  FilesContainerR const reference(getPath(referenceId));
+  FilesContainerR const streaming(getPath(streamingId));
+  FilesContainerR const parallel(getPath(parallelId));
+
+  vector<string> tags = {FEATURES_FILE_TAG, METADATA_FILE_TAG};
+  for (size_t i = 0; i < size(feature::g_arrCountryScales); ++i)
+  {
+    tags.push_back(feature::GetTagForIndex(GEOMETRY_FILE_TAG, i));
+    tags.push_back(feature::GetTagForIndex(TRIANGLE_FILE_TAG, i));
+  }
+
+  for (auto const & tag : tags)
+  {
+    TEST(reference.IsExist(tag), (tag));
+    for (auto const * cont : {&streaming, &parallel})
+    {
+      TEST(cont->IsExist(tag), (tag));
+      TEST(ReadSection(reference, tag) == ReadSection(*cont, tag), (tag));
+    }
+  }
+  TEST_GREATER(reference.GetReader(FEATURES_FILE_TAG).Size(), 0, ());
+}
+}  // namespace feature_sorter_tests
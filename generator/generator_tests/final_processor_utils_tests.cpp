@@ -0,0 +1,103 @@
+#include "testing/testing.hpp"
+
+#include "generator/final_processor_utils.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "base/file_name_utils.hpp"
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace final_processor_utils_tests
+{
+using namespace generator;
+using namespace platform::tests_support;
+using namespace std;
+
+UNIT_TEST(GetMwmTmpFilesBiggestFirst)
+{
+  string const kDirName = "final_processor_utils_tests";
+  ScopedDir const dir(kDirName);
+
+  auto const makeFile = [&kDirName](string const & name, size_t size) {
+    return ScopedFile(base::JoinPath(kDirName, name), string(size, 'x'));
+  };
+
+  ScopedFile const b = makeFile("B.mwm.tmp", 10);
+  ScopedFile const a = makeFile("A.mwm.tmp", 30);
+  ScopedFile const c = makeFile("C.mwm.tmp", 10);
+  ScopedFile const d = makeFile("D.mwm.tmp", 20);
+  // Files of other types are skipped.
+  ScopedFile const e = makeFile("E.mwm", 100);
+
+  auto const files =
+      GetMwmTmpFilesBiggestFirst(base::JoinPath(GetPlatform().WritableDir(), kDirName));
+  // Files of the same size are ordered by name.
+  TEST_EQUAL(files, Platform::FilesList({"A.mwm.tmp", "D.mwm.tmp", "B.mwm.tmp", "C.mwm.tmp"}), ());
+}
+
+UNIT_TEST(StagesTrace_Smoke)
+{
+  StagesTrace trace;
+  trace.AddStage("Order", 1.0);
+  trace.AddCountryStage("Order", "B", 0.5);
+  trace.AddCountryStage("Order", "A", 2.0);
+  trace.AddCountryStage("Order", "C", 1.0);
+  trace.AddStage("Cities", 3.0);
+  trace.AddStage("Order", 1.5);
+
+  auto const stages = trace.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+
+  TEST_EQUAL(stages[0].first, "Order", ());
+  TEST_ALMOST_EQUAL_ABS(stages[0].second.m_wallSeconds, 2.5, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(stages[0].second.m_totalCountriesSeconds, 3.5, 1e-9, ());
+  // The slowest country is the critical path.
+  TEST_ALMOST_EQUAL_ABS(stages[0].second.m_criticalPathSeconds, 2.0, 1e-9, ());
+  TEST_EQUAL(stages[0].second.m_criticalPathCountry, "A", ());
+
+  TEST_EQUAL(stages[1].first, "Cities", ());
+  TEST_ALMOST_EQUAL_ABS(stages[1].second.m_wallSeconds, 3.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(stages[1].second.m_totalCountriesSeconds, 0.0, 1e-9, ());
+  TEST(stages[1].second.m_criticalPathCountry.empty(), ());
+}
+
+// Countries are processed by a thread pool, so their stages are added concurrently.
+UNIT_TEST(StagesTrace_Threads)
+{
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kCountriesCount = 100;
+
+  StagesTrace trace;
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&trace, t]() {
+      for (size_t i = 0; i < kCountriesCount; ++i)
+      {
+        auto const country = to_string(t) + "_" + to_string(i);
+        trace.AddCountryStage("Order", country, 1.0);
+        trace.AddCountryStage("Finish", country, t == 2 && i == 50 ? 5.0 : 0.5);
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  // Every thread adds "Order" of a country before its "Finish".
+  auto const stages = trace.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].first, "Order", ());
+  TEST_ALMOST_EQUAL_ABS(stages[0].second.m_totalCountriesSeconds,
+                        kThreadsCount * kCountriesCount * 1.0, 1e-6, ());
+  TEST_EQUAL(stages[1].first, "Finish", ());
+  TEST_ALMOST_EQUAL_ABS(stages[1].second.m_totalCountriesSeconds,
+                        kThreadsCount * kCountriesCount * 0.5 + 4.5, 1e-6, ());
+  TEST_EQUAL(stages[1].second.m_criticalPathCountry, "2_50", ());
+}
+}  // namespace final_processor_utils_tests
@@ -8,13 +8,18 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace intermediate_data_test
@@ -109,4 +114,42 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.m_tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.m_tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_packed_point_storage_test)
+{
+  using feature::GenerateInfo;
+  using platform::tests_support::ScopedFile;
+
+  // Ids cover empty blocks, several sub-blocks of a block and the first and the last ids of blocks.
+  std::vector<std::tuple<uint64_t, double, double>> const points = {
+      {1, 55.7522200, 37.6155600},   {2, 55.7522201, 37.6155599},   {63, -33.8688197, 151.2092955},
+      {64, -33.8688198, 151.2092956}, {200, 0.0000001, -179.9999999}, {255, 89.9999999, 179.9999999},
+      {256, -89.9999999, -0.0000001}, {1024, 40.7127753, -74.0059728}, {1000000, 1.0, 2.0}};
+
+  ScopedFile const file("nodes.packed", ScopedFile::Mode::DoNotCreate);
+  {
+    auto writer = generator::cache::CreatePointStorageWriter(GenerateInfo::NodeStorageType::Packed,
+                                                             file.GetFullPath());
+    for (auto const & [id, lat, lon] : points)
+      writer->AddPoint(id, lat, lon);
+  }
+
+  auto const reader = generator::cache::CreatePointStorageReader(
+      GenerateInfo::NodeStorageType::Packed, file.GetFullPath());
+  for (auto const & [id, lat, lon] : points)
+  {
+    double readLat = 0.0;
+    double readLon = 0.0;
+    TEST(reader->GetPoint(id, readLat, readLon), (id));
+    TEST_ALMOST_EQUAL_ABS(readLat, lat, 1e-7, (id));
+    TEST_ALMOST_EQUAL_ABS(readLon, lon, 1e-7, (id));
+  }
+
+  for (uint64_t const id : {0, 3, 62, 65, 254, 257, 1023, 999999, 1000001, 100000000})
+  {
+    double lat = 0.0;
+    double lon = 0.0;
+    TEST(!reader->GetPoint(id, lat, lon), (id));
+  }
+}
 }  // namespace intermediate_data_test
@@ -4,6 +4,8 @@
 #include "generator/osm_element.hpp"
 #include "generator/osm_source.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
 #include "coding/parse_xml.hpp"
 
 #include <cstddef>
@@ -73,3 +75,38 @@ UNIT_TEST(Source_To_Element_check_equivalence)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
   }
 }
+
+UNIT_TEST(Source_To_Element_parallel_o5m_test)
+{
+  std::string src(std::begin(relation_o5m_data), std::end(relation_o5m_data));
+  std::istringstream ss(src);
+  SourceReader reader(ss);
+
+  std::vector<OsmElement> expected;
+  ProcessOsmElementsFromO5M(reader, [&expected](OsmElement && e)
+  {
+    expected.push_back(std::move(e));
+  });
+
+  platform::tests_support::ScopedFile const file("relation.o5m", src);
+  for (size_t threadsCount : {1, 2, 8})
+  {
+    // Segment size of one byte splits the file after every element, the decoder state
+    // is restored at each of them.
+    for (uint64_t segmentSize : {0, 1})
+    {
+      ParallelProcessorOsmElementsFromO5M processor(file.GetFullPath(), threadsCount,
+                                                    segmentSize);
+      std::vector<OsmElement> elements;
+      OsmElement element;
+      while (processor.TryRead(element))
+      {
+        elements.push_back(std::move(element));
+        element.Clear();
+      }
+
+      TEST_EQUAL(processor.Pos(), src.size(), ());
+      TEST_EQUAL(elements, expected, (threadsCount, segmentSize));
+    }
+  }
+}
@@ -44,6 +44,8 @@ public:
   void SetUKPostcodesData(std::string const & postcodesPath,
                           std::shared_ptr<storage::CountryInfoGetter> const & countryInfoGetter);
   void SetMwmLanguages(std::vector<std::string> const & languages);
+  void SetGeometryMemoryBudget(uint64_t bytes) { m_geometryMemoryBudget = bytes; }
+  void SetThreadsCount(size_t threadsCount) { m_threadsCount = threadsCount; }
 
   void Finish();
 
@@ -56,6 +58,8 @@ private:
   std::shared_ptr<storage::CountryInfoGetter> m_postcodesCountryInfoGetter;
   std::string m_ukPostcodesPath;
   uint32_t m_version = 0;
+  uint64_t m_geometryMemoryBudget = 0;
+  size_t m_threadsCount = 1;
 };
 }  // namespace tests_support
 }  // namespace generator
@@ -95,7 +95,8 @@ DEFINE_string(cache_path, "",
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, "
+              "packed (memory mapped, compressed, requires nodes to be sorted by id).");
 DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
@@ -104,6 +105,9 @@ DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
 DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
+DEFINE_uint64(generate_geometry_memory_mb, 0,
+              "Memory budget for sorting and reading features in --generate_geometry, in MB. "
+              "If it equals zero, features are sorted in memory.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
 DEFINE_bool(dump_cities_boundaries, false, "Dump cities boundaries to a file");
@@ -132,6 +136,8 @@ DEFINE_bool(make_transit_cross_mwm, false, "Make section for cross mwm transit r
 DEFINE_bool(make_transit_cross_mwm_experimental, false,
             "Experimental parameter. If set the new version of transit cross-mwm section will be "
             "generated. Makes section for cross mwm transit routing.");
+DEFINE_bool(make_contraction_hierarchy, false,
+            "Make section with contraction hierarchy for intra mwm car routing.");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
 DEFINE_string(srtm_path, "",
@@ -200,6 +206,8 @@ DEFINE_bool(dump_mwm_tmp, false, "Prints feature builder objects from .mwm.tmp")
 DEFINE_uint64(threads_count, 0, "Desired count of threads. If count equals zero, count of "
                                 "threads is set automatically.");
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_bool(scheduler_trace, false,
+            "Log wall and critical path (the slowest country) time of each final processing stage.");
 
 MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 {
@@ -231,6 +239,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   feature::GenerateInfo genInfo;
   genInfo.m_verbose = FLAGS_verbose;
+  genInfo.m_schedulerTrace = FLAGS_scheduler_trace;
   genInfo.m_intermediateDir = FLAGS_intermediate_data_path.empty()
                                   ? path
                                   : base::AddSlashIfNeeded(FLAGS_intermediate_data_path);
@@ -258,6 +267,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   genInfo.m_brandsTranslationsFilename = FLAGS_brands_translations_data;
   genInfo.m_citiesBoundariesFilename = FLAGS_cities_boundaries_data;
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_geometryMemoryBudget = FLAGS_generate_geometry_memory_mb * 1024 * 1024;
   genInfo.m_haveBordersForWholeWorld = FLAGS_have_borders_for_whole_world;
   genInfo.m_createWorld = FLAGS_generate_world;
   genInfo.m_makeCoasts = FLAGS_make_coasts;
@@ -276,7 +286,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
-    if (!GenerateIntermediateData(genInfo))
+    if (!GenerateIntermediateData(genInfo, threadsCount))
       return EXIT_FAILURE;
   }
 
@@ -309,8 +319,8 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   // Load mwm tree only if we need it
   std::unique_ptr<storage::CountryParentGetter> countryParentGetter;
   if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
-      FLAGS_make_transit_cross_mwm_experimental || !FLAGS_uk_postcodes_dataset.empty() ||
-      !FLAGS_us_postcodes_dataset.empty())
+      FLAGS_make_transit_cross_mwm_experimental || FLAGS_make_contraction_hierarchy ||
+      !FLAGS_uk_postcodes_dataset.empty() || !FLAGS_us_postcodes_dataset.empty())
   {
     countryParentGetter = std::make_unique<storage::CountryParentGetter>();
   }
@@ -352,7 +362,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       // On error move to the next bucket without index generation.
 
       LOG(LINFO, ("Generating result features for", country));
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
+      if (!feature::GenerateFinalFeatures(genInfo, country, mapType, threadsCount))
         continue;
 
       LOG(LINFO, ("Generating offsets table for", dataFile));
@@ -528,6 +538,12 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
         LOG(LCRITICAL, ("Generating city roads error."));
     }
 
+    if (FLAGS_make_contraction_hierarchy)
+    {
+      CHECK(countryParentGetter, ());
+      BuildContractionHierarchySection(path, dataFile, country, *countryParentGetter);
+    }
+
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
         FLAGS_make_transit_cross_mwm_experimental)
     {
@@ -1,13 +1,22 @@
 #include "generator/intermediate_data.hpp"
 
-#include <new>
-#include <set>
-#include <string>
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <array>
+#include <cstring>
+#include <new>
+#include <set>
+#include <string>
+
 #include "defines.hpp"
 
 namespace generator::cache
@@ -254,6 +263,194 @@ private:
   FileWriter m_fileWriter;
   uint64_t m_numProcessedPoints = 0;
 };
+
+// Packed point storage -----------------------------------------------------------------------------
+// Nodes are grouped into blocks of kPackedBlockSize consecutive ids. Each non-empty block is:
+// - presence bitmap, kPackedBlockSize bits;
+// - offsets of sub-blocks 1..N-1 from the end of the block header, uint16 each;
+// - for each sub-block, coordinates of present nodes in ids order: zigzag varint deltas of
+//   lat and lon from the previous node of the sub-block (from zero for the first one).
+// Sub-blocks keep the count of nodes which are decoded on each lookup small.
+// The file ends with the offsets of all blocks (plus one for the end of the last block)
+// and the number of these offsets, uint64 each.
+uint64_t constexpr kPackedBlockSize = 256;
+uint64_t constexpr kPackedSubBlockSize = 64;
+uint64_t constexpr kPackedSubBlocksCount = kPackedBlockSize / kPackedSubBlockSize;
+size_t constexpr kPackedBlockHeaderSize =
+    kPackedSubBlocksCount * sizeof(uint64_t) + (kPackedSubBlocksCount - 1) * sizeof(uint16_t);
+
+// PackedPointStorageMmapReader --------------------------------------------------------------------
+class PackedPointStorageMmapReader : public PointStorageReaderInterface
+{
+public:
+  explicit PackedPointStorageMmapReader(string const & name)
+    : m_mmapReader(name, MmapReader::Advice::Random)
+  {
+    uint64_t const size = m_mmapReader.Size();
+    CHECK_GREATER_OR_EQUAL(size, sizeof(uint64_t), ("Damaged file", name));
+
+    uint64_t offsetsCount = 0;
+    m_mmapReader.Read(size - sizeof(offsetsCount), &offsetsCount, sizeof(offsetsCount));
+    CHECK_LESS_OR_EQUAL((offsetsCount + 1) * sizeof(uint64_t), size, ("Damaged file", name));
+
+    m_offsets = m_mmapReader.Data() + size - (offsetsCount + 1) * sizeof(uint64_t);
+    m_blocksCount = offsetsCount == 0 ? 0 : offsetsCount - 1;
+  }
+
+  // PointStorageReaderInterface overrides:
+  bool GetPoint(uint64_t id, double & lat, double & lon) const override
+  {
+    LatLon ll;
+    bool ret = GetLatLon(id, ll) && FromLatLon(ll, lat, lon);
+    if (!ret)
+      LOG(LERROR, ("Node with id =", id, "not found!"));
+    return ret;
+  }
+
+private:
+  uint64_t GetBlockOffset(uint64_t block) const
+  {
+    uint64_t offset;
+    memcpy(&offset, m_offsets + block * sizeof(offset), sizeof(offset));
+    return offset;
+  }
+
+  bool GetLatLon(uint64_t id, LatLon & ll) const
+  {
+    uint64_t const block = id / kPackedBlockSize;
+    if (block >= m_blocksCount)
+      return false;
+
+    uint64_t const blockOffset = GetBlockOffset(block);
+    if (blockOffset == GetBlockOffset(block + 1))
+      return false;
+
+    uint8_t const * data = m_mmapReader.Data() + blockOffset;
+    uint64_t const subBlock = (id % kPackedBlockSize) / kPackedSubBlockSize;
+    uint64_t const bit = id % kPackedSubBlockSize;
+
+    uint64_t bitmap;
+    memcpy(&bitmap, data + subBlock * sizeof(bitmap), sizeof(bitmap));
+    if (((bitmap >> bit) & 1) == 0)
+      return false;
+
+    uint16_t subBlockOffset = 0;
+    if (subBlock != 0)
+    {
+      memcpy(&subBlockOffset,
+             data + kPackedSubBlocksCount * sizeof(bitmap) + (subBlock - 1) * sizeof(subBlockOffset),
+             sizeof(subBlockOffset));
+    }
+
+    // Number of nodes before |id| in the sub-block.
+    auto const rank = bits::PopCount(bitmap & ((uint64_t{1} << bit) - 1));
+    ArrayByteSource src(data + kPackedBlockHeaderSize + subBlockOffset);
+    int64_t lat = 0;
+    int64_t lon = 0;
+    for (uint32_t i = 0; i <= rank; ++i)
+    {
+      lat += ReadVarInt<int64_t>(src);
+      lon += ReadVarInt<int64_t>(src);
+    }
+
+    ll.m_lat = static_cast<int32_t>(lat);
+    ll.m_lon = static_cast<int32_t>(lon);
+    return true;
+  }
+
+  MmapReader m_mmapReader;
+  uint8_t const * m_offsets = nullptr;
+  uint64_t m_blocksCount = 0;
+};
+
+// PackedPointStorageWriter ------------------------------------------------------------------------
+// Requires points to be added in ascending order of ids, as they are in o5m and pbf files.
+class PackedPointStorageWriter : public PointStorageWriterBase
+{
+public:
+  explicit PackedPointStorageWriter(string const & name) : m_fileWriter(name) {}
+
+  ~PackedPointStorageWriter() noexcept(false) override
+  {
+    FlushBlock();
+    // End of the last block.
+    m_offsets.push_back(m_fileWriter.Pos());
+    m_fileWriter.Write(m_offsets.data(), m_offsets.size() * sizeof(uint64_t));
+    WriteToSink(m_fileWriter, static_cast<uint64_t>(m_offsets.size()));
+  }
+
+  // PointStorageWriterInterface overrides:
+  void AddPoint(uint64_t id, double lat, double lon) override
+  {
+    CHECK(m_numProcessedPoints == 0 || id > m_lastId,
+          ("Nodes must be sorted by id for the packed storage, got", id, "after", m_lastId));
+
+    uint64_t const block = id / kPackedBlockSize;
+    if (block != m_block)
+    {
+      FlushBlock();
+      m_block = block;
+    }
+
+    uint64_t const index = id % kPackedBlockSize;
+    ToLatLon(lat, lon, m_points[index]);
+    m_bitmap[index / kPackedSubBlockSize] |= uint64_t{1} << (index % kPackedSubBlockSize);
+
+    m_lastId = id;
+    ++m_numProcessedPoints;
+  }
+
+private:
+  void FlushBlock()
+  {
+    // Empty blocks have the same offset as the next one.
+    while (m_offsets.size() <= m_block)
+      m_offsets.push_back(m_fileWriter.Pos());
+
+    if (m_numProcessedPoints == 0)
+      return;
+
+    m_buffer.clear();
+    MemWriter<std::vector<uint8_t>> writer(m_buffer);
+    std::array<uint16_t, kPackedSubBlocksCount - 1> subBlockOffsets = {};
+    for (uint64_t subBlock = 0; subBlock < kPackedSubBlocksCount; ++subBlock)
+    {
+      if (subBlock != 0)
+        subBlockOffsets[subBlock - 1] = base::checked_cast<uint16_t>(m_buffer.size());
+
+      int64_t prevLat = 0;
+      int64_t prevLon = 0;
+      for (uint64_t bit = 0; bit < kPackedSubBlockSize; ++bit)
+      {
+        if (((m_bitmap[subBlock] >> bit) & 1) == 0)
+          continue;
+
+        auto const & ll = m_points[subBlock * kPackedSubBlockSize + bit];
+        WriteVarInt(writer, int64_t{ll.m_lat} - prevLat);
+        WriteVarInt(writer, int64_t{ll.m_lon} - prevLon);
+        prevLat = ll.m_lat;
+        prevLon = ll.m_lon;
+      }
+    }
+
+    for (auto const bitmap : m_bitmap)
+      WriteToSink(m_fileWriter, bitmap);
+    for (auto const offset : subBlockOffsets)
+      WriteToSink(m_fileWriter, offset);
+    m_fileWriter.Write(m_buffer.data(), m_buffer.size());
+
+    m_bitmap = {};
+  }
+
+  FileWriter m_fileWriter;
+  std::vector<uint64_t> m_offsets;
+  uint64_t m_block = 0;
+  uint64_t m_lastId = 0;
+  std::array<uint64_t, kPackedSubBlocksCount> m_bitmap = {};
+  std::array<LatLon, kPackedBlockSize> m_points;
+  std::vector<uint8_t> m_buffer;
+  uint64_t m_numProcessedPoints = 0;
+};
 }  // namespace
 
 // IndexFileReader ---------------------------------------------------------------------------------
@@ -431,6 +628,8 @@ CreatePointStorageReader(feature::GenerateInfo::NodeStorageType type, string con
     return std::make_unique<MapFilePointStorageReader>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return std::make_unique<RawMemPointStorageReader>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return std::make_unique<PackedPointStorageMmapReader>(name);
   }
   UNREACHABLE();
 }
@@ -446,6 +645,8 @@ CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType type, string con
     return std::make_unique<MapFilePointStorageWriter>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return std::make_unique<RawMemPointStorageWriter>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return std::make_unique<PackedPointStorageWriter>(name);
   }
   UNREACHABLE();
 }
@@ -27,6 +27,7 @@ class StreamBuffer
   TBuffer m_buffer;
   size_t const m_maxBufferSize;
   size_t m_recap; // recap read bytes
+  uint64_t m_readBytes = 0; // bytes got from m_reader
 
   TBuffer::const_iterator m_position;
 
@@ -37,6 +38,9 @@ public:
     Refill();
   }
 
+  // Number of bytes consumed from the stream.
+  uint64_t Pos() const { return m_readBytes - std::distance(m_position, m_buffer.cend()); }
+
   size_t Recap()
   {
     size_t const recap = m_recap;
@@ -101,6 +105,7 @@ private:
 
     size_t const readBytes = m_reader(m_buffer.data(), m_buffer.size());
     CHECK_NOT_EQUAL(readBytes, 0, ("Unexpected std::end input stream."));
+    m_readBytes += readBytes;
 
     if (readBytes != m_buffer.size())
       m_buffer.resize(readBytes);
@@ -175,6 +180,26 @@ protected:
     char const * role = nullptr;
   };
 
+public:
+  // Delta coding counters and the string table between two datasets. Lets decoding start
+  // in the middle of the data, from a dataset where the state was taken.
+  struct State
+  {
+    int64_t m_currentNodeRef = 0;
+    int64_t m_currentWayRef = 0;
+    int64_t m_currentRelationRef = 0;
+    int64_t m_id = 0;
+    int32_t m_lon = 0;
+    int32_t m_lat = 0;
+    uint64_t m_timestamp = 0;
+    uint64_t m_changeset = 0;
+    // Zero terminated keys and values of the string table records in the table order.
+    std::vector<char> m_strings;
+    size_t m_stringCurrentIndex = 0;
+  };
+
+protected:
+
   std::vector<StringTableRecord> m_stringTable;
   std::vector<char> m_stringBuffer;
   size_t m_stringCurrentIndex;
@@ -540,6 +565,33 @@ public:
     m_stringTable.resize(15000);
   }
 
+  void SetState(State const & state)
+  {
+    m_currentNodeRef = state.m_currentNodeRef;
+    m_currentWayRef = state.m_currentWayRef;
+    m_currentRelationRef = state.m_currentRelationRef;
+    m_id = state.m_id;
+    m_lon = state.m_lon;
+    m_lat = state.m_lat;
+    m_timestamp = state.m_timestamp;
+    m_changeset = state.m_changeset;
+
+    char const * p = state.m_strings.data();
+    char const * const end = p + state.m_strings.size();
+    for (auto & record : m_stringTable)
+    {
+      CHECK(p != end, ("Broken o5m string table state."));
+      for (char * dst : {record.key, record.value})
+      {
+        size_t const size = strnlen(p, std::min<size_t>(end - p, StringTableRecord::MaxEntrySize - 1));
+        memcpy(dst, p, size);
+        dst[size] = 0;
+        p += size + 1;
+      }
+    }
+    m_stringCurrentIndex = state.m_stringCurrentIndex;
+  }
+
   void Reset()
   {
     m_currentNodeRef = 0;
@@ -567,6 +619,12 @@ public:
       m_reader->Reset();
       NextValue();
     }
+    Iterator(O5MSource * reader, State const & state) : m_reader(reader), m_entity(reader)
+    {
+      m_reader->Reset();
+      m_reader->SetState(state);
+      NextValue();
+    }
 
     bool operator==(Iterator const & iter) const { return m_reader == iter.m_reader; }
     bool operator!=(Iterator const & iter) const { return !(*this == iter); }
@@ -578,8 +636,38 @@ public:
   };
 
   Iterator const begin() { return Iterator(this); }
+  // Continues decoding with |state| taken by GetState() at the same position of the data.
+  Iterator const begin(State const & state) { return Iterator(this, state); }
   Iterator const end() { return Iterator(); }
 
+  // Returns the state after the last read dataset, its remainder must be skipped before.
+  State GetState() const
+  {
+    State state;
+    state.m_currentNodeRef = m_currentNodeRef;
+    state.m_currentWayRef = m_currentWayRef;
+    state.m_currentRelationRef = m_currentRelationRef;
+    state.m_id = m_id;
+    state.m_lon = m_lon;
+    state.m_lat = m_lat;
+    state.m_timestamp = m_timestamp;
+    state.m_changeset = m_changeset;
+    for (auto const & record : m_stringTable)
+    {
+      for (char const * src : {record.key, record.value})
+      {
+        size_t const size = strnlen(src, StringTableRecord::MaxEntrySize - 1);
+        state.m_strings.insert(state.m_strings.end(), src, src + size);
+        state.m_strings.push_back(0);
+      }
+    }
+    state.m_stringCurrentIndex = m_stringCurrentIndex;
+    return state;
+  }
+
+  // Number of bytes read from the data.
+  uint64_t Pos() const { return m_buffer.Pos(); }
+
   O5MSource(TReadFunc reader, size_t readBufferSizeInBytes = 60000) : m_buffer(reader, readBufferSizeInBytes)
   {
     if (EntityType::Reset != EntityType(m_buffer.Get()))
@@ -7,11 +7,15 @@
 
 #include "geometry/mercator.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
+#include <utility>
 
 #include "defines.hpp"
 
@@ -159,11 +163,10 @@ ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream)
 {
 }
 
-bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
+namespace
+{
+void TranslateO5MEntity(osm::O5MSource::Entity const & entity, OsmElement & element)
 {
-  if (m_pos == m_dataset.end())
-    return false;
-
   using Type = osm::O5MSource::EntityType;
   auto const translate = [](Type t) -> OsmElement::EntityType {
     switch (t)
@@ -180,7 +183,6 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
   // iterating in loop. Furthermore, into Tags() method calls Nodes.Skip() and Members.Skip(),
   // thus first call of Nodes (Members) after Tags() will not return any results.
   // So don not reorder the "for" loops (!).
-  auto const & entity = *m_pos;
   element.m_id = entity.id;
   switch (entity.type)
   {
@@ -210,13 +212,241 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
 
   for (auto const & tag : entity.Tags())
     element.AddTag(tag.key, tag.value);
+}
+}  // namespace
 
+bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
+{
+  if (m_pos == m_dataset.end())
+    return false;
+
+  TranslateO5MEntity(*m_pos, element);
   ++m_pos;
   return true;
 }
 
+ParallelProcessorOsmElementsFromO5M::ParallelProcessorOsmElementsFromO5M(
+    std::string const & filename, size_t threadsCount, uint64_t segmentSize)
+  : m_filename(filename)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+
+  if (segmentSize == 0)
+  {
+    // A few segments per thread keep threads busy when segments are decoded at different speed.
+    size_t constexpr kSegmentsPerThread = 4;
+    uint64_t constexpr kMinSegmentSize = 1 << 20;
+
+    uint64_t fileSize = 0;
+    CHECK(Platform::GetFileSizeByFullPath(m_filename, fileSize), (m_filename));
+    segmentSize = std::max(fileSize / (threadsCount * kSegmentsPerThread), kMinSegmentSize);
+  }
+
+  LOG_SHORT(LINFO, ("Reading o5m file", m_filename, "by segments of", segmentSize, "bytes in",
+                    threadsCount, "threads"));
+
+  // Segments are taken by threads in the file order, so the segment which is read now
+  // is always being decoded or is already decoded.
+  m_threadPool = std::make_unique<base::thread_pool::computational::ThreadPool>(threadsCount);
+  m_scanner = std::thread([this, segmentSize]() { Scan(segmentSize); });
+}
+
+ParallelProcessorOsmElementsFromO5M::~ParallelProcessorOsmElementsFromO5M()
+{
+  m_stopped = true;
+  m_scanner.join();
+  {
+    std::lock_guard<std::mutex> segmentsLock(m_segmentsMutex);
+    for (auto & segment : m_segments)
+    {
+      std::lock_guard<std::mutex> lock(segment->m_mutex);
+      segment->m_cv.notify_all();
+    }
+  }
+  m_threadPool.reset();
+}
+
+bool ParallelProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
+{
+  while (m_chunkPos == m_chunk.m_elements.size())
+  {
+    if (!PopChunk())
+      return false;
+  }
+
+  element = std::move(m_chunk.m_elements[m_chunkPos++]);
+  return true;
+}
+
+void ParallelProcessorOsmElementsFromO5M::Scan(uint64_t segmentSize)
+{
+  std::ifstream stream(m_filename, std::ios::binary);
+  CHECK(stream.is_open(), ("Can't open file:", m_filename));
+  // Otherwise the data before the first reset would have to be decoded without a known state.
+  CHECK_EQUAL(stream.peek(), base::Underlying(osm::O5MSource::EntityType::Reset),
+              ("o5m file", m_filename, "doesn't start with a dataset reset."));
+
+  osm::O5MSource dataset([&](uint8_t * buffer, size_t size) {
+    stream.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(stream.gcount());
+  });
+
+  auto const addSegment = [this](uint64_t begin, uint64_t end, osm::O5MSource::State && state) {
+    std::lock_guard<std::mutex> lock(m_segmentsMutex);
+    auto * segment = m_segments.emplace_back(
+        std::make_unique<Segment>(begin, end, std::move(state))).get();
+    m_threadPool->SubmitWork([this, segment]() { DecodeSegment(*segment); });
+    m_segmentsCv.notify_all();
+  };
+
+  // The reset and the header are read by the constructor, the state after them is the initial one.
+  uint64_t begin = dataset.Pos();
+  auto state = dataset.GetState();
+  for (auto it = dataset.begin(); it != dataset.end() && !m_stopped; ++it)
+  {
+    // Only the delta coded values and the string table are decoded here.
+    auto const & entity = *it;
+    entity.SkipRemainder();
+    // The end of the other datasets is not tracked by the decoder.
+    if (entity.type != osm::O5MSource::EntityType::Node &&
+        entity.type != osm::O5MSource::EntityType::Way &&
+        entity.type != osm::O5MSource::EntityType::Relation)
+    {
+      continue;
+    }
+
+    uint64_t const pos = dataset.Pos();
+    if (pos - begin < segmentSize)
+      continue;
+
+    addSegment(begin, pos, std::move(state));
+    begin = pos;
+    state = dataset.GetState();
+  }
+
+  // The last segment ends with the end dataset.
+  if (!m_stopped)
+    addSegment(begin, dataset.Pos(), std::move(state));
+
+  std::lock_guard<std::mutex> lock(m_segmentsMutex);
+  m_scanned = true;
+  m_segmentsCv.notify_all();
+}
+
+void ParallelProcessorOsmElementsFromO5M::DecodeSegment(Segment & segment)
+{
+  size_t constexpr kChunkSize = 1024;
+  // Dataset reset and the header which O5MSource expects at the beginning of the data.
+  static std::vector<uint8_t> const kPrefix = {0xff, 0xe0, 0x04, 'o', '5', 'm', '2'};
+
+  std::ifstream stream(m_filename, std::ios::binary);
+  CHECK(stream.is_open(), ("Can't open file:", m_filename));
+  stream.seekg(static_cast<std::streamoff>(segment.m_begin));
+
+  size_t prefixPos = 0;
+  uint64_t bytesLeft = segment.m_end - segment.m_begin;
+  bool endWritten = false;
+  osm::O5MSource dataset([&](uint8_t * buffer, size_t size) -> size_t {
+    size_t read = 0;
+    for (; prefixPos < kPrefix.size() && read < size; ++prefixPos)
+      buffer[read++] = kPrefix[prefixPos];
+
+    auto const toRead = static_cast<size_t>(std::min<uint64_t>(size - read, bytesLeft));
+    stream.read(reinterpret_cast<char *>(buffer + read), static_cast<std::streamsize>(toRead));
+    auto const gcount = static_cast<size_t>(stream.gcount());
+    read += gcount;
+    bytesLeft -= gcount;
+
+    // The segment is closed with the end dataset.
+    if (read < size && !endWritten)
+    {
+      buffer[read++] = base::Underlying(osm::O5MSource::EntityType::End);
+      endWritten = true;
+    }
+    return read;
+  });
+
+  Chunk chunk;
+  chunk.m_elements.reserve(kChunkSize);
+  // Counters and the string table are restored to the values they had at the segment begin.
+  auto it = dataset.begin(segment.m_state);
+  segment.m_state = {};
+  for (; it != dataset.end(); ++it)
+  {
+    auto const & entity = *it;
+    TranslateO5MEntity(entity, chunk.m_elements.emplace_back());
+    if (chunk.m_elements.size() != kChunkSize)
+      continue;
+
+    chunk.m_pos = segment.m_end - bytesLeft;
+    if (!PushChunk(segment, std::move(chunk)))
+      return;
+
+    chunk = {};
+    chunk.m_elements.reserve(kChunkSize);
+  }
+
+  chunk.m_pos = segment.m_end;
+  PushChunk(segment, std::move(chunk));
+
+  std::lock_guard<std::mutex> lock(segment.m_mutex);
+  segment.m_done = true;
+  segment.m_cv.notify_all();
+}
+
+bool ParallelProcessorOsmElementsFromO5M::PushChunk(Segment & segment, Chunk && chunk)
+{
+  // Limits memory of the segments which are decoded ahead of the reader.
+  size_t constexpr kMaxChunksCount = 32;
+
+  std::unique_lock<std::mutex> lock(segment.m_mutex);
+  segment.m_cv.wait(lock, [&]() {
+    return m_stopped || segment.m_chunks.size() < kMaxChunksCount;
+  });
+
+  if (m_stopped)
+    return false;
+
+  segment.m_chunks.emplace_back(std::move(chunk));
+  segment.m_cv.notify_all();
+  return true;
+}
+
+bool ParallelProcessorOsmElementsFromO5M::PopChunk()
+{
+  for (;; ++m_currentSegment)
+  {
+    Segment * current = nullptr;
+    {
+      std::unique_lock<std::mutex> segmentsLock(m_segmentsMutex);
+      m_segmentsCv.wait(segmentsLock, [&]() {
+        return m_scanned || m_currentSegment < m_segments.size();
+      });
+      if (m_currentSegment == m_segments.size())
+        return false;
+      // Pointers to the segments stay valid when the deque grows.
+      current = m_segments[m_currentSegment].get();
+    }
+
+    auto & segment = *current;
+    std::unique_lock<std::mutex> lock(segment.m_mutex);
+    segment.m_cv.wait(lock, [&]() { return segment.m_done || !segment.m_chunks.empty(); });
+    if (segment.m_chunks.empty())
+      continue;
+
+    m_chunk = std::move(segment.m_chunks.front());
+    segment.m_chunks.pop_front();
+    segment.m_cv.notify_all();
+
+    m_chunkPos = 0;
+    m_pos = m_chunk.m_pos;
+    return true;
+  }
+}
+
 ProcessorOsmElementsFromXml::ProcessorOsmElementsFromXml(SourceReader & stream)
-  : m_xmlSource([&, this](auto * element) { m_queue.emplace(*element); })
+  : m_stream(stream)
+  , m_xmlSource([&, this](auto * element) { m_queue.emplace(*element); })
   , m_parser(stream, m_xmlSource)
 {
 }
@@ -245,7 +475,7 @@ bool ProcessorOsmElementsFromXml::TryRead(OsmElement & element)
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GenerateIntermediateData(feature::GenerateInfo & info)
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount)
 {
   auto nodes =
       cache::CreatePointStorageWriter(info.m_nodeStorageType, info.GetCacheFileName(NODES_FILE));
@@ -261,7 +491,21 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
     BuildIntermediateDataFromXML(reader, cache, towns);
     break;
   case feature::GenerateInfo::OsmSourceType::O5M:
-    BuildIntermediateDataFromO5M(reader, cache, towns);
+    if (!info.m_osmFileName.empty() && threadsCount > 1)
+    {
+      ParallelProcessorOsmElementsFromO5M processor(info.m_osmFileName, threadsCount);
+      OsmElement element;
+      while (processor.TryRead(element))
+      {
+        towns.CheckElement(element);
+        AddElementToCache(cache, std::move(element));
+        element.Clear();
+      }
+    }
+    else
+    {
+      BuildIntermediateDataFromO5M(reader, cache, towns);
+    }
     break;
   }
 
@@ -8,12 +8,21 @@
 
 #include "coding/parse_xml.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 struct OsmElement;
 class FeatureParams;
@@ -45,7 +54,7 @@ public:
   uint64_t Pos() const { return m_pos; }
 };
 
-bool GenerateIntermediateData(feature::GenerateInfo & info);
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount = 1);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void (OsmElement &&)> const & processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void (OsmElement &&)> const & processor);
@@ -56,6 +65,8 @@ public:
   virtual ~ProcessorOsmElementsInterface() = default;
 
   virtual bool TryRead(OsmElement & element) = 0;
+  // Returns position of the already read data in the source, in bytes.
+  virtual uint64_t Pos() const = 0;
 };
 
 class ProcessorOsmElementsFromO5M : public ProcessorOsmElementsInterface
@@ -65,6 +76,7 @@ public:
 
   // ProcessorOsmElementsInterface overrides:
   bool TryRead(OsmElement & element) override;
+  uint64_t Pos() const override { return m_stream.Pos(); }
 
 private:
   SourceReader & m_stream;
@@ -72,6 +84,73 @@ private:
   osm::O5MSource::Iterator m_pos;
 };
 
+// Reads o5m file in parallel. The file is split into segments of about |segmentSize| bytes
+// at dataset boundaries. A scanning thread walks through the datasets skipping their contents
+// and takes the decoder state (delta coding counters and the string table) at the beginning
+// of every segment, so the segments are decoded independently by |threadsCount| threads.
+// Elements are returned in the same order as they are in the file.
+// The file must start with a dataset reset and is required to be seekable, so stdin is
+// not supported.
+class ParallelProcessorOsmElementsFromO5M : public ProcessorOsmElementsInterface
+{
+public:
+  // |segmentSize| equal to zero means a few segments per thread.
+  ParallelProcessorOsmElementsFromO5M(std::string const & filename, size_t threadsCount,
+                                      uint64_t segmentSize = 0);
+  ~ParallelProcessorOsmElementsFromO5M() override;
+
+  // ProcessorOsmElementsInterface overrides:
+  bool TryRead(OsmElement & element) override;
+  uint64_t Pos() const override { return m_pos; }
+
+private:
+  struct Chunk
+  {
+    std::vector<OsmElement> m_elements;
+    // Position in the file after the elements of the chunk were read.
+    uint64_t m_pos = 0;
+  };
+
+  // Part of the file between two dataset boundaries.
+  struct Segment
+  {
+    Segment(uint64_t begin, uint64_t end, osm::O5MSource::State && state)
+      : m_begin(begin), m_end(end), m_state(std::move(state))
+    {
+    }
+
+    uint64_t const m_begin;
+    uint64_t const m_end;
+    // Decoder state at |m_begin|, released when decoding starts.
+    osm::O5MSource::State m_state;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Chunk> m_chunks;
+    bool m_done = false;
+  };
+
+  void Scan(uint64_t segmentSize);
+  void DecodeSegment(Segment & segment);
+  bool PushChunk(Segment & segment, Chunk && chunk);
+  bool PopChunk();
+
+  std::string m_filename;
+  std::mutex m_segmentsMutex;
+  std::condition_variable m_segmentsCv;
+  // Segments found by Scan(), guarded by |m_segmentsMutex|.
+  std::deque<std::unique_ptr<Segment>> m_segments;
+  bool m_scanned = false;
+  size_t m_currentSegment = 0;
+  Chunk m_chunk;
+  size_t m_chunkPos = 0;
+  uint64_t m_pos = 0;
+  std::atomic<bool> m_stopped{false};
+  // Should be destroyed before |m_segments|.
+  std::unique_ptr<base::thread_pool::computational::ThreadPool> m_threadPool;
+  std::thread m_scanner;
+};
+
 class ProcessorOsmElementsFromXml : public ProcessorOsmElementsInterface
 {
 public:
@@ -79,10 +158,13 @@ public:
 
   // ProcessorOsmElementsInterface overrides:
   bool TryRead(OsmElement & element) override;
+  uint64_t Pos() const override { return m_stream.Pos(); }
 
 private:
   bool TryReadFromQueue(OsmElement & element);
 
+  SourceReader & m_stream;
+
   XMLSource m_xmlSource;
   XMLSequenceParser<SourceReader, XMLSource> m_parser;
   std::queue<OsmElement> m_queue;
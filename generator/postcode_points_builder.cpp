@@ -271,8 +271,10 @@ bool BuildPostcodePoints(std::string const & path, storage::CountryId const & co
                          bool forceRebuild)
 {
   auto const & platform = GetPlatform();
-  auto const infoGetter = storage::CountryInfoReader::CreateCountryInfoGetter(platform);
+  auto const infoGetter = storage::CountryInfoReader::CreateCountryInfoReader(platform);
   CHECK(infoGetter, ());
+  // Every postcode point of the dataset is looked up.
+  infoGetter->LoadPointIndex();
   return BuildPostcodePointsWithInfoGetter(path, country, type, datasetPath, forceRebuild,
                                            *infoGetter);
 }
@@ -185,6 +185,7 @@ RawGenerator::FinalProcessorPtr RawGenerator::CreateCountryFinalProcessor(bool a
       m_genInfo.m_targetDir, m_genInfo.m_tmpDir, m_genInfo.m_intermediateDir,
       m_genInfo.m_haveBordersForWholeWorld, m_threadsCount);
   finalProcessor->SetIsolinesDir(m_genInfo.m_isolinesDir);
+  finalProcessor->SetStagesTrace(m_genInfo.m_schedulerTrace);
   finalProcessor->SetCitiesAreas(m_genInfo.GetIntermediateFileName(CITIES_AREAS_TMP_FILENAME));
   finalProcessor->SetMiniRoundabouts(m_genInfo.GetIntermediateFileName(MINI_ROUNDABOUTS_FILENAME));
   if (addAds)
@@ -223,7 +224,15 @@ bool RawGenerator::GenerateFilteredFeatures()
   switch (m_genInfo.m_osmFileType)
   {
   case feature::GenerateInfo::OsmSourceType::O5M:
-    sourceProcessor = std::make_unique<ProcessorOsmElementsFromO5M>(reader);
+    if (!m_genInfo.m_osmFileName.empty() && m_threadsCount > 1)
+    {
+      sourceProcessor = std::make_unique<ParallelProcessorOsmElementsFromO5M>(
+          m_genInfo.m_osmFileName, m_threadsCount);
+    }
+    else
+    {
+      sourceProcessor = std::make_unique<ProcessorOsmElementsFromO5M>(reader);
+    }
     break;
   case feature::GenerateInfo::OsmSourceType::XML:
     sourceProcessor = std::make_unique<ProcessorOsmElementsFromXml>(reader);
@@ -244,7 +253,7 @@ bool RawGenerator::GenerateFilteredFeatures()
     if (++element_pos != m_chunkSize)
       continue;
 
-    stats.Log(elements, reader.Pos());
+    stats.Log(elements, sourceProcessor->Pos());
     translators.Emit(elements);
     
     for (auto & e : elements)
@@ -253,7 +262,7 @@ bool RawGenerator::GenerateFilteredFeatures()
     element_pos = 0;
   }
   elements.resize(element_pos);
-  stats.Log(elements, reader.Pos(), true /* forcePrint */);
+  stats.Log(elements, sourceProcessor->Pos(), true /* forcePrint */);
   translators.Emit(std::move(elements));
 
   LOG(LINFO, ("Input was processed."));
@@ -13,6 +13,7 @@
 #include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter_joints.hpp"
+#include "routing/joint_hierarchy.hpp"
 #include "routing/joint_segment.hpp"
 #include "routing/vehicle_mask.hpp"
 #include "routing/world_graph.hpp"
@@ -687,6 +688,40 @@ void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
   SerializeCrossMwm(mwmFile, CROSS_MWM_FILE_TAG, builder);
 }
 
+void BuildContractionHierarchySection(string const & path, string const & mwmFile,
+                                      string const & country,
+                                      CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building contraction hierarchy section for", country));
+  base::Timer timer;
+
+  // Car only, like leaps in cross mwm section.
+  VehicleType const vhType = VehicleType::Car;
+  std::shared_ptr<VehicleModelInterface> vehicleModel =
+      CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+
+  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, vhType);
+  auto estimator = EdgeEstimator::Create(vhType, *vehicleModel, nullptr /* trafficStash */,
+                                         nullptr /* dataSource */, nullptr /* numMvmIds */);
+  IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel), mwmNumRoads),
+                   estimator);
+  DeserializeIndexGraph(mwmValue, vhType, graph);
+
+  JointHierarchy hierarchy;
+  hierarchy.Build(graph, *estimator);
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(CH_FILE_TAG);
+  auto const startPos = writer->Pos();
+  hierarchy.Serialize(*writer);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Contraction hierarchy section generated, size:", sectionSize, "bytes,",
+              graph.GetNumJoints(), "joints,", hierarchy.GetHierarchy().GetNumEdges(),
+              "edges, elapsed:", timer.ElapsedSeconds(), "seconds"));
+}
+
 void BuildTransitCrossMwmSection(
     string const & path, string const & mwmFile, string const & country,
     CountryParentNameGetterFn const & countryParentNameGetterFn,
@@ -22,6 +22,12 @@ void BuildRoutingCrossMwmSection(std::string const & path, std::string const & m
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
                                  std::string const & osmToFeatureFile,
                                  bool disableCrossMwmProgress);
+/// \brief Builds CH_FILE_TAG section with a contraction hierarchy over the car road graph.
+/// \note Before call of this method
+/// * routing, maxspeeds and city_roads sections should be generated
+void BuildContractionHierarchySection(std::string const & path, std::string const & mwmFile,
+                                      std::string const & country,
+                                      CountryParentNameGetterFn const & countryParentNameGetterFn);
 /// \brief Builds TRANSIT_CROSS_MWM_FILE_TAG section.
 /// \note Before a call of this method TRANSIT_FILE_TAG should be built.
 void BuildTransitCrossMwmSection(
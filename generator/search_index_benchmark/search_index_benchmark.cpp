@@ -0,0 +1,72 @@
+#include "generator/search_index_builder.hpp"
+
+#include "indexer/classificator_loader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_string(input, "", "Path to the mwm file.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+DEFINE_uint64(threads_count, std::thread::hardware_concurrency(), "Number of threads for the parallel run.");
+DEFINE_uint64(runs, 3, "Number of runs for every threads count.");
+
+namespace
+{
+double BuildIndex(FilesContainerR & container, uint32_t threadsCount, std::vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  MemWriter<std::vector<uint8_t>> writer(buffer);
+
+  base::Timer timer;
+  indexer::BuildSearchIndex(container, writer, threadsCount);
+  return timer.ElapsedSeconds();
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  gflags::SetUsageMessage("Times the search index section building for the mwm file.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_input.empty())
+  {
+    gflags::ShowUsageWithFlagsRestrict(argv[0], "search_index_benchmark");
+    return -1;
+  }
+
+  if (!FLAGS_user_resource_path.empty())
+    GetPlatform().SetResourceDir(FLAGS_user_resource_path);
+
+  classificator::Load();
+
+  FilesContainerR container(GetPlatform().GetReader(FLAGS_input, "f"));
+  auto const threadsCount = static_cast<uint32_t>(std::max<uint64_t>(FLAGS_threads_count, 1));
+
+  std::vector<uint8_t> serial;
+  std::vector<uint8_t> parallel;
+  for (uint64_t run = 0; run < FLAGS_runs; ++run)
+  {
+    auto const serialSeconds = BuildIndex(container, 1 /* threadsCount */, serial);
+    auto const parallelSeconds = BuildIndex(container, threadsCount, parallel);
+    CHECK(serial == parallel, ("Parallel search index differs from the serial one."));
+
+    std::cout << "Run " << run << ": index size " << serial.size() << " bytes, 1 thread "
+              << serialSeconds << " s, " << threadsCount << " threads " << parallelSeconds
+              << " s, speedup " << serialSeconds / parallelSeconds << std::endl;
+  }
+
+  return 0;
+}
@@ -36,12 +36,14 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -362,10 +364,11 @@ private:
   std::pair<int, int> m_scales;
 };
 
+// Collects sorted pairs of the search index using |threadsCount| threads.
 template <typename Key, typename Value>
 void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
                               CategoriesHolder const & categoriesHolder,
-                              std::vector<std::pair<Key, Value>> & keyValuePairs)
+                              std::vector<std::pair<Key, Value>> & keyValuePairs, uint32_t threadsCount)
 {
   feature::DataHeader const & header = features.GetHeader();
 
@@ -373,8 +376,78 @@ void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
   if (header.GetType() == feature::DataHeader::MapType::World)
     synonyms = std::make_unique<SynonymsHolder>(base::JoinPath(GetPlatform().ResourcesDir(), SYNONYMS_FILE));
 
-  features.GetVector().ForEach(FeatureInserter<Key, Value>(
-      synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange()));
+  // Features can be read by index only with the offsets table.
+  auto const featuresCount = base::checked_cast<uint32_t>(features.GetVector().GetNumFeatures());
+  if (threadsCount <= 1 || featuresCount == 0)
+  {
+    features.GetVector().ForEach(FeatureInserter<Key, Value>(
+        synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange()));
+    std::sort(keyValuePairs.begin(), keyValuePairs.end());
+    return;
+  }
+
+  // Every thread collects and sorts the pairs of its own range of features.
+  // FeaturesVector is not thread-safe so every thread opens its own one.
+  std::vector<std::vector<std::pair<Key, Value>>> shards(threadsCount);
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    for (uint32_t threadIdx = 0; threadIdx < threadsCount; ++threadIdx)
+    {
+      pool.SubmitWork([&, threadIdx]()
+      {
+        auto const fc = static_cast<uint64_t>(featuresCount);
+        auto const beg = static_cast<uint32_t>(fc * threadIdx / threadsCount);
+        auto const end = static_cast<uint32_t>(fc * (threadIdx + 1) / threadsCount);
+
+        auto & shard = shards[threadIdx];
+        FeaturesVectorTest threadFeatures(features.GetContainer().GetFileName());
+        FeatureInserter<Key, Value> inserter(synonyms.get(), shard, categoriesHolder,
+                                             header.GetScaleRange());
+        for (uint32_t i = beg; i < end; ++i)
+        {
+          auto ft = threadFeatures.GetVector().GetByIndex(i);
+          // See FeaturesVector::ForEach.
+          ft->SetID(FeatureID(MwmSet::MwmId(), i));
+          inserter(*ft, i);
+        }
+
+        std::sort(shard.begin(), shard.end());
+      });
+    }
+  }
+
+  // Merge sorted shards pairwise. Equal pairs are indistinguishable, so the result
+  // is the same as the result of sorting all pairs at once.
+  while (shards.size() > 1)
+  {
+    std::vector<std::vector<std::pair<Key, Value>>> merged((shards.size() + 1) / 2);
+    {
+      base::thread_pool::computational::ThreadPool pool(merged.size());
+      for (size_t i = 0; i < merged.size(); ++i)
+      {
+        pool.SubmitWork([&shards, &merged, i]()
+        {
+          auto & lhs = shards[2 * i];
+          if (2 * i + 1 == shards.size())
+          {
+            merged[i] = std::move(lhs);
+            return;
+          }
+
+          auto & rhs = shards[2 * i + 1];
+          merged[i].reserve(lhs.size() + rhs.size());
+          std::merge(std::make_move_iterator(lhs.begin()), std::make_move_iterator(lhs.end()),
+                     std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()),
+                     std::back_inserter(merged[i]));
+          std::vector<std::pair<Key, Value>>().swap(lhs);
+          std::vector<std::pair<Key, Value>>().swap(rhs);
+        });
+      }
+    }
+    shards = std::move(merged);
+  }
+
+  keyValuePairs = std::move(shards[0]);
 }
 
 void ReadAddressData(std::string const & filename, std::vector<feature::AddressData> & addrs)
@@ -509,8 +582,6 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
 
 namespace indexer
 {
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
-
 bool BuildSearchIndexFromDataFile(std::string const & country, feature::GenerateInfo const & info,
                                   bool forceRebuild, uint32_t threadsCount)
 {
@@ -530,7 +601,7 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      BuildSearchIndex(readContainer, writer, threadsCount);
       LOG(LINFO, ("Search index size =", writer.Size()));
     }
     if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
@@ -585,12 +656,12 @@ bool BuildSearchIndexFromDataFile(std::string const & country, feature::Generate
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount)
 {
   using Key = strings::UniString;
   using Value = Uint64IndexValue;
 
-  LOG(LINFO, ("Start building search index for", container.GetFileName()));
+  LOG(LINFO, ("Start building search index for", container.GetFileName(), "threads:", threadsCount));
   base::Timer timer;
 
   auto const & categoriesHolder = GetDefaultCategories();
@@ -599,13 +670,11 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
   SingleValueSerializer<Value> serializer;
 
   std::vector<std::pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
-
-  std::sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs, threadsCount);
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
   trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
-      indexWriter, serializer, searchIndexKeyValuePairs);
+      indexWriter, serializer, searchIndexKeyValuePairs, threadsCount);
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
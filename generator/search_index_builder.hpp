@@ -2,6 +2,10 @@
 
 #include "generator/generate_info.hpp"
 
+#include "coding/files_container.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
 #include <string>
 
 namespace indexer
@@ -12,4 +16,8 @@ namespace indexer
 // in version mismatch when trying to read the index.
 bool BuildSearchIndexFromDataFile(std::string const & country, feature::GenerateInfo const & info,
                                   bool forceRebuild, uint32_t threadsCount);
+
+// Writes the search index trie of the mwm |container| to |indexWriter| in the reversed form.
+// The result does not depend on |threadsCount|.
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, uint32_t threadsCount);
 }  // namespace indexer
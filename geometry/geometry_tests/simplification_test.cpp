@@ -1,3 +1,4 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "geometry/geometry_tests/large_polygon.hpp"
@@ -8,9 +9,12 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 
+#include <cmath>
 #include <cstdint>
 #include <limits>
+#include <random>
 #include <vector>
 
 namespace simplification_test
@@ -79,6 +83,36 @@ void SimplifyNearOptimal20(m2::PointD const * f, m2::PointD const * l, double e,
   SimplifyNearOptimal(20, f, l, e, distFn, out);
 }
 
+void SimplifyVisvalingamFn(m2::PointD const * f, m2::PointD const * l, double e, DistanceFn,
+                           PointOutput out)
+{
+  SimplifyVisvalingam(f, l, e, out);
+}
+
+// Distance function which is not recognized by simpl::MaxDistance() and is called per point.
+struct ScalarDistanceFn
+{
+  double operator()(P const & a, P const & b, P const & x) const { return DistanceFn()(a, b, x); }
+};
+
+// Random walk with a slowly changing direction, similar to coastlines.
+vector<P> MakeLongPolyline(size_t count)
+{
+  mt19937 rng(0);
+  normal_distribution<double> turn(0.0, 0.3);
+  vector<P> points;
+  points.reserve(count);
+  P p(0.0, 0.0);
+  double angle = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    points.push_back(p);
+    angle += turn(rng);
+    p += P(cos(angle), sin(angle)) * 1e-3;
+  }
+  return points;
+}
+
 void CheckDPStrict(P const * arr, size_t n, double eps, size_t expectedCount)
 {
   vector<P> vec;
@@ -132,6 +166,117 @@ UNIT_TEST(Simplification_Opt20_Polyline)
                            &SimplifyNearOptimal20);
 }
 
+UNIT_TEST(Simplification_Visvalingam_Smoke) { TestSimplificationSmoke(&SimplifyVisvalingamFn); }
+
+UNIT_TEST(Simplification_Visvalingam_Line) { TestSimplificationOfLine(&SimplifyVisvalingamFn); }
+
+UNIT_TEST(Simplification_Visvalingam_Polyline)
+{
+  TestSimplificationOfPoly(LargePolylineTestData::m_Data, LargePolylineTestData::m_Size,
+                           &SimplifyVisvalingamFn);
+}
+
+UNIT_TEST(Simplification_Visvalingam_RemovesLeastSignificant)
+{
+  P const arr[] = {P(0, 0), P(1, 0.1), P(2, 0), P(3, 5), P(4, 0)};
+  vector<P> result;
+  SimplifyVisvalingam(arr, arr + ARRAY_SIZE(arr), 1.0, base::MakeBackInsertFunctor(result));
+  TEST_EQUAL(result, vector<P>({P(0, 0), P(2, 0), P(3, 5), P(4, 0)}), ());
+
+  result.clear();
+  SimplifyVisvalingam(arr, arr + ARRAY_SIZE(arr), 100.0, base::MakeBackInsertFunctor(result));
+  TEST_EQUAL(result, vector<P>({P(0, 0), P(4, 0)}), ());
+}
+
+UNIT_TEST(Simplification_MaxDistance_Batches)
+{
+  auto const points = MakeLongPolyline(2000);
+  DistanceFn distFn;
+  ScalarDistanceFn scalarFn;
+  for (size_t first = 0; first < points.size(); first += 97)
+  {
+    for (size_t last = first + 1; last < points.size(); last += 131)
+    {
+      auto const batched = simpl::MaxDistance(points.begin() + first, points.begin() + last, distFn);
+      auto const scalar =
+          simpl::MaxDistance(points.begin() + first, points.begin() + last, scalarFn);
+      TEST_EQUAL(batched.first, scalar.first, (first, last));
+      TEST(batched.second == scalar.second, (first, last));
+    }
+  }
+
+  // Degenerate segment.
+  P const arr[] = {P(1, 1), P(2, 2), P(3, 1), P(1, 1)};
+  auto const res = simpl::MaxDistance(arr, arr + 3, distFn);
+  TEST_EQUAL(res.first, 4.0, ());
+  TEST_EQUAL(res.second, arr + 2, ());
+}
+
+UNIT_TEST(Simplification_DP_LongPolyline)
+{
+  // All the points are kept with eps == 0.
+  size_t constexpr kCount = 20000;
+  vector<P> points;
+  for (size_t i = 0; i < kCount; ++i)
+    points.emplace_back(i, i % 2);
+
+  vector<P> result;
+  SimplifyDP(points.begin(), points.end(), 0.0, DistanceFn(), base::MakeBackInsertFunctor(result));
+  TEST_EQUAL(result, points, ());
+
+  auto const walk = MakeLongPolyline(100000);
+  for (double eps : {1e-8, 1e-6, 1e-4})
+  {
+    vector<P> batched;
+    vector<P> scalar;
+    SimplifyDP(walk.begin(), walk.end(), eps, DistanceFn(), base::MakeBackInsertFunctor(batched));
+    SimplifyDP(walk.begin(), walk.end(), eps, ScalarDistanceFn(),
+               base::MakeBackInsertFunctor(scalar));
+    TEST_EQUAL(batched, scalar, (eps));
+    TEST_LESS(batched.size(), walk.size(), (eps));
+  }
+}
+
+// Polylines of 1e3 - 1e7 points, similar to coastlines and admin boundaries.
+BENCHMARK_TEST(Simplification_LongPolylines)
+{
+  double const eps = base::Pow2(1e-3);
+  for (size_t count = 1000; count <= IF_DEBUG_ELSE(100000, 10000000); count *= 10)
+  {
+    auto const points = MakeLongPolyline(count);
+
+    auto const measure = [&points](string const & name, auto && simplify)
+    {
+      vector<P> result;
+      base::Timer timer;
+      simplify(base::MakeBackInsertFunctor(result));
+      LOG(LINFO, (name, "points:", points.size(), "->", result.size(), "time:",
+                  timer.ElapsedSeconds(), "s"));
+    };
+
+    measure("DP", [&](PointOutput out) {
+      SimplifyDP(points.begin(), points.end(), eps, DistanceFn(), out);
+    });
+    measure("DP scalar", [&](PointOutput out) {
+      SimplifyDP(points.begin(), points.end(), eps, ScalarDistanceFn(), out);
+    });
+    measure("Visvalingam", [&](PointOutput out) {
+      SimplifyVisvalingam(points.begin(), points.end(), eps, out);
+    });
+
+    // Near-optimal simplification is used by the generator for all geometry scales.
+    if (count <= 1000000)
+    {
+      measure("NearOptimal20", [&](PointOutput out) {
+        SimplifyNearOptimal(20, points.begin(), points.end(), eps, DistanceFn(), out);
+      });
+      measure("NearOptimal20 scalar", [&](PointOutput out) {
+        SimplifyNearOptimal(20, points.begin(), points.end(), eps, ScalarDistanceFn(), out);
+      });
+    }
+  }
+}
+
 UNIT_TEST(Simpfication_DP_DegenerateTrg)
 {
   P arr1[] = {P(0, 0), P(100, 100), P(100, 500), P(0, 600)};
@@ -0,0 +1,56 @@
+#include "geometry/simplification.hpp"
+
+namespace simpl
+{
+namespace
+{
+// Distances of a batch are stored on the stack, so the loop computing them has no branches
+// and no dependencies between iterations.
+size_t constexpr kBatchSize = 256;
+}  // namespace
+
+std::pair<double, size_t> MaxSquaredDistance(m2::PointD const & a, m2::PointD const & b,
+                                             m2::PointD const * points, size_t count)
+{
+  // The same computations as in m2::ParametrizedSegment::SquaredDistanceToPoint().
+  m2::PointD dir = b - a;
+  double const length = dir.Length();
+  if (dir.IsAlmostZero())
+    dir = m2::PointD::Zero();
+  else
+    dir = dir / length;
+
+  std::pair<double, size_t> res(0.0, count);
+  double dists[kBatchSize];
+  for (size_t begin = 0; begin < count; begin += kBatchSize)
+  {
+    size_t const n = std::min(kBatchSize, count - begin);
+    m2::PointD const * p = points + begin;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      double const dx = p[i].x - a.x;
+      double const dy = p[i].y - a.y;
+      double const ex = p[i].x - b.x;
+      double const ey = p[i].y - b.y;
+      double const t = dir.x * dx + dir.y * dy;
+      double const cross = dx * dir.y - dy * dir.x;
+
+      double const toA = dx * dx + dy * dy;
+      double const toB = ex * ex + ey * ey;
+      double const toLine = cross * cross;
+      dists[i] = t <= 0 ? toA : (t >= length ? toB : toLine);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (res.first < dists[i])
+      {
+        res.first = dists[i];
+        res.second = begin + i;
+      }
+    }
+  }
+  return res;
+}
+}  // namespace simpl
@@ -1,51 +1,97 @@
 #pragma once
 
 #include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // Polyline simplification algorithms.
 
 namespace simpl
 {
+// Returns the max squared distance from the segment [a, b] to |points| and the index of the
+// first farthest point or |count| if all the distances are zero.
+// Gives the same results as m2::SquaredDistanceFromSegmentToPoint but processes points by
+// branchless batches which are vectorized by the compiler.
+std::pair<double, size_t> MaxSquaredDistance(m2::PointD const & a, m2::PointD const & b,
+                                             m2::PointD const * points, size_t count);
+
+template <typename Iter>
+bool constexpr IsPointDArrayIter =
+    std::is_same_v<Iter, m2::PointD const *> || std::is_same_v<Iter, m2::PointD *> ||
+    std::is_same_v<Iter, std::vector<m2::PointD>::const_iterator> ||
+    std::is_same_v<Iter, std::vector<m2::PointD>::iterator>;
+
 ///@name This functions take input range NOT like STL does: [first, last].
 //@{
 template <typename DistanceFn, typename Iter>
 std::pair<double, Iter> MaxDistance(Iter first, Iter last, DistanceFn & distFn)
 {
-  std::pair<double, Iter> res(0.0, last);
+  if constexpr (std::is_same_v<std::remove_const_t<DistanceFn>,
+                               m2::SquaredDistanceFromSegmentToPoint> &&
+                IsPointDArrayIter<Iter>)
+  {
+    if (first == last)
+      return {0.0, last};
 
-  for (Iter i = first + 1; i != last; ++i)
+    auto const res = MaxSquaredDistance(*first, *last, &*(first + 1),
+                                        static_cast<size_t>(last - first - 1));
+    return {res.first, first + 1 + res.second};
+  }
+  else
   {
-    double const d = distFn(*first, *last, *i);
-    if (res.first < d)
+    std::pair<double, Iter> res(0.0, last);
+
+    for (Iter i = first + 1; i != last; ++i)
     {
-      res.first = d;
-      res.second = i;
+      double const d = distFn(*first, *last, *i);
+      if (res.first < d)
+      {
+        res.first = d;
+        res.second = i;
+      }
     }
-  }
 
-  return res;
+    return res;
+  }
 }
 
 // Actual SimplifyDP implementation.
+// Uses an explicit stack of ranges instead of the recursion which overflows the call stack
+// on long polylines. The leftmost range is always processed first, so the points are emitted
+// in the order of the polyline.
 template <typename DistanceFn, typename Iter, typename Out>
 void SimplifyDP(Iter first, Iter last, double epsilon, DistanceFn & distFn, Out & out)
 {
-  if (first != last)
+  std::vector<std::pair<Iter, Iter>> ranges;
+  ranges.emplace_back(first, last);
+  while (!ranges.empty())
   {
-    auto const maxDist = MaxDistance(first, last, distFn);
-    if (maxDist.first >= epsilon)
+    auto const [f, l] = ranges.back();
+    ranges.pop_back();
+
+    if (f != l)
     {
-      simpl::SimplifyDP(first, maxDist.second, epsilon, distFn, out);
-      simpl::SimplifyDP(maxDist.second, last, epsilon, distFn, out);
-      return;
+      auto const maxDist = MaxDistance(f, l, distFn);
+      if (maxDist.first >= epsilon && maxDist.second != l)
+      {
+        ranges.emplace_back(maxDist.second, l);
+        ranges.emplace_back(f, maxDist.second);
+        continue;
+      }
     }
+    out(*l);
   }
-  out(*last);
 }
 //@}
 
@@ -73,6 +119,79 @@ void SimplifyDP(Iter beg, Iter end, double epsilon, DistanceFn distFn, Out out)
   }
 }
 
+// Visvalingam-Whyatt algorithm for STL-like range [beg, end).
+// Iteratively removes the point which makes the triangle of the least area with its current
+// neighbours while the area is less than |minArea|. The first and the last points are kept.
+// |minArea| is in squared units of the points, e.g. it may be a squared epsilon of SimplifyDP.
+// O(n log n), uses O(n) additional memory.
+template <typename Iter, typename Out>
+void SimplifyVisvalingam(Iter beg, Iter end, double minArea, Out out)
+{
+  size_t const n = static_cast<size_t>(std::distance(beg, end));
+  if (n <= 2)
+  {
+    for (Iter it = beg; it != end; ++it)
+      out(*it);
+    return;
+  }
+
+  auto const triangleArea = [&beg](size_t a, size_t b, size_t c)
+  {
+    m2::PointD const pa(*(beg + a));
+    return std::fabs(m2::CrossProduct(m2::PointD(*(beg + b)) - pa, m2::PointD(*(beg + c)) - pa)) /
+           2.0;
+  };
+
+  // Doubly linked list of the remaining points.
+  std::vector<size_t> prev(n);
+  std::vector<size_t> next(n);
+  // Effective areas of the remaining points, heap entries with other areas are outdated.
+  std::vector<double> areas(n, std::numeric_limits<double>::infinity());
+  using AreaAndIndex = std::pair<double, size_t>;
+  std::priority_queue<AreaAndIndex, std::vector<AreaAndIndex>, std::greater<AreaAndIndex>> heap;
+
+  next[0] = 1;
+  prev[n - 1] = n - 2;
+  next[n - 1] = n;
+  for (size_t i = 1; i + 1 < n; ++i)
+  {
+    prev[i] = i - 1;
+    next[i] = i + 1;
+    areas[i] = triangleArea(i - 1, i, i + 1);
+    heap.emplace(areas[i], i);
+  }
+
+  while (!heap.empty() && heap.top().first < minArea)
+  {
+    auto const [area, i] = heap.top();
+    heap.pop();
+    if (area != areas[i])
+      continue;
+
+    areas[i] = std::numeric_limits<double>::quiet_NaN();
+    size_t const p = prev[i];
+    size_t const nx = next[i];
+    next[p] = nx;
+    prev[nx] = p;
+
+    // The area of a neighbour is not less than the area of the removed point, so the points
+    // are removed in the order of their significance.
+    if (p != 0)
+    {
+      areas[p] = std::max(triangleArea(prev[p], p, nx), area);
+      heap.emplace(areas[p], p);
+    }
+    if (nx + 1 != n)
+    {
+      areas[nx] = std::max(triangleArea(p, nx, next[nx]), area);
+      heap.emplace(areas[nx], nx);
+    }
+  }
+
+  for (size_t i = 0; i < n; i = next[i])
+    out(*(beg + i));
+}
+
 // Dynamic programming near-optimal simplification.
 // Uses O(n) additional memory.
 // Worst case O(n^3) performance, average O(n*k^2), where k is maxFalseLookAhead - parameter,
@@ -1,4 +1,6 @@
 #include "indexer/data_source.hpp"
+#include "indexer/features_offsets_table.hpp"
+#include "indexer/mapped_sections.hpp"
 #include "indexer/scale_index.hpp"
 #include "indexer/unique_index.hpp"
 
@@ -81,7 +83,6 @@ private:
 
 void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
 {
-  std::unique_ptr<FeatureType> ft;
   switch (src.GetFeatureStatus(index))
   {
   case FeatureStatus::Deleted:
@@ -89,17 +90,18 @@ void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSourc
   case FeatureStatus::Created:
   case FeatureStatus::Modified:
   {
-    ft = src.GetModifiedFeature(index);
-    break;
+    auto ft = src.GetModifiedFeature(index);
+    CHECK(ft, ());
+    fn(*ft);
+    return;
   }
   case FeatureStatus::Untouched:
   {
-    ft = src.GetOriginalFeature(index);
-    break;
+    // Features are read one by one, so the memory of the previous one is reused.
+    fn(src.DecodeOriginalFeature(index));
+    return;
   }
   }
-  CHECK(ft, ());
-  fn(*ft);
 }
 }  //  namespace
 
@@ -172,6 +174,12 @@ std::unique_ptr<MwmValue> DataSource::CreateValue(MwmInfo & info) const
   auto p = std::make_unique<MwmValue>(localFile);
 
   p->SetTable(dynamic_cast<MwmInfoEx &>(info));
+  if (m_mappedMode)
+  {
+    // Offsets of features are read for every feature, the table is small.
+    p->m_table->Advise(::detail::MappedFile::Advice::WillNeed);
+    p->m_mapped = std::make_shared<feature::MappedSections>(p->m_cont);
+  }
 
   p->m_metaDeserializer = indexer::MetadataDeserializer::Load(p->m_cont);
   CHECK(p->m_metaDeserializer, ());
@@ -252,6 +260,22 @@ void DataSource::ForClosestToPoint(FeatureCallback const & f, StopSearchCallback
   ForEachInIntervals(readFunctor, covering::CoveringMode::Spiral, rect, scale);
 }
 
+void DataSource::ForClosestFeatureIDsToPoint(FeatureIdCallback const & f,
+                                             StopSearchCallback const & stop,
+                                             m2::PointD const & center, double sizeM, int scale) const
+{
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(center, sizeM);
+
+  // Skips the same features as ReadFeatureType().
+  auto readFeatureId = [&f](uint32_t index, FeatureSource & src) {
+    auto const status = src.GetFeatureStatus(index);
+    if (status != FeatureStatus::Deleted && status != FeatureStatus::Obsolete)
+      f({src.GetMwmId(), index});
+  };
+  ReadMWMFunctor readFunctor(*m_factory, readFeatureId, stop);
+  ForEachInIntervals(readFunctor, covering::CoveringMode::Spiral, rect, scale);
+}
+
 void DataSource::ForEachInScale(FeatureCallback const & f, int scale) const
 {
   auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
@@ -298,14 +322,16 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID>
         ASSERT_NOT_EQUAL(
             FeatureStatus::Deleted, fts,
             ("Deleted feature was cached. It should not be here. Please review your code."));
-        std::unique_ptr<FeatureType> ft;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
-          ft = src->GetModifiedFeature(fidIter->m_index);
+        {
+          auto ft = src->GetModifiedFeature(fidIter->m_index);
+          CHECK(ft, ());
+          fn(*ft);
+        }
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
-
-        CHECK(ft, ());
-        fn(*ft);
+        {
+          fn(src->DecodeOriginalFeature(fidIter->m_index));
+        }
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
     }
     else
@@ -35,6 +35,11 @@ public:
   // hierarchy and there is no fast way to merge frozen and edited features.
   void ForClosestToPoint(FeatureCallback const & f, StopSearchCallback const & stopCallback,
                          m2::PointD const & center, double sizeM, int scale) const;
+  // Same as ForClosestToPoint() but calls |f| for ids of the features without reading them,
+  // so the caller may skip the features it has seen before.
+  void ForClosestFeatureIDsToPoint(FeatureIdCallback const & f,
+                                   StopSearchCallback const & stopCallback,
+                                   m2::PointD const & center, double sizeM, int scale) const;
   void ForEachInScale(FeatureCallback const & f, int scale) const;
   void ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const & rect, int scale,
                            MwmId const & id) const;
@@ -51,6 +56,11 @@ public:
     return (*m_factory)(handle);
   }
 
+  /// When |mapped| is true features and centers are read right from the memory mapped mwm files
+  /// without copying. Works for plain mwm files only, e.g. on read-only servers.
+  /// Must be set before maps are registered.
+  void SetMappedMode(bool mapped) { m_mappedMode = mapped; }
+
 protected:
   using ReaderCallback = std::function<void(MwmSet::MwmHandle const & handle,
                                             covering::CoveringGetter & cov, int scale)>;
@@ -68,6 +78,7 @@ protected:
 
 private:
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  bool m_mappedMode = false;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
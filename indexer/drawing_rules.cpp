@@ -11,6 +11,7 @@
 #include "base/logging.hpp"
 
 #include <functional>
+#include <limits>
 
 #include <boost/iterator/iterator_facade.hpp>
 
@@ -24,6 +25,9 @@ namespace
 {
   uint32_t const DEFAULT_BG_COLOR = 0xEEEEDD;
 
+  // Point, line and area.
+  int constexpr kGeomTypesCount = 3;
+
   drule::text_type_t GetTextType(string const & text)
   {
     if (text == "addr:housename")
@@ -72,6 +76,13 @@ bool BaseRule::TestFeature(FeatureType & ft, int zoom) const
   return m_selector->Test(ft, zoom);
 }
 
+bool BaseRule::TestFeature(FeatureSelectorValues & values) const
+{
+  if (nullptr == m_selector)
+    return true;
+  return m_selector->Test(values);
+}
+
 void BaseRule::SetSelector(unique_ptr<ISelector> && selector)
 {
   m_selector = std::move(selector);
@@ -93,6 +104,10 @@ void RulesHolder::Clean()
 
   m_dRules.clear();
   m_colors.clear();
+
+  m_typeRules.clear();
+  m_keysRanges.clear();
+  m_keys.clear();
 }
 
 Key RulesHolder::AddRule(int scale, rule_type_t type, BaseRule * p)
@@ -114,6 +129,65 @@ BaseRule const * RulesHolder::Find(Key const & k) const
   return m_dRules[k.m_index];
 }
 
+RulesHolder::SuitableKeys RulesHolder::GetSuitableKeys(uint32_t type, int scale,
+                                                      feature::GeomType gt) const
+{
+  ASSERT(0 <= scale && scale <= scales::GetUpperStyleScale(), (scale));
+  ASSERT(gt != feature::GeomType::Undefined, ());
+
+  auto const it = m_typeRules.find(type);
+  if (it == m_typeRules.end() || gt == feature::GeomType::Undefined)
+    return {};
+
+  auto const & range =
+      m_keysRanges[it->second.m_firstRange + scale * kGeomTypesCount + static_cast<int>(gt)];
+  return {m_keys.data() + range.m_begin, m_keys.data() + range.m_end, range.m_hasSelectors};
+}
+
+int RulesHolder::GetMaxOverlaysPriority(uint32_t type) const
+{
+  auto const it = m_typeRules.find(type);
+  if (it == m_typeRules.end())
+    return std::numeric_limits<int>::min();
+  return it->second.m_maxOverlaysPriority;
+}
+
+void RulesHolder::InitSuitableKeys()
+{
+  int const scalesCount = scales::GetUpperStyleScale() + 1;
+
+  classif().ForEachTree([&](ClassifObject const * p, uint32_t type)
+  {
+    if (!p->IsDrawableAny())
+      return;
+
+    TypeRules & typeRules = m_typeRules[type];
+    typeRules.m_firstRange = static_cast<uint32_t>(m_keysRanges.size());
+    typeRules.m_maxOverlaysPriority = p->GetMaxOverlaysPriority();
+
+    for (int scale = 0; scale < scalesCount; ++scale)
+    {
+      for (int gt = 0; gt < kGeomTypesCount; ++gt)
+      {
+        KeysT keys;
+        p->GetSuitable(scale, static_cast<feature::GeomType>(gt), keys);
+
+        KeysRange range;
+        range.m_begin = static_cast<uint32_t>(m_keys.size());
+        for (auto const & k : keys)
+        {
+          range.m_hasSelectors |= Find(k)->HasSelector();
+          m_keys.push_back(k);
+        }
+        range.m_end = static_cast<uint32_t>(m_keys.size());
+        m_keysRanges.push_back(range);
+      }
+    }
+  });
+
+  LOG(LDEBUG, ("Precompiled drawing rules of", m_typeRules.size(), "types, keys:", m_keys.size()));
+}
+
 uint32_t RulesHolder::GetBgColor(int scale) const
 {
   ASSERT_LESS(scale, static_cast<int>(m_bgColors.size()), ());
@@ -462,6 +536,7 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
+  InitSuitableKeys();
 }
 
 void LoadRules()
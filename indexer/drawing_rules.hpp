@@ -2,6 +2,7 @@
 
 #include "indexer/drawing_rule_def.hpp"
 #include "indexer/drules_selector.hpp"
+#include "indexer/feature_decl.hpp"
 #include "indexer/map_style.hpp"
 
 #include "base/base.hpp"
@@ -43,6 +44,9 @@ namespace drule
     // Test feature by runtime feature style selector
     // Returns true if rule is applicable for feature, otherwise it returns false
     bool TestFeature(FeatureType & ft, int zoom) const;
+    // The same but reuses feature properties evaluated for other rules.
+    bool TestFeature(FeatureSelectorValues & values) const;
+    bool HasSelector() const { return m_selector != nullptr; }
 
     // Set runtime feature style selector
     void SetSelector(std::unique_ptr<ISelector> && selector);
@@ -54,6 +58,28 @@ namespace drule
   class RulesHolder
   {
   public:
+    // Keys of drawing rules of a classificator type for a scale and a geometry type.
+    class SuitableKeys
+    {
+    public:
+      SuitableKeys() = default;
+      SuitableKeys(Key const * begin, Key const * end, bool hasSelectors)
+        : m_begin(begin), m_end(end), m_hasSelectors(hasSelectors)
+      {
+      }
+
+      Key const * begin() const { return m_begin; }
+      Key const * end() const { return m_end; }
+      bool empty() const { return m_begin == m_end; }
+      // True if some of the rules has a runtime selector.
+      bool HasSelectors() const { return m_hasSelectors; }
+
+    private:
+      Key const * m_begin = nullptr;
+      Key const * m_end = nullptr;
+      bool m_hasSelectors = false;
+    };
+
     RulesHolder();
     ~RulesHolder();
 
@@ -61,6 +87,12 @@ namespace drule
 
     BaseRule const * Find(Key const & k) const;
 
+    // Same as ClassifObject::GetSuitable() but the keys are precompiled on loading for every
+    // scale and geometry type, so there are no classificator tree traversal and no copying.
+    SuitableKeys GetSuitableKeys(uint32_t type, int scale, feature::GeomType gt) const;
+    // Same as ClassifObject::GetMaxOverlaysPriority().
+    int GetMaxOverlaysPriority(uint32_t type) const;
+
     uint32_t GetBgColor(int scale) const;
     uint32_t GetColor(std::string const & name) const;
 
@@ -80,12 +112,32 @@ namespace drule
   private:
     void InitBackgroundColors(ContainerProto const & cp);
     void InitColors(ContainerProto const & cp);
+    void InitSuitableKeys();
     void Clean();
 
+    struct KeysRange
+    {
+      uint32_t m_begin = 0;
+      uint32_t m_end = 0;
+      bool m_hasSelectors = false;
+    };
+
+    struct TypeRules
+    {
+      // Index of the range for scale 0 and point geometry in |m_keysRanges|.
+      uint32_t m_firstRange = 0;
+      int m_maxOverlaysPriority = 0;
+    };
+
     /// background color for scales in range [0...scales::UPPER_STYLE_SCALE]
     std::vector<uint32_t> m_bgColors;
     std::unordered_map<std::string, uint32_t> m_colors;
     std::vector<BaseRule *> m_dRules;
+
+    // Precompiled keys of drawable classificator types.
+    std::unordered_map<uint32_t, TypeRules> m_typeRules;
+    std::vector<KeysRange> m_keysRanges;
+    std::vector<Key> m_keys;
   };
 
   RulesHolder & rules();
@@ -6,6 +6,9 @@
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
 
 namespace drule
 {
@@ -13,89 +16,96 @@ using namespace std;
 
 namespace
 {
+// Instructions of the compiled selector, in order of the evaluation cost: population is read
+// from the feature header, name needs string processing and bbox area parses the geometry.
+enum class Opcode : uint8_t
+{
+  // [population op value]
+  Population,
+  // [name op value]
+  Name,
+  // [bbox_area op value]
+  BoundingBoxArea,
+};
 
-class CompositeSelector : public ISelector
+struct Instruction
 {
-public:
-  explicit CompositeSelector(size_t capacity)
+  Opcode m_opcode = Opcode::Population;
+  SelectorOperatorType m_operator = SelectorOperatorUnknown;
+  // Operand, depends on |m_opcode|.
+  uint64_t m_uintValue = 0;
+  double m_doubleValue = 0.0;
+  string m_stringValue;
+};
+
+template <typename T>
+bool Compare(SelectorOperatorType op, T const & tagValue, T const & value)
+{
+  switch (op)
   {
-    m_selectors.reserve(capacity);
+  case SelectorOperatorUnknown: return false;
+  case SelectorOperatorNotEqual: return tagValue != value;
+  case SelectorOperatorLessOrEqual: return tagValue <= value;
+  case SelectorOperatorGreaterOrEqual: return tagValue >= value;
+  case SelectorOperatorEqual: return tagValue == value;
+  case SelectorOperatorLess: return tagValue < value;
+  case SelectorOperatorGreater: return tagValue > value;
+  case SelectorOperatorIsNotSet: return tagValue == T();
+  case SelectorOperatorIsSet: return tagValue != T();
   }
+  UNREACHABLE();
+}
 
-  void Add(unique_ptr<ISelector> && selector)
+// Runtime feature style selector implementation: a conjunction of conditions which is
+// evaluated as a flat list of instructions.
+class Selector : public ISelector
+{
+public:
+  explicit Selector(vector<Instruction> && program) : m_program(std::move(program))
   {
-    m_selectors.emplace_back(std::move(selector));
+    // Cheap conditions go first to skip the expensive ones when possible.
+    stable_sort(m_program.begin(), m_program.end(), [](Instruction const & l, Instruction const & r)
+    {
+      return l.m_opcode < r.m_opcode;
+    });
   }
 
   // ISelector overrides:
   bool Test(FeatureType & ft, int zoom) const override
   {
-    for (auto const & selector : m_selectors)
-      if (!selector->Test(ft, zoom))
-        return false;
-    return true;
+    FeatureSelectorValues values(ft, zoom);
+    return Test(values);
   }
 
-private:
-  vector<unique_ptr<ISelector>> m_selectors;
-};
-
-// Runtime feature style selector implementation
-template <typename TType>
-class Selector : public ISelector
-{
-public:
-  // Signature of function which takes a property from a feature
-  typedef bool (*TGetFeatureTagValueFn)(FeatureType &, int, TType & value);
-
-  Selector(TGetFeatureTagValueFn fn, SelectorOperatorType op, TType const & value)
-    : m_getFeatureValueFn(fn), m_evalFn(nullptr), m_value(value)
+  bool Test(FeatureSelectorValues & values) const override
   {
-    ASSERT(fn != nullptr, ());
-
-    switch (op)
+    for (auto const & instr : m_program)
     {
-    case SelectorOperatorUnknown: m_evalFn = nullptr; break;
-    case SelectorOperatorNotEqual: m_evalFn = &Selector<TType>::NotEqual; break;
-    case SelectorOperatorLessOrEqual: m_evalFn = &Selector<TType>::LessOrEqual; break;
-    case SelectorOperatorGreaterOrEqual: m_evalFn = &Selector<TType>::GreaterOrEqual; break;
-    case SelectorOperatorEqual: m_evalFn = &Selector<TType>::Equal; break;
-    case SelectorOperatorLess: m_evalFn = &Selector<TType>::Less; break;
-    case SelectorOperatorGreater: m_evalFn = &Selector<TType>::Greater; break;
-    case SelectorOperatorIsNotSet: m_evalFn = &Selector<TType>::IsNotSet; break;
-    case SelectorOperatorIsSet: m_evalFn = &Selector<TType>::IsSet; break;
+      if (!Execute(instr, values))
+        return false;
     }
-
-    ASSERT(m_evalFn != nullptr, ("Unknown or unexpected selector operator type"));
-    if (nullptr == m_evalFn)
-      m_evalFn = &Selector<TType>::Unknown;
+    return true;
   }
 
-  // ISelector overrides:
-  bool Test(FeatureType & ft, int zoom) const override
+private:
+  static bool Execute(Instruction const & instr, FeatureSelectorValues & values)
   {
-    TType tagValue;
-    if (!m_getFeatureValueFn(ft, zoom, tagValue))
-      return false;
-    return (this->*m_evalFn)(tagValue);
+    switch (instr.m_opcode)
+    {
+    case Opcode::BoundingBoxArea:
+    {
+      double sqM;
+      return values.GetBoundingBoxArea(sqM) && Compare(instr.m_operator, sqM, instr.m_doubleValue);
+    }
+    case Opcode::Population:
+      return Compare(instr.m_operator, values.GetPopulation(), instr.m_uintValue);
+    case Opcode::Name:
+      return Compare(instr.m_operator, values.GetName(), instr.m_stringValue);
+    }
+    UNREACHABLE();
   }
 
-private:
-  bool Unknown(TType const &) const { return false; }
-  bool NotEqual(TType const & tagValue) const { return tagValue != m_value; }
-  bool LessOrEqual(TType const & tagValue) const { return tagValue <= m_value; }
-  bool GreaterOrEqual(TType const & tagValue) const { return tagValue >= m_value; }
-  bool Equal(TType const & tagValue) const { return tagValue == m_value; }
-  bool Less(TType const & tagValue) const { return tagValue < m_value; }
-  bool Greater(TType const & tagValue) const { return tagValue > m_value; }
-  bool IsNotSet(TType const & tagValue) const { return tagValue == TType(); }
-  bool IsSet(TType const & tagValue) const { return tagValue != TType(); }
-
-  typedef bool (Selector<TType>::*TOperationFn)(TType const &) const;
-
-  TGetFeatureTagValueFn m_getFeatureValueFn;
-  TOperationFn m_evalFn;
-  TType const m_value;
+  vector<Instruction> m_program;
 };
 
 /*
@@ -132,67 +142,47 @@ private:
 };
 */
 
-// Feature tag value evaluator for tag 'population'
-bool GetPopulation(FeatureType & ft, int, uint64_t & population)
-{
-  population = ftypes::GetPopulation(ft);
-  return true;
-}
-
-// Feature tag value evaluator for tag 'name'
-bool GetName(FeatureType & ft, int, string & name)
-{
-  name = ft.GetReadableName();
-  return true;
-}
-
-// Feature tag value evaluator for tag 'bbox_area' (bounding box area in sq.meters)
-bool GetBoundingBoxArea(FeatureType & ft, int zoom, double & sqM)
-{
-  if (feature::GeomType::Area != ft.GetGeomType())
-    return false;
-
-  // https://github.com/organicmaps/organicmaps/issues/2840
-  sqM = mercator::AreaOnEarth(ft.GetLimitRect(zoom));
-  return true;
-}
-}  // namespace
-
-unique_ptr<ISelector> ParseSelector(string const & str)
+bool Compile(string const & str, Instruction & instr)
 {
   SelectorExpression e;
   if (!ParseSelector(str, e))
   {
     // bad string format
     LOG(LDEBUG, ("Invalid selector format:", str));
-    return unique_ptr<ISelector>();
+    return false;
   }
 
+  ASSERT(e.m_operator != SelectorOperatorUnknown, ("Unknown or unexpected selector operator type"));
+  instr.m_operator = e.m_operator;
+
   if (e.m_tag == "population")
   {
-    uint64_t value = 0;
-    if (!e.m_value.empty() && !strings::to_uint64(e.m_value, value))
+    instr.m_opcode = Opcode::Population;
+    if (!e.m_value.empty() && !strings::to_uint64(e.m_value, instr.m_uintValue))
     {
       // bad string format
       LOG(LDEBUG, ("Invalid selector:", str));
-      return unique_ptr<ISelector>();
+      return false;
     }
-    return make_unique<Selector<uint64_t>>(&GetPopulation, e.m_operator, value);
+    return true;
   }
   else if (e.m_tag == "name")
   {
-    return make_unique<Selector<string>>(&GetName, e.m_operator, e.m_value);
+    instr.m_opcode = Opcode::Name;
+    instr.m_stringValue = e.m_value;
+    return true;
   }
   else if (e.m_tag == "bbox_area")
   {
-    double value = 0;
-    if (!e.m_value.empty() && (!strings::to_double(e.m_value, value) || value < 0))
+    instr.m_opcode = Opcode::BoundingBoxArea;
+    if (!e.m_value.empty() &&
+        (!strings::to_double(e.m_value, instr.m_doubleValue) || instr.m_doubleValue < 0))
     {
       // bad string format
       LOG(LDEBUG, ("Invalid selector:", str));
-      return unique_ptr<ISelector>();
+      return false;
     }
-    return make_unique<Selector<double>>(&GetBoundingBoxArea, e.m_operator, value);
+    return true;
   }
 //  else if (e.m_tag == "extra_tag")
 //  {
@@ -208,25 +198,64 @@ unique_ptr<ISelector> ParseSelector(string const & str)
 //  }
 
   LOG(LERROR, ("Unrecognized selector:", str));
-  return unique_ptr<ISelector>();
+  return false;
 }
+}  // namespace
 
-unique_ptr<ISelector> ParseSelector(vector<string> const & strs)
+uint64_t FeatureSelectorValues::GetPopulation()
 {
-  unique_ptr<CompositeSelector> cs = make_unique<CompositeSelector>(strs.size());
+  if (!m_population)
+    m_population = ftypes::GetPopulation(*m_ft);
+  return *m_population;
+}
 
-  for (string const & str : strs)
+string const & FeatureSelectorValues::GetName()
+{
+  if (!m_name)
+    m_name = m_ft->GetReadableName();
+  return *m_name;
+}
+
+bool FeatureSelectorValues::GetBoundingBoxArea(double & sqM)
+{
+  if (!m_ft)
+  {
+    if (!m_bboxArea)
+      return false;
+  }
+  else if (feature::GeomType::Area != m_ft->GetGeomType())
+  {
+    return false;
+  }
+
+  // https://github.com/organicmaps/organicmaps/issues/2840
+  if (!m_bboxArea)
+    m_bboxArea = mercator::AreaOnEarth(m_ft->GetLimitRect(m_zoom));
+  sqM = *m_bboxArea;
+  return true;
+}
+
+unique_ptr<ISelector> ParseSelector(string const & str)
+{
+  vector<Instruction> program(1);
+  if (!Compile(str, program.front()))
+    return unique_ptr<ISelector>();
+  return make_unique<Selector>(std::move(program));
+}
+
+unique_ptr<ISelector> ParseSelector(vector<string> const & strs)
+{
+  vector<Instruction> program(strs.size());
+  for (size_t i = 0; i < strs.size(); ++i)
   {
-    unique_ptr<ISelector> s = ParseSelector(str);
-    if (nullptr == s)
+    if (!Compile(strs[i], program[i]))
     {
-      LOG(LDEBUG, ("Invalid composite selector:", str));
+      LOG(LDEBUG, ("Invalid composite selector:", strs[i]));
       return unique_ptr<ISelector>();
     }
-    cs->Add(std::move(s));
   }
 
-  return unique_ptr<ISelector>(cs.release());
+  return make_unique<Selector>(std::move(program));
 }
 
 }  // namespace drule
@@ -2,12 +2,41 @@
 
 #include "indexer/feature.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace drule
 {
+// Feature properties used by runtime selectors. The properties are evaluated on demand and only
+// once, so one instance should be shared by all the rules tested for a feature.
+class FeatureSelectorValues
+{
+public:
+  FeatureSelectorValues(FeatureType & ft, int zoom) : m_ft(&ft), m_zoom(zoom) {}
+  // Values which are known in advance, e.g. in tests. |bboxArea| is empty for non-area features.
+  FeatureSelectorValues(uint64_t population, std::string name, std::optional<double> bboxArea)
+    : m_zoom(0), m_population(population), m_name(std::move(name)), m_bboxArea(bboxArea)
+  {
+  }
+
+  // Tag 'population'.
+  uint64_t GetPopulation();
+  // Tag 'name'.
+  std::string const & GetName();
+  // Tag 'bbox_area', bounding box area in sq.meters. Returns false for non-area features.
+  bool GetBoundingBoxArea(double & sqM);
+
+private:
+  FeatureType * m_ft = nullptr;
+  int const m_zoom;
+
+  std::optional<uint64_t> m_population;
+  std::optional<std::string> m_name;
+  std::optional<double> m_bboxArea;
+};
 
 // Runtime feature style selector absract interface.
 class ISelector
@@ -18,12 +47,15 @@ public:
   // If ISelector.Test returns true then style is applicable for the feature,
   // otherwise, if ISelector.Test returns false, style cannot be applied to the feature.
   virtual bool Test(FeatureType & ft, int zoom) const = 0;
+  // The same but reuses feature properties evaluated for other selectors.
+  virtual bool Test(FeatureSelectorValues & values) const = 0;
 };
 
 // Factory method which builds ISelector from a string.
 std::unique_ptr<ISelector> ParseSelector(std::string const & str);
 
 // Factory method which builds composite ISelector from a set of string.
+// All the conditions are compiled into a single flat program.
 std::unique_ptr<ISelector> ParseSelector(std::vector<std::string> const & strs);
 
 }  // namespace drule
@@ -117,9 +117,9 @@ uint32_t CalcOffset(ArrayByteSource const & source, uint8_t const * start)
   return static_cast<uint32_t>(distance(start, source.PtrUint8()));
 }
 
-uint8_t Header(vector<uint8_t> const & data)
+uint8_t Header(uint8_t const * data)
 {
- CHECK(!data.empty(), ());
+ CHECK(data, ());
  return data[0];
 }
 
@@ -190,14 +190,49 @@ uint8_t ReadByte(TSource & src)
 FeatureType::FeatureType(SharedLoadInfo const * loadInfo, vector<uint8_t> && buffer,
                          indexer::MetadataDeserializer * metadataDeserializer)
   : m_loadInfo(loadInfo)
-  , m_data(std::move(buffer))
+  , m_buffer(std::move(buffer))
   , m_metadataDeserializer(metadataDeserializer)
 {
   CHECK(m_loadInfo, ());
+  CHECK(!m_buffer.empty(), ());
 
+  m_data = m_buffer.data();
   m_header = Header(m_data);
 }
 
+void FeatureType::Reset(SharedLoadInfo const * loadInfo, vector<uint8_t> & buffer,
+                        indexer::MetadataDeserializer * metadataDeserializer)
+{
+  m_buffer.swap(buffer);
+  Reset(loadInfo, m_buffer.data(), m_buffer.size(), metadataDeserializer);
+}
+
+void FeatureType::Reset(SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+                        indexer::MetadataDeserializer * metadataDeserializer)
+{
+  CHECK(loadInfo, ());
+  CHECK_GREATER(size, 0, ());
+  m_loadInfo = loadInfo;
+  m_metadataDeserializer = metadataDeserializer;
+  m_data = data;
+  m_header = Header(m_data);
+
+  m_types = {};
+  m_id = {};
+  m_params.MakeZero();
+  m_center = {};
+  m_limitRect = {};
+  m_points.clear();
+  m_triangles.clear();
+  m_metadata = {};
+  m_metaIds.clear();
+
+  m_parsed.Reset();
+  m_offsets.Reset();
+  m_ptsSimpMask = 0;
+  m_innerStats = {};
+}
+
 std::unique_ptr<FeatureType> FeatureType::CreateFromMapObject(osm::MapObject const & emo)
 {
   auto ft = std::unique_ptr<FeatureType>(new FeatureType());
@@ -274,7 +309,7 @@ void FeatureType::ParseTypes()
 
   auto const typesOffset = sizeof(m_header);
   Classificator & c = classif();
-  ArrayByteSource source(m_data.data() + typesOffset);
+  ArrayByteSource source(m_data + typesOffset);
 
   size_t const count = GetTypesCount();
   for (size_t i = 0; i < count; ++i)
@@ -293,7 +328,7 @@ void FeatureType::ParseTypes()
     }
   }
 
-  m_offsets.m_common = CalcOffset(source, m_data.data());
+  m_offsets.m_common = CalcOffset(source, m_data);
   m_parsed.m_types = true;
 }
 
@@ -305,7 +340,7 @@ void FeatureType::ParseCommon()
   CHECK(m_loadInfo, ());
   ParseTypes();
 
-  ArrayByteSource source(m_data.data() + m_offsets.m_common);
+  ArrayByteSource source(m_data + m_offsets.m_common);
   uint8_t const h = Header(m_data);
   m_params.Read(source, h);
 
@@ -315,7 +350,7 @@ void FeatureType::ParseCommon()
     m_limitRect.Add(m_center);
   }
 
-  m_offsets.m_header2 = CalcOffset(source, m_data.data());
+  m_offsets.m_header2 = CalcOffset(source, m_data);
   m_parsed.m_common = true;
 }
 
@@ -351,7 +386,7 @@ void FeatureType::ParseHeader2()
   ParseCommon();
 
   uint8_t elemsCount = 0, geomScalesMask = 0;
-  BitSource bitSource(m_data.data() + m_offsets.m_header2);
+  BitSource bitSource(m_data + m_offsets.m_header2);
   auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
 
   if (headerGeomType == HeaderGeomType::Line || headerGeomType == HeaderGeomType::Area)
@@ -420,7 +455,7 @@ void FeatureType::ParseHeader2()
     }
   }
   // Size of the whole header incl. inner geometry / triangles.
-  m_innerStats.m_size = CalcOffset(src, m_data.data());
+  m_innerStats.m_size = CalcOffset(src, m_data);
   m_parsed.m_header2 = true;
 }
 
@@ -41,6 +41,15 @@ public:
 
   static std::unique_ptr<FeatureType> CreateFromMapObject(osm::MapObject const & emo);
 
+  /// Replaces the feature with the one from |buffer| keeping the memory of the decoded data
+  /// (points, names, etc.). |buffer| gets the data of the previous feature to be reused too.
+  void Reset(feature::SharedLoadInfo const * loadInfo, std::vector<uint8_t> & buffer,
+             indexer::MetadataDeserializer * metadataDeserializer);
+  /// Same as above but the feature is decoded right from |data| without copying it.
+  /// |data| must be valid while the feature is used.
+  void Reset(feature::SharedLoadInfo const * loadInfo, uint8_t const * data, size_t size,
+             indexer::MetadataDeserializer * metadataDeserializer);
+
   feature::GeomType GetGeomType() const;
 
   uint8_t GetTypesCount() const { return (m_header & feature::HEADER_MASK_TYPE) + 1; }
@@ -243,7 +252,9 @@ private:
 
   // Non-owning pointer to shared load info. SharedLoadInfo created once per FeaturesVector.
   feature::SharedLoadInfo const * m_loadInfo = nullptr;
-  std::vector<uint8_t> m_data;
+  // Serialized feature. Points to |m_buffer| or to the memory mapped features section.
+  std::vector<uint8_t> m_buffer;
+  uint8_t const * m_data = nullptr;
 
   // Pointer to shared metedata deserializer. Must be set for mwm format >= Format::v11
   indexer::MetadataDeserializer * m_metadataDeserializer = nullptr;
@@ -254,5 +265,6 @@ private:
 
   InnerGeomStat m_innerStats;
 
+  friend class FeatureDecoder;
   DISALLOW_COPY_AND_MOVE(FeatureType);
 };
@@ -20,7 +20,7 @@ FeatureSource::FeatureSource(MwmSet::MwmHandle const & handle) : m_handle(handle
 
   auto const & value = *m_handle.GetValue();
   m_vector = std::make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get(),
-                                              value.m_metaDeserializer.get());
+                                              value.m_metaDeserializer.get(), value.m_mapped.get());
 }
 
 size_t FeatureSource::GetNumFeatures() const
@@ -41,6 +41,15 @@ std::unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) c
   return ft;
 }
 
+FeatureType & FeatureSource::DecodeOriginalFeature(uint32_t index)
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector, ());
+  auto & ft = m_vector->GetByIndex(index, m_decoder);
+  ft.SetID({ GetMwmId(), index });
+  return ft;
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
@@ -34,6 +34,9 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  // Same as GetOriginalFeature() but reuses the memory of the previously decoded feature,
+  // the result is valid until the next call.
+  FeatureType & DecodeOriginalFeature(uint32_t index);
 
   MwmSet::MwmId const & GetMwmId() const { return m_handle.GetId(); }
 
@@ -48,6 +51,7 @@ public:
 protected:
   MwmSet::MwmHandle const & m_handle;
   std::unique_ptr<FeaturesVector> m_vector;
+  FeatureDecoder m_decoder;
 };
 
 // Lightweight FeatureSource factory. Each DataSource owns factory object.
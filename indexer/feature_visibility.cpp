@@ -49,12 +49,14 @@ void GetDrawRule(vector<uint32_t> const & types, int level, GeomType geomType, d
 
 void FilterRulesByRuntimeSelector(FeatureType & f, int zoomLevel, drule::KeysT & keys)
 {
-  keys.erase_if([&f, zoomLevel](drule::Key const & key)
+  // Feature properties are evaluated once for all the rules.
+  drule::FeatureSelectorValues values(f, zoomLevel);
+  keys.erase_if([&values](drule::Key const & key)
   {
     drule::BaseRule const * const rule = drule::rules().Find(key);
     if (rule == nullptr)
       return true;
-    return !rule->TestFeature(f, zoomLevel);
+    return !rule->TestFeature(values);
   });
 }
 
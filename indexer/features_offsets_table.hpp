@@ -85,6 +85,9 @@ namespace feature
     /// \return index of a feature
     size_t GetFeatureIndexbyOffset(uint32_t offset) const;
 
+    /// Hints the OS how the table is going to be read if it's loaded from a container.
+    void Advise(::detail::MappedFile::Advice advice) const { m_handle.Advise(advice); }
+
     /// \return number of features offsets in a table.
     size_t size() const { return static_cast<size_t>(m_table.num_ones()); }
 
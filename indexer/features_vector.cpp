@@ -8,10 +8,13 @@
 
 FeaturesVector::FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
                                feature::FeaturesOffsetsTable const * table,
-                               indexer::MetadataDeserializer * metaDeserializer)
-: m_loadInfo(cont, header), m_table(table), m_metaDeserializer(metaDeserializer)
+                               indexer::MetadataDeserializer * metaDeserializer,
+                               feature::MappedSections const * mapped)
+: m_loadInfo(cont, header), m_table(table), m_metaDeserializer(metaDeserializer), m_mapped(mapped)
 {
-  InitRecordsReader();
+  // Records are read from |m_mapped| directly.
+  if (!m_mapped)
+    InitRecordsReader();
 }
 
 void FeaturesVector::InitRecordsReader()
@@ -29,9 +32,36 @@ void FeaturesVector::InitRecordsReader()
 std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
 {
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  if (m_mapped)
+  {
+    uint32_t size = 0;
+    uint8_t const * data = m_mapped->GetFeature(ftOffset, size);
+    return std::make_unique<FeatureType>(&m_loadInfo, std::vector<uint8_t>(data, data + size),
+                                         m_metaDeserializer);
+  }
   return std::make_unique<FeatureType>(&m_loadInfo, m_recordReader->ReadRecord(ftOffset), m_metaDeserializer);
 }
 
+FeatureType & FeaturesVector::GetByIndex(uint32_t index, FeatureDecoder & decoder) const
+{
+  auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  FeatureType * ft = nullptr;
+  if (m_mapped)
+  {
+    uint32_t size = 0;
+    uint8_t const * data = m_mapped->GetFeature(ftOffset, size);
+    ft = &decoder.Decode(m_loadInfo, data, size, m_metaDeserializer);
+  }
+  else
+  {
+    m_recordReader->ReadRecord(ftOffset, decoder.m_buffer);
+    ft = &decoder.Decode(m_loadInfo, m_metaDeserializer);
+  }
+  // The index is needed for Metadata loading, see ForEach().
+  ft->SetID(FeatureID(MwmSet::MwmId(), index));
+  return *ft;
+}
+
 size_t FeaturesVector::GetNumFeatures() const
 {
   return m_table ? m_table->size() : 0;
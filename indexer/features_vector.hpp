@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/feature.hpp"
+#include "indexer/mapped_sections.hpp"
 #include "indexer/metadata_serdes.hpp"
 #include "indexer/shared_load_info.hpp"
 
@@ -12,6 +13,38 @@
 
 namespace feature { class FeaturesOffsetsTable; }
 
+/// Reusable storage to decode features of FeaturesVector. The record buffer and the decoded data
+/// of a feature (points, names, etc.) keep their memory between features, so after a few features
+/// decoding doesn't allocate. A decoded feature is valid until the next one is decoded.
+/// Note! This class is NOT Thread-Safe.
+class FeatureDecoder
+{
+  DISALLOW_COPY_AND_MOVE(FeatureDecoder);
+
+public:
+  FeatureDecoder() = default;
+
+private:
+  friend class FeaturesVector;
+
+  FeatureType & Decode(feature::SharedLoadInfo const & loadInfo,
+                       indexer::MetadataDeserializer * metaDeserializer)
+  {
+    m_feature.Reset(&loadInfo, m_buffer, metaDeserializer);
+    return m_feature;
+  }
+
+  FeatureType & Decode(feature::SharedLoadInfo const & loadInfo, uint8_t const * data,
+                       uint32_t size, indexer::MetadataDeserializer * metaDeserializer)
+  {
+    m_feature.Reset(&loadInfo, data, size, metaDeserializer);
+    return m_feature;
+  }
+
+  FeatureType m_feature;
+  std::vector<uint8_t> m_buffer;
+};
+
 /// Note! This class is NOT Thread-Safe.
 /// You should have separate instance of Vector for every thread.
 class FeaturesVector
@@ -19,27 +52,53 @@ class FeaturesVector
   DISALLOW_COPY(FeaturesVector);
 
 public:
+  /// When |mapped| is not null features are decoded right from its memory, it must outlive
+  /// the vector and the features decoded into FeatureDecoder.
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
                  feature::FeaturesOffsetsTable const * table,
-                 indexer::MetadataDeserializer * metaDeserializer);
+                 indexer::MetadataDeserializer * metaDeserializer,
+                 feature::MappedSections const * mapped = nullptr);
 
+  /// The feature keeps a copy of its record, so it may outlive the vector.
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
+  /// Decodes the feature into |decoder|, the result is valid until the next decoding.
+  FeatureType & GetByIndex(uint32_t index, FeatureDecoder & decoder) const;
 
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
+  {
+    FeatureDecoder decoder;
+    ForEach(decoder, std::forward<ToDo>(toDo));
+  }
+
+  /// Same as ForEach(toDo) but features are decoded into |decoder|, so |toDo| must not keep
+  /// references to a feature.
+  template <class ToDo> void ForEach(FeatureDecoder & decoder, ToDo && toDo) const
   {
     uint32_t index = 0;
-    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data)
+    auto const process = [&](FeatureType & ft, uint32_t pos)
     {
-      FeatureType ft(&m_loadInfo, std::move(data), m_metaDeserializer);
-
       // We can't properly set MwmId here, because FeaturesVector
       // works with FileContainerR, not with MwmId/MwmHandle/MwmValue.
       // But it's OK to set at least feature's index, because it can
       // be used later for Metadata loading.
       ft.SetID(FeatureID(MwmSet::MwmId(), index));
       toDo(ft, m_table ? index++ : pos);
+    };
+
+    if (m_mapped)
+    {
+      m_mapped->ForEachFeature([&](uint32_t pos, uint8_t const * data, uint32_t size)
+      {
+        process(decoder.Decode(m_loadInfo, data, size, m_metaDeserializer), pos);
+      });
+      return;
+    }
+
+    m_recordReader->ForEachRecord(decoder.m_buffer, [&](uint32_t pos)
+    {
+      process(decoder.Decode(m_loadInfo, m_metaDeserializer), pos);
     });
   }
 
@@ -69,6 +128,7 @@ private:
   std::unique_ptr<RecordReader> m_recordReader;
   feature::FeaturesOffsetsTable const * m_table;
   indexer::MetadataDeserializer * m_metaDeserializer;
+  feature::MappedSections const * m_mapped = nullptr;
 };
 
 /// Test features vector (reader) that combines all the needed data for stand-alone work.
@@ -1,6 +1,8 @@
 #include "testing/testing.hpp"
 
 #include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
+#include "indexer/scales.hpp"
 
 #include "generator/generator_tests_support/test_with_classificator.hpp"
 
@@ -102,3 +104,40 @@ UNIT_CLASS_TEST(TestWithClassificator, Classificator_StableIndex)
   TEST_EQUAL(type, c.GetTypeForIndex(356 - 1), ());
   TEST_EQUAL(type, c.GetTypeForIndex(357 - 1), ());
 }
+
+UNIT_CLASS_TEST(TestWithClassificator, Classificator_PrecompiledSuitableKeys)
+{
+  Classificator const & c = classif();
+  auto const & rules = drule::rules();
+
+  size_t typesCount = 0;
+  c.ForEachTree([&](ClassifObject const * p, uint32_t type)
+  {
+    if (!p->IsDrawableAny())
+      return;
+
+    ++typesCount;
+    TEST_EQUAL(p->GetMaxOverlaysPriority(), rules.GetMaxOverlaysPriority(type),
+               (c.GetReadableObjectName(type)));
+
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      for (auto const gt :
+           {feature::GeomType::Point, feature::GeomType::Line, feature::GeomType::Area})
+      {
+        drule::KeysT expected;
+        p->GetSuitable(scale, gt, expected);
+
+        auto const keys = rules.GetSuitableKeys(type, scale, gt);
+        TEST(expected == drule::KeysT(keys.begin(), keys.end()),
+             (c.GetReadableObjectName(type), scale, gt));
+      }
+    }
+  });
+  TEST_GREATER(typesCount, 0, ());
+
+  uint32_t const type = c.GetTypeByPath({"building"});
+  TEST(!rules.GetSuitableKeys(type, scales::GetUpperStyleScale(), feature::GeomType::Area).empty(),
+       ());
+  TEST(rules.GetSuitableKeys(type, 0, feature::GeomType::Area).empty(), ());
+}
@@ -0,0 +1,142 @@
+#include "testing/testing.hpp"
+
+#include "indexer/drules_selector.hpp"
+#include "indexer/drules_selector_parser.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace drules_selector_test
+{
+using namespace drule;
+using namespace std;
+
+struct Values
+{
+  uint64_t m_population;
+  string m_name;
+  optional<double> m_bboxArea;
+};
+
+template <typename T>
+bool Compare(SelectorOperatorType op, T const & tagValue, T const & value)
+{
+  switch (op)
+  {
+  case SelectorOperatorUnknown: return false;
+  case SelectorOperatorNotEqual: return tagValue != value;
+  case SelectorOperatorLessOrEqual: return tagValue <= value;
+  case SelectorOperatorGreaterOrEqual: return tagValue >= value;
+  case SelectorOperatorEqual: return tagValue == value;
+  case SelectorOperatorLess: return tagValue < value;
+  case SelectorOperatorGreater: return tagValue > value;
+  case SelectorOperatorIsNotSet: return tagValue == T();
+  case SelectorOperatorIsSet: return tagValue != T();
+  }
+  return false;
+}
+
+// Evaluates every condition on its own, the way the selectors did it before they were compiled.
+bool TestReference(vector<string> const & strs, Values const & v)
+{
+  for (auto const & str : strs)
+  {
+    SelectorExpression e;
+    TEST(ParseSelector(str, e), (str));
+
+    bool res = false;
+    if (e.m_tag == "population")
+    {
+      uint64_t value = 0;
+      TEST(e.m_value.empty() || strings::to_uint64(e.m_value, value), (str));
+      res = Compare(e.m_operator, v.m_population, value);
+    }
+    else if (e.m_tag == "name")
+    {
+      res = Compare(e.m_operator, v.m_name, e.m_value);
+    }
+    else if (e.m_tag == "bbox_area")
+    {
+      double value = 0;
+      TEST(e.m_value.empty() || strings::to_double(e.m_value, value), (str));
+      res = v.m_bboxArea && Compare(e.m_operator, *v.m_bboxArea, value);
+    }
+    else
+    {
+      TEST(false, ("Unexpected tag", str));
+    }
+
+    if (!res)
+      return false;
+  }
+  return true;
+}
+
+void TestSelector(vector<string> const & strs, vector<Values> const & values)
+{
+  auto const selector = ParseSelector(strs);
+  TEST(selector, (strs));
+
+  for (auto const & v : values)
+  {
+    FeatureSelectorValues featureValues(v.m_population, v.m_name, v.m_bboxArea);
+    TEST_EQUAL(selector->Test(featureValues), TestReference(strs, v),
+               (strs, v.m_population, v.m_name, v.m_bboxArea));
+  }
+}
+
+vector<Values> const kValues = {
+    {0, "", nullopt},
+    {0, "", 0.0},
+    {1000, "", 5000.0},
+    {1000, "Berlin", nullopt},
+    {50000, "Berlin", 10000.0},
+    {3000000, "Berlin", 1e9},
+    {50000, "Paris", 10000.0},
+};
+
+UNIT_TEST(DruleSelector_SingleConditions)
+{
+  vector<string> const selectors = {
+      "population",         "!population",         "population=50000", "population!=50000",
+      "population<50000",   "population>50000",    "population<=50000", "population>=50000",
+      "name",               "!name",               "name=Berlin",       "name!=Berlin",
+      "bbox_area",          "!bbox_area",          "bbox_area=10000",   "bbox_area!=10000",
+      "bbox_area<10000",    "bbox_area>10000",     "bbox_area<=10000",  "bbox_area>=10000",
+  };
+
+  for (auto const & s : selectors)
+  {
+    TestSelector({s}, kValues);
+
+    // Single string factory compiles the same program.
+    auto const selector = ParseSelector(s);
+    TEST(selector, (s));
+    for (auto const & v : kValues)
+    {
+      FeatureSelectorValues featureValues(v.m_population, v.m_name, v.m_bboxArea);
+      TEST_EQUAL(selector->Test(featureValues), TestReference({s}, v), (s));
+    }
+  }
+}
+
+UNIT_TEST(DruleSelector_Conjunctions)
+{
+  // Compiled instructions are reordered by the evaluation cost, it must not change the result.
+  TestSelector({"bbox_area>=5000", "population>1000", "name"}, kValues);
+  TestSelector({"!name", "bbox_area<10000"}, kValues);
+  TestSelector({"name!=Berlin", "!bbox_area", "population"}, kValues);
+  TestSelector({"population>=1000", "population<=50000", "name=Berlin"}, kValues);
+}
+
+UNIT_TEST(DruleSelector_Invalid)
+{
+  TEST(!ParseSelector("population>abc"), ());
+  TEST(!ParseSelector("bbox_area>-1"), ());
+  TEST(!ParseSelector(vector<string>{"population>1000", "population>abc"}), ());
+}
+}  // namespace drules_selector_test
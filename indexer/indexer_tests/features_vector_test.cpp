@@ -1,12 +1,18 @@
 #include "testing/testing.hpp"
 
+#include "indexer/centers_table.hpp"
 #include "indexer/data_source.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/mapped_sections.hpp"
 #include "indexer/mwm_set.hpp"
+#include "indexer/scales.hpp"
 
 #include "platform/local_country_file.hpp"
 
+#include "geometry/point2d.hpp"
+
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -76,4 +82,150 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
   });
   TEST_EQUAL(expected, actual, ());
 }
+
+// Features decoded into the reused FeatureDecoder are the same as separately created ones.
+UNIT_TEST(FeaturesVectorTest_Decoder)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_table.get(), value->m_metaDeserializer.get());
+
+  auto const getTypes = [](FeatureType & ft) {
+    vector<uint32_t> types;
+    ft.ForEachType([&types](uint32_t type) { types.push_back(type); });
+    return types;
+  };
+  auto const getPoints = [](FeatureType & ft, int scale) {
+    vector<m2::PointD> points;
+    ft.ForEachPoint([&points](m2::PointD const & p) { points.push_back(p); }, scale);
+    ft.ForEachTriangle([&points](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3) {
+      points.insert(points.end(), {p1, p2, p3});
+    }, scale);
+    return points;
+  };
+
+  FeatureDecoder decoder;
+  size_t count = 0;
+  fv.ForEach(decoder, [&](FeatureType & ft, uint32_t index)
+  {
+    auto expected = fv.GetByIndex(index);
+    expected->SetID(ft.GetID());
+    TEST_EQUAL(getTypes(ft), getTypes(*expected), (index));
+    TEST_EQUAL(ft.GetNames(), expected->GetNames(), (index));
+    TEST_EQUAL(ft.GetLayer(), expected->GetLayer(), (index));
+    TEST_EQUAL(ft.GetHouseNumber(), expected->GetHouseNumber(), (index));
+    TEST_EQUAL(ft.GetMetadata(feature::Metadata::FMD_POSTCODE),
+               expected->GetMetadata(feature::Metadata::FMD_POSTCODE), (index));
+    for (int scale : {scales::GetUpperWorldScale(), scales::GetUpperScale(),
+                      static_cast<int>(FeatureType::BEST_GEOMETRY)})
+    {
+      ft.ResetGeometry();
+      expected->ResetGeometry();
+      TEST_EQUAL(getPoints(ft, scale), getPoints(*expected, scale), (index, scale));
+    }
+    ++count;
+  });
+  TEST_EQUAL(count, fv.GetNumFeatures(), ());
+
+  // Random access into the same decoder.
+  for (uint32_t index = 0; index < fv.GetNumFeatures(); index += 7)
+  {
+    auto expected = fv.GetByIndex(index);
+    auto & ft = fv.GetByIndex(index, decoder);
+    TEST_EQUAL(getTypes(ft), getTypes(*expected), (index));
+    TEST_EQUAL(ft.GetNames(), expected->GetNames(), (index));
+    TEST_EQUAL(getPoints(ft, FeatureType::BEST_GEOMETRY),
+               getPoints(*expected, FeatureType::BEST_GEOMETRY), (index));
+  }
+}
+
+// Features and centers read in place from the mapped mwm are the same as the copied ones.
+UNIT_TEST(FeaturesVectorTest_Mapped)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  FrozenDataSource mappedDataSource;
+  mappedDataSource.SetMappedMode(true);
+  auto mappedResult = mappedDataSource.RegisterMap(localFile);
+  TEST_EQUAL(mappedResult.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  MwmSet::MwmHandle mappedHandle = mappedDataSource.GetMwmHandleById(mappedResult.first);
+  TEST(handle.IsAlive(), ());
+  TEST(mappedHandle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  auto const * mappedValue = mappedHandle.GetValue();
+  TEST(!value->m_mapped, ());
+  TEST(mappedValue->m_mapped, ());
+
+  FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_table.get(),
+                    value->m_metaDeserializer.get());
+  FeaturesVector mappedFv(mappedValue->m_cont, mappedValue->GetHeader(),
+                          mappedValue->m_table.get(), mappedValue->m_metaDeserializer.get(),
+                          mappedValue->m_mapped.get());
+  TEST_EQUAL(fv.GetNumFeatures(), mappedFv.GetNumFeatures(), ());
+
+  auto const getPoints = [](FeatureType & ft) {
+    vector<m2::PointD> points;
+    ft.ForEachPoint([&points](m2::PointD const & p) { points.push_back(p); },
+                    FeatureType::BEST_GEOMETRY);
+    return points;
+  };
+
+  FeatureDecoder decoder;
+  size_t count = 0;
+  mappedFv.ForEach(decoder, [&](FeatureType & ft, uint32_t index)
+  {
+    auto expected = fv.GetByIndex(index);
+    expected->SetID(ft.GetID());
+    TEST_EQUAL(ft.GetTypesCount(), expected->GetTypesCount(), (index));
+    TEST_EQUAL(ft.GetNames(), expected->GetNames(), (index));
+    TEST_EQUAL(ft.GetHouseNumber(), expected->GetHouseNumber(), (index));
+    TEST_EQUAL(ft.GetMetadata(feature::Metadata::FMD_POSTCODE),
+               expected->GetMetadata(feature::Metadata::FMD_POSTCODE), (index));
+    TEST_EQUAL(getPoints(ft), getPoints(*expected), (index));
+    ++count;
+  });
+  TEST_EQUAL(count, fv.GetNumFeatures(), ());
+
+  for (uint32_t index = 0; index < fv.GetNumFeatures(); index += 7)
+  {
+    auto expected = fv.GetByIndex(index);
+    // Owned features copy their records, decoded ones point to the mapped memory.
+    auto owned = mappedFv.GetByIndex(index);
+    auto & ft = mappedFv.GetByIndex(index, decoder);
+    TEST_EQUAL(ft.GetNames(), expected->GetNames(), (index));
+    TEST_EQUAL(owned->GetNames(), expected->GetNames(), (index));
+    TEST_EQUAL(getPoints(ft), getPoints(*expected), (index));
+    TEST_EQUAL(getPoints(*owned), getPoints(*expected), (index));
+  }
+
+  auto centersReader = mappedValue->m_mapped->CreateCentersReader();
+  TEST(centersReader, ());
+  auto mappedCenters = search::CentersTable::LoadV1(*centersReader);
+  auto reader = value->m_cont.GetReader(CENTERS_FILE_TAG);
+  auto centers = search::CentersTable::LoadV1(*reader.GetPtr());
+  TEST(mappedCenters, ());
+  TEST(centers, ());
+  for (uint32_t index = 0; index < fv.GetNumFeatures(); index += 7)
+  {
+    m2::PointD expected;
+    m2::PointD actual;
+    TEST_EQUAL(centers->Get(index, expected), mappedCenters->Get(index, actual), (index));
+    TEST_EQUAL(expected, actual, (index));
+  }
+}
 } // namespace features_vector_test
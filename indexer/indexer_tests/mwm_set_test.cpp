@@ -5,10 +5,16 @@
 #include "indexer/indexer_tests/test_mwm_set.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "coding/reader.hpp"
+
+#include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include <atomic>
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace mwm_set_test
 {
@@ -169,4 +175,181 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+class CountingMwmSet : public TestMwmSet
+{
+public:
+  using TestMwmSet::TestMwmSet;
+
+  size_t GetNumCreatedValues() const { return m_numCreatedValues; }
+
+protected:
+  std::unique_ptr<MwmValue> CreateValue(MwmInfo & info) const override
+  {
+    ++m_numCreatedValues;
+    return TestMwmSet::CreateValue(info);
+  }
+
+private:
+  mutable atomic<size_t> m_numCreatedValues{0};
+};
+
+// Handles of an mwm which is used by many threads reuse the same values.
+UNIT_TEST(MwmSetConcurrentHandles)
+{
+  size_t constexpr kThreadsCount = 8;
+  size_t constexpr kHandlesCount = 20000;
+
+  ScopedMwm mwm4("4.mwm");
+  CountingMwmSet mwmSet;
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("4")).first;
+  TEST(id.IsAlive(), ());
+
+  atomic<size_t> numDeadHandles{0};
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      for (size_t j = 0; j < kHandlesCount; ++j)
+      {
+        auto const handle = mwmSet.GetMwmHandleById(id);
+        if (!handle.IsAlive() || handle.GetValue()->GetCountryFileName() != "4")
+          ++numDeadHandles;
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(numDeadHandles, 0, ());
+  TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, ());
+  TEST_LESS_OR_EQUAL(mwmSet.GetNumCreatedValues(), kThreadsCount, ());
+
+  TEST(mwmSet.Deregister(CountryFile("4")), ());
+  TEST(!id.IsAlive(), ());
+  TEST(!mwmSet.GetMwmHandleById(id).IsAlive(), ());
+}
+
+// Idle values parked in an mwm with long-lived handles count against the cache size.
+UNIT_TEST(MwmSetFreeValuesBudget)
+{
+  size_t constexpr kCacheSize = 2;
+  size_t constexpr kHandlesCount = 8;
+
+  ScopedMwm mwm4("4.mwm");
+  CountingMwmSet mwmSet(kCacheSize);
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("4")).first;
+
+  auto const longLived = mwmSet.GetMwmHandleById(id);
+  TEST(longLived.IsAlive(), ());
+
+  auto const takeHandles = [&]()
+  {
+    vector<MwmSet::MwmHandle> handles;
+    for (size_t i = 0; i < kHandlesCount; ++i)
+    {
+      handles.push_back(mwmSet.GetMwmHandleById(id));
+      TEST(handles.back().IsAlive(), ());
+    }
+  };
+
+  takeHandles();
+  TEST_EQUAL(mwmSet.GetNumCreatedValues(), kHandlesCount + 1, ());
+
+  // Only |kCacheSize| released values were kept open, the rest were closed.
+  takeHandles();
+  TEST_EQUAL(mwmSet.GetNumCreatedValues(), 2 * kHandlesCount + 1 - kCacheSize, ());
+  TEST_EQUAL(id.GetInfo()->GetNumRefs(), 1, ());
+}
+
+// Requests for handles of an idle mwm don't defer its deregistration.
+UNIT_TEST(MwmSetDeregisterIdleWithConcurrentProbes)
+{
+  // Values can't be created, so the handles are never taken and the mwm stays idle.
+  class NoValuesMwmSet : public TestMwmSet
+  {
+  protected:
+    std::unique_ptr<MwmValue> CreateValue(MwmInfo &) const override
+    {
+      MYTHROW(Reader::TooManyFilesException, ("Too many files"));
+    }
+  };
+
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kIterationsCount = 200;
+
+  base::ScopedLogLevelChanger const criticalLogLevel(LCRITICAL);
+  ScopedMwm mwm4("4.mwm");
+  for (size_t i = 0; i < kIterationsCount; ++i)
+  {
+    NoValuesMwmSet mwmSet;
+    auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("4")).first;
+
+    atomic<size_t> numProbes{0};
+    atomic<bool> stop{false};
+    vector<thread> threads;
+    for (size_t j = 0; j < kThreadsCount; ++j)
+    {
+      threads.emplace_back([&]()
+      {
+        while (!stop)
+        {
+          TEST(!mwmSet.GetMwmHandleById(id).IsAlive(), ());
+          ++numProbes;
+        }
+      });
+    }
+
+    while (numProbes < 100)
+      this_thread::yield();
+
+    TEST(mwmSet.Deregister(CountryFile("4")), (i));
+    TEST_EQUAL(id.GetInfo()->GetStatus(), MwmInfo::STATUS_DEREGISTERED, (i));
+
+    stop = true;
+    for (auto & t : threads)
+      t.join();
+  }
+}
+
+// An mwm deregistered while other threads use its handles is deregistered as soon as
+// the last handle is released.
+UNIT_TEST(MwmSetDeregisterWithConcurrentHandles)
+{
+  size_t constexpr kThreadsCount = 8;
+
+  ScopedMwm mwm4("4.mwm");
+  TestMwmSet mwmSet;
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("4")).first;
+
+  atomic<size_t> numAliveHandles{0};
+  atomic<bool> stop{false};
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      while (!stop)
+      {
+        auto const handle = mwmSet.GetMwmHandleById(id);
+        if (handle.IsAlive())
+          ++numAliveHandles;
+      }
+    });
+  }
+
+  while (numAliveHandles < 10000)
+    this_thread::yield();
+
+  mwmSet.Deregister(CountryFile("4"));
+  stop = true;
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(id.GetInfo()->GetStatus(), MwmInfo::STATUS_DEREGISTERED, ());
+  TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, ());
+  TEST(!mwmSet.GetMwmHandleById(id).IsAlive(), ());
+  TEST(!mwmSet.GetMwmHandleByCountryFile(CountryFile("4")).IsAlive(), ());
+}
 }  // namespace mwm_set_test
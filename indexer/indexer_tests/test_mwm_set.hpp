@@ -18,6 +18,9 @@ namespace tests
 
 class TestMwmSet : public MwmSet
 {
+public:
+  using MwmSet::MwmSet;
+
 protected:
   /// @name MwmSet overrides
   //@{
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <random>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -223,3 +224,37 @@ UNIT_TEST(TrieBuilder_Build)
     }
   }
 }
+
+UNIT_TEST(TrieBuilder_Build_Parallel)
+{
+  using Key = buffer_vector<trie::TrieChar, 8>;
+  using KeyValuePair = pair<Key, uint32_t>;
+
+  mt19937 rng(0);
+  vector<KeyValuePair> v;
+  for (uint32_t i = 0; i < 10000; ++i)
+  {
+    // Short keys over a small alphabet give shared prefixes, duplicates and empty keys.
+    Key key(rng() % 6);
+    for (auto & c : key)
+      c = 'a' + rng() % 5;
+    v.emplace_back(key, rng() % 1000);
+  }
+  sort(v.begin(), v.end());
+
+  using Sink = PushBackByteSink<vector<uint8_t>>;
+  SingleValueSerializer<uint32_t> serializer;
+
+  vector<uint8_t> expected;
+  Sink expectedSink(expected);
+  trie::Build<Sink, Key, ValueList<uint32_t>, SingleValueSerializer<uint32_t>>(expectedSink, serializer, v);
+
+  for (size_t threadsCount : {1, 2, 3, 8})
+  {
+    vector<uint8_t> buf;
+    Sink sink(buf);
+    trie::Build<Sink, Key, ValueList<uint32_t>, SingleValueSerializer<uint32_t>>(sink, serializer, v,
+                                                                                 threadsCount);
+    TEST_EQUAL(buf, expected, (threadsCount));
+  }
+}
@@ -0,0 +1,42 @@
+#include "indexer/mapped_sections.hpp"
+
+#include "indexer/dat_section_header.hpp"
+
+#include "defines.hpp"
+
+namespace feature
+{
+MappedSections::MappedSections(FilesContainerR const & cont)
+{
+  m_file.Open(cont.GetFileName());
+
+  auto const features = cont.GetAbsoluteOffsetAndSize(FEATURES_FILE_TAG);
+  m_featuresHandle.Assign(m_file.Map(features.first, features.second, FEATURES_FILE_TAG));
+  // Servers mostly read features by ids, readahead of neighbouring pages is wasted then.
+  m_featuresHandle.Advise(::detail::MappedFile::Advice::Random);
+
+  MemReader reader(m_featuresHandle.GetData<char>(), m_featuresHandle.GetSize());
+  DatSectionHeader header;
+  header.Read(reader);
+  CHECK_LESS_OR_EQUAL(uint64_t{header.m_featuresOffset} + header.m_featuresSize,
+                      m_featuresHandle.GetSize(), (cont.GetFileName()));
+  m_features = m_featuresHandle.GetData<uint8_t>() + header.m_featuresOffset;
+  m_featuresSize = header.m_featuresSize;
+
+  if (cont.IsExist(CENTERS_FILE_TAG))
+  {
+    auto const centers = cont.GetAbsoluteOffsetAndSize(CENTERS_FILE_TAG);
+    m_centersHandle.Assign(m_file.Map(centers.first, centers.second, CENTERS_FILE_TAG));
+    // Centers are looked up by the ids of search results.
+    m_centersHandle.Advise(::detail::MappedFile::Advice::Random);
+  }
+}
+
+std::unique_ptr<Reader> MappedSections::CreateCentersReader() const
+{
+  if (!m_centersHandle.IsValid())
+    return {};
+  return std::make_unique<MemReader>(m_centersHandle.GetData<char>(),
+                                     static_cast<size_t>(m_centersHandle.GetSize()));
+}
+}  // namespace feature
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "coding/byte_stream.hpp"
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace feature
+{
+/// Sections of an mwm which are read right from the memory mapped file: features are decoded
+/// from the mapped records without copying them into buffers and the centers table is read
+/// in place. The mwm must be a plain file (not a zip or an asset), e.g. on servers.
+class MappedSections
+{
+public:
+  explicit MappedSections(FilesContainerR const & cont);
+
+  /// Returns the record of the feature at |pos| in the features section.
+  uint8_t const * GetFeature(uint32_t pos, uint32_t & size) const
+  {
+    ASSERT_LESS(pos, m_featuresSize, ());
+    ArrayByteSource source(m_features + pos);
+    size = ReadVarUint<uint32_t>(source);
+    ASSERT_LESS_OR_EQUAL(pos + size, m_featuresSize, ());
+    return source.PtrUint8();
+  }
+
+  /// Calls |fn|(pos, data, size) for every record of the features section.
+  template <class Fn>
+  void ForEachFeature(Fn && fn) const
+  {
+    ArrayByteSource source(m_features);
+    uint8_t const * const end = m_features + m_featuresSize;
+    while (source.PtrUint8() < end)
+    {
+      auto const pos = static_cast<uint32_t>(source.PtrUint8() - m_features);
+      uint32_t const size = ReadVarUint<uint32_t>(source);
+      fn(pos, source.PtrUint8(), size);
+      source.Advance(size);
+    }
+  }
+
+  /// @return reader of the mapped centers section or nullptr if there is no such section.
+  std::unique_ptr<Reader> CreateCentersReader() const;
+
+private:
+  ::detail::MappedFile m_file;
+  ::detail::MappedFile::Handle m_featuresHandle;
+  ::detail::MappedFile::Handle m_centersHandle;
+
+  uint8_t const * m_features = nullptr;
+  uint32_t m_featuresSize = 0;
+};
+}  // namespace feature
@@ -23,6 +23,12 @@ using platform::LocalCountryFile;
 
 MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
 
+MwmInfo::~MwmInfo()
+{
+  for (auto & value : m_freeValues)
+    delete value.exchange(nullptr);
+}
+
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
   if (m_minScale > 0)
@@ -160,19 +166,16 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     return false;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  if (info->m_numRefs == 0)
+  // Handles may be taken without |m_lock|, so the mwm is closed for them atomically.
+  uint32_t numRefs = 0;
+  if (info->m_numRefs.compare_exchange_strong(numRefs, MwmInfo::kDeregisteredRefs))
   {
     SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
     vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
     infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-    {
-      if (it->first == id)
-      {
-        m_cache.erase(it);
-        break;
-      }
-    }
+    while (TakeFreeValue(*info))
+      ;
+    ClearCache(id);
     return true;
   }
 
@@ -278,6 +281,9 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
 
   ++info->m_numRefs;
 
+  if (auto value = TakeFreeValue(*info))
+    return value;
+
   // Search in cache.
   for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
   {
@@ -285,6 +291,7 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
     {
       unique_ptr<MwmValue> result = std::move(it->second);
       m_cache.erase(it);
+      --m_numIdleValues;
       return result;
     }
   }
@@ -296,7 +303,8 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
   catch (Reader::TooManyFilesException const & ex)
   {
     LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
-    --info->m_numRefs;
+    if (--info->m_numRefs == 0)
+      OnNoRefsImpl(id, events);
     return nullptr;
   }
   catch (exception const & ex)
@@ -311,6 +319,19 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValue> p)
 {
+  ASSERT(id.IsAlive(), (id));
+  ASSERT(p.get() != nullptr, ());
+  if (!id.IsAlive() || !p)
+    return;
+
+  // Leave the value for other handles of the mwm if it's up to date.
+  auto & info = *id.GetInfo();
+  if (info.IsUpToDate() && PutFreeValue(info, p))
+  {
+    ReleaseRef(id);
+    return;
+  }
+
   WithEventLog([&](EventList & events)
                {
                  UnlockValueImpl(id, std::move(p), events);
@@ -325,30 +346,129 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, EventList
     return;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  ASSERT_GREATER(info->m_numRefs, 0, ());
-  --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
-    VERIFY(DeregisterImpl(id, events), ());
+  ASSERT_GREATER(info->GetNumRefs(), 0, ());
+  if (--info->m_numRefs == 0)
+    OnNoRefsImpl(id, events);
 
   if (info->IsUpToDate())
+    AddToCacheImpl(id, std::move(p));
+}
+
+void MwmSet::OnNoRefsImpl(MwmId const & id, EventList & events)
+{
+  auto & info = *id.GetInfo();
+  // A handle may be taken without |m_lock| in the meantime, the last one of them will do the work.
+  if (info.m_numRefs != 0)
+    return;
+
+  if (info.GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+  {
+    DeregisterImpl(id, events);
+    return;
+  }
+
+  while (auto value = TakeFreeValue(info))
+  {
+    if (info.IsUpToDate())
+      AddToCacheImpl(id, std::move(value));
+  }
+}
+
+void MwmSet::AddToCacheImpl(MwmId const & id, unique_ptr<MwmValue> value)
+{
+  /// @todo Probably, it's better to store only "unique by id" free caches here.
+  /// But it's no obvious if we have many threads working with the single mwm.
+
+  m_cache.push_back(make_pair(id, std::move(value)));
+  ++m_numIdleValues;
+  // Values parked in mwms count too, so more than one value may be closed here.
+  while (m_numIdleValues > m_cacheSize && !m_cache.empty())
+  {
+    LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", m_cache.front().first));
+    m_cache.pop_front();
+    --m_numIdleValues;
+  }
+}
+
+unique_ptr<MwmValue> MwmSet::TakeFreeValue(MwmInfo & info)
+{
+  for (auto & value : info.m_freeValues)
+  {
+    if (value.load() != nullptr)
+    {
+      if (auto * p = value.exchange(nullptr))
+      {
+        --m_numIdleValues;
+        return unique_ptr<MwmValue>(p);
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool MwmSet::PutFreeValue(MwmInfo & info, unique_ptr<MwmValue> & value)
+{
+  // Reserve a place in the budget of idle values first.
+  size_t numIdle = m_numIdleValues.load();
+  do
   {
-    /// @todo Probably, it's better to store only "unique by id" free caches here.
-    /// But it's no obvious if we have many threads working with the single mwm.
+    if (numIdle >= m_cacheSize)
+      return false;
+  } while (!m_numIdleValues.compare_exchange_weak(numIdle, numIdle + 1));
 
-    m_cache.push_back(make_pair(id, std::move(p)));
-    if (m_cache.size() > m_cacheSize)
+  for (auto & freeValue : info.m_freeValues)
+  {
+    MwmValue * expected = nullptr;
+    if (freeValue.load() == nullptr && freeValue.compare_exchange_strong(expected, value.get()))
     {
-      LOG(LDEBUG, ("MwmValue max cache size reached! Added", id, "removed", m_cache.front().first));
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
+      UNUSED_VALUE(value.release());
+      return true;
     }
   }
+
+  --m_numIdleValues;
+  return false;
+}
+
+unique_ptr<MwmValue> MwmSet::LockFreeValue(MwmId const & id)
+{
+  auto & info = *id.GetInfo();
+  uint32_t numRefs = info.m_numRefs.load();
+  do
+  {
+    // Idle mwms have no free values and their references are taken under |m_lock| only,
+    // otherwise they can't be deregistered at once.
+    if (numRefs == 0 || (numRefs & MwmInfo::kDeregisteredRefs) != 0)
+      return nullptr;
+  } while (!info.m_numRefs.compare_exchange_weak(numRefs, numRefs + 1));
+
+  // The mwm can't be deregistered until the reference is released.
+  if (info.IsUpToDate())
+  {
+    if (auto value = TakeFreeValue(info))
+      return value;
+  }
+
+  ReleaseRef(id);
+  return nullptr;
+}
+
+void MwmSet::ReleaseRef(MwmId const & id)
+{
+  if (--id.GetInfo()->m_numRefs != 0)
+    return;
+
+  WithEventLog([&](EventList & events)
+               {
+                 OnNoRefsImpl(id, events);
+               });
 }
 
 void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearFreeValuesImpl();
   m_info.clear();
 }
 
@@ -356,6 +476,19 @@ void MwmSet::ClearCache()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearFreeValuesImpl();
+}
+
+void MwmSet::ClearFreeValuesImpl()
+{
+  for (auto const & p : m_info)
+  {
+    for (auto const & info : p.second)
+    {
+      while (TakeFreeValue(*info))
+        ;
+    }
+  }
 }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
@@ -376,6 +509,13 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryF
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
+  // Fast path for mwms which are being used by other handles.
+  if (id.IsAlive())
+  {
+    if (auto value = LockFreeValue(id))
+      return MwmHandle(*this, id, std::move(value));
+  }
+
   MwmSet::MwmHandle handle;
   WithEventLog([&](EventList & events)
                {
@@ -392,7 +532,11 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & eve
   return MwmHandle(*this, id, std::move(value));
 }
 
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
+void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end)
+{
+  m_numIdleValues -= static_cast<size_t>(distance(beg, end));
+  m_cache.erase(beg, end);
+}
 
 void MwmSet::ClearCache(MwmId const & id)
 {
@@ -12,6 +12,7 @@
 
 #include "defines.hpp"
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <map>
@@ -21,7 +22,13 @@
 #include <utility>
 #include <vector>
 
-namespace feature { class FeaturesOffsetsTable; }
+namespace feature
+{
+class FeaturesOffsetsTable;
+class MappedSections;
+}  // namespace feature
+
+class MwmValue;
 
 /// Information about stored mwm.
 class MwmInfo
@@ -45,7 +52,7 @@ public:
   };
 
   MwmInfo();
-  virtual ~MwmInfo() = default;
+  virtual ~MwmInfo();
 
   /// @obsolete Rect around region border. Features which cross region border may cross this rect.
   /// @todo VNG: Not true. This rect accumulates all features in MWM. Since we don't crop features by border,
@@ -74,7 +81,7 @@ public:
   feature::RegionData const & GetRegionData() const { return m_data; }
 
   /// Returns the lock counter value for test needs.
-  uint8_t GetNumRefs() const { return m_numRefs; }
+  uint32_t GetNumRefs() const { return m_numRefs & ~kDeregisteredRefs; }
 
 protected:
   Status SetStatus(Status status)
@@ -88,7 +95,18 @@ protected:
 
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
-  uint32_t m_numRefs;                 ///< Number of active handles.
+  std::atomic<uint32_t> m_numRefs;    ///< Number of active handles.
+
+private:
+  // Is set to |m_numRefs| of a deregistered mwm, so it can't be locked anymore.
+  static uint32_t constexpr kDeregisteredRefs = 1U << 31;
+  static size_t constexpr kFreeValuesCount = 8;
+
+  // Values which are not used by handles at the moment. While the mwm has active handles,
+  // values are taken and returned here without MwmSet's lock, so threads working with the same
+  // mwm don't contend. They count against MwmSet's cache size, so the number of open idle
+  // values is bounded by it. The last released handle moves them to MwmSet's cache.
+  std::array<std::atomic<MwmValue *>, kFreeValuesCount> m_freeValues = {};
 };
 
 class MwmInfoEx : public MwmInfo
@@ -108,8 +126,6 @@ private:
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
 };
 
-class MwmValue;
-
 class MwmSet
 {
 public:
@@ -343,6 +359,30 @@ private:
   /// @precondition This function is always called under mutex m_lock.
   MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
 
+  /// @name Lock-free locking of values from MwmInfo::m_freeValues.
+  //@{
+  std::unique_ptr<MwmValue> TakeFreeValue(MwmInfo & info);
+  /// @return false if there is no place for |value| or the budget of idle values is exhausted,
+  /// it's not moved then.
+  bool PutFreeValue(MwmInfo & info, std::unique_ptr<MwmValue> & value);
+  std::unique_ptr<MwmValue> LockFreeValue(MwmId const & id);
+  /// Decrements the number of handles and takes m_lock only if it was the last one.
+  void ReleaseRef(MwmId const & id);
+  //@}
+
+  /// Moves free values to the cache or deregisters the mwm marked to deregister
+  /// if there are no active handles.
+  /// @precondition This function is always called under mutex m_lock.
+  void OnNoRefsImpl(MwmId const & id, EventList & events);
+
+  /// Closes the least recently used values if the budget of idle values is exceeded.
+  /// @precondition This function is always called under mutex m_lock.
+  void AddToCacheImpl(MwmId const & id, std::unique_ptr<MwmValue> value);
+
+  /// Takes all the values parked in mwms' MwmInfo::m_freeValues.
+  /// @precondition This function is always called under mutex m_lock.
+  void ClearFreeValuesImpl();
+
   std::unique_ptr<MwmValue> LockValue(MwmId const & id);
   std::unique_ptr<MwmValue> LockValueImpl(MwmId const & id, EventList & events);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValue> p);
@@ -354,6 +394,10 @@ private:
 
   Cache m_cache;
   size_t const m_cacheSize;
+  /// Number of open values which are not used by handles: the ones in |m_cache| and the ones
+  /// parked in MwmInfo::m_freeValues. It never exceeds |m_cacheSize|, so idle values don't
+  /// keep more files open than the cache alone did.
+  std::atomic<size_t> m_numIdleValues{0};
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -381,6 +425,8 @@ public:
   std::shared_ptr<feature::FeaturesOffsetsTable> m_table;
   std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
   std::unique_ptr<HouseToStreetTable> m_house2street;
+  /// Not null if sections are read from the mapped file, see DataSource::SetMappedMode().
+  std::shared_ptr<feature::MappedSections> m_mapped;
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
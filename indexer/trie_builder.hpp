@@ -7,10 +7,12 @@
 #include "base/buffer_vector.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -230,23 +232,22 @@ void AppendValue(NodeInfo & node, Value const & value)
     LOG(LERROR, ("Cannot append to a finalized value list."));
 }
 
-template <typename Sink, typename Key, typename ValueList, typename Serializer>
-void Build(Sink & sink, Serializer const & serializer,
-           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+// Appends sorted |[beg, end)| pairs to the trie whose path from the root to the last added key is
+// |nodes|. Nodes that are not on the path of the last added key are written to |sink|.
+template <typename Sink, typename It, typename Nodes, typename Serializer>
+void AddKeyValuePairs(Sink & sink, Serializer const & serializer, It const beg, It const end,
+                      Nodes & nodes)
 {
-  using Value = typename ValueList::Value;
-  using NodeInfo = NodeInfo<ValueList>;
-
-  std::vector<NodeInfo> nodes;
-  nodes.emplace_back(sink.Pos(), kDefaultChar);
+  using Pair = typename std::iterator_traits<It>::value_type;
+  using Key = typename Pair::first_type;
 
   Key prevKey;
-  std::pair<Key, Value> prevE;  // e for "element".
+  Pair prevE;  // e for "element".
 
-  for (auto it = data.begin(); it != data.end(); ++it)
+  for (auto it = beg; it != end; ++it)
   {
     auto e = *it;
-    if (it != data.begin() && e == prevE)
+    if (it != beg && e == prevE)
       continue;
 
     auto const & key = e.first;
@@ -265,6 +266,18 @@ void Build(Sink & sink, Serializer const & serializer,
     prevKey = key;
     std::swap(e, prevE);
   }
+}
+
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void Build(Sink & sink, Serializer const & serializer,
+           std::vector<std::pair<Key, typename ValueList::Value>> const & data)
+{
+  using NodeInfo = NodeInfo<ValueList>;
+
+  std::vector<NodeInfo> nodes;
+  nodes.emplace_back(sink.Pos(), kDefaultChar);
+
+  AddKeyValuePairs(sink, serializer, data.begin(), data.end(), nodes);
 
   // Pop all the nodes from the stack.
   PopNodes(sink, serializer, nodes, nodes.size() - 1);
@@ -272,4 +285,78 @@ void Build(Sink & sink, Serializer const & serializer,
   // Write the root.
   WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, nodes.back(), true /* isRoot */);
 }
+
+// Builds the same trie as Build() does, byte to byte. Children of the root are independent
+// subtries: sizes of the nodes are relative, so every subtrie (keys with the same first char)
+// is built into its own buffer by |threadsCount| threads and the buffers are concatenated
+// in the order of the first char.
+template <typename Sink, typename Key, typename ValueList, typename Serializer>
+void Build(Sink & sink, Serializer const & serializer,
+           std::vector<std::pair<Key, typename ValueList::Value>> const & data, size_t threadsCount)
+{
+  using NodeInfo = NodeInfo<ValueList>;
+  using Buffer = std::vector<uint8_t>;
+
+  if (threadsCount <= 1)
+  {
+    Build<Sink, Key, ValueList, Serializer>(sink, serializer, data);
+    return;
+  }
+
+  NodeInfo root(sink.Pos(), kDefaultChar);
+
+  // Values of the empty key are stored in the root.
+  auto it = data.begin();
+  for (; it != data.end() && it->first.empty(); ++it)
+    AppendValue(root, it->second);
+
+  struct Subtrie
+  {
+    using It = typename std::vector<std::pair<Key, typename ValueList::Value>>::const_iterator;
+
+    Subtrie(It beg, It end) : m_beg(beg), m_end(end) {}
+
+    It m_beg;
+    It m_end;
+    Buffer m_buffer;
+    std::vector<ChildInfo> m_children;
+  };
+
+  std::vector<Subtrie> subtries;
+  while (it != data.end())
+  {
+    auto const c = it->first[0];
+    auto const beg = it;
+    it = std::find_if(it, data.end(), [c](auto const & e) { return e.first[0] != c; });
+    subtries.emplace_back(beg, it);
+  }
+
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    for (auto & subtrie : subtries)
+    {
+      pool.SubmitWork([&serializer, &subtrie]() {
+        PushBackByteSink<Buffer> subtrieSink(subtrie.m_buffer);
+
+        // The fake root collects the only child which is the root of the subtrie.
+        std::vector<NodeInfo> nodes;
+        nodes.emplace_back(subtrieSink.Pos(), kDefaultChar);
+        AddKeyValuePairs(subtrieSink, serializer, subtrie.m_beg, subtrie.m_end, nodes);
+        PopNodes(subtrieSink, serializer, nodes, nodes.size() - 1);
+        subtrie.m_children = std::move(nodes.back().m_children);
+      });
+    }
+  }
+
+  for (auto & subtrie : subtries)
+  {
+    CHECK_EQUAL(subtrie.m_children.size(), 1, ());
+    sink.Write(subtrie.m_buffer.data(), subtrie.m_buffer.size());
+    root.m_children.push_back(std::move(subtrie.m_children[0]));
+    Buffer().swap(subtrie.m_buffer);
+  }
+
+  // Write the root.
+  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, root, true /* isRoot */);
+}
 }  // namespace trie
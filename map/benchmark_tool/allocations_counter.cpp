@@ -0,0 +1,32 @@
+#include "map/benchmark_tool/api.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaced global allocation functions count allocations of the whole tool.
+// Aligned and nothrow versions are not replaced, they are rare or call these ones.
+namespace
+{
+std::atomic<uint64_t> g_allocationsCount{0};
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  g_allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  if (void * p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void * p, std::size_t) noexcept { std::free(p); }
+
+namespace bench
+{
+uint64_t GetAllocationsCount() { return g_allocationsCount.load(std::memory_order_relaxed); }
+}  // namespace bench
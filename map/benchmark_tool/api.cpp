@@ -1,5 +1,7 @@
 #include "map/benchmark_tool/api.hpp"
 
+#include "indexer/scales.hpp"
+
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
@@ -34,6 +36,70 @@ void Result::CalcMetrics()
     m_all = -1.0;
 }
 
+void AllocationsResult::Print()
+{
+  if (m_allocations.empty())
+  {
+    cout << "No frames" << endl;
+    return;
+  }
+
+  sort(m_allocations.begin(), m_allocations.end());
+  uint64_t const all = accumulate(m_allocations.begin(), m_allocations.end(), uint64_t{0});
+  cout << fixed << setprecision(2);
+  cout << "ALLOCATIONS PER FRAME[ median:" << m_allocations[m_allocations.size() / 2] <<
+          " avg:" << static_cast<double>(all) / m_allocations.size() <<
+          " max:" << m_allocations.back() << " ] ";
+  cout << "TOTAL[ frames:" << m_allocations.size() << " features:" << m_features <<
+          " allocations:" << all << " per feature:" <<
+          (m_features == 0 ? 0.0 : static_cast<double>(all) / m_features) << " ]" << endl;
+}
+
+void IterationResult::Print()
+{
+  if (m_features == 0)
+  {
+    cout << "No features" << endl;
+    return;
+  }
+
+  auto const print = [this](string const & name, Mode const & mode)
+  {
+    cout << name << "[ sequential:" << m_features / mode.m_sequential <<
+            " random:" << m_features / mode.m_random << " ] ";
+  };
+
+  cout << fixed << setprecision(0);
+  cout << "FEATURES PER SECOND ";
+  print("COPIED", m_copied);
+  print("MAPPED", m_mapped);
+  cout << setprecision(2);
+  cout << "SPEEDUP[ sequential:" << m_copied.m_sequential / m_mapped.m_sequential <<
+          " random:" << m_copied.m_random / m_mapped.m_random << " ] ";
+  cout << "TOTAL[ features:" << m_features << " ]" << endl;
+}
+
+void DrawRulesResult::Print()
+{
+  if (m_features == 0)
+  {
+    cout << "No features" << endl;
+    return;
+  }
+
+  if (!m_isConsistent)
+    cout << "Different keys are found by the classificator and by the tables" << endl;
+
+  // Keys are collected for every style scale.
+  double const lookups = static_cast<double>(m_features) * (scales::GetUpperStyleScale() + 1);
+  cout << fixed << setprecision(0);
+  cout << "NS PER FEATURE AND SCALE[ classificator:" << m_classificator * 1e9 / lookups <<
+          " tables:" << m_tables * 1e9 / lookups << " ] ";
+  cout << setprecision(2);
+  cout << "SPEEDUP[ " << m_classificator / m_tables << " ] ";
+  cout << "TOTAL[ features:" << m_features << " keys:" << m_keys << " ]" << endl;
+}
+
 void AllResult::Print()
 {
   //m_reading.PrintAllTimes();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,6 +32,23 @@ namespace bench
     std::vector<double> m_time;
   };
 
+  /// Numbers of memory allocations made while tiles are read.
+  class AllocationsResult
+  {
+  public:
+    void Add(uint64_t allocations, uint64_t features)
+    {
+      m_allocations.push_back(allocations);
+      m_features += features;
+    }
+
+    void Print();
+
+  private:
+    std::vector<uint64_t> m_allocations;
+    uint64_t m_features = 0;
+  };
+
   class AllResult
   {
   public:
@@ -43,6 +61,54 @@ namespace bench
     double m_all = 0.0;
   };
 
+  /// Throughput of reading all features of a map with FeaturesVector in both modes:
+  /// records copied by readers and records decoded right from the mapped mwm.
+  class IterationResult
+  {
+  public:
+    struct Mode
+    {
+      // Best of the runs, in seconds.
+      double m_sequential = 0.0;
+      double m_random = 0.0;
+    };
+
+    void Print();
+
+    Mode m_copied;
+    Mode m_mapped;
+    uint32_t m_features = 0;
+  };
+
+  /// Time of collecting drawing rule keys of all features for every style scale in two ways:
+  /// by walking the classificator tree and by the rule tables precompiled on loading.
+  class DrawRulesResult
+  {
+  public:
+    void Print();
+
+    // Best of the runs, in seconds.
+    double m_classificator = 0.0;
+    double m_tables = 0.0;
+    uint64_t m_keys = 0;
+    uint32_t m_features = 0;
+    // False if the ways have found different numbers of keys.
+    bool m_isConsistent = true;
+  };
+
+  /// @return number of memory allocations by the global operator new made by the process.
+  uint64_t GetAllocationsCount();
+
   /// @param[in] count number of times to run benchmark
   void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR, AllResult & res);
+
+  /// Reads the same tiles as RunFeaturesLoadingBenchmark and counts allocations per tile.
+  void RunAllocationsBenchmark(std::string filePath, std::pair<int, int> scaleR,
+                               AllocationsResult & res);
+
+  /// Reads all features of the map in order and by shuffled indices |runs| times in each mode.
+  void RunIterationBenchmark(std::string filePath, int runs, IterationResult & res);
+
+  /// Collects drawing rule keys of all features of the map in both ways |runs| times.
+  void RunDrawRulesBenchmark(std::string filePath, int runs, DrawRulesResult & res);
 }  // namespace bench
@@ -0,0 +1,141 @@
+#include "map/benchmark_tool/api.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/drawing_rules.hpp"
+#include "indexer/drules_selector.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bench
+{
+namespace
+{
+struct Feature
+{
+  unique_ptr<FeatureType> m_ft;
+  feature::TypesHolder m_types;
+};
+
+// Keys of the feature as the stylist collected them before the rules were precompiled:
+// the classificator tree is walked for every type and every rule with a selector evaluates
+// the feature properties on its own.
+size_t GetKeysByClassificator(Feature & f, int scale)
+{
+  Classificator const & cl = classif();
+  auto const geomType = f.m_types.GetGeomType();
+
+  drule::KeysT keys;
+  for (uint32_t t : f.m_types)
+  {
+    drule::KeysT typeKeys;
+    cl.GetObject(t)->GetSuitable(scale, geomType, typeKeys);
+    keys.append(typeKeys.begin(), typeKeys.end());
+  }
+
+  keys.erase_if([&f, scale](drule::Key const & key)
+  {
+    drule::BaseRule const * const rule = drule::rules().Find(key);
+    return rule == nullptr || !rule->TestFeature(*f.m_ft, scale);
+  });
+  return keys.size();
+}
+
+// Keys of the feature from the precompiled tables, the selectors share the feature properties.
+size_t GetKeysByTables(Feature & f, int scale)
+{
+  auto const & rules = drule::rules();
+  auto const geomType = f.m_types.GetGeomType();
+
+  drule::KeysT keys;
+  bool hasSelectors = false;
+  for (uint32_t t : f.m_types)
+  {
+    auto const typeKeys = rules.GetSuitableKeys(t, scale, geomType);
+    hasSelectors |= typeKeys.HasSelectors();
+    keys.append(typeKeys.begin(), typeKeys.end());
+  }
+
+  if (hasSelectors)
+  {
+    drule::FeatureSelectorValues values(*f.m_ft, scale);
+    keys.erase_if([&rules, &values](drule::Key const & key)
+    {
+      drule::BaseRule const * const rule = rules.Find(key);
+      return rule == nullptr || !rule->TestFeature(values);
+    });
+  }
+  return keys.size();
+}
+
+template <typename GetKeys>
+double RunBest(vector<Feature> & features, int runs, GetKeys && getKeys, uint64_t & keys)
+{
+  double best = numeric_limits<double>::max();
+  for (int i = 0; i < runs; ++i)
+  {
+    keys = 0;
+    base::Timer timer;
+    for (auto & f : features)
+    {
+      for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+        keys += getKeys(f, scale);
+    }
+    best = min(best, timer.ElapsedSeconds());
+  }
+  return best;
+}
+}  // namespace
+
+void RunDrawRulesBenchmark(string fileName, int runs, DrawRulesResult & res)
+{
+  base::GetNameFromFullPath(fileName);
+  base::GetNameWithoutExt(fileName);
+
+  FrozenDataSource dataSource;
+  auto const r = dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting(std::move(fileName)));
+  if (r.second != MwmSet::RegResult::Success)
+    return;
+
+  auto const handle = dataSource.GetMwmHandleById(r.first);
+  auto const & value = *handle.GetValue();
+  FeaturesVector const fv(value.m_cont, value.GetHeader(), value.m_table.get(),
+                          value.m_metaDeserializer.get(), value.m_mapped.get());
+
+  vector<Feature> features;
+  features.reserve(fv.GetNumFeatures());
+  for (uint32_t i = 0; i < fv.GetNumFeatures(); ++i)
+  {
+    auto ft = fv.GetByIndex(i);
+    feature::TypesHolder types(*ft);
+    features.push_back({std::move(ft), std::move(types)});
+  }
+  res.m_features = static_cast<uint32_t>(features.size());
+
+  // Warm up: the lazily decoded feature properties are cached by FeatureType for both ways.
+  uint64_t keys = 0;
+  RunBest(features, 1 /* runs */, GetKeysByClassificator, keys);
+
+  uint64_t tablesKeys = 0;
+  res.m_classificator = RunBest(features, runs, GetKeysByClassificator, keys);
+  res.m_tables = RunBest(features, runs, GetKeysByTables, tablesKeys);
+  res.m_keys = keys;
+  res.m_isConsistent = keys == tablesKeys;
+}
+}  // namespace bench
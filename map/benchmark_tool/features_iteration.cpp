@@ -0,0 +1,86 @@
+#include "map/benchmark_tool/api.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/mapped_sections.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/macros.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bench
+{
+namespace
+{
+// Decodes the parts of a feature which are read by most clients.
+uint64_t ReadFeature(FeatureType & ft)
+{
+  uint64_t sum = 0;
+  ft.ForEachType([&sum](uint32_t type) { sum += type; });
+  ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+  sum += ft.GetPointsCount();
+  return sum;
+}
+
+void RunMode(platform::LocalCountryFile const & localFile, bool mapped, int runs,
+             IterationResult::Mode & res, uint32_t & features)
+{
+  FrozenDataSource dataSource;
+  dataSource.SetMappedMode(mapped);
+  auto const r = dataSource.RegisterMap(localFile);
+  if (r.second != MwmSet::RegResult::Success)
+    return;
+
+  auto const handle = dataSource.GetMwmHandleById(r.first);
+  auto const & value = *handle.GetValue();
+  FeaturesVector const fv(value.m_cont, value.GetHeader(), value.m_table.get(),
+                          value.m_metaDeserializer.get(), value.m_mapped.get());
+  features = static_cast<uint32_t>(fv.GetNumFeatures());
+
+  vector<uint32_t> indices(features);
+  iota(indices.begin(), indices.end(), 0);
+  shuffle(indices.begin(), indices.end(), mt19937(0 /* seed */));
+
+  FeatureDecoder decoder;
+  uint64_t sum = 0;
+  res.m_sequential = res.m_random = numeric_limits<double>::max();
+  for (int i = 0; i < runs; ++i)
+  {
+    base::Timer timer;
+    fv.ForEach(decoder, [&sum](FeatureType & ft, uint32_t) { sum += ReadFeature(ft); });
+    res.m_sequential = min(res.m_sequential, timer.ElapsedSeconds());
+
+    timer.Reset();
+    for (auto const index : indices)
+      sum += ReadFeature(fv.GetByIndex(index, decoder));
+    res.m_random = min(res.m_random, timer.ElapsedSeconds());
+  }
+
+  // The sum is printed to keep the compiler from throwing the decoding away.
+  cout << (mapped ? "Mapped" : "Copied") << " checksum: " << sum << endl;
+}
+}  // namespace
+
+void RunIterationBenchmark(string fileName, int runs, IterationResult & res)
+{
+  base::GetNameFromFullPath(fileName);
+  base::GetNameWithoutExt(fileName);
+  auto const localFile = platform::LocalCountryFile::MakeForTesting(std::move(fileName));
+
+  RunMode(localFile, false /* mapped */, runs, res.m_copied, res.m_features);
+  RunMode(localFile, true /* mapped */, runs, res.m_mapped, res.m_features);
+}
+}  // namespace bench
@@ -32,6 +32,7 @@ namespace
     }
 
     bool IsEmpty() const { return m_count == 0; }
+    size_t GetCount() const { return m_count; }
 
     void operator()(FeatureType & ft)
     {
@@ -60,16 +61,16 @@ namespace
     int m_scale = 0;
   };
 
-  void RunBenchmark(FeaturesFetcher const & src, m2::RectD const & rect,
-                    pair<int, int> const & scaleRange, AllResult & res)
+  // Calls |fn|(rect, scale) for rects from |rect| divided down to |scaleRange|.second while
+  // |fn| returns true (rect has features).
+  template <typename Fn>
+  void ForEachFrame(m2::RectD const & rect, pair<int, int> const & scaleRange, Fn && fn)
   {
     ASSERT_LESS_OR_EQUAL(scaleRange.first, scaleRange.second, ());
 
     vector<m2::RectD> rects;
     rects.push_back(rect);
 
-    Accumulator acc(res.m_reading);
-
     while (!rects.empty())
     {
       m2::RectD const r = rects.back();
@@ -78,15 +79,7 @@ namespace
       bool doDivide = true;
       int const scale = scales::GetScaleLevel(r);
       if (scale >= scaleRange.first)
-      {
-        acc.Reset(scale);
-
-        base::Timer timer;
-        src.ForEachFeature(r, acc, scale);
-        res.Add(timer.ElapsedSeconds());
-
-        doDivide = !acc.IsEmpty();
-      }
+        doDivide = fn(r, scale);
 
       if (doDivide && scale < scaleRange.second)
       {
@@ -97,28 +90,79 @@ namespace
       }
     }
   }
+
+  void RunBenchmark(FeaturesFetcher const & src, m2::RectD const & rect,
+                    pair<int, int> const & scaleRange, AllResult & res)
+  {
+    Accumulator acc(res.m_reading);
+
+    ForEachFrame(rect, scaleRange, [&](m2::RectD const & r, int scale)
+    {
+      acc.Reset(scale);
+
+      base::Timer timer;
+      src.ForEachFeature(r, acc, scale);
+      res.Add(timer.ElapsedSeconds());
+
+      return !acc.IsEmpty();
+    });
+  }
+
+  void RunAllocationsBenchmark(FeaturesFetcher const & src, m2::RectD const & rect,
+                               pair<int, int> const & scaleRange, AllocationsResult & res)
+  {
+    Result unused;
+    Accumulator acc(unused);
+
+    ForEachFrame(rect, scaleRange, [&](m2::RectD const & r, int scale)
+    {
+      acc.Reset(scale);
+
+      uint64_t const before = GetAllocationsCount();
+      src.ForEachFeature(r, acc, scale);
+      res.Add(GetAllocationsCount() - before, acc.GetCount());
+
+      return !acc.IsEmpty();
+    });
+  }
+
+  // Registers the map and clamps |scaleRange| to its scales.
+  // @return false if there is nothing to read.
+  bool RegisterMap(string fileName, FeaturesFetcher & src, pair<int, int> & scaleRange,
+                   m2::RectD & rect)
+  {
+    base::GetNameFromFullPath(fileName);
+    base::GetNameWithoutExt(fileName);
+
+    auto const r = src.RegisterMap(platform::LocalCountryFile::MakeForTesting(std::move(fileName)));
+    if (r.second != MwmSet::RegResult::Success)
+      return false;
+
+    uint8_t const minScale = r.first.GetInfo()->m_minScale;
+    uint8_t const maxScale = r.first.GetInfo()->m_maxScale;
+    if (minScale > scaleRange.first)
+      scaleRange.first = minScale;
+    if (maxScale < scaleRange.second)
+      scaleRange.second = maxScale;
+
+    rect = r.first.GetInfo()->m_bordersRect;
+    return scaleRange.first <= scaleRange.second;
+  }
 }
 
 void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, AllResult & res)
 {
-  base::GetNameFromFullPath(fileName);
-  base::GetNameWithoutExt(fileName);
-
   FeaturesFetcher src;
-  auto const r = src.RegisterMap(platform::LocalCountryFile::MakeForTesting(std::move(fileName)));
-  if (r.second != MwmSet::RegResult::Success)
-    return;
-
-  uint8_t const minScale = r.first.GetInfo()->m_minScale;
-  uint8_t const maxScale = r.first.GetInfo()->m_maxScale;
-  if (minScale > scaleRange.first)
-    scaleRange.first = minScale;
-  if (maxScale < scaleRange.second)
-    scaleRange.second = maxScale;
-
-  if (scaleRange.first > scaleRange.second)
-    return;
+  m2::RectD rect;
+  if (RegisterMap(std::move(fileName), src, scaleRange, rect))
+    RunBenchmark(src, rect, scaleRange, res);
+}
 
-  RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, res);
+void RunAllocationsBenchmark(string fileName, pair<int, int> scaleRange, AllocationsResult & res)
+{
+  FeaturesFetcher src;
+  m2::RectD rect;
+  if (RegisterMap(std::move(fileName), src, scaleRange, rect))
+    RunAllocationsBenchmark(src, rect, scaleRange, res);
 }
 }  // namespace bench
@@ -13,6 +13,12 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_bool(count_allocations, false, "Count memory allocations per frame instead of timing");
+DEFINE_bool(iterate_features, false,
+            "Compare throughput of reading all features with copied and mapped records");
+DEFINE_bool(draw_rules, false,
+            "Compare collecting drawing rule keys by the classificator and by the precompiled tables");
+DEFINE_int32(runs, 3, "Number of runs of --iterate_features and --draw_rules, the best one is taken");
 
 int main(int argc, char ** argv)
 {
@@ -41,6 +47,33 @@ int main(int argc, char ** argv)
   {
     using namespace bench;
 
+    if (FLAGS_iterate_features)
+    {
+      IterationResult res;
+      RunIterationBenchmark(FLAGS_input, FLAGS_runs, res);
+
+      res.Print();
+      return 0;
+    }
+
+    if (FLAGS_draw_rules)
+    {
+      DrawRulesResult res;
+      RunDrawRulesBenchmark(FLAGS_input, FLAGS_runs, res);
+
+      res.Print();
+      return 0;
+    }
+
+    if (FLAGS_count_allocations)
+    {
+      AllocationsResult res;
+      RunAllocationsBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
+
+      res.Print();
+      return 0;
+    }
+
     AllResult res;
     RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
 
@@ -12,8 +12,14 @@
 
 #include "coding/string_utf8_multilang.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace address_tests
 {
@@ -104,4 +110,61 @@ UNIT_TEST(ReverseGeocoder_Smoke)
     TestAddress(coder, mwmInfo, {53.89745, 27.55835}, streetNames, "18А");
   }
 }
+
+// Compares batch reverse geocoding of a GPS track with the single point one and measures both.
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  auto const regResult = dataSource.RegisterMap(LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+  auto const & rect = regResult.first.GetInfo()->m_bordersRect;
+
+  // Random walk with 10 meters steps in the center of Minsk, which stays inside the mwm.
+  std::mt19937 rng(1 /* seed */);
+  std::uniform_real_distribution<double> step(-mercator::MetersToMercator(10.0),
+                                              mercator::MetersToMercator(10.0));
+  std::vector<m2::PointD> points;
+  m2::PointD pt = mercator::FromLatLon(53.89815, 27.54265);
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    pt.x = std::clamp(pt.x + step(rng), rect.minX(), rect.maxX());
+    pt.y = std::clamp(pt.y + step(rng), rect.minY(), rect.maxY());
+    points.push_back(pt);
+  }
+
+  ReverseGeocoder coder(dataSource);
+
+  base::Timer timer;
+  std::vector<ReverseGeocoder::Address> expected(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    coder.GetNearbyAddress(points[i], ReverseGeocoder::kLookupRadiusM, expected[i]);
+  double const singleSeconds = timer.ElapsedSeconds();
+
+  size_t const numFound = std::count_if(expected.begin(), expected.end(),
+                                        [](auto const & addr) { return addr.IsValid(); });
+  TEST_GREATER(numFound, points.size() / 2, ());
+
+  for (size_t threadsCount : {1, 4})
+  {
+    timer.Reset();
+    std::vector<ReverseGeocoder::Address> addrs;
+    coder.GetNearbyAddresses(points, ReverseGeocoder::kLookupRadiusM, threadsCount, addrs);
+    double const batchSeconds = timer.ElapsedSeconds();
+
+    TEST_EQUAL(addrs.size(), expected.size(), ());
+    for (size_t i = 0; i < addrs.size(); ++i)
+    {
+      TEST_EQUAL(addrs[i].m_building.m_id, expected[i].m_building.m_id, (i));
+      TEST_EQUAL(addrs[i].GetDistance(), expected[i].GetDistance(), (i));
+      TEST_EQUAL(addrs[i].m_street.m_id, expected[i].m_street.m_id, (i));
+      TEST_EQUAL(addrs[i].GetStreetName(), expected[i].GetStreetName(), (i));
+    }
+
+    LOG(LINFO, ("Points:", points.size(), "single point loop:", points.size() / singleSeconds,
+                "points/s, batch with", threadsCount, "threads:", points.size() / batchSeconds,
+                "points/s"));
+  }
+}
 } // namespace address_tests
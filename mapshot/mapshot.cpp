@@ -3,18 +3,29 @@
 #include "software_renderer/cpu_drawer.hpp"
 #include "software_renderer/feature_processor.hpp"
 #include "software_renderer/frame_image.hpp"
+#include "software_renderer/glyph_cache.hpp"
+#include "software_renderer/tile_renderer.hpp"
 
 #include "drape_frontend/visual_params.hpp"
 
+#include "drape/glyph_raster_cache.hpp"
+
 #include "geometry/mercator.hpp"
 
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gflags/gflags.h>
 
@@ -29,6 +40,13 @@ DEFINE_int32(width, 480, "Resulting image width");
 DEFINE_int32(height, 640, "Resulting image height");
 DEFINE_double(vs, 2.0, "Visual scale (mdpi = 1.0, hdpi = 1.5, xhdpiScale = 2.0, "
                        "6plus = 2.4, xxhdpi = 3.0, xxxhdpi = 3.5)");
+DEFINE_bool(tiles, false, "Read tiles in format \"z/x/y\" from stdin and render them into "
+                          "the tile cache");
+DEFINE_string(cachedir, "", "Tile cache directory, -outpath is used when empty");
+DEFINE_int32(tilesize, 256, "Tile size in pixels");
+DEFINE_int32(metatile, 8, "Number of tiles along a metatile side");
+DEFINE_int32(threads, 1, "Number of threads rendering tiles");
+DEFINE_string(glyphcache, "", "Path to the persistent glyph cache, it's not used when empty");
 
 //----------------------------------------------------------------------------------------
 
@@ -72,6 +90,7 @@ string FilenameSeq(string const & path)
 }
 
 unique_ptr<software_renderer::CPUDrawer> cpuDrawer;
+shared_ptr<dp::GlyphRasterCache> glyphRasterCache;
 
 bool IsFrameRendererInitialized()
 {
@@ -86,7 +105,9 @@ void InitFrameRenderer(float visualScale)
   {
     df::VisualParams::Init(visualScale, 1024 /* dummy tile size */);
     string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
-    cpuDrawer = make_unique_dp<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
+    CPUDrawer::Params params(resPostfix, visualScale);
+    params.m_glyphRasterCache = glyphRasterCache;
+    cpuDrawer = make_unique_dp<CPUDrawer>(params);
   }
 }
 
@@ -169,6 +190,91 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
   file.close();
 }
+
+bool ParseTile(string const & src, software_renderer::TileKey & key)
+{
+  vector<string> parts;
+  strings::ParseCSVRow(src, '/', parts);
+  return parts.size() == 3 && strings::to_uint(parts[0], key.m_zoom) &&
+         strings::to_uint(parts[1], key.m_x) && strings::to_uint(parts[2], key.m_y) &&
+         key.IsValid();
+}
+
+// Renders tiles read from stdin by FLAGS_threads threads and prints the throughput.
+void RenderTiles(Framework & framework)
+{
+  using namespace software_renderer;
+
+  vector<TileKey> keys;
+  for (string line; getline(cin, line);)
+  {
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    TileKey key;
+    if (!ParseTile(line, key))
+    {
+      cerr << "Bad tile [" << line << "]" << endl;
+      exit(1);
+    }
+    keys.push_back(key);
+  }
+
+  size_t const numThreads = static_cast<size_t>(max(FLAGS_threads, 1));
+
+  TileRenderer::Params params;
+  params.m_cacheDir = FLAGS_cachedir.empty() ? FLAGS_outpath : FLAGS_cachedir;
+  params.m_visualScale = FLAGS_vs;
+  params.m_tileSize = static_cast<uint32_t>(FLAGS_tilesize);
+  params.m_metatileSize = static_cast<uint32_t>(max(FLAGS_metatile, 1));
+  params.m_numDrawers = numThreads;
+  params.m_glyphRasterCache = glyphRasterCache;
+
+  // Drawers' initialization is a part of time to the first tile.
+  base::Timer startTimer;
+  TileRenderer renderer(framework.GetDataSource(), params);
+
+  atomic<size_t> next(0);
+  atomic<size_t> numFailed(0);
+  once_flag firstTile;
+  double firstTileSeconds = 0.0;
+  auto const work = [&]() {
+    for (size_t i = next++; i < keys.size(); i = next++)
+    {
+      if (renderer.GetTile(keys[i]).empty())
+        ++numFailed;
+      call_once(firstTile, [&]() { firstTileSeconds = startTimer.ElapsedSeconds(); });
+    }
+  };
+
+  base::Timer timer;
+  vector<thread> threads;
+  for (size_t i = 1; i < numThreads; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto & t : threads)
+    t.join();
+  double const seconds = max(timer.ElapsedSeconds(), 1e-9);
+
+  size_t const numCores =
+      min(numThreads, static_cast<size_t>(max(thread::hardware_concurrency(), 1U)));
+  double const tilesPerSecond = keys.size() / seconds;
+  auto const stats = renderer.GetStats();
+  cout << "Tiles: " << keys.size() << ", failed: " << numFailed
+       << ", rendered metatiles: " << stats.m_numRenderedMetatiles
+       << ", cache hits: " << stats.m_numCacheHits << endl;
+  cout << "Time: " << seconds << " s, " << tilesPerSecond << " tiles/s, "
+       << tilesPerSecond / numCores << " tiles/s per core" << endl;
+  cout << "Time to the first tile: " << firstTileSeconds << " s";
+  if (glyphRasterCache)
+  {
+    cout << ", glyph cache: " << (glyphRasterCache->GetNumLoadedGlyphs() == 0 ? "cold" : "warm")
+         << ", hits: " << glyphRasterCache->GetStats().m_hits
+         << ", misses: " << glyphRasterCache->GetStats().m_misses;
+  }
+  cout << endl;
+}
 }  // namespace
 
 int main(int argc, char * argv[])
@@ -177,9 +283,9 @@ int main(int argc, char * argv[])
       "Generate screenshots of OMaps maps in chosen places, specified by coordinates and zoom.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
-  if (!FLAGS_c && FLAGS_place.empty())
+  if (!FLAGS_c && FLAGS_place.empty() && !FLAGS_tiles)
   {
-    cerr << "Either -c or -place must be set" << endl;
+    cerr << "One of -c, -place or -tiles must be set" << endl;
     return 1;
   }
 
@@ -193,6 +299,18 @@ int main(int argc, char * argv[])
   {
     Framework f(FrameworkParams(false /* m_enableDiffs */));
 
+    if (!FLAGS_glyphcache.empty())
+    {
+      glyphRasterCache = make_shared<dp::GlyphRasterCache>(
+          FLAGS_glyphcache, software_renderer::GlyphCache::GetRasterCacheFingerprint(FLAGS_vs));
+    }
+
+    if (FLAGS_tiles)
+    {
+      RenderTiles(f);
+      return 0;
+    }
+
     auto processPlace = [&](string const & place)
     {
       Place p = ParsePlace(place);
@@ -21,34 +21,44 @@ namespace openlr
 void CandidatePointsGetter::FillJunctionPointCandidates(m2::PointD const & p,
                                                         std::vector<m2::PointD> & candidates)
 {
-  // TODO(mgsergio): Get optimal value using experiments on a sample.
-  // Or start with small radius and scale it up when there are too few points.
-  size_t const kRectSideMeters = 110;
-
-  auto const rect = mercator::RectByCenterXYAndSizeInMeters(p, kRectSideMeters);
-  auto const selectCandidates = [&rect, &candidates](FeatureType & ft) {
-    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-    ft.ForEachPoint(
-        [&rect, &candidates](m2::PointD const & candidate) {
-          if (rect.IsPointInside(candidate))
-            candidates.emplace_back(candidate);
-        },
-        scales::GetUpperScale());
+  auto const append = [&candidates](std::vector<m2::PointD> const & points) {
+    candidates.insert(candidates.end(), points.begin(), points.end());
   };
-
-  m_dataSource.ForEachInRect(selectCandidates, rect, scales::GetUpperScale());
-
-  // TODO: Move this to a separate stage.
-  // 1030292476 Does not match. Some problem occur with points.
-  // Either points duplicate or something alike. Check this
-  // later. The idea to fix this was to move SortUnique to the stage
-  // after enriching with projections.
-
-  base::SortUnique(candidates,
-                   [&p](m2::PointD const & a, m2::PointD const & b) {
-                     return mercator::DistanceOnEarth(a, p) < mercator::DistanceOnEarth(b, p);
-                   },
-                   [](m2::PointD const & a, m2::PointD const & b) { return a == b; });
+  if (!m_cache.m_junctionPoints.Find(p, append))
+  {
+    // TODO(mgsergio): Get optimal value using experiments on a sample.
+    // Or start with small radius and scale it up when there are too few points.
+    size_t const kRectSideMeters = 110;
+
+    std::vector<m2::PointD> points;
+    auto const rect = mercator::RectByCenterXYAndSizeInMeters(p, kRectSideMeters);
+    auto const selectCandidates = [&rect, &points](FeatureType & ft) {
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      ft.ForEachPoint(
+          [&rect, &points](m2::PointD const & candidate) {
+            if (rect.IsPointInside(candidate))
+              points.emplace_back(candidate);
+          },
+          scales::GetUpperScale());
+    };
+
+    m_dataSource.ForEachInRect(selectCandidates, rect, scales::GetUpperScale());
+
+    // TODO: Move this to a separate stage.
+    // 1030292476 Does not match. Some problem occur with points.
+    // Either points duplicate or something alike. Check this
+    // later. The idea to fix this was to move SortUnique to the stage
+    // after enriching with projections.
+
+    base::SortUnique(points,
+                     [&p](m2::PointD const & a, m2::PointD const & b) {
+                       return mercator::DistanceOnEarth(a, p) < mercator::DistanceOnEarth(b, p);
+                     },
+                     [](m2::PointD const & a, m2::PointD const & b) { return a == b; });
+
+    append(points);
+    m_cache.m_junctionPoints.Insert(p, points);
+  }
 
   candidates.resize(std::min(m_maxJunctionCandidates, candidates.size()));
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "openlr/decoder_cache.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/stats.hpp"
 
@@ -17,11 +18,12 @@ class CandidatePointsGetter
 {
 public:
   CandidatePointsGetter(size_t const maxJunctionCandidates, size_t const maxProjectionCandidates,
-                        DataSource const & dataSource, Graph & graph)
+                        DataSource const & dataSource, Graph & graph, DecoderCache & cache)
     : m_maxJunctionCandidates(maxJunctionCandidates)
     , m_maxProjectionCandidates(maxProjectionCandidates)
     , m_dataSource(dataSource)
     , m_graph(graph)
+    , m_cache(cache)
   {
   }
 
@@ -40,5 +42,6 @@ private:
 
   DataSource const & m_dataSource;
   Graph & m_graph;
+  DecoderCache & m_cache;
 };
 }  // namespace openlr
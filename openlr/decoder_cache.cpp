@@ -0,0 +1,47 @@
+#include "openlr/decoder_cache.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+
+using namespace std;
+
+namespace openlr
+{
+namespace
+{
+template <typename Map>
+void ReportMap(string const & name, Map const & map, uint64_t & hits, uint64_t & misses)
+{
+  uint64_t const total = map.GetHits() + map.GetMisses();
+  LOG(LINFO, (name, "lookups:", total, "hit rate:",
+              total == 0 ? 0.0 : static_cast<double>(map.GetHits()) / total));
+  hits += map.GetHits();
+  misses += map.GetMisses();
+}
+}  // namespace
+
+size_t DecoderCache::PointHash::operator()(m2::PointD const & p) const
+{
+  return base::Hash(p.x, p.y);
+}
+
+size_t DecoderCache::PointCountHash::operator()(pair<m2::PointD, uint32_t> const & key) const
+{
+  return PointHash()(key.first) ^ hash<uint32_t>()(key.second);
+}
+
+void DecoderCache::Report() const
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  ReportMap("Outgoing edges", m_outgoingEdges, hits, misses);
+  ReportMap("Ingoing edges", m_ingoingEdges, hits, misses);
+  ReportMap("Closest edges", m_closestEdges, hits, misses);
+  ReportMap("Junction points", m_junctionPoints, hits, misses);
+  ReportMap("Scored junction points", m_scoreJunctionPoints, hits, misses);
+
+  uint64_t const total = hits + misses;
+  LOG(LINFO, ("Cache lookups:", total, "hit rate:",
+              total == 0 ? 0.0 : static_cast<double>(hits) / total));
+}
+}  // namespace openlr
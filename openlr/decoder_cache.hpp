@@ -0,0 +1,122 @@
+#pragma once
+
+#include "openlr/cache_line_size.hpp"
+#include "openlr/score_types.hpp"
+
+#include "routing/features_road_graph.hpp"
+#include "routing/road_graph.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/point_with_altitude.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openlr
+{
+// Thread-safe map which is filled by many threads. The map is split into shards with
+// separate locks so threads rarely wait for each other. Values are never changed after
+// insertion.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SharedMap
+{
+public:
+  // Calls |fn| for the value of |key| if it exists. Returns false otherwise.
+  template <typename Fn>
+  bool Find(Key const & key, Fn && fn)
+  {
+    auto & shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    auto const it = shard.m_values.find(key);
+    if (it == shard.m_values.end())
+    {
+      ++shard.m_misses;
+      return false;
+    }
+
+    fn(it->second);
+    ++shard.m_hits;
+    return true;
+  }
+
+  // The value which is inserted first is kept if several threads compute the same key.
+  void Insert(Key const & key, Value const & value)
+  {
+    auto & shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.m_values.emplace(key, value);
+  }
+
+  uint64_t GetHits() const { return Sum(&Shard::m_hits); }
+  uint64_t GetMisses() const { return Sum(&Shard::m_misses); }
+
+private:
+  static size_t constexpr kShardsCount = 64;
+
+  // Lookup counters are kept by shards under their locks, so threads which look up keys of
+  // different shards don't write to a common cache line.
+  struct alignas(kCacheLineSize) Shard
+  {
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, Value, Hash> m_values;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  Shard & GetShard(Key const & key) { return m_shards[Hash()(key) % kShardsCount]; }
+
+  uint64_t Sum(uint64_t Shard::*counter) const
+  {
+    uint64_t sum = 0;
+    for (auto const & shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      sum += shard.*counter;
+    }
+    return sum;
+  }
+
+  std::array<Shard, kShardsCount> m_shards;
+};
+
+// Results of road graph and candidate points lookups shared by all threads decoding segments
+// of a feed. Neighbouring segments have common points, so the lookups around them are made once.
+// Keys are exact points: edges start at the requested junction and candidates depend on
+// the exact location of a point, so results of rounded keys would differ.
+// *NOTE* Cached edges keep FeatureIDs, so all the threads must use the same data source.
+class DecoderCache
+{
+public:
+  using Junction = geometry::PointWithAltitude;
+  using EdgeListT = routing::FeaturesRoadGraph::EdgeListT;
+  using Vicinities = std::vector<std::pair<routing::Edge, Junction>>;
+
+  struct PointHash
+  {
+    size_t operator()(m2::PointD const & p) const;
+  };
+
+  struct PointCountHash
+  {
+    size_t operator()(std::pair<m2::PointD, uint32_t> const & key) const;
+  };
+
+  void Report() const;
+
+  // Regular edges of junctions.
+  SharedMap<Junction, EdgeListT> m_outgoingEdges;
+  SharedMap<Junction, EdgeListT> m_ingoingEdges;
+  // Closest edges of points with the number of requested edges.
+  SharedMap<std::pair<m2::PointD, uint32_t>, Vicinities, PointCountHash> m_closestEdges;
+  // Sorted candidate points of CandidatePointsGetter and ScoreCandidatePointsGetter.
+  SharedMap<m2::PointD, std::vector<m2::PointD>, PointHash> m_junctionPoints;
+  SharedMap<m2::PointD, ScorePointVec, PointHash> m_scoreJunctionPoints;
+};
+}  // namespace openlr
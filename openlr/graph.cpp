@@ -3,7 +3,6 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point_with_altitude.hpp"
 
-#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -20,26 +19,27 @@ using EdgeGetter = void (IRoadGraph::*)(geometry::PointWithAltitude const &,
 
 void GetRegularEdges(geometry::PointWithAltitude const & junction, IRoadGraph const & graph,
                      EdgeGetter const edgeGetter,
-                     Graph::EdgeCacheT & cache,
+                     SharedMap<Graph::Junction, Graph::EdgeListT> & cache,
                      Graph::EdgeListT & edges)
 {
-  auto const it = cache.find(junction);
-  if (it == end(cache))
-  {
-    auto & es = cache[junction];
-    (graph.*edgeGetter)(junction, es);
+  auto const append = [&edges](Graph::EdgeListT const & es) {
     edges.append(begin(es), end(es));
-  }
-  else
-  {
-    auto const & es = it->second;
-    edges.append(begin(es), end(es));
-  }
+  };
+  if (cache.Find(junction, append))
+    return;
+
+  Graph::EdgeListT es;
+  (graph.*edgeGetter)(junction, es);
+  append(es);
+  cache.Insert(junction, es);
 }
 }  // namespace
 
-Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory)
-  : m_dataSource(dataSource, nullptr /* numMwmIDs */), m_graph(m_dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory,
+             DecoderCache & cache)
+  : m_dataSource(dataSource, nullptr /* numMwmIDs */)
+  , m_graph(m_dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+  , m_cache(cache)
 {
 }
 
@@ -57,20 +57,27 @@ void Graph::GetIngoingEdges(Junction const & junction, EdgeListT & edges)
 
 void Graph::GetRegularOutgoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, m_outgoingCache, edges);
+  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges,
+                  m_cache.m_outgoingEdges, edges);
 }
 
 void Graph::GetRegularIngoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, m_ingoingCache, edges);
+  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges,
+                  m_cache.m_ingoingEdges, edges);
 }
 
 void Graph::FindClosestEdges(m2::PointD const & point, uint32_t const count,
                              vector<pair<Edge, Junction>> & vicinities) const
 {
+  auto const key = make_pair(point, count);
+  if (m_cache.m_closestEdges.Find(key, [&vicinities](auto const & vs) { vicinities = vs; }))
+    return;
+
   m_graph.FindClosestEdges(
       mercator::RectByCenterXYAndSizeInMeters(point, FeaturesRoadGraph::kClosestEdgesRadiusM),
       count, vicinities);
+  m_cache.m_closestEdges.Insert(key, vicinities);
 }
 
 void Graph::AddIngoingFakeEdge(Edge const & e)
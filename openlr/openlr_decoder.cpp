@@ -4,6 +4,7 @@
 #include "openlr/candidate_paths_getter.hpp"
 #include "openlr/candidate_points_getter.hpp"
 #include "openlr/decoded_path.hpp"
+#include "openlr/decoder_cache.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/helpers.hpp"
 #include "openlr/openlr_model.hpp"
@@ -39,6 +40,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <functional>
@@ -220,8 +222,12 @@ void CopyWithoutOffsets(InputIterator start, InputIterator stop, OutputIterator
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf)
-    : m_dataSource(dataSource), m_graph(dataSource, std::move(cmf)), m_infoGetter(dataSource)
+  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf,
+                    DecoderCache & cache)
+    : m_dataSource(dataSource)
+    , m_cache(cache)
+    , m_graph(dataSource, std::move(cmf), cache)
+    , m_infoGetter(dataSource)
   {
   }
 
@@ -242,7 +248,7 @@ public:
     LOG(LDEBUG, ("Decoding segment:", segment.m_segmentId, "with", points.size(), "points"));
 
     CandidatePointsGetter pointsGetter(kMaxJunctionCandidates, kMaxProjectionCandidates,
-                                       m_dataSource, m_graph);
+                                       m_dataSource, m_graph, m_cache);
     CandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, stat);
 
     if (!pathsGetter.GetLineCandidatesForPoints(points, lineCandidates))
@@ -299,6 +305,7 @@ public:
 
 private:
   DataSource const & m_dataSource;
+  DecoderCache & m_cache;
   Graph m_graph;
   RoadInfoGetter m_infoGetter;
 };
@@ -309,8 +316,12 @@ private:
 class SegmentsDecoderV3
 {
 public:
-  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory)
-      : m_dataSource(dataSource), m_graph(dataSource, std::move(carModelFactory)), m_infoGetter(dataSource)
+  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory,
+                    DecoderCache & cache)
+    : m_dataSource(dataSource)
+    , m_cache(cache)
+    , m_graph(dataSource, std::move(carModelFactory), cache)
+    , m_infoGetter(dataSource)
   {
   }
 
@@ -330,7 +341,7 @@ public:
     LOG(LINFO, ("Decoding segment:", segment.m_segmentId, "with", points.size(), "points"));
 
     ScoreCandidatePointsGetter pointsGetter(kMaxJunctionCandidates, kMaxProjectionCandidates,
-                                            m_dataSource, m_graph);
+                                            m_dataSource, m_graph, m_cache);
     ScoreCandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, stat);
 
     if (!pathsGetter.GetLineCandidatesForPoints(points, segment.m_source, lineCandidates))
@@ -394,6 +405,7 @@ public:
 
 private:
   DataSource const & m_dataSource;
+  DecoderCache & m_cache;
   Graph m_graph;
   RoadInfoGetter m_infoGetter;
 };
@@ -435,9 +447,9 @@ bool OpenLRDecoder::SegmentsFilter::Matches(LinearSegment const & segment) const
 }
 
 // OpenLRDecoder -----------------------------------------------------------------------------
-OpenLRDecoder::OpenLRDecoder(vector<FrozenDataSource> & dataSources,
+OpenLRDecoder::OpenLRDecoder(DataSource & dataSource,
                              CountryParentNameGetter const & countryParentNameGetter)
-  : m_dataSources(dataSources), m_countryParentNameGetter(countryParentNameGetter)
+  : m_dataSource(dataSource), m_countryParentNameGetter(countryParentNameGetter)
 {
 }
 
@@ -457,16 +469,19 @@ template <typename Decoder, typename Stats>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
                            uint32_t const numThreads, vector<DecodedPath> & paths)
 {
-  auto const worker = [&](size_t threadNum, DataSource & dataSource, Stats & stat)
+  size_t constexpr kBatchSize = GetOptimalBatchSize();
+  size_t const numSegments = segments.size();
+
+  DecoderCache cache;
+  // Threads take batches of segments one by one since decoding time of segments differs a lot.
+  atomic<size_t> nextBatch(0);
+  auto const worker = [&](size_t threadNum, Stats & stat)
   {
-    size_t constexpr kBatchSize = GetOptimalBatchSize();
     size_t constexpr kProgressFrequency = 100;
 
-    size_t const numSegments = segments.size();
-
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
-    base::Timer timer;
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    Decoder decoder(m_dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter), cache);
+    for (size_t i = nextBatch.fetch_add(kBatchSize); i < numSegments;
+         i = nextBatch.fetch_add(kBatchSize))
     {
       for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
       {
@@ -474,11 +489,10 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
           ++stat.m_routesFailed;
         ++stat.m_routesHandled;
 
-        if (stat.m_routesHandled % kProgressFrequency == 0 || i == segments.size() - 1)
+        if (stat.m_routesHandled % kProgressFrequency == 0 || j + 1 == numSegments)
         {
           LOG(LINFO, ("Thread", threadNum, "processed", stat.m_routesHandled,
                       "failed:", stat.m_routesFailed));
-          timer.Reset();
         }
       }
     }
@@ -488,9 +502,9 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
   vector<Stats> stats(numThreads);
   vector<thread> workers;
   for (size_t i = 1; i < numThreads; ++i)
-    workers.emplace_back(worker, i, ref(m_dataSources[i]), ref(stats[i]));
+    workers.emplace_back(worker, i, ref(stats[i]));
 
-  worker(0 /* threadNum */, m_dataSources[0], stats[0]);
+  worker(0 /* threadNum */, stats[0]);
   for (auto & worker : workers)
     worker.join();
 
@@ -499,6 +513,9 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
     allStats.Add(s);
 
   allStats.Report();
-  LOG(LINFO, ("Matching tool:", timer.ElapsedSeconds(), "seconds."));
+  cache.Report();
+  double const seconds = timer.ElapsedSeconds();
+  LOG(LINFO, ("Matching tool:", seconds, "seconds,", numSegments / max(seconds, 1e-3),
+              "segments per second."));
 }
 }  // namespace openlr
@@ -40,10 +40,11 @@ public:
     bool const m_multipointsOnly;
   };
 
-  OpenLRDecoder(std::vector<FrozenDataSource> & dataSources,
-                CountryParentNameGetter const & countryParentNameGetter);
+  // |dataSource| is used by all decoding threads.
+  OpenLRDecoder(DataSource & dataSource, CountryParentNameGetter const & countryParentNameGetter);
 
   // Maps partner segments to mwm paths. |segments| should be sorted by partner id.
+  // Segments are decoded by |numThreads| threads which share the results of road graph lookups.
   void DecodeV2(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
                 std::vector<DecodedPath> & paths);
 
@@ -55,7 +56,7 @@ private:
   void Decode(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
               std::vector<DecodedPath> & paths);
 
-  std::vector<FrozenDataSource> & m_dataSources;
+  DataSource & m_dataSource;
   CountryParentNameGetter m_countryParentNameGetter;
 };
 }  // namespace openlr
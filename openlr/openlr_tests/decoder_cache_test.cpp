@@ -0,0 +1,76 @@
+#include "testing/testing.hpp"
+
+#include "openlr/decoder_cache.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(SharedMap_Smoke)
+{
+  SharedMap<m2::PointD, vector<int>, DecoderCache::PointHash> map;
+  vector<int> value;
+  auto const get = [&value](vector<int> const & v) { value = v; };
+
+  TEST(!map.Find(m2::PointD(1.0, 2.0), get), ());
+  map.Insert(m2::PointD(1.0, 2.0), {1, 2});
+  // The first value is kept.
+  map.Insert(m2::PointD(1.0, 2.0), {3});
+  TEST(map.Find(m2::PointD(1.0, 2.0), get), ());
+  TEST_EQUAL(value, vector<int>({1, 2}), ());
+  TEST(!map.Find(m2::PointD(2.0, 1.0), get), ());
+
+  TEST_EQUAL(map.GetHits(), 1, ());
+  TEST_EQUAL(map.GetMisses(), 2, ());
+}
+
+// Threads look up overlapping sets of keys like the decoding threads do with the points of
+// neighbouring segments.
+UNIT_TEST(SharedMap_Concurrent)
+{
+  size_t constexpr kThreadsCount = 8;
+  uint32_t constexpr kKeysCount = 10000;
+
+  SharedMap<m2::PointD, uint32_t, DecoderCache::PointHash> map;
+  atomic<uint32_t> computed(0);
+  atomic<uint32_t> wrong(0);
+
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      for (uint32_t i = 0; i < kKeysCount; ++i)
+      {
+        uint32_t const key = (i + static_cast<uint32_t>(t) * 997) % kKeysCount;
+        m2::PointD const p(key * 1e-5, 1.0 - key * 1e-5);
+        uint32_t value = 0;
+        if (!map.Find(p, [&value](uint32_t v) { value = v; }))
+        {
+          ++computed;
+          value = key;
+          map.Insert(p, value);
+        }
+        if (value != key)
+          ++wrong;
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST_EQUAL(wrong, 0, ());
+  TEST_EQUAL(map.GetHits() + map.GetMisses(), kThreadsCount * kKeysCount, ());
+  TEST_EQUAL(map.GetMisses(), computed, ());
+  TEST_GREATER_OR_EQUAL(computed, kKeysCount, ());
+  TEST_LESS(computed, kThreadsCount * kKeysCount, ());
+}
+}  // namespace
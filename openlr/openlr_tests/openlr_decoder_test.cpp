@@ -0,0 +1,175 @@
+#include "testing/testing.hpp"
+
+#include "openlr/decoded_path.hpp"
+#include "openlr/openlr_decoder.hpp"
+#include "openlr/openlr_model.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/location.hpp"
+
+#include "geometry/angles.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+namespace
+{
+uint32_t constexpr kThreadsCount = 4;
+double constexpr kBearDistM = 25.0;
+
+// Returns the point |distM| meters along |points| from the first one.
+m2::PointD GetPointAlong(vector<m2::PointD> const & points, double distM)
+{
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    double const segmentM = mercator::DistanceOnEarth(points[i], points[i + 1]);
+    if (segmentM >= distM)
+      return points[i] + (points[i + 1] - points[i]) * (distM / segmentM);
+    distM -= segmentM;
+  }
+  return points.back();
+}
+
+// Bearing of |points| at the first one as it is encoded in location reference points.
+uint8_t GetBearing(vector<m2::PointD> const & points)
+{
+  auto const & start = points.front();
+  auto const angle = location::AngleToBearing(
+      base::RadToDeg(ang::AngleTo(start, GetPointAlong(points, kBearDistM))));
+  return static_cast<uint8_t>(base::Clamp(angle / (360.0 / 256.0), 0.0, 255.0));
+}
+
+// The road class which the decoders match best to |hwClass|.
+FunctionalRoadClass GetFunctionalRoadClass(ftypes::HighwayClass hwClass)
+{
+  switch (hwClass)
+  {
+  case ftypes::HighwayClass::Trunk: return FunctionalRoadClass::FRC0;
+  case ftypes::HighwayClass::Primary: return FunctionalRoadClass::FRC1;
+  case ftypes::HighwayClass::Secondary: return FunctionalRoadClass::FRC2;
+  case ftypes::HighwayClass::Tertiary: return FunctionalRoadClass::FRC3;
+  case ftypes::HighwayClass::LivingStreet:
+  case ftypes::HighwayClass::Service: return FunctionalRoadClass::FRC4;
+  default: return FunctionalRoadClass::NotAValue;
+  }
+}
+
+LocationReferencePoint MakePoint(vector<m2::PointD> const & points, FunctionalRoadClass frc,
+                                 uint32_t distanceToNextPoint)
+{
+  LocationReferencePoint point;
+  point.m_latLon = mercator::ToLatLon(points.front());
+  point.m_bearing = GetBearing(points);
+  point.m_functionalRoadClass = frc;
+  point.m_formOfWay = FormOfWay::SingleCarriageway;
+  point.m_distanceToNextPoint = distanceToNextPoint;
+  point.m_lfrcnp = frc;
+  return point;
+}
+
+// Makes two-point segments along the car roads of the mwm. Neighbouring roads share junctions,
+// so threads look up the same junctions in the decoder cache.
+vector<LinearSegment> MakeSegments(DataSource const & dataSource)
+{
+  auto const & carModel = routing::CarModel::AllLimitsInstance();
+
+  vector<LinearSegment> segments;
+  dataSource.ForEachInScale([&](FeatureType & ft)
+  {
+    if (!carModel.IsRoad(ft))
+      return;
+
+    auto const frc = GetFunctionalRoadClass(ftypes::GetHighwayClass(feature::TypesHolder(ft)));
+    if (frc == FunctionalRoadClass::NotAValue)
+      return;
+
+    vector<m2::PointD> points;
+    ft.ForEachPoint([&points](m2::PointD const & p) { points.push_back(p); },
+                    FeatureType::BEST_GEOMETRY);
+
+    double lengthM = 0.0;
+    for (size_t i = 0; i + 1 < points.size(); ++i)
+      lengthM += mercator::DistanceOnEarth(points[i], points[i + 1]);
+    if (lengthM < 100.0 || lengthM > 2000.0)
+      return;
+
+    LinearSegment segment;
+    segment.m_source = LinearSegmentSource::FromLocationReferenceTag;
+    segment.m_segmentId = static_cast<uint32_t>(segments.size());
+    segment.m_segmentLengthMeters = static_cast<uint32_t>(lengthM);
+
+    auto & lrps = segment.m_locationReference.m_points;
+    lrps.push_back(MakePoint(points, frc, segment.m_segmentLengthMeters));
+    reverse(points.begin(), points.end());
+    lrps.push_back(MakePoint(points, frc, 0 /* distanceToNextPoint */));
+
+    segments.push_back(move(segment));
+  }, scales::GetUpperScale());
+  return segments;
+}
+
+size_t GetDecodedCount(vector<DecodedPath> const & paths)
+{
+  return count_if(paths.cbegin(), paths.cend(),
+                  [](DecodedPath const & path) { return !path.m_path.empty(); });
+}
+
+void TestPathsEqual(vector<DecodedPath> const & lhs, vector<DecodedPath> const & rhs)
+{
+  TEST_EQUAL(lhs.size(), rhs.size(), ());
+  for (size_t i = 0; i < lhs.size(); ++i)
+  {
+    TEST_EQUAL(lhs[i].m_segmentId, rhs[i].m_segmentId, (i));
+    TEST_EQUAL(lhs[i].m_path, rhs[i].m_path, (lhs[i].m_segmentId));
+  }
+}
+
+// Threads share the road graph and candidate lookups, which must not change decoded paths.
+UNIT_TEST(OpenLRDecoder_SameResultsForAnyNumberOfThreads)
+{
+  classificator::Load();
+  base::ScopedLogLevelChanger const warningLogLevel(LWARNING);
+
+  FrozenDataSource dataSource;
+  auto const regResult =
+      dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+  auto const segments = MakeSegments(dataSource);
+  TEST_GREATER(segments.size(), 100, ());
+
+  OpenLRDecoder decoder(dataSource, [](string const &) { return string(); });
+
+  vector<DecodedPath> oneThreadPaths(segments.size());
+  decoder.DecodeV2(segments, 1 /* numThreads */, oneThreadPaths);
+  vector<DecodedPath> threadsPaths(segments.size());
+  decoder.DecodeV2(segments, kThreadsCount, threadsPaths);
+
+  TEST_GREATER(GetDecodedCount(oneThreadPaths), segments.size() / 2, ());
+  TestPathsEqual(oneThreadPaths, threadsPaths);
+
+  oneThreadPaths.assign(segments.size(), {});
+  decoder.DecodeV3(segments, 1 /* numThreads */, oneThreadPaths);
+  threadsPaths.assign(segments.size(), {});
+  decoder.DecodeV3(segments, kThreadsCount, threadsPaths);
+
+  TEST_GREATER(GetDecodedCount(oneThreadPaths), segments.size() / 2, ());
+  TestPathsEqual(oneThreadPaths, threadsPaths);
+}
+}  // namespace
@@ -36,24 +36,33 @@ void ScoreCandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p
                                                             ScoreEdgeVec & edgeCandidates)
 {
   ScorePointVec pointCandidates;
-  auto const selectCandidates = [&p, &pointCandidates, this](FeatureType & ft) {
-    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-    if (ft.GetGeomType() != feature::GeomType::Line || !routing::IsRoad(feature::TypesHolder(ft)))
-      return;
-
-    ft.ForEachPoint(
-        [&p, &pointCandidates, this](m2::PointD const & candidate) {
-          if (mercator::DistanceOnEarth(p, candidate) < kRadius)
-            pointCandidates.emplace_back(GetScoreByDistance(p, candidate), candidate);
-        },
-        scales::GetUpperScale());
-  };
-
-  m_dataSource.ForEachInRect(selectCandidates, mercator::RectByCenterXYAndSizeInMeters(p, kRadius),
-                             scales::GetUpperScale());
-
-  base::SortUnique(pointCandidates);
-  std::reverse(pointCandidates.begin(), pointCandidates.end());
+  if (!m_cache.m_scoreJunctionPoints.Find(
+          p, [&pointCandidates](ScorePointVec const & points) { pointCandidates = points; }))
+  {
+    auto const selectCandidates = [&p, &pointCandidates, this](FeatureType & ft) {
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      if (ft.GetGeomType() != feature::GeomType::Line ||
+          !routing::IsRoad(feature::TypesHolder(ft)))
+      {
+        return;
+      }
+
+      ft.ForEachPoint(
+          [&p, &pointCandidates, this](m2::PointD const & candidate) {
+            if (mercator::DistanceOnEarth(p, candidate) < kRadius)
+              pointCandidates.emplace_back(GetScoreByDistance(p, candidate), candidate);
+          },
+          scales::GetUpperScale());
+    };
+
+    m_dataSource.ForEachInRect(selectCandidates,
+                               mercator::RectByCenterXYAndSizeInMeters(p, kRadius),
+                               scales::GetUpperScale());
+
+    base::SortUnique(pointCandidates);
+    std::reverse(pointCandidates.begin(), pointCandidates.end());
+    m_cache.m_scoreJunctionPoints.Insert(p, pointCandidates);
+  }
 
   pointCandidates.resize(std::min(m_maxJunctionCandidates, pointCandidates.size()));
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "openlr/decoder_cache.hpp"
 #include "openlr/graph.hpp"
 #include "openlr/score_types.hpp"
 #include "openlr/stats.hpp"
@@ -18,11 +19,12 @@ class ScoreCandidatePointsGetter
 {
 public:
   ScoreCandidatePointsGetter(size_t maxJunctionCandidates, size_t maxProjectionCandidates,
-                             DataSource const & dataSource, Graph & graph)
+                             DataSource const & dataSource, Graph & graph, DecoderCache & cache)
     : m_maxJunctionCandidates(maxJunctionCandidates)
     , m_maxProjectionCandidates(maxProjectionCandidates)
     , m_dataSource(dataSource)
     , m_graph(graph)
+    , m_cache(cache)
   {
   }
 
@@ -46,5 +48,6 @@ private:
 
   DataSource const & m_dataSource;
   Graph & m_graph;
+  DecoderCache & m_cache;
 };
 }  // namespace openlr
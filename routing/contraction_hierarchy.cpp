@@ -0,0 +1,411 @@
+#include "routing/contraction_hierarchy.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+using Distance = ContractionHierarchy::Distance;
+using Weight = ContractionHierarchy::Weight;
+
+template <typename T>
+using MinQueue = priority_queue<pair<T, uint32_t>, vector<pair<T, uint32_t>>, greater<pair<T, uint32_t>>>;
+
+class Contractor
+{
+public:
+  struct Arc
+  {
+    uint32_t m_vertex;
+    Weight m_weight;
+  };
+
+  using Arcs = vector<Arc>;
+
+  Contractor(uint32_t numVertices, vector<ContractionHierarchy::Edge> const & edges,
+             uint32_t witnessSettleLimit)
+    : m_out(numVertices)
+    , m_in(numVertices)
+    , m_contracted(numVertices, false)
+    , m_deletedNeighbors(numVertices, 0)
+    , m_distances(numVertices, ContractionHierarchy::kInfiniteDistance)
+    , m_witnessSettleLimit(witnessSettleLimit)
+  {
+    for (auto const & e : edges)
+    {
+      CHECK_LESS(e.m_from, numVertices, ());
+      CHECK_LESS(e.m_to, numVertices, ());
+      if (e.m_from != e.m_to)
+        AddArc(e.m_from, e.m_to, e.m_weight);
+    }
+  }
+
+  // Contracts all the vertices and calls |f(v, out, in)| with upward arcs of every contracted vertex.
+  template <typename F>
+  void Run(F && f)
+  {
+    uint32_t const numVertices = static_cast<uint32_t>(m_out.size());
+
+    MinQueue<int64_t> queue;
+    for (uint32_t v = 0; v < numVertices; ++v)
+      queue.emplace(GetPriority(v), v);
+
+    vector<ContractionHierarchy::Edge> shortcuts;
+    while (!queue.empty())
+    {
+      uint32_t const v = queue.top().second;
+      queue.pop();
+      if (m_contracted[v])
+        continue;
+
+      // Lazy update: priorities of the vertices change when their neighbours are contracted.
+      int64_t const priority = GetPriority(v);
+      if (!queue.empty() && priority > queue.top().first)
+      {
+        queue.emplace(priority, v);
+        continue;
+      }
+
+      shortcuts.clear();
+      FindShortcuts(v, &shortcuts);
+
+      f(v, m_out[v], m_in[v]);
+
+      m_contracted[v] = true;
+      for (auto const & arc : m_out[v])
+      {
+        RemoveArc(m_in[arc.m_vertex], v);
+        ++m_deletedNeighbors[arc.m_vertex];
+      }
+      for (auto const & arc : m_in[v])
+      {
+        RemoveArc(m_out[arc.m_vertex], v);
+        ++m_deletedNeighbors[arc.m_vertex];
+      }
+      Arcs().swap(m_out[v]);
+      Arcs().swap(m_in[v]);
+
+      for (auto const & s : shortcuts)
+        AddArc(s.m_from, s.m_to, s.m_weight);
+    }
+  }
+
+private:
+  void AddArc(uint32_t from, uint32_t to, Weight weight)
+  {
+    auto const update = [](Arcs & arcs, uint32_t vertex, Weight weight) {
+      for (auto & arc : arcs)
+      {
+        if (arc.m_vertex == vertex)
+        {
+          arc.m_weight = min(arc.m_weight, weight);
+          return;
+        }
+      }
+      arcs.push_back({vertex, weight});
+    };
+
+    update(m_out[from], to, weight);
+    update(m_in[to], from, weight);
+  }
+
+  static void RemoveArc(Arcs & arcs, uint32_t vertex)
+  {
+    auto const it = find_if(arcs.begin(), arcs.end(),
+                            [vertex](Arc const & arc) { return arc.m_vertex == vertex; });
+    CHECK(it != arcs.end(), ());
+    *it = arcs.back();
+    arcs.pop_back();
+  }
+
+  int64_t GetPriority(uint32_t v)
+  {
+    // Edge difference plus the number of contracted neighbours to contract uniformly.
+    auto const shortcuts = static_cast<int64_t>(FindShortcuts(v, nullptr /* shortcuts */));
+    return shortcuts - static_cast<int64_t>(m_out[v].size() + m_in[v].size()) +
+           m_deletedNeighbors[v];
+  }
+
+  // \returns the number of shortcuts which are necessary to contract |v|.
+  size_t FindShortcuts(uint32_t v, vector<ContractionHierarchy::Edge> * shortcuts)
+  {
+    size_t count = 0;
+    for (auto const & in : m_in[v])
+    {
+      Weight maxOut = 0;
+      for (auto const & out : m_out[v])
+      {
+        if (out.m_vertex != in.m_vertex)
+          maxOut = max(maxOut, out.m_weight);
+      }
+
+      RunWitnessSearch(in.m_vertex, v, Distance(in.m_weight) + maxOut);
+
+      for (auto const & out : m_out[v])
+      {
+        if (out.m_vertex == in.m_vertex)
+          continue;
+
+        Distance const viaV = Distance(in.m_weight) + out.m_weight;
+        if (m_distances[out.m_vertex] <= viaV)
+          continue;
+
+        ++count;
+        if (shortcuts)
+        {
+          CHECK_LESS(viaV, numeric_limits<Weight>::max(), ());
+          shortcuts->push_back({in.m_vertex, out.m_vertex, static_cast<Weight>(viaV)});
+        }
+      }
+
+      for (auto const u : m_touched)
+        m_distances[u] = ContractionHierarchy::kInfiniteDistance;
+      m_touched.clear();
+    }
+    return count;
+  }
+
+  // Bounded Dijkstra from |source| which does not pass through |excluded|. Not found witnesses
+  // only lead to redundant shortcuts.
+  void RunWitnessSearch(uint32_t source, uint32_t excluded, Distance limit)
+  {
+    MinQueue<Distance> queue;
+    m_distances[source] = 0;
+    m_touched.push_back(source);
+    queue.emplace(0, source);
+
+    uint32_t settled = 0;
+    while (!queue.empty() && settled < m_witnessSettleLimit)
+    {
+      auto const [d, u] = queue.top();
+      queue.pop();
+      if (d > m_distances[u])
+        continue;
+      if (d > limit)
+        break;
+
+      ++settled;
+      for (auto const & arc : m_out[u])
+      {
+        if (arc.m_vertex == excluded)
+          continue;
+
+        Distance const nd = d + arc.m_weight;
+        if (nd < m_distances[arc.m_vertex])
+        {
+          if (m_distances[arc.m_vertex] == ContractionHierarchy::kInfiniteDistance)
+            m_touched.push_back(arc.m_vertex);
+          m_distances[arc.m_vertex] = nd;
+          queue.emplace(nd, arc.m_vertex);
+        }
+      }
+    }
+  }
+
+  vector<Arcs> m_out;
+  vector<Arcs> m_in;
+  vector<bool> m_contracted;
+  vector<uint32_t> m_deletedNeighbors;
+
+  vector<Distance> m_distances;
+  vector<uint32_t> m_touched;
+  uint32_t m_witnessSettleLimit;
+};
+}  // namespace
+
+// static
+ContractionHierarchy ContractionHierarchy::Build(uint32_t numVertices, vector<Edge> const & edges,
+                                                 uint32_t witnessSettleLimit)
+{
+  CHECK_GREATER(witnessSettleLimit, 0, ());
+
+  vector<Contractor::Arcs> up[2];
+  up[kForward].resize(numVertices);
+  up[kBackward].resize(numVertices);
+
+  Contractor contractor(numVertices, edges, witnessSettleLimit);
+  contractor.Run([&](uint32_t v, Contractor::Arcs const & out, Contractor::Arcs const & in) {
+    up[kForward][v] = out;
+    up[kBackward][v] = in;
+  });
+
+  ContractionHierarchy hierarchy;
+  hierarchy.m_numVertices = numVertices;
+  for (size_t direction : {kForward, kBackward})
+  {
+    auto & result = hierarchy.m_up[direction];
+    for (auto & arcs : up[direction])
+    {
+      sort(arcs.begin(), arcs.end(),
+           [](Contractor::Arc const & l, Contractor::Arc const & r) { return l.m_vertex < r.m_vertex; });
+      for (auto const & arc : arcs)
+      {
+        result.m_targets.push_back(arc.m_vertex);
+        result.m_weights.push_back(arc.m_weight);
+      }
+      result.m_offsets.push_back(base::asserted_cast<uint32_t>(result.m_targets.size()));
+      Contractor::Arcs().swap(arcs);
+    }
+  }
+  return hierarchy;
+}
+
+ContractionHierarchy::Distance ContractionHierarchy::FindDistance(vector<Seed> const & sources,
+                                                                  vector<Seed> const & targets,
+                                                                  size_t * settled) const
+{
+  unordered_map<uint32_t, Distance> distances[2];
+  MinQueue<Distance> queues[2];
+
+  auto const init = [&](size_t direction, vector<Seed> const & seeds) {
+    for (auto const & seed : seeds)
+    {
+      CHECK_LESS(seed.m_vertex, m_numVertices, ());
+      auto const [it, inserted] = distances[direction].emplace(seed.m_vertex, seed.m_distance);
+      if (!inserted && it->second <= seed.m_distance)
+        continue;
+      it->second = seed.m_distance;
+      queues[direction].emplace(seed.m_distance, seed.m_vertex);
+    }
+  };
+  init(kForward, sources);
+  init(kBackward, targets);
+
+  Distance best = kInfiniteDistance;
+  size_t settledCount = 0;
+  size_t direction = kForward;
+  while (true)
+  {
+    // A direction is finished when its closest vertex is not closer than the best path.
+    bool const active[2] = {!queues[kForward].empty() && queues[kForward].top().first < best,
+                            !queues[kBackward].empty() && queues[kBackward].top().first < best};
+    if (!active[kForward] && !active[kBackward])
+      break;
+    if (!active[direction])
+      direction = 1 - direction;
+
+    auto & queue = queues[direction];
+    auto const [d, v] = queue.top();
+    queue.pop();
+    auto & ownDistances = distances[direction];
+    if (d > ownDistances[v])
+      continue;
+
+    ++settledCount;
+    auto const & otherDistances = distances[1 - direction];
+    if (auto const it = otherDistances.find(v); it != otherDistances.cend())
+      best = min(best, d + it->second);
+
+    ForEachUpwardEdge(direction, v, [&](uint32_t w, Weight weight) {
+      Distance const nd = d + weight;
+      auto const [it, inserted] = ownDistances.emplace(w, nd);
+      if (!inserted && it->second <= nd)
+        return;
+      it->second = nd;
+      queue.emplace(nd, w);
+    });
+
+    direction = 1 - direction;
+  }
+
+  if (settled)
+    *settled = settledCount;
+  return best;
+}
+
+unordered_map<uint32_t, ContractionHierarchy::Distance> ContractionHierarchy::SearchUpward(
+    size_t direction, vector<Seed> const & seeds) const
+{
+  unordered_map<uint32_t, Distance> distances;
+  MinQueue<Distance> queue;
+  for (auto const & seed : seeds)
+  {
+    CHECK_LESS(seed.m_vertex, m_numVertices, ());
+    auto const [it, inserted] = distances.emplace(seed.m_vertex, seed.m_distance);
+    if (!inserted && it->second <= seed.m_distance)
+      continue;
+    it->second = seed.m_distance;
+    queue.emplace(seed.m_distance, seed.m_vertex);
+  }
+
+  while (!queue.empty())
+  {
+    auto const [d, v] = queue.top();
+    queue.pop();
+    if (d > distances[v])
+      continue;
+
+    ForEachUpwardEdge(direction, v, [&](uint32_t w, Weight weight) {
+      Distance const nd = d + weight;
+      auto const [it, inserted] = distances.emplace(w, nd);
+      if (!inserted && it->second <= nd)
+        return;
+      it->second = nd;
+      queue.emplace(nd, w);
+    });
+  }
+  return distances;
+}
+
+// ContractionHierarchy::Potentials ----------------------------------------------------------------
+// Paths to seeds end with downward edges, so the search from seeds goes over backward edges
+// and potentials are collected over forward ones.
+ContractionHierarchy::Potentials::Potentials(ContractionHierarchy const & hierarchy,
+                                             vector<Seed> const & seeds, bool toSeeds)
+  : m_hierarchy(hierarchy)
+  , m_direction(toSeeds ? kForward : kBackward)
+  , m_searchSpace(hierarchy.SearchUpward(toSeeds ? kBackward : kForward, seeds))
+{
+}
+
+ContractionHierarchy::Distance ContractionHierarchy::Potentials::Get(uint32_t vertex)
+{
+  CHECK_LESS(vertex, m_hierarchy.GetNumVertices(), ());
+  if (auto const it = m_potentials.find(vertex); it != m_potentials.cend())
+    return it->second;
+
+  // Upward edges make a DAG so the potential of a vertex is known as soon as the potentials of
+  // its upward neighbours are. Explicit stack is used because upward paths may be long.
+  vector<pair<uint32_t, bool /* expanded */>> stack = {{vertex, false}};
+  while (!stack.empty())
+  {
+    auto & [v, expanded] = stack.back();
+    if (m_potentials.count(v) != 0)
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if (!expanded)
+    {
+      expanded = true;
+      uint32_t const current = v;
+      m_hierarchy.ForEachUpwardEdge(m_direction, current, [&](uint32_t w, Weight) {
+        if (m_potentials.count(w) == 0)
+          stack.emplace_back(w, false);
+      });
+      continue;
+    }
+
+    uint32_t const current = v;
+    stack.pop_back();
+
+    auto const it = m_searchSpace.find(current);
+    Distance potential = it == m_searchSpace.cend() ? kInfiniteDistance : it->second;
+    m_hierarchy.ForEachUpwardEdge(m_direction, current, [&](uint32_t w, Weight weight) {
+      Distance const p = m_potentials.at(w);
+      if (p != kInfiniteDistance)
+        potential = min(potential, p + weight);
+    });
+    m_potentials.emplace(current, potential);
+  }
+
+  return m_potentials.at(vertex);
+}
+}  // namespace routing
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+/// \brief Contraction hierarchy over a directed graph with integer edge weights.
+/// Vertices are contracted one by one in the order of increasing importance. Every edge of
+/// the hierarchy goes from a less important vertex to a more important one, so any shortest path
+/// consists of an "upward" part of forward edges and a "downward" part of backward edges.
+/// Shortcuts are not unpacked: the hierarchy is used as an exact distance oracle only.
+class ContractionHierarchy
+{
+public:
+  using Weight = uint32_t;
+  using Distance = uint64_t;
+
+  static Distance constexpr kInfiniteDistance = std::numeric_limits<Distance>::max();
+
+  struct Edge
+  {
+    uint32_t m_from = 0;
+    uint32_t m_to = 0;
+    Weight m_weight = 0;
+  };
+
+  // Search origin with an initial distance.
+  struct Seed
+  {
+    uint32_t m_vertex = 0;
+    Distance m_distance = 0;
+  };
+
+  /// \param witnessSettleLimit is a number of vertices settled by a witness search at most.
+  /// Smaller values make preprocessing faster and the hierarchy larger, the result is exact anyway.
+  static ContractionHierarchy Build(uint32_t numVertices, std::vector<Edge> const & edges,
+                                    uint32_t witnessSettleLimit = 500);
+
+  uint32_t GetNumVertices() const { return m_numVertices; }
+  size_t GetNumEdges() const { return m_up[kForward].m_targets.size() + m_up[kBackward].m_targets.size(); }
+
+  /// \returns the shortest distance from |sources| to |targets| or kInfiniteDistance.
+  /// \param settled if not nullptr is set to the number of vertices settled by both searches.
+  Distance FindDistance(std::vector<Seed> const & sources, std::vector<Seed> const & targets,
+                        size_t * settled = nullptr) const;
+
+  template <class Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteVarUint(sink, m_numVertices);
+    for (auto const & up : m_up)
+    {
+      for (uint32_t v = 0; v < m_numVertices; ++v)
+      {
+        WriteVarUint(sink, up.m_offsets[v + 1] - up.m_offsets[v]);
+        for (uint32_t i = up.m_offsets[v]; i < up.m_offsets[v + 1]; ++i)
+        {
+          WriteVarInt(sink, static_cast<int64_t>(up.m_targets[i]) - static_cast<int64_t>(v));
+          WriteVarUint(sink, up.m_weights[i]);
+        }
+      }
+    }
+  }
+
+  template <class Source>
+  void Deserialize(Source & src)
+  {
+    m_numVertices = ReadVarUint<uint32_t>(src);
+    for (auto & up : m_up)
+    {
+      up.m_offsets.assign(1, 0);
+      up.m_offsets.reserve(m_numVertices + 1);
+      up.m_targets.clear();
+      up.m_weights.clear();
+      for (uint32_t v = 0; v < m_numVertices; ++v)
+      {
+        auto const count = ReadVarUint<uint32_t>(src);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          auto const target = static_cast<int64_t>(v) + ReadVarInt<int64_t>(src);
+          CHECK(target >= 0 && target < m_numVertices, (target, m_numVertices));
+          up.m_targets.push_back(static_cast<uint32_t>(target));
+          up.m_weights.push_back(ReadVarUint<Weight>(src));
+        }
+        up.m_offsets.push_back(base::asserted_cast<uint32_t>(up.m_targets.size()));
+      }
+    }
+  }
+
+  /// \brief Exact shortest distances to (or from) a fixed set of seeds for arbitrary vertices.
+  /// One search over the hierarchy is made in the constructor, every Get() call after it
+  /// only walks the upward edges of not yet visited vertices (see "CH-Potentials", Strasser, 2019).
+  class Potentials
+  {
+  public:
+    // |toSeeds| == true: Get(v) is a distance from v to seeds, otherwise from seeds to v.
+    Potentials(ContractionHierarchy const & hierarchy, std::vector<Seed> const & seeds,
+               bool toSeeds);
+
+    Distance Get(uint32_t vertex);
+    size_t GetSettledCount() const { return m_searchSpace.size(); }
+
+  private:
+    ContractionHierarchy const & m_hierarchy;
+    // Direction of the upward edges to walk in Get().
+    size_t m_direction;
+    std::unordered_map<uint32_t, Distance> m_searchSpace;
+    std::unordered_map<uint32_t, Distance> m_potentials;
+  };
+
+private:
+  static size_t constexpr kForward = 0;
+  static size_t constexpr kBackward = 1;
+
+  // Upward edges of all vertices in the CSR format.
+  // |m_up[kForward]| has edges (v -> w) at v, |m_up[kBackward]| has edges (w -> v) at v.
+  struct UpwardEdges
+  {
+    std::vector<uint32_t> m_offsets = {0};
+    std::vector<uint32_t> m_targets;
+    std::vector<Weight> m_weights;
+  };
+
+  template <typename F>
+  void ForEachUpwardEdge(size_t direction, uint32_t v, F && f) const
+  {
+    auto const & up = m_up[direction];
+    for (uint32_t i = up.m_offsets[v]; i < up.m_offsets[v + 1]; ++i)
+      f(up.m_targets[i], up.m_weights[i]);
+  }
+
+  // Full Dijkstra search over the upward edges of |direction| from |seeds|.
+  std::unordered_map<uint32_t, Distance> SearchUpward(size_t direction,
+                                                      std::vector<Seed> const & seeds) const;
+
+  uint32_t m_numVertices = 0;
+  UpwardEdges m_up[2];
+};
+}  // namespace routing
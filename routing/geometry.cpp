@@ -281,13 +281,23 @@ double RoadGeometry::GetRoadLengthM() const
 
 // Geometry ----------------------------------------------------------------------------------------
 Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize)
+  : Geometry(std::move(loader), nullptr /* roadCache */, kFakeNumMwmId, 0 /* mwmVersion */,
+             roadsCacheSize)
+{
+}
+
+Geometry::Geometry(unique_ptr<GeometryLoader> loader, shared_ptr<RoadGeometryCache> roadCache,
+                   NumMwmId mwmId, int64_t mwmVersion, size_t roadsCacheSize)
   : m_loader(std::move(loader))
+  , m_roadCache(std::move(roadCache))
+  , m_mwmId(mwmId)
+  , m_mwmVersion(mwmVersion)
 {
   CHECK(m_loader, ());
 
-  m_featureIdToRoad = make_unique<RoutingCacheT>(roadsCacheSize, [this](uint32_t featureId, RoadGeometry & road)
+  m_featureIdToRoad = make_unique<RoutingCacheT>(roadsCacheSize, [this](uint32_t featureId, RoadPtrT & road)
   {
-    m_loader->Load(featureId, road);
+    LoadRoad(featureId, road);
   });
 }
 
@@ -296,7 +306,29 @@ RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
   ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
-  return m_featureIdToRoad->GetValue(featureId);
+  return *m_featureIdToRoad->GetValue(featureId);
+}
+
+void Geometry::LoadRoad(uint32_t featureId, RoadPtrT & road)
+{
+  if (m_roadCache)
+  {
+    road = m_roadCache->Find(m_mwmId, m_mwmVersion, featureId);
+    if (road)
+      return;
+  }
+
+  auto loaded = make_shared<RoadGeometry>();
+  m_loader->Load(featureId, *loaded);
+
+  if (m_roadCache)
+  {
+    // Calculates all the distances, so the shared road is not changed by GetDistance().
+    loaded->GetRoadLengthM();
+    m_roadCache->Insert(m_mwmId, m_mwmVersion, featureId, loaded);
+  }
+
+  road = std::move(loaded);
 }
 
 SpeedInUnits GeometryLoader::GetSavedMaxspeed(uint32_t featureId, bool forward)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/latlon_with_altitude.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/road_point.hpp"
 #include "routing/routing_options.hpp"
 
@@ -129,6 +130,8 @@ public:
 /// \note The cache |m_featureIdToRoad| is used for road geometry for single-directional
 /// and bidirectional A*. According to tests it's faster to use one cache for both directions
 /// in bidirectional A* case than two separate caches, one for each direction (one for each A* wave).
+/// \note If |m_roadCache| is set, misses of |m_featureIdToRoad| are looked up in this
+/// process-wide cache before loading, and loaded roads are put to it.
 class Geometry final
 {
 public:
@@ -136,6 +139,11 @@ public:
   /// \brief Geometry constructor
   /// \param roadsCacheSize in-memory geometry elements count limit
   Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
+  /// \param roadCache shared cache of roads, may be nullptr.
+  /// \param mwmId id of the mwm of |loader| in |roadCache|.
+  /// \param mwmVersion version of the mwm of |loader|.
+  Geometry(std::unique_ptr<GeometryLoader> loader, std::shared_ptr<RoadGeometryCache> roadCache,
+           NumMwmId mwmId, int64_t mwmVersion, size_t roadsCacheSize = kRoadsCacheSize);
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -154,10 +162,15 @@ public:
   }
 
 private:
-  /// @todo Use LRU cache?
-  using RoutingCacheT = FifoCache<uint32_t, RoadGeometry, ska::bytell_hash_map<uint32_t, RoadGeometry>>;
+  using RoadPtrT = RoadGeometryCache::RoadPtrT;
+  using RoutingCacheT = FifoCache<uint32_t, RoadPtrT, ska::bytell_hash_map<uint32_t, RoadPtrT>>;
+
+  void LoadRoad(uint32_t featureId, RoadPtrT & road);
 
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<RoutingCacheT> m_featureIdToRoad;
+  std::shared_ptr<RoadGeometryCache> m_roadCache;
+  NumMwmId m_mwmId = kFakeNumMwmId;
+  int64_t m_mwmVersion = 0;
 };
 }  // namespace routing
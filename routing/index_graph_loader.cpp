@@ -166,7 +166,9 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
   if (!geometry)
   {
     auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-    geometry = make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+    geometry = make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes),
+                                     RoadGeometryCache::GetShared(m_vehicleType, m_loadAltitudes), numMwmId,
+                                     handle.GetInfo()->GetVersion());
   }
 
   auto graph = make_unique<IndexGraph>(geometry, m_estimator, m_avoidRoutingOptions);
@@ -185,7 +187,9 @@ IndexGraphLoaderImpl::GeometryPtrT IndexGraphLoaderImpl::CreateGeometry(NumMwmId
   MwmValue const * value = handle.GetValue();
 
   auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-  return make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+  return make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes),
+                               RoadGeometryCache::GetShared(m_vehicleType, m_loadAltitudes), numMwmId,
+                               handle.GetInfo()->GetVersion());
 }
 
 void IndexGraphLoaderImpl::Clear() { m_graphs.clear(); }
@@ -1,6 +1,7 @@
 #include "routing/index_graph_starter.hpp"
 
 #include "routing/fake_edges_container.hpp"
+#include "routing/joint_hierarchy.hpp"
 #include "routing/regions_sparse_graph.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
@@ -68,6 +69,15 @@ void IndexGraphStarter::Append(FakeEdgesContainer const & container)
   m_fakeNumerationStart += container.m_fake.GetSize();
 }
 
+Segment IndexGraphStarter::AddExtraFinish(FakeEnding const & finishEnding,
+                                          FakeEnding const & startEnding)
+{
+  auto const finishSegment = GetFakeSegment(m_fakeNumerationStart);
+  AddEnding(finishEnding, startEnding, false /* isStart */, false /* strictForward */);
+  m_finish.FillMwmIds();
+  return finishSegment;
+}
+
 void IndexGraphStarter::SetGuides(GuidesGraph const & guides) { m_guides = guides; }
 
 void IndexGraphStarter::SetRegionsGraphMode(std::shared_ptr<RegionsSparseGraph> regionsSparseGraph)
@@ -76,6 +86,35 @@ void IndexGraphStarter::SetRegionsGraphMode(std::shared_ptr<RegionsSparseGraph>
   m_graph.SetRegionsGraphMode(true);
 }
 
+void IndexGraphStarter::SetPotentials(shared_ptr<JointPotentials> toFinish,
+                                      shared_ptr<JointPotentials> fromStart)
+{
+  CHECK_EQUAL(toFinish == nullptr, fromStart == nullptr, ());
+  m_finishPotentials = std::move(toFinish);
+  m_startPotentials = std::move(fromStart);
+}
+
+RouteWeight IndexGraphStarter::HeuristicCostEstimate(Vertex const & from, ms::LatLon const & to) const
+{
+  RouteWeight const weight = m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), to);
+  // Fake segments get the straight line estimate only. It's consistent with the potentials
+  // because real segments lead to fake ones through the ending points with zero potential.
+  if (!m_finishPotentials || IsFakeSegment(from))
+    return weight;
+
+  JointPotentials * potentials = nullptr;
+  if (to == GetPoint(GetFinishSegment(), true /* front */))
+    potentials = m_finishPotentials.get();
+  else if (to == GetPoint(GetStartSegment(), true /* front */))
+    potentials = m_startPotentials.get();
+
+  if (!potentials || from.GetMwmId() != potentials->GetMwmId())
+    return weight;
+
+  double const potential = potentials->Get(from.GetRoadPoint(true /* front */));
+  return RouteWeight(max(weight.GetWeight(), potential));
+}
+
 LatLonWithAltitude const & IndexGraphStarter::GetStartJunction() const
 {
   auto const & startSegment = GetStartSegment();
@@ -22,6 +22,7 @@
 namespace routing
 {
 class FakeEdgesContainer;
+class JointPotentials;
 class RegionsSparseGraph;
 
 // Group highway types on categories (classes) to use in leaps candidates filtering.
@@ -63,6 +64,12 @@ public:
 
   void Append(FakeEdgesContainer const & container);
 
+  /// \brief Adds one more finish ending for one-to-many searches from the start.
+  /// Fake edges along a segment from the start to the finish aren't made, so |finishEnding|
+  /// shouldn't have projections to the segments of the start.
+  /// \returns the fake segment of the added finish. GetFinishSegment() is not changed.
+  Segment AddExtraFinish(FakeEnding const & finishEnding, FakeEnding const & startEnding);
+
   void SetGuides(GuidesGraph const & guides);
 
   void SetRegionsGraphMode(std::shared_ptr<RegionsSparseGraph> regionsSparseGraph);
@@ -94,6 +101,13 @@ public:
   std::set<NumMwmId> GetMwms() const;
   std::set<NumMwmId> const & GetStartMwms() const { return m_start.m_mwmIds; }
   std::set<NumMwmId> const & GetFinishMwms() const { return m_finish.m_mwmIds; }
+  std::set<Segment> const & GetStartRealSegments() const { return m_start.m_real; }
+  std::set<Segment> const & GetFinishRealSegments() const { return m_finish.m_real; }
+
+  /// \brief Sets potentials which are combined with the straight line heuristic for real segments
+  /// of the potentials' mwm. Pass nullptr-s to use the straight line heuristic only.
+  void SetPotentials(std::shared_ptr<JointPotentials> toFinish,
+                     std::shared_ptr<JointPotentials> fromStart);
 
   // Checks whether |weight| meets non-pass-through crossing restrictions according to placement of
   // start and finish in pass-through/non-pass-through area and number of non-pass-through crosses.
@@ -123,8 +137,7 @@ public:
 
   RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) override
   {
-    return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */),
-                                         GetPoint(to, true /* front */));
+    return HeuristicCostEstimate(from, GetPoint(to, true /* front */));
   }
 
   void SetAStarParents(bool forward, Parents<Segment> & parents) override
@@ -151,10 +164,7 @@ public:
     GetEdgesList({vertex, Weight(0.0)}, isOutgoing, false /* useAccessConditional */, edges);
   }
 
-  RouteWeight HeuristicCostEstimate(Vertex const & from, ms::LatLon const & to) const
-  {
-    return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), to);
-  }
+  RouteWeight HeuristicCostEstimate(Vertex const & from, ms::LatLon const & to) const;
 
   RouteWeight CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
   RouteWeight CalcGuidesSegmentWeight(Segment const & segment,
@@ -259,5 +269,9 @@ private:
 
   // Field for routing in mode for finding all route mwms.
   std::shared_ptr<RegionsSparseGraph> m_regionsGraph = nullptr;
+
+  // Contraction hierarchy potentials, see SetPotentials().
+  std::shared_ptr<JointPotentials> m_finishPotentials;
+  std::shared_ptr<JointPotentials> m_startPotentials;
 };
 }  // namespace routing
@@ -265,6 +265,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
         &dataSource, m_numMwmIds))
   , m_directionsEngine(CreateDirectionsEngine(m_vehicleType, m_numMwmIds, m_dataSource))
   , m_countryParentNameGetterFn(countryParentNameGetterFn)
+  , m_jointHierarchies(dataSource, m_numMwmIds)
 {
   CHECK(!m_name.empty(), ());
   CHECK(m_numMwmIds, ());
@@ -510,6 +511,41 @@ void IndexRouter::AddGuidesOsmConnectionsToGraphStarter(size_t checkpointIdxFrom
   }
 }
 
+RouterResultCode IndexRouter::CalculateRouteMatrix(vector<m2::PointD> const & sources,
+                                                   vector<m2::PointD> const & targets,
+                                                   MatrixLimits const & limits,
+                                                   RouterDelegate const & delegate,
+                                                   RouteMatrix & matrix)
+{
+  matrix.assign(sources.size(), vector<MatrixCell>(targets.size()));
+  if (m_vehicleType == VehicleType::Transit)
+  {
+    LOG(LWARNING, ("Route matrix isn't supported for transit."));
+    for (auto & row : matrix)
+    {
+      for (auto & cell : row)
+        cell.m_code = RouterResultCode::InternalError;
+    }
+    return RouterResultCode::InternalError;
+  }
+
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this]
+    {
+      ClearState();
+    });
+
+    return DoCalculateRouteMatrix(sources, targets, limits, delegate, matrix);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate route matrix for", sources.size(), "sources and", targets.size(),
+                 "targets:\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
 RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                m2::PointD const & startDirection,
                                                RouterDelegate const & delegate, Route & route)
@@ -712,6 +748,14 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
   LOG(LINFO, ("Routing in mode:", mode));
 
   base::ScopedTimerWithLog timer("Route build");
+  if (mode == WorldGraphMode::Joints && SetupJointPotentials(starter))
+  {
+    // Routes may leave the mwm, the potentials are lower bounds for such routes too.
+    auto const result = CalculateSubrouteJointsMode(starter, delegate, progress, subroute);
+    starter.SetPotentials(nullptr /* toFinish */, nullptr /* fromStart */);
+    return result;
+  }
+
   switch (mode)
   {
   case WorldGraphMode::Joints:
@@ -1107,6 +1151,191 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   return RouterResultCode::NoError;
 }
 
+RouterResultCode IndexRouter::DoCalculateRouteMatrix(vector<m2::PointD> const & sources,
+                                                     vector<m2::PointD> const & targets,
+                                                     MatrixLimits const & limits,
+                                                     RouterDelegate const & delegate,
+                                                     RouteMatrix & matrix)
+{
+  base::Timer timer;
+  TrafficStash::Guard guard(m_trafficStash);
+  // All the searches use one graph, so index graphs and cross-mwm transitions are loaded once.
+  auto graph = MakeWorldGraph();
+  graph->SetMode(WorldGraphMode::NoLeaps);
+
+  PointsOnEdgesSnapping snapping(*this, *graph);
+  // Returns an ending without projections if there are no roads near |point|.
+  auto const snap = [&](m2::PointD const & point, bool isOutgoing) {
+    vector<Segment> segments;
+    bool dummy = false;
+    if (!snapping.FindBestSegments(point, {} /* direction */, isOutgoing, segments, dummy))
+      return FakeEnding();
+    return MakeFakeEnding(segments, point, *graph);
+  };
+
+  vector<FakeEnding> targetEndings;
+  targetEndings.reserve(targets.size());
+  for (auto const & target : targets)
+    targetEndings.push_back(snap(target, false /* isOutgoing */));
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    auto & row = matrix[i];
+    FakeEnding const sourceEnding = snap(sources[i], true /* isOutgoing */);
+    if (sourceEnding.m_projections.empty())
+    {
+      for (auto & cell : row)
+        cell.m_code = RouterResultCode::StartPointNotFound;
+      continue;
+    }
+
+    set<Segment> sourceSegments;
+    for (auto const & projection : sourceEnding.m_projections)
+    {
+      sourceSegments.insert(projection.m_segment);
+      sourceSegments.insert(projection.m_segment.GetReversed());
+    }
+
+    unique_ptr<IndexGraphStarter> starter;
+    map<Segment, size_t> finishes;
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      auto const & targetEnding = targetEndings[j];
+      if (targetEnding.m_projections.empty())
+      {
+        row[j].m_code = RouterResultCode::EndPointNotFound;
+        continue;
+      }
+
+      // A target on a segment of the source needs fake edges from the source along the segment.
+      // They are made for the finish of a starter only, so such a target gets its own starter.
+      bool const onSourceSegment = any_of(
+          targetEnding.m_projections.cbegin(), targetEnding.m_projections.cend(),
+          [&](Projection const & projection) { return sourceSegments.count(projection.m_segment) != 0; });
+      if (onSourceSegment)
+      {
+        IndexGraphStarter pairStarter(sourceEnding, targetEnding, 0 /* fakeNumerationStart */,
+                                      false /* strictForward */, *graph);
+        auto const result = CalculateRouteMatrixRow(
+            pairStarter, {{pairStarter.GetFinishSegment(), j}}, limits, delegate, row);
+        if (result != RouterResultCode::NoError)
+          return result;
+        continue;
+      }
+
+      if (starter)
+      {
+        finishes.emplace(starter->AddExtraFinish(targetEnding, sourceEnding), j);
+        continue;
+      }
+
+      starter = make_unique<IndexGraphStarter>(sourceEnding, targetEnding,
+                                               0 /* fakeNumerationStart */,
+                                               false /* strictForward */, *graph);
+      finishes.emplace(starter->GetFinishSegment(), j);
+    }
+
+    if (!starter)
+      continue;
+
+    auto const result = CalculateRouteMatrixRow(*starter, finishes, limits, delegate, row);
+    if (result != RouterResultCode::NoError)
+      return result;
+  }
+
+  LOG(LINFO, ("Route matrix", sources.size(), "x", targets.size(), "is calculated in",
+              timer.ElapsedSeconds(), "seconds."));
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateRouteMatrixRow(IndexGraphStarter & starter,
+                                                      map<Segment, size_t> const & finishes,
+                                                      MatrixLimits const & limits,
+                                                      RouterDelegate const & delegate,
+                                                      vector<MatrixCell> & row)
+{
+  using Vertex = IndexGraphStarter::Vertex;
+  using Edge = IndexGraphStarter::Edge;
+  using Weight = IndexGraphStarter::Weight;
+
+  AStarAlgorithm<Vertex, Edge, Weight> algorithm;
+  AStarAlgorithm<Vertex, Edge, Weight>::Context context(starter);
+
+  double weightLimit = numeric_limits<double>::max();
+  if (limits.m_weightFactor > 0.0)
+  {
+    double maxEstimate = 0.0;
+    for (auto const & finish : finishes)
+    {
+      auto const & point = starter.GetPoint(finish.first, true /* front */);
+      maxEstimate = max(maxEstimate,
+                        starter.HeuristicCostEstimate(starter.GetStartSegment(), point).GetWeight());
+    }
+    weightLimit = max(maxEstimate * limits.m_weightFactor, limits.m_minWeightLimitSec);
+  }
+
+  // Plain Dijkstra: there is no single finish for the A* heuristic.
+  size_t finishesLeft = finishes.size();
+  uint32_t visitCount = 0;
+  bool cancelled = false;
+  auto const visitVertex = [&](Vertex const & vertex) {
+    if (++visitCount % kVisitPeriod == 0 && delegate.GetCancellable().IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    if (finishes.count(vertex) != 0)
+      --finishesLeft;
+    return finishesLeft != 0;
+  };
+
+  auto const adjustEdgeWeight = [](Vertex const & /* vertex */, Edge const & edge) {
+    return edge.GetWeight();
+  };
+  // The same length checks as the route searches have. Pass-through changes are allowed
+  // as for the finish which allows the most of them.
+  bool isLimitExceeded = false;
+  auto const filterStates = [&](auto const & state) {
+    if (state.distance.GetWeight() > weightLimit)
+    {
+      isLimitExceeded = true;
+      return false;
+    }
+    return starter.CheckLength(state.distance);
+  };
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, adjustEdgeWeight,
+                          filterStates, reducedToRealLength, context);
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  vector<Segment> path;
+  for (auto const & [finish, targetIdx] : finishes)
+  {
+    auto & cell = row[targetIdx];
+    if (!context.HasDistance(finish))
+    {
+      cell.m_code = RouterResultCode::RouteNotFound;
+      cell.m_isLimitExceeded = isLimitExceeded;
+      continue;
+    }
+
+    // ETA is calculated the same way as in RedressRoute().
+    context.ReconstructPath(finish, path);
+    double eta = starter.CalculateETAWithoutPenalty(path.front());
+    for (size_t k = 1; k < path.size(); ++k)
+      eta += starter.CalculateETA(path[k - 1], path[k]);
+
+    cell.m_code = RouterResultCode::NoError;
+    cell.m_weight = context.GetDistance(finish).GetWeight();
+    cell.m_etaSec = eta;
+  }
+
+  return RouterResultCode::NoError;
+}
+
 unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 {
   // Use saved routing options for all types (car, bicycle, pedestrian).
@@ -1795,6 +2024,81 @@ bool IndexRouter::AreMwmsNear(IndexGraphStarter const & starter) const
                              starter.GetFinishJunction().GetLatLon()) < kCloseMwmPointsDistanceM;
 }
 
+bool IndexRouter::SetupJointPotentials(IndexGraphStarter & starter)
+{
+  if (!m_contractionHierarchyEnabled || m_vehicleType != VehicleType::Car)
+    return false;
+
+  auto const & startMwms = starter.GetStartMwms();
+  if (startMwms.size() != 1 || startMwms != starter.GetFinishMwms())
+    return false;
+
+  // Start and finish potentials are chosen by the point in IndexGraphStarter::HeuristicCostEstimate().
+  if (starter.GetPoint(starter.GetStartSegment(), true /* front */) ==
+      starter.GetPoint(starter.GetFinishSegment(), true /* front */))
+  {
+    return false;
+  }
+
+  NumMwmId const mwmId = *startMwms.begin();
+  auto & graph = starter.GetGraph();
+  auto const * hierarchy = GetJointHierarchy(mwmId, graph);
+  if (!hierarchy)
+    return false;
+
+  // A route may go through the neighbouring mwms. Its weight outside the mwm is bounded by
+  // the straight line estimate from the border point to the ending.
+  auto const getBorders = [&](ms::LatLon const & ending) {
+    JointPotentials::Borders borders;
+    for (bool const isEnter : {false, true})
+    {
+      graph.ForEachTransition(mwmId, isEnter, [&](Segment const & transition) {
+        for (bool const front : {false, true})
+        {
+          double const weight =
+              graph.HeuristicCostEstimate(graph.GetPoint(transition, front), ending).GetWeight();
+          auto const it = borders.emplace(transition.GetRoadPoint(front), weight).first;
+          it->second = min(it->second, weight);
+        }
+      });
+    }
+    return borders;
+  };
+
+  starter.SetPotentials(
+      make_shared<JointPotentials>(*hierarchy, graph, mwmId, starter.GetFinishRealSegments(),
+                                   true /* toEndings */,
+                                   getBorders(starter.GetPoint(starter.GetFinishSegment(),
+                                                               true /* front */))),
+      make_shared<JointPotentials>(*hierarchy, graph, mwmId, starter.GetStartRealSegments(),
+                                   false /* toEndings */,
+                                   getBorders(starter.GetPoint(starter.GetStartSegment(),
+                                                               true /* front */))));
+  return true;
+}
+
+JointHierarchy const * IndexRouter::GetJointHierarchy(NumMwmId numMwmId, WorldGraph & graph)
+{
+  // The handle is held till ClearState(), so the mwm version isn't deregistered while it's used.
+  auto const version = m_dataSource.GetHandle(numMwmId).GetInfo()->GetVersion();
+  return m_jointHierarchies.Get(numMwmId, version, [&]() {
+    auto hierarchy = make_unique<JointHierarchy>();
+    if (m_dataSource.GetSectionStatus(numMwmId, CH_FILE_TAG) != MwmDataSource::SectionExists ||
+        !ReadJointHierarchyFromMwm(m_dataSource.GetMwmValue(numMwmId), *hierarchy))
+    {
+      return unique_ptr<JointHierarchy>();
+    }
+
+    if (!hierarchy->IsCompatible(graph, numMwmId))
+    {
+      LOG(LWARNING, (CH_FILE_TAG, "section of", m_numMwmIds->GetFile(numMwmId),
+                     "doesn't match the vehicle model and is not used."));
+      return unique_ptr<JointHierarchy>();
+    }
+    return hierarchy;
+  });
+}
+
 bool IndexRouter::DoesTransitSectionExist(NumMwmId numMwmId)
 {
   return m_dataSource.GetSectionStatus(numMwmId, TRANSIT_FILE_TAG) == MwmDataSource::SectionExists;
@@ -10,6 +10,7 @@
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/guides_connections.hpp"
+#include "routing/joint_hierarchy.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/regions_decl.hpp"
 #include "routing/router.hpp"
@@ -26,9 +27,11 @@
 #include "geometry/tree4d.hpp"
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace traffic { class TrafficCache; }
@@ -89,6 +92,44 @@ public:
 
   VehicleType GetVehicleType() const { return m_vehicleType; }
 
+  /// \brief Weight and ETA of the best route from a source to a target of a route matrix.
+  struct MatrixCell
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    // True if |m_code| is RouteNotFound because the search was stopped by MatrixLimits.
+    // A longer route may exist then.
+    bool m_isLimitExceeded = false;
+    double m_weight = 0.0;
+    double m_etaSec = 0.0;
+  };
+
+  /// \brief A search from a source of a route matrix is limited by the weight of the straight line
+  /// estimate of the farthest target multiplied by |m_weightFactor|, but not less than
+  /// |m_minWeightLimitSec|. Zero |m_weightFactor| means no limit.
+  struct MatrixLimits
+  {
+    double m_weightFactor = 10.0;
+    double m_minWeightLimitSec = 30 * 60;
+  };
+
+  // Cells are indexed by [source][target].
+  using RouteMatrix = std::vector<std::vector<MatrixCell>>;
+
+  /// \brief Calculates weights and ETAs of routes from every point of |sources| to every point
+  /// of |targets|. A single one-to-many search is made for every source, loaded index graphs
+  /// and cross-mwm transitions are reused by all of them. Routes are not reconstructed.
+  /// \returns NoError if all the searches are done even if some cells have no route,
+  /// codes of the cells are in |matrix|. Route matrix isn't supported for transit,
+  /// InternalError is returned in all the cells then.
+  RouterResultCode CalculateRouteMatrix(std::vector<m2::PointD> const & sources,
+                                        std::vector<m2::PointD> const & targets,
+                                        MatrixLimits const & limits,
+                                        RouterDelegate const & delegate, RouteMatrix & matrix);
+
+  /// \brief Enables A* potentials from CH_FILE_TAG sections for car routes inside one mwm.
+  /// It's enabled by default and has no effect for mwms without the section.
+  void SetContractionHierarchyEnabled(bool enabled) { m_contractionHierarchyEnabled = enabled; }
+
 private:
   RouterResultCode CalculateSubrouteJointsMode(IndexGraphStarter & starter,
                                                RouterDelegate const & delegate,
@@ -113,6 +154,20 @@ private:
                                      IndexGraphStarter & graph, std::vector<Segment> & subroute,
                                      bool guidesActive = false);
 
+  RouterResultCode DoCalculateRouteMatrix(std::vector<m2::PointD> const & sources,
+                                          std::vector<m2::PointD> const & targets,
+                                          MatrixLimits const & limits,
+                                          RouterDelegate const & delegate, RouteMatrix & matrix);
+  /// \brief Propagates a wave from the start of |starter| until all |finishes| are reached and
+  /// fills cells of |row| of the finishes. The wave is limited by |limits| and by
+  /// IndexGraphStarter::CheckLength().
+  /// \param finishes fake finish segments of |starter| and indexes of their targets in |row|.
+  RouterResultCode CalculateRouteMatrixRow(IndexGraphStarter & starter,
+                                           std::map<Segment, size_t> const & finishes,
+                                           MatrixLimits const & limits,
+                                           RouterDelegate const & delegate,
+                                           std::vector<MatrixCell> & row);
+
   RouterResultCode AdjustRoute(Checkpoints const & checkpoints,
                                m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
@@ -255,6 +310,10 @@ private:
   }
 
   void SetupAlgorithmMode(IndexGraphStarter & starter, bool guidesActive = false) const;
+  /// \returns true if contraction hierarchy potentials are set to |starter|. It's possible
+  /// if start and finish are in the same mwm which has a compatible CH_FILE_TAG section.
+  bool SetupJointPotentials(IndexGraphStarter & starter);
+  JointHierarchy const * GetJointHierarchy(NumMwmId numMwmId, WorldGraph & graph);
   uint32_t ConnectTracksOnGuidesToOsm(std::vector<m2::PointD> const & checkpoints,
                                       WorldGraph & graph);
 
@@ -291,5 +350,9 @@ private:
   GuidesConnections m_guides;
 
   CountryParentNameGetterFn m_countryParentNameGetterFn;
+
+  bool m_contractionHierarchyEnabled = true;
+  // Loaded CH_FILE_TAG sections, nullptr for mwms without a compatible section.
+  JointHierarchyCache m_jointHierarchies;
 };
 }  // namespace routing
@@ -0,0 +1,310 @@
+#include "routing/joint_hierarchy.hpp"
+
+#include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/joint.hpp"
+#include "routing/world_graph.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+size_t constexpr kSamplesCount = 64;
+}  // namespace
+
+// JointHierarchy ----------------------------------------------------------------------------------
+// static
+JointHierarchy::Weight JointHierarchy::ToWeight(double seconds)
+{
+  CHECK_GREATER_OR_EQUAL(seconds, 0.0, ());
+  double const ms = floor(seconds * 1000.0);
+  CHECK_LESS(ms, static_cast<double>(numeric_limits<Weight>::max()), (seconds));
+  return static_cast<Weight>(ms);
+}
+
+// static
+double JointHierarchy::ToSeconds(Distance distance)
+{
+  return static_cast<double>(distance) / 1000.0;
+}
+
+void JointHierarchy::Build(IndexGraph const & graph, EdgeEstimator const & estimator)
+{
+  using Purpose = EdgeEstimator::Purpose;
+
+  uint32_t const samplesStep = max(graph.GetNumRoads() / static_cast<uint32_t>(kSamplesCount), 1U);
+
+  vector<ContractionHierarchy::Edge> edges;
+  m_samples.clear();
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & roadJoints) {
+    RoadGeometry const & road = graph.GetRoadGeometry(featureId);
+    if (!road.IsValid())
+      return;
+
+    bool const twoWay = !road.IsOneWay();
+    if (featureId % samplesStep == 0 && road.GetPointsCount() > 1)
+    {
+      Segment const segment(kFakeNumMwmId, featureId, 0 /* segmentIdx */, true /* forward */);
+      m_samples.push_back({featureId, 0 /* segmentIdx */, true /* forward */,
+                           ToWeight(estimator.CalcSegmentWeight(segment, road, Purpose::Weight))});
+    }
+
+    Joint::Id prevJoint = Joint::kInvalidId;
+    double forwardWeight = 0.0;
+    double backwardWeight = 0.0;
+    for (uint32_t pointId = 0; pointId < road.GetPointsCount(); ++pointId)
+    {
+      if (pointId > 0)
+      {
+        uint32_t const segmentIdx = pointId - 1;
+        forwardWeight += estimator.CalcSegmentWeight(
+            Segment(kFakeNumMwmId, featureId, segmentIdx, true /* forward */), road, Purpose::Weight);
+        if (twoWay)
+        {
+          backwardWeight += estimator.CalcSegmentWeight(
+              Segment(kFakeNumMwmId, featureId, segmentIdx, false /* forward */), road,
+              Purpose::Weight);
+        }
+      }
+
+      Joint::Id const jointId = roadJoints.GetJointId(pointId);
+      if (jointId == Joint::kInvalidId)
+        continue;
+
+      if (prevJoint != Joint::kInvalidId)
+      {
+        edges.push_back({prevJoint, jointId, ToWeight(forwardWeight)});
+        if (twoWay)
+          edges.push_back({jointId, prevJoint, ToWeight(backwardWeight)});
+      }
+
+      prevJoint = jointId;
+      forwardWeight = 0.0;
+      backwardWeight = 0.0;
+    }
+  });
+
+  // Roads are visited in the hash map order.
+  sort(m_samples.begin(), m_samples.end(),
+       [](Sample const & l, Sample const & r) { return l.m_featureId < r.m_featureId; });
+  if (m_samples.size() > kSamplesCount)
+    m_samples.resize(kSamplesCount);
+
+  m_hierarchy = ContractionHierarchy::Build(graph.GetNumJoints(), edges);
+}
+
+bool JointHierarchy::IsCompatible(WorldGraph & graph, NumMwmId mwmId) const
+{
+  if (m_hierarchy.GetNumVertices() != graph.GetIndexGraph(mwmId).GetNumJoints())
+    return false;
+
+  return all_of(m_samples.cbegin(), m_samples.cend(), [&](Sample const & sample) {
+    Segment const segment(mwmId, sample.m_featureId, sample.m_segmentIdx, sample.m_forward);
+    double const weight =
+        graph.CalcSegmentWeight(segment, EdgeEstimator::Purpose::Weight).GetWeight();
+    return ToWeight(weight) >= sample.m_weight;
+  });
+}
+
+// JointPotentials ---------------------------------------------------------------------------------
+namespace
+{
+map<RoadPoint, double> GetSeeds(set<Segment> const & endings, NumMwmId mwmId,
+                                JointPotentials::Borders const & borders)
+{
+  map<RoadPoint, double> seeds = borders;
+  // Real path to a fake ending leaves the real graph at one of the ending segment's points.
+  for (auto const & segment : endings)
+  {
+    if (segment.GetMwmId() != mwmId)
+      continue;
+    seeds[segment.GetRoadPoint(false /* front */)] = 0.0;
+    seeds[segment.GetRoadPoint(true /* front */)] = 0.0;
+  }
+  return seeds;
+}
+}  // namespace
+
+JointPotentials::JointPotentials(JointHierarchy const & hierarchy, WorldGraph & graph,
+                                 NumMwmId mwmId, set<Segment> const & endings, bool toEndings,
+                                 Borders const & borders)
+  : m_graph(graph)
+  , m_indexGraph(graph.GetIndexGraph(mwmId))
+  , m_mwmId(mwmId)
+  , m_toEndings(toEndings)
+  , m_seeds(GetSeeds(endings, mwmId, borders))
+  , m_potentials(hierarchy.GetHierarchy(), CollectJointSeeds(), toEndings)
+{
+}
+
+vector<ContractionHierarchy::Seed> JointPotentials::CollectJointSeeds()
+{
+  vector<ContractionHierarchy::Seed> seeds;
+  for (auto const & [point, weight] : m_seeds)
+  {
+    Joint::Id const jointId = m_indexGraph.GetJointId(point);
+    if (jointId != Joint::kInvalidId)
+    {
+      seeds.push_back({jointId, JointHierarchy::ToWeight(weight)});
+      continue;
+    }
+
+    // Joints the seed point is reachable from (or reachable from the seed point).
+    Walk(point, !m_toEndings /* outgoing */,
+         [&, weight = weight](Joint::Id jointId, double seconds) {
+           seeds.push_back({jointId, JointHierarchy::ToWeight(weight + seconds)});
+         },
+         [](double /* seconds */, double /* weight */) {});
+  }
+  return seeds;
+}
+
+double JointPotentials::Get(RoadPoint const & point)
+{
+  if (auto const it = m_cache.find(point); it != m_cache.cend())
+    return it->second;
+
+  double potential = kUnreachable;
+  auto const onJoint = [&](Joint::Id jointId, double seconds) {
+    auto const distance = m_potentials.Get(jointId);
+    if (distance != ContractionHierarchy::kInfiniteDistance)
+      potential = min(potential, seconds + JointHierarchy::ToSeconds(distance));
+  };
+
+  if (auto const it = m_seeds.find(point); it != m_seeds.cend())
+    potential = it->second;
+
+  if (Joint::Id const jointId = m_indexGraph.GetJointId(point); jointId != Joint::kInvalidId)
+  {
+    onJoint(jointId, 0.0 /* seconds */);
+  }
+  else
+  {
+    Walk(point, m_toEndings /* outgoing */, onJoint,
+         [&](double seconds, double weight) { potential = min(potential, seconds + weight); });
+  }
+
+  m_cache.emplace(point, potential);
+  return potential;
+}
+
+template <typename JointFn, typename SeedFn>
+void JointPotentials::Walk(RoadPoint const & point, bool outgoing, JointFn && onJoint,
+                           SeedFn && onSeed)
+{
+  uint32_t const featureId = point.GetFeatureId();
+  RoadGeometry const & road = m_indexGraph.GetRoadGeometry(featureId);
+  uint32_t const pointsCount = road.GetPointsCount();
+
+  for (bool const increasing : {true, false})
+  {
+    // Moving from |point| to higher point ids means going forward along outgoing edges and
+    // backward along ingoing ones.
+    bool const forward = increasing == outgoing;
+    if (!forward && road.IsOneWay())
+      continue;
+
+    double seconds = 0.0;
+    uint32_t pointId = point.GetPointId();
+    while (increasing ? pointId + 1 < pointsCount : pointId > 0)
+    {
+      uint32_t const segmentIdx = increasing ? pointId : pointId - 1;
+      pointId = increasing ? pointId + 1 : pointId - 1;
+
+      seconds += m_graph.CalcSegmentWeight(Segment(m_mwmId, featureId, segmentIdx, forward),
+                                           EdgeEstimator::Purpose::Weight).GetWeight();
+
+      RoadPoint const next(featureId, pointId);
+      if (auto const it = m_seeds.find(next); it != m_seeds.cend())
+        onSeed(seconds, it->second);
+
+      Joint::Id const jointId = m_indexGraph.GetJointId(next);
+      if (jointId != Joint::kInvalidId)
+      {
+        onJoint(jointId, seconds);
+        break;
+      }
+    }
+  }
+}
+
+bool ReadJointHierarchyFromMwm(MwmValue const & mwmValue, JointHierarchy & hierarchy)
+{
+  if (!mwmValue.m_cont.IsExist(CH_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(CH_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    hierarchy.Deserialize(src);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading", CH_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+// JointHierarchyCache -----------------------------------------------------------------------------
+JointHierarchyCache::JointHierarchyCache(DataSource & dataSource,
+                                         shared_ptr<NumMwmIds> numMwmIds)
+  : m_dataSource(dataSource), m_numMwmIds(std::move(numMwmIds))
+{
+  CHECK(m_numMwmIds, ());
+  m_dataSource.AddObserver(*this);
+}
+
+JointHierarchyCache::~JointHierarchyCache() { m_dataSource.RemoveObserver(*this); }
+
+JointHierarchy const * JointHierarchyCache::Get(NumMwmId numMwmId, int64_t version,
+                                                LoadFn const & load)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto const it = m_entries.find(numMwmId);
+    if (it != m_entries.cend() && it->second.m_version == version)
+      return it->second.m_hierarchy.get();
+  }
+
+  // The section is read without the lock to keep observer methods fast.
+  Entry entry;
+  entry.m_version = version;
+  entry.m_hierarchy = load();
+
+  lock_guard<mutex> lock(m_mutex);
+  auto & cached = m_entries[numMwmId];
+  cached = std::move(entry);
+  return cached.m_hierarchy.get();
+}
+
+void JointHierarchyCache::OnMapDeregistered(platform::LocalCountryFile const & localFile)
+{
+  auto const & countryFile = localFile.GetCountryFile();
+  if (!m_numMwmIds->ContainsFile(countryFile))
+    return;
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_entries.find(m_numMwmIds->GetId(countryFile));
+  // An older version may be deregistered after the updated one is cached.
+  if (it != m_entries.end() && it->second.m_version == localFile.GetVersion())
+    m_entries.erase(it);
+}
+}  // namespace routing
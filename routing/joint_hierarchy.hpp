@@ -0,0 +1,189 @@
+#pragma once
+
+#include "routing/contraction_hierarchy.hpp"
+#include "routing/road_point.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class DataSource;
+class MwmValue;
+
+namespace routing
+{
+class EdgeEstimator;
+class IndexGraph;
+class WorldGraph;
+
+/// \brief Contraction hierarchy over the joints of an mwm car index graph (CH_FILE_TAG section).
+/// The hierarchy edges connect consecutive joints of every road in all the allowed directions,
+/// so the hierarchy distances are lower bounds of the route weights: turn restrictions, penalties,
+/// road access and traffic may only make routes longer.
+class JointHierarchy
+{
+public:
+  using Weight = ContractionHierarchy::Weight;
+  using Distance = ContractionHierarchy::Distance;
+
+  enum class Version : uint16_t
+  {
+    V0 = 0
+  };
+
+  // Segment weight used in preprocessing. It's used to check that the section was built with
+  // the same vehicle model as the one the router has.
+  struct Sample
+  {
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = 0;
+    bool m_forward = true;
+    Weight m_weight = 0;
+  };
+
+  // Weights are stored in milliseconds rounded down.
+  static Weight ToWeight(double seconds);
+  static double ToSeconds(Distance distance);
+
+  void Build(IndexGraph const & graph, EdgeEstimator const & estimator);
+
+  ContractionHierarchy const & GetHierarchy() const { return m_hierarchy; }
+  std::vector<Sample> const & GetSamples() const { return m_samples; }
+
+  /// \returns true if weights of sample segments in |graph| are not less than the weights used
+  /// in preprocessing.
+  bool IsCompatible(WorldGraph & graph, NumMwmId mwmId) const;
+
+  template <class Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, static_cast<uint16_t>(Version::V0));
+    WriteVarUint(sink, static_cast<uint32_t>(m_samples.size()));
+    for (auto const & sample : m_samples)
+    {
+      WriteVarUint(sink, sample.m_featureId);
+      WriteVarUint(sink, sample.m_segmentIdx);
+      WriteToSink(sink, static_cast<uint8_t>(sample.m_forward ? 1 : 0));
+      WriteVarUint(sink, sample.m_weight);
+    }
+    m_hierarchy.Serialize(sink);
+  }
+
+  template <class Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, static_cast<uint16_t>(Version::V0), ());
+
+    m_samples.resize(ReadVarUint<uint32_t>(src));
+    for (auto & sample : m_samples)
+    {
+      sample.m_featureId = ReadVarUint<uint32_t>(src);
+      sample.m_segmentIdx = ReadVarUint<uint32_t>(src);
+      sample.m_forward = ReadPrimitiveFromSource<uint8_t>(src) != 0;
+      sample.m_weight = ReadVarUint<Weight>(src);
+    }
+    m_hierarchy.Deserialize(src);
+  }
+
+private:
+  ContractionHierarchy m_hierarchy;
+  std::vector<Sample> m_samples;
+};
+
+/// \brief A* potentials of IndexGraphStarter vertices of one mwm: lower bounds of the weight from
+/// a road point to the finish (or from the start to a road point) in seconds. The potentials are
+/// exact distances in the relaxed graph of |hierarchy| to the nearest seed plus the seed's weight,
+/// so they are consistent. Seeds are the ending points with zero weight and the border points
+/// with lower bounds of the weight outside the mwm, so routes through other mwms are not missed.
+class JointPotentials
+{
+public:
+  // Potential of points which can't reach the ending. It's finite to keep reduced weights finite.
+  static double constexpr kUnreachable = 1.0E10;
+
+  // Points where routes leave (or enter) the mwm and lower bounds of the weight between them
+  // and the ending outside the mwm in seconds.
+  using Borders = std::map<RoadPoint, double>;
+
+  /// \param endings real segments connected with the fake start or finish.
+  /// \param toEndings true for distances to the finish, false for distances from the start.
+  JointPotentials(JointHierarchy const & hierarchy, WorldGraph & graph, NumMwmId mwmId,
+                  std::set<Segment> const & endings, bool toEndings, Borders const & borders = {});
+
+  NumMwmId GetMwmId() const { return m_mwmId; }
+  double Get(RoadPoint const & point);
+
+  size_t GetSettledCount() const { return m_potentials.GetSettledCount(); }
+
+private:
+  std::vector<ContractionHierarchy::Seed> CollectJointSeeds();
+
+  // Walks along the road from |point| to the nearest joint in both directions and calls
+  // |onJoint(jointId, seconds)| for the joints and |onSeed(seconds, weight)| for the seeds on
+  // the way. |outgoing| is true to follow the vehicle direction and false to go against it.
+  template <typename JointFn, typename SeedFn>
+  void Walk(RoadPoint const & point, bool outgoing, JointFn && onJoint, SeedFn && onSeed);
+
+  WorldGraph & m_graph;
+  IndexGraph & m_indexGraph;
+  NumMwmId m_mwmId;
+  bool m_toEndings;
+  // Seed points and their weights in seconds.
+  std::map<RoadPoint, double> m_seeds;
+  ContractionHierarchy::Potentials m_potentials;
+  std::unordered_map<RoadPoint, double, RoadPoint::Hash> m_cache;
+};
+
+/// \returns false if there is no CH_FILE_TAG section in the mwm.
+bool ReadJointHierarchyFromMwm(MwmValue const & mwmValue, JointHierarchy & hierarchy);
+
+/// \brief Loaded hierarchies of mwms which are kept between routes. An entry is dropped when
+/// its mwm version is deregistered and is replaced when the mwm is updated.
+/// Get() should be called from one thread, observer methods may be called from any thread.
+class JointHierarchyCache : public MwmSet::Observer
+{
+public:
+  // Returns nullptr if there is no usable hierarchy in the mwm.
+  using LoadFn = std::function<std::unique_ptr<JointHierarchy>()>;
+
+  JointHierarchyCache(DataSource & dataSource, std::shared_ptr<NumMwmIds> numMwmIds);
+  ~JointHierarchyCache() override;
+
+  /// \returns the hierarchy of |version| of the mwm, it's loaded with |load| if it isn't cached.
+  /// The hierarchy stays valid while a handle of the mwm version is held.
+  JointHierarchy const * Get(NumMwmId numMwmId, int64_t version, LoadFn const & load);
+
+  // MwmSet::Observer overrides:
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  struct Entry
+  {
+    int64_t m_version = 0;
+    std::unique_ptr<JointHierarchy> m_hierarchy;
+  };
+
+  DataSource & m_dataSource;
+  std::shared_ptr<NumMwmIds> m_numMwmIds;
+
+  std::mutex m_mutex;
+  std::unordered_map<NumMwmId, Entry> m_entries;
+};
+}  // namespace routing
@@ -0,0 +1,174 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/latlon_with_altitude.hpp"
+
+#include "base/assert.hpp"
+
+#include <array>
+#include <sstream>
+#include <utility>
+
+namespace routing
+{
+namespace
+{
+// Approximate overhead of a hash map node, a list node and a shared_ptr control block.
+size_t constexpr kItemOverheadBytes = 128;
+
+struct SharedCaches
+{
+  std::mutex m_mutex;
+  size_t m_memoryLimit = 0;
+  // Indexed by vehicle type and by load altitudes flag.
+  std::array<std::array<std::shared_ptr<RoadGeometryCache>, 2>, static_cast<size_t>(VehicleType::Count)> m_caches;
+};
+
+SharedCaches & GetSharedCaches()
+{
+  static SharedCaches caches;
+  return caches;
+}
+}  // namespace
+
+RoadGeometryCache::RoadGeometryCache(size_t memoryLimitBytes, size_t shardsCount)
+  : m_shardMemoryLimit(memoryLimitBytes / shardsCount), m_shards(shardsCount)
+{
+  CHECK_GREATER(shardsCount, 0, ());
+}
+
+RoadGeometryCache::RoadPtrT RoadGeometryCache::Find(NumMwmId mwmId, int64_t mwmVersion,
+                                                    uint32_t featureId)
+{
+  Key const key{mwmId, mwmVersion, featureId};
+  Shard & shard = GetShard(key);
+
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  auto const it = shard.m_items.find(key);
+  if (it == shard.m_items.end())
+  {
+    ++m_misses;
+    return nullptr;
+  }
+
+  ++m_hits;
+  shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second.m_lruIt);
+  return it->second.m_road;
+}
+
+void RoadGeometryCache::Insert(NumMwmId mwmId, int64_t mwmVersion, uint32_t featureId,
+                               RoadPtrT const & road)
+{
+  CHECK(road, ());
+
+  Key const key{mwmId, mwmVersion, featureId};
+  Shard & shard = GetShard(key);
+  size_t const memorySize = GetMemorySize(*road);
+
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  // The road may be loaded by several threads at once. The first one is kept.
+  if (shard.m_items.count(key) != 0 || memorySize > m_shardMemoryLimit)
+    return;
+
+  while (shard.m_memorySize + memorySize > m_shardMemoryLimit)
+  {
+    CHECK(!shard.m_lru.empty(), ());
+    auto const it = shard.m_items.find(shard.m_lru.back());
+    CHECK(it != shard.m_items.end(), ());
+    shard.m_memorySize -= it->second.m_memorySize;
+    shard.m_items.erase(it);
+    shard.m_lru.pop_back();
+    ++m_evictions;
+  }
+
+  shard.m_lru.push_front(key);
+  shard.m_items.emplace(key, Item{road, memorySize, shard.m_lru.begin()});
+  shard.m_memorySize += memorySize;
+}
+
+void RoadGeometryCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    shard.m_lru.clear();
+    shard.m_items.clear();
+    shard.m_memorySize = 0;
+  }
+}
+
+RoadGeometryCache::Stats RoadGeometryCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    stats.m_roadsCount += shard.m_items.size();
+    stats.m_memoryBytes += shard.m_memorySize;
+  }
+  return stats;
+}
+
+// static
+void RoadGeometryCache::SetSharedMemoryLimit(size_t memoryLimitBytes)
+{
+  auto & shared = GetSharedCaches();
+  std::lock_guard<std::mutex> guard(shared.m_mutex);
+  shared.m_memoryLimit = memoryLimitBytes;
+  for (auto & caches : shared.m_caches)
+  {
+    for (auto & cache : caches)
+      cache.reset();
+  }
+}
+
+// static
+std::shared_ptr<RoadGeometryCache> RoadGeometryCache::GetShared(VehicleType vehicleType,
+                                                                bool loadAltitudes)
+{
+  CHECK_LESS(vehicleType, VehicleType::Count, ());
+
+  auto & shared = GetSharedCaches();
+  std::lock_guard<std::mutex> guard(shared.m_mutex);
+  if (shared.m_memoryLimit == 0)
+    return nullptr;
+
+  auto & cache = shared.m_caches[static_cast<size_t>(vehicleType)][loadAltitudes ? 1 : 0];
+  if (!cache)
+    cache = std::make_shared<RoadGeometryCache>(shared.m_memoryLimit);
+  return cache;
+}
+
+// static
+size_t RoadGeometryCache::GetMemorySize(RoadGeometry const & road)
+{
+  size_t const pointsCount = road.GetPointsCount();
+  return sizeof(RoadGeometry) + kItemOverheadBytes + pointsCount * sizeof(LatLonWithAltitude) +
+         (pointsCount > 0 ? pointsCount - 1 : 0) * sizeof(double);
+}
+
+RoadGeometryCache::Shard & RoadGeometryCache::GetShard(Key const & key)
+{
+  // Neighbouring features of the same mwm should get to different shards.
+  uint64_t const hash = KeyHash()(key) * 0x9E3779B97F4A7C15ULL;
+  return m_shards[(hash >> 32) % m_shards.size()];
+}
+
+size_t RoadGeometryCache::KeyHash::operator()(Key const & key) const
+{
+  uint64_t const mwmHash = (static_cast<uint64_t>(key.m_mwmId) << 32) | key.m_featureId;
+  return static_cast<size_t>(mwmHash ^ (static_cast<uint64_t>(key.m_mwmVersion) << 48));
+}
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats)
+{
+  std::ostringstream out;
+  out << "RoadGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", evictions: " << stats.m_evictions << ", roads: " << stats.m_roadsCount
+      << ", memory bytes: " << stats.m_memoryBytes << " ]";
+  return out.str();
+}
+}  // namespace routing
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "routing/vehicle_mask.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+class RoadGeometry;
+
+/// \brief Process-wide cache of road geometry which may be shared by Geometry instances of
+/// several routers working in parallel.
+/// \note Roads are keyed by (NumMwmId, mwm version, featureId), so all users of the same cache
+/// should use the same NumMwmIds numeration. The roads of an updated mwm are not mixed up with
+/// the roads of its previous version, which are evicted as the least recently used ones.
+/// \note The cache is split into shards. Every shard has its own lock and its own LRU list.
+/// The size of the cache is limited by approximate memory usage of the roads, not by
+/// their count.
+class RoadGeometryCache final
+{
+public:
+  using RoadPtrT = std::shared_ptr<RoadGeometry const>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_roadsCount = 0;
+    size_t m_memoryBytes = 0;
+  };
+
+  static size_t constexpr kDefaultShardsCount = 64;
+
+  /// \param memoryLimitBytes Approximate memory limit for all the cached roads.
+  explicit RoadGeometryCache(size_t memoryLimitBytes, size_t shardsCount = kDefaultShardsCount);
+
+  /// \returns the cached road or nullptr if there is no road for |featureId| in the cache.
+  RoadPtrT Find(NumMwmId mwmId, int64_t mwmVersion, uint32_t featureId);
+
+  /// \brief Puts |road| to the cache. The road is read by several threads after that, so all its
+  /// lazily calculated fields should be calculated before, see RoadGeometry::GetRoadLengthM().
+  void Insert(NumMwmId mwmId, int64_t mwmVersion, uint32_t featureId, RoadPtrT const & road);
+
+  void Clear();
+
+  Stats GetStats() const;
+  size_t GetMemoryLimit() const { return m_shardMemoryLimit * m_shards.size(); }
+
+  /// \brief Enables the process-wide caches returned by GetShared() with |memoryLimitBytes|
+  /// memory limit for every of them. Zero disables the caches.
+  /// \note Geometry instances which are already created are not affected.
+  static void SetSharedMemoryLimit(size_t memoryLimitBytes);
+
+  /// \returns the process-wide cache for the roads of |vehicleType|
+  /// or nullptr if the shared caches are disabled, which is the default.
+  static std::shared_ptr<RoadGeometryCache> GetShared(VehicleType vehicleType, bool loadAltitudes);
+
+  /// \returns approximate number of bytes used by |road|.
+  static size_t GetMemorySize(RoadGeometry const & road);
+
+private:
+  struct Key
+  {
+    bool operator==(Key const & rhs) const
+    {
+      return m_featureId == rhs.m_featureId && m_mwmId == rhs.m_mwmId &&
+             m_mwmVersion == rhs.m_mwmVersion;
+    }
+
+    NumMwmId m_mwmId = kFakeNumMwmId;
+    int64_t m_mwmVersion = 0;
+    uint32_t m_featureId = 0;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  struct Item
+  {
+    RoadPtrT m_road;
+    size_t m_memorySize = 0;
+    std::list<Key>::iterator m_lruIt;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m_mutex;
+    // The most recently used keys are at the front.
+    std::list<Key> m_lru;
+    std::unordered_map<Key, Item, KeyHash> m_items;
+    size_t m_memorySize = 0;
+  };
+
+  Shard & GetShard(Key const & key);
+
+  size_t const m_shardMemoryLimit;
+  std::vector<Shard> m_shards;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+};
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats);
+}  // namespace routing
@@ -95,9 +95,15 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
 {
   CHECK_GREATER(threadsNumber, 0, ());
   LOG(LINFO, ("Threads number:", threadsNumber));
-  CHECK(m_cig, ());
   CHECK(m_cpg, ());
 
+  // Countries of route points are looked up by all the threads, so they use the point index
+  // instead of the regions cache with its lock.
+  auto cig = storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(cig, ());
+  cig->LoadPointIndex();
+  m_cig = std::move(cig);
+
   classificator::Load();
   std::vector<platform::LocalCountryFile> localFiles;
   platform::FindAllLocalMapsAndCleanup(std::numeric_limits<int64_t>::max(), localFiles);
@@ -142,6 +148,19 @@ std::future<RoutesBuilder::Result> RoutesBuilder::ProcessTaskAsync(Params const
   return m_threadPool.Submit(std::move(processor), params);
 }
 
+RoutesBuilder::MatrixResult RoutesBuilder::ProcessMatrixTask(MatrixParams const & params)
+{
+  Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
+  return processor(params);
+}
+
+std::future<RoutesBuilder::MatrixResult>
+RoutesBuilder::ProcessMatrixTaskAsync(MatrixParams const & params)
+{
+  Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
+  return m_threadPool.Submit(std::move(processor), params);
+}
+
 // RoutesBuilder::Result ---------------------------------------------------------------------------
 
 // static
@@ -326,5 +345,37 @@ RoutesBuilder::Processor::operator()(Params const & params)
 
   return result;
 }
+
+RoutesBuilder::MatrixResult
+RoutesBuilder::Processor::operator()(MatrixParams const & params)
+{
+  InitRouter(params.m_type);
+  SCOPE_GUARD(returnDataSource, [&]() {
+    m_dataSourceStorage.PushDataSource(std::move(m_dataSource));
+  });
+
+  LOG(LINFO, ("Start building route matrix, sources:", params.m_sources.size(),
+              "targets:", params.m_targets.size()));
+
+  CHECK(m_dataSource, ());
+
+  MatrixResult result;
+  double timeSum = 0.0;
+  for (size_t i = 0; i < params.m_launchesNumber; ++i)
+  {
+    m_delegate->SetTimeout(params.m_timeoutSeconds);
+    base::Timer timer;
+    result.m_code = m_router->CalculateRouteMatrix(params.m_sources, params.m_targets,
+                                                   params.m_limits, *m_delegate, result.m_matrix);
+
+    if (result.m_code != RouterResultCode::NoError)
+      break;
+
+    timeSum += timer.ElapsedSeconds();
+  }
+
+  result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
+  return result;
+}
 }  // namespace routes_builder
 }  // namespace routing
@@ -95,9 +95,29 @@ public:
     double m_buildTimeSeconds = 0.0;
   };
 
+  struct MatrixParams
+  {
+    VehicleType m_type = VehicleType::Car;
+    std::vector<m2::PointD> m_sources;
+    std::vector<m2::PointD> m_targets;
+    IndexRouter::MatrixLimits m_limits;
+    uint32_t m_timeoutSeconds = RouterDelegate::kNoTimeout;
+    uint32_t m_launchesNumber = 1;
+  };
+
+  struct MatrixResult
+  {
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    IndexRouter::RouteMatrix m_matrix;
+    double m_buildTimeSeconds = 0.0;
+  };
+
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
+  MatrixResult ProcessMatrixTask(MatrixParams const & params);
+  std::future<MatrixResult> ProcessMatrixTaskAsync(MatrixParams const & params);
+
 private:
 
   class Processor
@@ -111,6 +131,7 @@ private:
     Processor(Processor && rhs) noexcept;
 
     Result operator()(Params const & params);
+    MatrixResult operator()(MatrixParams const & params);
 
   private:
     void InitRouter(VehicleType type);
@@ -134,8 +155,7 @@ private:
   std::shared_ptr<storage::CountryParentGetter> m_cpg =
       std::make_shared<storage::CountryParentGetter>();
 
-  std::shared_ptr<storage::CountryInfoGetter> m_cig =
-      storage::CountryInfoReader::CreateCountryInfoGetter(GetPlatform());
+  std::shared_ptr<storage::CountryInfoGetter> m_cig;
 
   std::shared_ptr<NumMwmIds> m_numMwmIds = std::make_shared<NumMwmIds>();
 
@@ -22,6 +22,15 @@ DEFINE_string(routes_file, "", "Path to file with routes in format: \n\t"
                                "second_start_lat second_start_lon second_finish_lat second_finish_lon\n\t"
                                "...");
 
+DEFINE_string(matrix_sources, "", "Path to file with sources of a route matrix in format: \n\t"
+                                   "first_lat first_lon\n\t"
+                                   "second_lat second_lon\n\t"
+                                   "...\n\t"
+                                   "Route matrix mode is used instead of --routes_file if it's set.");
+
+DEFINE_string(matrix_targets, "", "Path to file with targets of a route matrix in the same format "
+                                  "as --matrix_sources.");
+
 DEFINE_string(dump_path, "", "Path where routes will be dumped after building."
                              "Useful for intermediate results, because routes building "
                              "is a long process.");
@@ -53,6 +62,11 @@ bool IsLocalBuild()
   return !FLAGS_routes_file.empty() && FLAGS_api_name.empty() && FLAGS_api_token.empty();
 }
 
+bool IsMatrixBuild()
+{
+  return !FLAGS_matrix_sources.empty() && !FLAGS_matrix_targets.empty();
+}
+
 bool IsApiBuild()
 {
   return !FLAGS_routes_file.empty() && !FLAGS_api_name.empty() && !FLAGS_api_token.empty();
@@ -71,8 +85,8 @@ int Main(int argc, char ** argv)
 
   CHECK_GREATER_OR_EQUAL(FLAGS_timeout, 0, ("Timeout should be greater than zero."));
 
-  CHECK(!FLAGS_routes_file.empty(),
-        ("\n\n\t--routes_file is required.",
+  CHECK(!FLAGS_routes_file.empty() || IsMatrixBuild(),
+        ("\n\n\t--routes_file or --matrix_sources with --matrix_targets are required.",
          "\n\nType --help for usage."));
 
   if (!FLAGS_data_path.empty())
@@ -81,7 +95,7 @@ int Main(int argc, char ** argv)
   if (!FLAGS_resources_path.empty())
     GetPlatform().SetResourceDir(FLAGS_resources_path);
 
-  CHECK(IsLocalBuild() || IsApiBuild(),
+  CHECK(IsMatrixBuild() || IsLocalBuild() || IsApiBuild(),
         ("\n\n\t--routes_file empty is:", FLAGS_routes_file.empty(),
          "\n\t--api_name empty is:", FLAGS_api_name.empty(),
          "\n\t--api_token empty is:", FLAGS_api_token.empty(),
@@ -98,6 +112,14 @@ int Main(int argc, char ** argv)
   else
     CHECK_EQUAL(Platform::MkDir(FLAGS_dump_path), Platform::EError::ERR_OK,());
 
+  if (IsMatrixBuild())
+  {
+    BuildRouteMatrix(FLAGS_matrix_sources, FLAGS_matrix_targets, FLAGS_dump_path, FLAGS_threads,
+                     FLAGS_timeout, FLAGS_vehicle_type, FLAGS_verbose,
+                     static_cast<uint32_t>(FLAGS_launches_number));
+    return 0;
+  }
+
   if (IsLocalBuild())
   {
     auto const launchesNumber = static_cast<uint32_t>(FLAGS_launches_number);
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <optional>
@@ -61,6 +62,28 @@ routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
   CHECK(false, ("Unknown vehicle type:", str));
   UNREACHABLE();
 }
+
+uint64_t GetThreadsNumber(uint64_t threadsNumber)
+{
+  if (threadsNumber)
+    return threadsNumber;
+
+  auto const hardwareConcurrency = std::thread::hardware_concurrency();
+  return hardwareConcurrency > 0 ? hardwareConcurrency : 2;
+}
+
+std::vector<m2::PointD> LoadPoints(std::string const & filename)
+{
+  std::ifstream input(filename);
+  CHECK(input.good(), ("Error during opening:", filename));
+
+  std::vector<m2::PointD> points;
+  ms::LatLon point;
+  while (input >> point.m_lat >> point.m_lon)
+    points.emplace_back(mercator::FromLatLon(point));
+
+  return points;
+}
 }  // namespace
 
 void BuildRoutes(std::string const & routesPath,
@@ -78,13 +101,7 @@ void BuildRoutes(std::string const & routesPath,
   std::ifstream input(routesPath);
   CHECK(input.good(), ("Error during opening:", routesPath));
 
-  if (!threadsNumber)
-  {
-    auto const hardwareConcurrency = std::thread::hardware_concurrency();
-    threadsNumber = hardwareConcurrency > 0 ? hardwareConcurrency : 2;
-  }
-
-  RoutesBuilder routesBuilder(threadsNumber);
+  RoutesBuilder routesBuilder(GetThreadsNumber(threadsNumber));
 
   std::vector<std::future<RoutesBuilder::Result>> tasks;
   double lastPercent = 0.0;
@@ -145,6 +162,82 @@ void BuildRoutes(std::string const & routesPath,
   }
 }
 
+void BuildRouteMatrix(std::string const & sourcesPath,
+                      std::string const & targetsPath,
+                      std::string const & dumpPath,
+                      uint64_t threadsNumber,
+                      uint32_t timeoutSeconds,
+                      std::string const & vehicleTypeStr,
+                      bool verbose,
+                      uint32_t launchesNumber)
+{
+  auto const sources = LoadPoints(sourcesPath);
+  auto const targets = LoadPoints(targetsPath);
+  CHECK(!sources.empty() && !targets.empty(), (sourcesPath, targetsPath));
+
+  threadsNumber = GetThreadsNumber(threadsNumber);
+  RoutesBuilder routesBuilder(threadsNumber);
+
+  RoutesBuilder::MatrixParams params;
+  params.m_type = ConvertVehicleTypeFromString(vehicleTypeStr);
+  params.m_targets = targets;
+  params.m_timeoutSeconds = timeoutSeconds;
+  params.m_launchesNumber = launchesNumber;
+
+  // Every task calculates a block of rows.
+  size_t const rowsPerTask = (sources.size() + threadsNumber - 1) / threadsNumber;
+  std::vector<std::future<RoutesBuilder::MatrixResult>> tasks;
+  base::Timer timer;
+  {
+    base::ScopedLogLevelChanger changer(verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+    for (size_t begin = 0; begin < sources.size(); begin += rowsPerTask)
+    {
+      auto const end = std::min(begin + rowsPerTask, sources.size());
+      params.m_sources.assign(sources.begin() + begin, sources.begin() + end);
+      tasks.emplace_back(routesBuilder.ProcessMatrixTaskAsync(params));
+    }
+
+    for (auto & task : tasks)
+      task.wait();
+  }
+
+  double const elapsedSeconds = timer.ElapsedSeconds();
+  size_t const cellsNumber = sources.size() * targets.size();
+  LOG_FORCE(LINFO, ("Route matrix", sources.size(), "x", targets.size(), "vehicle type:",
+                    params.m_type, "took:", elapsedSeconds, "seconds,",
+                    cellsNumber / elapsedSeconds / launchesNumber, "cells per second."));
+
+  std::string const fullPath = base::JoinPath(dumpPath, "matrix.csv");
+  std::ofstream output(fullPath);
+  CHECK(output.good(), ("Error during opening:", fullPath));
+  output << "source,target,code,weight,eta,limit_exceeded\n";
+
+  size_t sourceIdx = 0;
+  size_t foundNumber = 0;
+  for (auto & task : tasks)
+  {
+    auto const result = task.get();
+    if (result.m_code != RouterResultCode::NoError)
+      LOG_FORCE(LWARNING, ("Route matrix rows from", sourceIdx, "are not built:", result.m_code));
+
+    for (auto const & row : result.m_matrix)
+    {
+      for (size_t targetIdx = 0; targetIdx < row.size(); ++targetIdx)
+      {
+        auto const & cell = row[targetIdx];
+        if (cell.m_code == RouterResultCode::NoError)
+          ++foundNumber;
+
+        output << sourceIdx << "," << targetIdx << "," << static_cast<int>(cell.m_code) << ","
+               << cell.m_weight << "," << cell.m_etaSec << "," << cell.m_isLimitExceeded << "\n";
+      }
+      ++sourceIdx;
+    }
+  }
+
+  LOG_FORCE(LINFO, ("Routes found:", foundNumber, "of", cellsNumber, "Matrix is saved to:", fullPath));
+}
+
 std::optional<std::tuple<ms::LatLon, ms::LatLon, int32_t>> ParseApiLine(std::ifstream & input)
 {
   std::string line;
@@ -22,6 +22,18 @@ void BuildRoutes(std::string const & routesPath,
                  bool verbose,
                  uint32_t launchesNumber);
 
+/// \brief Calculates a route matrix from points of |sourcesPath| to points of |targetsPath|
+/// (one "lat lon" pair per line) and saves it to |dumpPath| in csv format.
+/// Sources are split between |threadsNumber| threads.
+void BuildRouteMatrix(std::string const & sourcesPath,
+                      std::string const & targetsPath,
+                      std::string const & dumpPath,
+                      uint64_t threadsNumber,
+                      uint32_t timeoutSeconds,
+                      std::string const & vehicleType,
+                      bool verbose,
+                      uint32_t launchesNumber);
+
 void BuildRoutesWithApi(std::unique_ptr<routing_quality::api::RoutingApi> routingApi,
                         std::string const & routesPath,
                         std::string const & dumpPath,
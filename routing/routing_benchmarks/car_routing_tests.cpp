@@ -3,13 +3,19 @@
 #include "routing/routing_benchmarks/helpers.hpp"
 
 #include "routing/car_directions.hpp"
+#include "routing/index_router.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/router_delegate.hpp"
 
 #include "routing_common/car_model.hpp"
 
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
 #include <memory>
 #include <set>
 #include <string>
@@ -37,6 +43,46 @@ public:
       TestRouter(*router, startMerc, finalMerc, routeFoundByAstarBidirectional);
   }
 
+  // Compares latency and the number of visited vertices with and without CH_FILE_TAG section
+  // potentials. Routing visitor reports every 40th visited vertex to the point check callback.
+  void TestContractionHierarchy(ms::LatLon const & start, ms::LatLon const & final,
+                                size_t reiterations)
+  {
+    m2::PointD const startMerc = mercator::FromLatLon(start);
+    m2::PointD const finalMerc = mercator::FromLatLon(final);
+
+    double etas[2] = {};
+    for (bool const enabled : {false, true})
+    {
+      auto router = CreateRouter("test-astar-bidirectional");
+      auto * indexRouter = dynamic_cast<routing::IndexRouter *>(router.get());
+      TEST(indexRouter, ());
+      indexRouter->SetContractionHierarchyEnabled(enabled);
+
+      size_t pointChecks = 0;
+      routing::RouterDelegate delegate;
+      delegate.SetPointCheckCallback([&pointChecks](ms::LatLon const &) { ++pointChecks; });
+
+      routing::Route route("", 0 /* route id */);
+      base::Timer timer;
+      for (size_t i = 0; i < reiterations; ++i)
+      {
+        auto const resultCode = router->CalculateRoute(
+            routing::Checkpoints(startMerc, finalMerc), m2::PointD::Zero() /* startDirection */,
+            false /* adjust */, delegate, route);
+        TEST_EQUAL(resultCode, routing::RouterResultCode::NoError, ());
+      }
+
+      LOG(LINFO, ("Contraction hierarchy enabled:", enabled, "average time, seconds:",
+                  timer.ElapsedSeconds() / reiterations, "point checks per route:",
+                  pointChecks / reiterations));
+      etas[enabled ? 1 : 0] = route.GetTotalTimeSec();
+    }
+
+    // Both searches are exact, so only equal weight alternatives may differ.
+    TEST(base::AlmostEqualRel(etas[0], etas[1], 0.01), (etas[0], etas[1]));
+  }
+
 protected:
   std::unique_ptr<routing::VehicleModelFactoryInterface> CreateModelFactory() override
   {
@@ -64,4 +110,10 @@ UNIT_CLASS_TEST(CarTest, InAirport)
 {
   TestCarRouter(ms::LatLon(55.97285, 37.41275), ms::LatLon(55.96396, 37.41922), 30);
 }
+
+// Long route across the city, the mwm should be generated with --make_contraction_hierarchy.
+UNIT_CLASS_TEST(CarTest, ContractionHierarchyAcrossCity)
+{
+  TestContractionHierarchy(ms::LatLon(55.89162, 37.44391), ms::LatLon(55.59353, 37.72683), 10);
+}
 }  // namespace
@@ -1,5 +1,7 @@
 #include "testing/testing.hpp"
 
+#include "routing/index_router.hpp"
+#include "routing/router_delegate.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/routing_options.hpp"
 
@@ -8,6 +10,7 @@
 #include "geometry/mercator.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace route_test
 {
@@ -80,6 +83,77 @@ UNIT_TEST(RussiaUfaToUstKatavTest)
       FromLatLon(54.9228, 58.1469), 164667.);
 }
 
+// Route matrix cells have the same ETAs as the routes between the same points.
+UNIT_TEST(RussiaMoscowRouteMatrix)
+{
+  auto & components = GetVehicleComponents(VehicleType::Car);
+  auto & router = dynamic_cast<IndexRouter &>(components.GetRouter());
+
+  std::vector<m2::PointD> const sources = {FromLatLon(55.75100, 37.61790),
+                                           FromLatLon(55.66216, 37.63259)};
+  std::vector<m2::PointD> const targets = {FromLatLon(55.66237, 37.63560),
+                                           FromLatLon(55.77787, 37.70405),
+                                           FromLatLon(55.70838, 37.53716)};
+
+  RouterDelegate delegate;
+  IndexRouter::RouteMatrix matrix;
+  TEST_EQUAL(router.CalculateRouteMatrix(sources, targets, IndexRouter::MatrixLimits(), delegate,
+                                         matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.size(), sources.size(), ());
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    TEST_EQUAL(matrix[i].size(), targets.size(), ());
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      auto const & cell = matrix[i][j];
+      TEST_EQUAL(cell.m_code, RouterResultCode::NoError, (i, j));
+
+      TRouteResult const routeResult =
+          CalculateRoute(components, sources[i], {0.0, 0.0} /* startDirection */, targets[j]);
+      TEST_EQUAL(routeResult.second, RouterResultCode::NoError, (i, j));
+      TestRouteTime(*routeResult.first, cell.m_etaSec, 0.02 /* relativeError */);
+    }
+  }
+}
+
+// Targets beyond the limits of a route matrix are reported apart from the ones without routes.
+UNIT_TEST(RussiaMoscowRouteMatrixLimits)
+{
+  auto & components = GetVehicleComponents(VehicleType::Car);
+  auto & router = dynamic_cast<IndexRouter &>(components.GetRouter());
+
+  std::vector<m2::PointD> const sources = {FromLatLon(55.75100, 37.61790)};
+  std::vector<m2::PointD> const targets = {FromLatLon(55.66237, 37.63560),
+                                           FromLatLon(55.77787, 37.70405)};
+
+  // Routes are always longer than the straight line estimates at the maximum speed.
+  IndexRouter::MatrixLimits limits;
+  limits.m_weightFactor = 1.0;
+  limits.m_minWeightLimitSec = 0.0;
+
+  RouterDelegate delegate;
+  IndexRouter::RouteMatrix matrix;
+  TEST_EQUAL(router.CalculateRouteMatrix(sources, targets, limits, delegate, matrix),
+             RouterResultCode::NoError, ());
+  for (auto const & cell : matrix.front())
+  {
+    TEST_EQUAL(cell.m_code, RouterResultCode::RouteNotFound, ());
+    TEST(cell.m_isLimitExceeded, ());
+  }
+
+  // Zero factor means no limit.
+  limits.m_weightFactor = 0.0;
+  TEST_EQUAL(router.CalculateRouteMatrix(sources, targets, limits, delegate, matrix),
+             RouterResultCode::NoError, ());
+  for (auto const & cell : matrix.front())
+  {
+    TEST_EQUAL(cell.m_code, RouterResultCode::NoError, ());
+    TEST(!cell.m_isLimitExceeded, ());
+  }
+}
+
 UNIT_TEST(RussiaMoscowNoServiceCrossing)
 {
   CalculateRouteAndTestRouteLength(
@@ -2,8 +2,13 @@
 
 #include "routing/routing_integration_tests/routing_test_tools.hpp"
 
+#include "routing/index_router.hpp"
+#include "routing/router_delegate.hpp"
+
 #include "geometry/mercator.hpp"
 
+#include <vector>
+
 namespace transit_route_test
 {
 using namespace routing;
@@ -180,4 +185,28 @@ UNIT_TEST(Transit_NewYork_GrassmereToPleasantPlains)
   CHECK(routeResult.first, ());
   integration::CheckSubwayExistence(*routeResult.first);
 }
+
+// Route matrix isn't supported for transit, every cell gets an error instead of a crash.
+UNIT_TEST(Transit_RouteMatrixIsNotSupported)
+{
+  auto & router =
+      dynamic_cast<IndexRouter &>(integration::GetVehicleComponents(VehicleType::Transit).GetRouter());
+
+  std::vector<m2::PointD> const sources = {mercator::FromLatLon(55.75018, 37.60971)};
+  std::vector<m2::PointD> const targets = {mercator::FromLatLon(55.67245, 37.86130),
+                                           mercator::FromLatLon(55.74089, 37.62831)};
+
+  RouterDelegate delegate;
+  IndexRouter::RouteMatrix matrix;
+  TEST_EQUAL(router.CalculateRouteMatrix(sources, targets, IndexRouter::MatrixLimits(), delegate,
+                                         matrix),
+             RouterResultCode::InternalError, ());
+  TEST_EQUAL(matrix.size(), sources.size(), ());
+  for (auto const & row : matrix)
+  {
+    TEST_EQUAL(row.size(), targets.size(), ());
+    for (auto const & cell : row)
+      TEST_EQUAL(cell.m_code, RouterResultCode::InternalError, ());
+  }
+}
 } // namespace transit_route_test
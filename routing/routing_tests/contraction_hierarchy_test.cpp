@@ -0,0 +1,213 @@
+#include "testing/testing.hpp"
+
+#include "routing/contraction_hierarchy.hpp"
+#include "routing/joint_hierarchy.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "platform/country_file.hpp"
+#include "platform/local_country_file.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace contraction_hierarchy_test
+{
+using namespace routing;
+using namespace std;
+
+using Distance = ContractionHierarchy::Distance;
+using Edge = ContractionHierarchy::Edge;
+using Seed = ContractionHierarchy::Seed;
+
+vector<Edge> MakeRandomGraph(uint32_t numVertices, size_t numEdges, uint32_t seed)
+{
+  mt19937 rng(seed);
+  uniform_int_distribution<uint32_t> vertex(0, numVertices - 1);
+  uniform_int_distribution<uint32_t> weight(1, 1000);
+
+  vector<Edge> edges;
+  // A grid-like chain to make the graph mostly connected.
+  for (uint32_t v = 0; v + 1 < numVertices; ++v)
+  {
+    edges.push_back({v, v + 1, weight(rng)});
+    if (v % 3 != 0)
+      edges.push_back({v + 1, v, weight(rng)});
+  }
+  while (edges.size() < numEdges)
+    edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+  return edges;
+}
+
+// Plain Dijkstra over |edges| (or over reversed |edges|) from |seeds|.
+vector<Distance> Dijkstra(uint32_t numVertices, vector<Edge> const & edges,
+                          vector<Seed> const & seeds, bool reversed)
+{
+  vector<vector<pair<uint32_t, uint32_t>>> adjacency(numVertices);
+  for (auto const & e : edges)
+  {
+    if (reversed)
+      adjacency[e.m_to].emplace_back(e.m_from, e.m_weight);
+    else
+      adjacency[e.m_from].emplace_back(e.m_to, e.m_weight);
+  }
+
+  vector<Distance> distances(numVertices, ContractionHierarchy::kInfiniteDistance);
+  using State = pair<Distance, uint32_t>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  for (auto const & seed : seeds)
+  {
+    if (seed.m_distance < distances[seed.m_vertex])
+    {
+      distances[seed.m_vertex] = seed.m_distance;
+      queue.emplace(seed.m_distance, seed.m_vertex);
+    }
+  }
+
+  while (!queue.empty())
+  {
+    auto const [d, v] = queue.top();
+    queue.pop();
+    if (d > distances[v])
+      continue;
+    for (auto const & [w, weight] : adjacency[v])
+    {
+      if (d + weight < distances[w])
+      {
+        distances[w] = d + weight;
+        queue.emplace(distances[w], w);
+      }
+    }
+  }
+  return distances;
+}
+
+UNIT_TEST(ContractionHierarchy_FindDistance)
+{
+  uint32_t const numVertices = 300;
+  auto const edges = MakeRandomGraph(numVertices, 900 /* numEdges */, 1 /* seed */);
+  auto const hierarchy = ContractionHierarchy::Build(numVertices, edges);
+
+  for (uint32_t s = 0; s < numVertices; s += 7)
+  {
+    auto const expected = Dijkstra(numVertices, edges, {{s, 0}}, false /* reversed */);
+    for (uint32_t t = 0; t < numVertices; ++t)
+      TEST_EQUAL(hierarchy.FindDistance({{s, 0}}, {{t, 0}}), expected[t], (s, t));
+  }
+}
+
+UNIT_TEST(ContractionHierarchy_SmallWitnessLimit)
+{
+  uint32_t const numVertices = 200;
+  auto const edges = MakeRandomGraph(numVertices, 700 /* numEdges */, 2 /* seed */);
+  auto const exact = ContractionHierarchy::Build(numVertices, edges);
+  auto const coarse = ContractionHierarchy::Build(numVertices, edges, 1 /* witnessSettleLimit */);
+
+  TEST_GREATER_OR_EQUAL(coarse.GetNumEdges(), exact.GetNumEdges(), ());
+  for (uint32_t s = 0; s < numVertices; s += 11)
+  {
+    for (uint32_t t = 0; t < numVertices; t += 3)
+      TEST_EQUAL(coarse.FindDistance({{s, 0}}, {{t, 0}}), exact.FindDistance({{s, 0}}, {{t, 0}}), ());
+  }
+}
+
+UNIT_TEST(ContractionHierarchy_Potentials)
+{
+  uint32_t const numVertices = 300;
+  auto const edges = MakeRandomGraph(numVertices, 800 /* numEdges */, 3 /* seed */);
+  auto const hierarchy = ContractionHierarchy::Build(numVertices, edges);
+
+  vector<Seed> const seeds = {{10, 5}, {150, 0}, {299, 100}};
+  for (bool const toSeeds : {true, false})
+  {
+    auto const expected = Dijkstra(numVertices, edges, seeds, toSeeds /* reversed */);
+    ContractionHierarchy::Potentials potentials(hierarchy, seeds, toSeeds);
+    for (uint32_t v = numVertices; v > 0; --v)
+      TEST_EQUAL(potentials.Get(v - 1), expected[v - 1], (toSeeds, v - 1));
+    TEST_GREATER(potentials.GetSettledCount(), 0, ());
+  }
+}
+
+UNIT_TEST(ContractionHierarchy_Serialization)
+{
+  uint32_t const numVertices = 100;
+  auto const edges = MakeRandomGraph(numVertices, 300 /* numEdges */, 4 /* seed */);
+  auto const hierarchy = ContractionHierarchy::Build(numVertices, edges);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    hierarchy.Serialize(writer);
+  }
+
+  ContractionHierarchy deserialized;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  deserialized.Deserialize(src);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(deserialized.GetNumVertices(), numVertices, ());
+  TEST_EQUAL(deserialized.GetNumEdges(), hierarchy.GetNumEdges(), ());
+  for (uint32_t s = 0; s < numVertices; s += 5)
+  {
+    for (uint32_t t = 0; t < numVertices; t += 5)
+      TEST_EQUAL(deserialized.FindDistance({{s, 0}}, {{t, 0}}), hierarchy.FindDistance({{s, 0}}, {{t, 0}}), ());
+  }
+}
+
+// Hierarchies are kept between routes and are dropped only when their mwm version is gone.
+UNIT_TEST(JointHierarchyCache_Versions)
+{
+  platform::CountryFile const countryFile("Country");
+  auto numMwmIds = make_shared<NumMwmIds>();
+  numMwmIds->RegisterFile(countryFile);
+  NumMwmId const numMwmId = numMwmIds->GetId(countryFile);
+
+  FrozenDataSource dataSource;
+  JointHierarchyCache cache(dataSource, numMwmIds);
+
+  size_t loads = 0;
+  auto const load = [&loads]() {
+    ++loads;
+    return make_unique<JointHierarchy>();
+  };
+
+  auto const * hierarchy = cache.Get(numMwmId, 1 /* version */, load);
+  TEST(hierarchy, ());
+  TEST_EQUAL(cache.Get(numMwmId, 1 /* version */, load), hierarchy, ());
+  TEST_EQUAL(loads, 1, ());
+
+  // The mwm is updated.
+  TEST(cache.Get(numMwmId, 2 /* version */, load), ());
+  TEST_EQUAL(loads, 2, ());
+
+  // The old version is deregistered after the update, the new one stays cached.
+  cache.OnMapDeregistered(platform::LocalCountryFile("dir", countryFile, 1 /* version */));
+  cache.Get(numMwmId, 2 /* version */, load);
+  TEST_EQUAL(loads, 2, ());
+
+  cache.OnMapDeregistered(platform::LocalCountryFile("dir", countryFile, 2 /* version */));
+  cache.Get(numMwmId, 2 /* version */, load);
+  TEST_EQUAL(loads, 3, ());
+
+  // Mwms without a usable section are cached too.
+  cache.OnMapDeregistered(platform::LocalCountryFile("dir", countryFile, 2 /* version */));
+  auto const loadNothing = [&loads]() {
+    ++loads;
+    return unique_ptr<JointHierarchy>();
+  };
+  TEST(!cache.Get(numMwmId, 2 /* version */, loadNothing), ());
+  TEST(!cache.Get(numMwmId, 2 /* version */, loadNothing), ());
+  TEST_EQUAL(loads, 4, ());
+}
+}  // namespace contraction_hierarchy_test
@@ -11,6 +11,7 @@
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_router.hpp"
+#include "routing/joint_hierarchy.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -350,6 +351,249 @@ UNIT_TEST(FindPathManhattan)
   }
 }
 
+// Manhattan-like city with one-way avenues and streets of different speeds. Routes found with
+// contraction hierarchy potentials have the same weights as the routes found without them.
+UNIT_TEST(FindPathManhattanWithJointPotentials)
+{
+  uint32_t constexpr kCitySize = 5;
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      street.emplace_back(static_cast<double>(j), static_cast<double>(i));
+      // Odd avenues go in the opposite direction.
+      uint32_t const y = i % 2 == 0 ? j : kCitySize - 1 - j;
+      avenue.emplace_back(static_cast<double>(i), static_cast<double>(y));
+    }
+    loader->AddRoad(i, false, static_cast<float>(1 + i % 3) /* speed */, street);
+    loader->AddRoad(i + kCitySize, true, 2.0 /* speed */, avenue);
+  }
+
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+
+  vector<Joint> joints;
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      uint32_t const avenuePointId = j % 2 == 0 ? i : kCitySize - 1 - i;
+      joints.emplace_back(MakeJoint({{i, j}, {j + kCitySize, avenuePointId}}));
+    }
+  }
+
+  unique_ptr<WorldGraph> worldGraph = BuildWorldGraph(std::move(loader), estimator, joints);
+
+  JointHierarchy hierarchy;
+  hierarchy.Build(worldGraph->GetIndexGraph(kTestNumMwmId), *estimator);
+  TEST_EQUAL(hierarchy.GetHierarchy().GetNumVertices(), kCitySize * kCitySize, ());
+  TEST(hierarchy.IsCompatible(*worldGraph, kTestNumMwmId), ());
+
+  vector<FakeEnding> endPoints;
+  for (uint32_t featureId = 0; featureId < kCitySize; ++featureId)
+  {
+    for (uint32_t segmentId = 0; segmentId < kCitySize - 1; ++segmentId)
+    {
+      endPoints.push_back(MakeFakeEnding(featureId, segmentId,
+                                         m2::PointD(0.5 + segmentId, featureId), *worldGraph));
+    }
+  }
+
+  for (auto const & start : endPoints)
+  {
+    for (auto const & finish : endPoints)
+    {
+      if (&start == &finish)
+        continue;
+
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      vector<Segment> route;
+      double expectedTimeSec;
+      TEST_EQUAL(CalculateRoute(*starter, route, expectedTimeSec),
+                 AlgorithmForIndexGraphStarter::Result::OK, ());
+
+      starter = MakeStarter(start, finish, *worldGraph);
+      starter->SetPotentials(
+          make_shared<JointPotentials>(hierarchy, *worldGraph, kTestNumMwmId,
+                                       starter->GetFinishRealSegments(), true /* toEndings */),
+          make_shared<JointPotentials>(hierarchy, *worldGraph, kTestNumMwmId,
+                                       starter->GetStartRealSegments(), false /* toEndings */));
+      double timeSec;
+      TEST_EQUAL(CalculateRoute(*starter, route, timeSec),
+                 AlgorithmForIndexGraphStarter::Result::OK, ());
+      TEST(base::AlmostEqualAbs(timeSec, expectedTimeSec, 1e-5), (timeSec, expectedTimeSec));
+    }
+  }
+}
+
+// Start and finish are in the same mwm but the best route goes through a neighbouring mwm
+// (road 3). The hierarchy is built for the mwm roads only, like a CH_FILE_TAG section is.
+//
+//   (1, 3)-------(3, 3)
+//     |             |
+//     |             |
+//   S-(1, 0)=====(3, 0)-F
+//         Neighbour
+//
+UNIT_TEST(FindPathThroughNeighbourWithJointPotentials)
+{
+  auto const makeLoader = [](bool withNeighbour) {
+    unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+    loader->AddRoad(0 /* featureId */, false, 1.0 /* speed */,
+                    RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}}));
+    loader->AddRoad(1 /* featureId */, false, 1.0 /* speed */,
+                    RoadGeometry::Points({{1.0, 0.0}, {1.0, 3.0}, {3.0, 3.0}, {3.0, 0.0}}));
+    loader->AddRoad(2 /* featureId */, false, 1.0 /* speed */,
+                    RoadGeometry::Points({{3.0, 0.0}, {4.0, 0.0}}));
+    if (withNeighbour)
+    {
+      loader->AddRoad(3 /* featureId */, false, 1.0 /* speed */,
+                      RoadGeometry::Points({{1.0, 0.0}, {3.0, 0.0}}));
+    }
+    return loader;
+  };
+
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+
+  vector<Joint> const joints = {MakeJoint({{0, 1}, {1, 0}, {3, 0}}),
+                                MakeJoint({{1, 3}, {2, 0}, {3, 1}})};
+  unique_ptr<WorldGraph> worldGraph = BuildWorldGraph(makeLoader(true /* withNeighbour */),
+                                                      estimator, joints);
+
+  vector<Joint> const mwmJoints = {MakeJoint({{0, 1}, {1, 0}}), MakeJoint({{1, 3}, {2, 0}})};
+  auto const mwmGraph =
+      BuildIndexGraph(makeLoader(false /* withNeighbour */), estimator, mwmJoints);
+  JointHierarchy hierarchy;
+  hierarchy.Build(*mwmGraph, *estimator);
+
+  auto const start = MakeFakeEnding(0 /* featureId */, 0 /* segmentIdx */, m2::PointD(0.5, 0.0),
+                                    *worldGraph);
+  auto const finish = MakeFakeEnding(2 /* featureId */, 0 /* segmentIdx */, m2::PointD(3.5, 0.0),
+                                     *worldGraph);
+
+  auto starter = MakeStarter(start, finish, *worldGraph);
+  vector<Segment> route;
+  double expectedTimeSec;
+  TEST_EQUAL(CalculateRoute(*starter, route, expectedTimeSec),
+             AlgorithmForIndexGraphStarter::Result::OK, ());
+
+  auto const throughNeighbour = [](vector<Segment> const & route) {
+    return any_of(route.cbegin(), route.cend(),
+                  [](Segment const & segment) { return segment.GetFeatureId() == 3; });
+  };
+  TEST(throughNeighbour(route), (route));
+
+  // The mwm roads alone give a too high potential, it would hide the route through the neighbour.
+  JointPotentials mwmPotentials(hierarchy, *worldGraph, kTestNumMwmId,
+                                starter->GetFinishRealSegments(), true /* toEndings */);
+  TEST_GREATER(mwmPotentials.Get(RoadPoint(0 /* featureId */, 1 /* pointId */)), expectedTimeSec,
+               ());
+
+  // Ends of road 3 are the border points, like the transitions of the mwm are in IndexRouter.
+  auto const getBorders = [&](ms::LatLon const & ending) {
+    JointPotentials::Borders borders;
+    for (bool const front : {false, true})
+    {
+      Segment const segment(kTestNumMwmId, 3 /* featureId */, 0 /* segmentIdx */,
+                            true /* forward */);
+      borders[segment.GetRoadPoint(front)] =
+          worldGraph->HeuristicCostEstimate(worldGraph->GetPoint(segment, front), ending)
+              .GetWeight();
+    }
+    return borders;
+  };
+
+  starter = MakeStarter(start, finish, *worldGraph);
+  starter->SetPotentials(
+      make_shared<JointPotentials>(
+          hierarchy, *worldGraph, kTestNumMwmId, starter->GetFinishRealSegments(),
+          true /* toEndings */,
+          getBorders(starter->GetPoint(starter->GetFinishSegment(), true /* front */))),
+      make_shared<JointPotentials>(
+          hierarchy, *worldGraph, kTestNumMwmId, starter->GetStartRealSegments(),
+          false /* toEndings */,
+          getBorders(starter->GetPoint(starter->GetStartSegment(), true /* front */))));
+
+  double timeSec;
+  TEST_EQUAL(CalculateRoute(*starter, route, timeSec),
+             AlgorithmForIndexGraphStarter::Result::OK, ());
+  TEST(throughNeighbour(route), (route));
+  TEST(base::AlmostEqualAbs(timeSec, expectedTimeSec, 1e-5), (timeSec, expectedTimeSec));
+}
+
+// Finishes added with IndexGraphStarter::AddExtraFinish() are reached by one wave from the start
+// with the same weights as the routes to them.
+UNIT_TEST(OneToManyManhattan)
+{
+  uint32_t constexpr kCitySize = 4;
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      street.emplace_back(static_cast<double>(j), static_cast<double>(i));
+      avenue.emplace_back(static_cast<double>(i), static_cast<double>(j));
+    }
+    loader->AddRoad(i, false, static_cast<float>(1 + i) /* speed */, street);
+    loader->AddRoad(i + kCitySize, i % 2 == 0 /* oneWay */, 1.0 /* speed */, avenue);
+  }
+
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+
+  vector<Joint> joints;
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    for (uint32_t j = 0; j < kCitySize; ++j)
+      joints.emplace_back(MakeJoint({{i, j}, {j + kCitySize, i}}));
+  }
+
+  unique_ptr<WorldGraph> worldGraph = BuildWorldGraph(std::move(loader), estimator, joints);
+
+  vector<FakeEnding> targets;
+  for (uint32_t featureId = 1; featureId < kCitySize; ++featureId)
+  {
+    for (uint32_t segmentId = 0; segmentId < kCitySize - 1; ++segmentId)
+    {
+      targets.push_back(MakeFakeEnding(featureId + kCitySize, segmentId,
+                                       m2::PointD(featureId, 0.5 + segmentId), *worldGraph));
+    }
+  }
+
+  // The source is on a street, the targets are on avenues.
+  auto const source = MakeFakeEnding(0 /* featureId */, 1 /* segmentIdx */,
+                                     m2::PointD(1.5, 0.0), *worldGraph);
+
+  auto starter = MakeStarter(source, targets[0], *worldGraph);
+  vector<Segment> finishes = {starter->GetFinishSegment()};
+  for (size_t i = 1; i < targets.size(); ++i)
+    finishes.push_back(starter->AddExtraFinish(targets[i], source));
+
+  AlgorithmForIndexGraphStarter algorithm;
+  AlgorithmForIndexGraphStarter::Context context(*starter);
+  algorithm.PropagateWave(*starter, starter->GetStartSegment(),
+                          [](Segment const & /* vertex */) { return true; }, context);
+
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    auto pairStarter = MakeStarter(source, targets[i], *worldGraph);
+    vector<Segment> route;
+    double expectedTimeSec;
+    TEST_EQUAL(CalculateRoute(*pairStarter, route, expectedTimeSec),
+               AlgorithmForIndexGraphStarter::Result::OK, ());
+
+    TEST(context.HasDistance(finishes[i]), (i));
+    double const timeSec = context.GetDistance(finishes[i]).GetWeight();
+    TEST(base::AlmostEqualAbs(timeSec, expectedTimeSec, 1e-5), (i, timeSec, expectedTimeSec));
+  }
+}
+
 // Roads                                          y:
 //
 //  fast road R0              * - * - *           -1
@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+
+#include "base/thread_pool_computational.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace road_geometry_cache_test
+{
+using namespace routing;
+using namespace std;
+
+int64_t constexpr kVersion = 220101;
+
+RoadGeometryCache::RoadPtrT MakeRoad(uint32_t featureId)
+{
+  RoadGeometry::Points const points = {{0.0, 0.0}, {featureId / 10.0, 0.0}};
+  auto road = make_shared<RoadGeometry>(false /* oneWay */, 1.0 /* weightSpeedKMpH */,
+                                        1.0 /* etaSpeedKMpH */, points);
+  road->GetRoadLengthM();
+  return road;
+}
+
+UNIT_TEST(RoadGeometryCache_FindInsert)
+{
+  RoadGeometryCache cache(1000000 /* memoryLimitBytes */);
+
+  TEST(!cache.Find(0 /* mwmId */, kVersion, 1 /* featureId */), ());
+  auto const road = MakeRoad(1);
+  cache.Insert(0 /* mwmId */, kVersion, 1 /* featureId */, road);
+  TEST_EQUAL(cache.Find(0 /* mwmId */, kVersion, 1 /* featureId */), road, ());
+  // The same feature id of another mwm.
+  TEST(!cache.Find(1 /* mwmId */, kVersion, 1 /* featureId */), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+  TEST_EQUAL(stats.m_roadsCount, 1, ());
+  TEST_EQUAL(stats.m_memoryBytes, RoadGeometryCache::GetMemorySize(*road), ());
+
+  cache.Clear();
+  TEST(!cache.Find(0 /* mwmId */, kVersion, 1 /* featureId */), ());
+}
+
+UNIT_TEST(RoadGeometryCache_Versions)
+{
+  RoadGeometryCache cache(1000000 /* memoryLimitBytes */);
+
+  auto const road = MakeRoad(1);
+  cache.Insert(0 /* mwmId */, kVersion, 1 /* featureId */, road);
+  // The road of the updated mwm is not found and is kept apart from the old one.
+  TEST(!cache.Find(0 /* mwmId */, kVersion + 1, 1 /* featureId */), ());
+  auto const updatedRoad = MakeRoad(2);
+  cache.Insert(0 /* mwmId */, kVersion + 1, 1 /* featureId */, updatedRoad);
+  TEST_EQUAL(cache.Find(0 /* mwmId */, kVersion + 1, 1 /* featureId */), updatedRoad, ());
+  TEST_EQUAL(cache.Find(0 /* mwmId */, kVersion, 1 /* featureId */), road, ());
+  TEST_EQUAL(cache.GetStats().m_roadsCount, 2, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Lru)
+{
+  size_t const roadSize = RoadGeometryCache::GetMemorySize(*MakeRoad(0));
+  // The only shard for three roads.
+  RoadGeometryCache cache(3 * roadSize, 1 /* shardsCount */);
+
+  for (uint32_t featureId = 0; featureId < 3; ++featureId)
+    cache.Insert(0 /* mwmId */, kVersion, featureId, MakeRoad(featureId));
+
+  // Road 0 becomes the most recently used, road 1 is evicted.
+  TEST(cache.Find(0 /* mwmId */, kVersion, 0 /* featureId */), ());
+  cache.Insert(0 /* mwmId */, kVersion, 3 /* featureId */, MakeRoad(3));
+
+  TEST(cache.Find(0 /* mwmId */, kVersion, 0 /* featureId */), ());
+  TEST(!cache.Find(0 /* mwmId */, kVersion, 1 /* featureId */), ());
+  TEST(cache.Find(0 /* mwmId */, kVersion, 2 /* featureId */), ());
+  TEST(cache.Find(0 /* mwmId */, kVersion, 3 /* featureId */), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_evictions, 1, ());
+  TEST_EQUAL(stats.m_roadsCount, 3, ());
+  TEST_LESS_OR_EQUAL(stats.m_memoryBytes, cache.GetMemoryLimit(), ());
+}
+
+UNIT_TEST(RoadGeometryCache_Threads)
+{
+  size_t const roadSize = RoadGeometryCache::GetMemorySize(*MakeRoad(0));
+  uint32_t constexpr kRoadsCount = 1000;
+  RoadGeometryCache cache(kRoadsCount / 2 * roadSize, 4 /* shardsCount */);
+
+  size_t constexpr kThreadsCount = 8;
+  {
+    base::thread_pool::computational::ThreadPool pool(kThreadsCount);
+    for (size_t i = 0; i < kThreadsCount; ++i)
+    {
+      pool.SubmitWork([&cache]()
+      {
+        for (uint32_t featureId = 0; featureId < kRoadsCount; ++featureId)
+        {
+          auto road = cache.Find(0 /* mwmId */, kVersion, featureId);
+          if (!road)
+          {
+            road = MakeRoad(featureId);
+            cache.Insert(0 /* mwmId */, kVersion, featureId, road);
+          }
+          TEST_ALMOST_EQUAL_ABS(road->GetPoint(1).m_lon, featureId / 10.0, 1e-9, ());
+        }
+      });
+    }
+  }
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits + stats.m_misses, kThreadsCount * kRoadsCount, ());
+  TEST_LESS_OR_EQUAL(stats.m_memoryBytes, cache.GetMemoryLimit(), ());
+}
+}  // namespace road_geometry_cache_test
@@ -75,6 +75,16 @@ uint64_t CBV::PopCount() const
   return m_p->PopCount();
 }
 
+uint64_t CBV::GetMemoryBytes() const
+{
+  if (IsFull() || IsEmpty())
+    return 0;
+
+  if (m_p->GetStorageStrategy() == coding::CompressedBitVector::StorageStrategy::Dense)
+    return static_cast<coding::DenseCBV const &>(*m_p).NumBitGroups() * sizeof(uint64_t);
+  return m_p->PopCount() * sizeof(uint64_t);
+}
+
 CBV CBV::Union(CBV const & rhs) const
 {
   if (IsFull() || rhs.IsEmpty())
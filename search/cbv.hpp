@@ -37,6 +37,9 @@ public:
   bool HasBit(uint64_t id) const;
   uint64_t PopCount() const;
 
+  // Returns the approximate size of the stored bits in bytes.
+  uint64_t GetMemoryBytes() const;
+
   template <typename Fn>
   void ForEach(Fn && fn) const
   {
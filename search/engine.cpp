@@ -1,16 +1,19 @@
 #include "search/engine.hpp"
 
 #include "search/processor.hpp"
+#include "search/result.hpp"
 
 #include "storage/country_info_getter.hpp"
 
 #include "indexer/categories_holder.hpp"
+#include "indexer/data_source.hpp"
 #include "indexer/search_string_utils.hpp"
 
 #include "base/scope_guard.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <vector>
 
@@ -44,6 +47,23 @@ public:
       suggests.emplace_back(s.first.first, s.second, s.first.second);
   }
 };
+
+// Finishes the query which is not going to be processed in the same way as Processor finishes
+// a cancelled one.
+void FinishCancelled(SearchParams & params)
+{
+  if (params.m_onStarted)
+    params.m_onStarted();
+
+  Results results;
+  results.SetEndMarker(true /* isCancelled */);
+  params.m_onResults(std::move(results));
+}
+
+uint64_t ToMilliseconds(chrono::steady_clock::duration duration)
+{
+  return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(duration).count());
+}
 }  // namespace
 
 // ProcessorHandle----------------------------------------------------------------------------------
@@ -82,7 +102,10 @@ Engine::Params::Params(string const & locale, size_t numThreads)
 // Engine ------------------------------------------------------------------------------------------
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
-  : m_shutdown(false)
+  : m_dataSource(dataSource)
+  , m_maxQueuedQueries(params.m_maxQueuedQueries)
+  , m_timeoutIncludesQueueTime(params.m_timeoutIncludesQueueTime)
+  , m_shutdown(false)
 {
   InitSuggestions doInit;
   categories.ForEachName(doInit);
@@ -100,6 +123,8 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
   for (size_t i = 0; i < params.m_numThreads; ++i)
     m_threads.emplace_back(&Engine::MainLoop, this, ref(m_contexts[i]));
 
+  m_dataSource.AddObserver(*this);
+
   CacheWorldLocalities();
   LoadCitiesBoundaries();
   LoadCountriesTree();
@@ -107,6 +132,8 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
 
 Engine::~Engine()
 {
+  m_dataSource.RemoveObserver(*this);
+
   {
     lock_guard<mutex> lock(m_mu);
     m_shutdown = true;
@@ -119,12 +146,50 @@ Engine::~Engine()
 
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams params)
 {
+  auto const postTime = chrono::steady_clock::now();
   shared_ptr<ProcessorHandle> handle(new ProcessorHandle());
-  PostMessage(Message::TYPE_TASK, [this, params = std::move(params), handle](Processor & processor)
-              {
-                DoSearch(std::move(params), handle, processor);
-              });
-  return handle;
+  {
+    lock_guard<mutex> lock(m_mu);
+    if (m_maxQueuedQueries == 0 || m_numQueuedQueries < m_maxQueuedQueries)
+    {
+      ++m_numQueuedQueries;
+      m_messages.emplace(Message::TYPE_TASK,
+                         [this, params = std::move(params), handle, postTime](Processor & processor)
+                         {
+                           DoSearch(std::move(params), handle, postTime, processor);
+                         });
+      m_cv.notify_one();
+      return handle;
+    }
+  }
+
+  ++m_numRejected;
+  LOG(LWARNING, ("Search queue is full, the query is rejected:", m_maxQueuedQueries,
+                 "queries are waiting."));
+  FinishCancelled(params);
+  return {};
+}
+
+Engine::Stats Engine::GetStats() const
+{
+  Stats stats;
+  stats.m_latency = m_latency.GetSnapshot();
+  stats.m_numRejected = m_numRejected;
+  stats.m_numExpired = m_numExpired;
+  for (auto const & context : m_contexts)
+  {
+    auto const cacheStats = context.m_processor->GetRetrievalCacheStats();
+    stats.m_retrievalCacheHits += cacheStats.m_hits;
+    stats.m_retrievalCacheMisses += cacheStats.m_misses;
+  }
+  return stats;
+}
+
+void Engine::ResetStats()
+{
+  m_latency.Clear();
+  m_numRejected = 0;
+  m_numExpired = 0;
 }
 
 void Engine::SetLocale(string const & locale)
@@ -140,6 +205,13 @@ void Engine::ClearCaches()
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
+void Engine::OnMapDeregistered(platform::LocalCountryFile const & localFile)
+{
+  PostMessage(Message::TYPE_BROADCAST, [localFile](Processor & processor) {
+    processor.OnMapDeregistered(localFile);
+  });
+}
+
 void Engine::CacheWorldLocalities()
 {
   PostMessage(Message::TYPE_BROADCAST,
@@ -255,6 +327,8 @@ void Engine::MainLoop(Context & context)
       {
         context.m_messages.push(std::move(m_messages.front()));
         m_messages.pop();
+        CHECK_GREATER(m_numQueuedQueries, 0, ());
+        --m_numQueuedQueries;
       }
 
       messages.swap(context.m_messages);
@@ -279,8 +353,27 @@ void Engine::PostMessage(Args &&... args)
   m_cv.notify_one();
 }
 
-void Engine::DoSearch(SearchParams params, shared_ptr<ProcessorHandle> handle, Processor & processor)
+void Engine::DoSearch(SearchParams params, shared_ptr<ProcessorHandle> handle,
+                      chrono::steady_clock::time_point postTime, Processor & processor)
 {
+  if (m_timeoutIncludesQueueTime)
+  {
+    auto const queueTime = chrono::steady_clock::now() - postTime;
+    if (queueTime >= params.m_timeout)
+    {
+      ++m_numExpired;
+      LOG(LWARNING, ("Search query expired after", ToMilliseconds(queueTime), "ms in the queue."));
+      FinishCancelled(params);
+      return;
+    }
+    params.m_timeout -= chrono::duration_cast<SearchParams::TimeDurationT>(queueTime);
+  }
+
+  SCOPE_GUARD(recordLatency, [&]()
+  {
+    m_latency.Add(ToMilliseconds(chrono::steady_clock::now() - postTime));
+  });
+
   LOG(LINFO, ("Search started:", params.m_mode));
   base::Timer timer;
   SCOPE_GUARD(printDuration, [&timer]()
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "search/latency_histogram.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
 
 #include "indexer/categories_holder.hpp"
+#include "indexer/mwm_set.hpp"
 
 #include "base/macros.hpp"
 #include "base/thread.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -66,7 +71,7 @@ private:
 // queries one by one.
 //
 // NOTE: this class is thread safe.
-class Engine
+class Engine : public MwmSet::Observer
 {
 public:
   struct Params
@@ -80,14 +85,38 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // Maximum number of search queries waiting for a free thread, zero means no limit.
+    // Queries posted when the queue is full are rejected: they are finished right away
+    // with an empty cancelled results set.
+    size_t m_maxQueuedQueries = 0;
+
+    // When true, SearchParams::m_timeout is counted from the Search() call instead of
+    // the start of processing, so time spent in the queue is a part of the query deadline
+    // and queries which expired in the queue are not processed at all.
+    // This is what a server handling independent queries needs.
+    bool m_timeoutIncludesQueueTime = false;
+  };
+
+  struct Stats
+  {
+    // Time from the Search() call to the end of processing for all processed queries.
+    LatencyHistogram::Snapshot m_latency;
+    uint64_t m_numRejected = 0;
+    uint64_t m_numExpired = 0;
+
+    // Lookups of query tokens in the retrieval caches of all processors, not reset by ResetStats().
+    uint64_t m_retrievalCacheHits = 0;
+    uint64_t m_retrievalCacheMisses = 0;
   };
 
   // Doesn't take ownership of dataSource and categories.
   Engine(DataSource & dataSource, CategoriesHolder const & categories,
          storage::CountryInfoGetter const & infoGetter, Params const & params);
-  ~Engine();
+  ~Engine() override;
 
   // Posts search request to the queue and returns its handle.
+  // An expired handle is returned when the request is rejected because the queue is full.
   std::weak_ptr<ProcessorHandle> Search(SearchParams params);
 
   // Sets default locale on all query processors.
@@ -96,6 +125,10 @@ public:
   // Returns the number of request-processing threads.
   size_t GetNumThreads() const;
 
+  // Returns latency percentiles and counters of the queries posted since the last ResetStats().
+  Stats GetStats() const;
+  void ResetStats();
+
   // Posts request to clear caches to the queue.
   void ClearCaches();
 
@@ -122,6 +155,10 @@ public:
   void OnBookmarksDetachedFromGroup(bookmarks::GroupId const & groupId,
                                     std::vector<bookmarks::Id> const & marks);
 
+  // MwmSet::Observer overrides:
+  // Posts request to drop cached data of the mwm to the queue.
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
 private:
   struct Message
   {
@@ -166,14 +203,27 @@ private:
   template <typename... Args>
   void PostMessage(Args &&... args);
 
-  void DoSearch(SearchParams params, std::shared_ptr<ProcessorHandle> handle, Processor & processor);
+  void DoSearch(SearchParams params, std::shared_ptr<ProcessorHandle> handle,
+                std::chrono::steady_clock::time_point postTime, Processor & processor);
+
+  DataSource & m_dataSource;
 
   std::vector<Suggest> m_suggests;
 
+  size_t const m_maxQueuedQueries;
+  bool const m_timeoutIncludesQueueTime;
+
   bool m_shutdown;
   std::mutex m_mu;
   std::condition_variable m_cv;
 
+  // Number of TYPE_TASK messages in |m_messages|, guarded by |m_mu|.
+  size_t m_numQueuedQueries = 0;
+
+  LatencyHistogram m_latency;
+  std::atomic<uint64_t> m_numRejected{0};
+  std::atomic<uint64_t> m_numExpired{0};
+
   std::queue<Message> m_messages;
   std::vector<Context> m_contexts;
   std::vector<threads::SimpleThread> m_threads;
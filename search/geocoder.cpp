@@ -71,6 +71,7 @@ size_t constexpr kPivotRectsCacheSize = 10;
 size_t constexpr kPostcodesRectsCacheSize = 10;
 size_t constexpr kSuburbsRectsCacheSize = 10;
 size_t constexpr kLocalityRectsCacheSize = 10;
+size_t constexpr kRetrievalCacheMaxBytes = 16 * 1024 * 1024;
 
 UniString const kUniSpace(MakeUniString(" "));
 
@@ -337,6 +338,7 @@ Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter con
   , m_postcodesRectsCache(kPostcodesRectsCacheSize, m_cancellable, kMaxPostcodeRadiusM)
   , m_suburbsRectsCache(kSuburbsRectsCacheSize, m_cancellable, kMaxSuburbRadiusM)
   , m_localityRectsCache(kLocalityRectsCacheSize, m_cancellable)
+  , m_retrievalCache(kRetrievalCacheMaxBytes)
   , m_filter(nullptr)
   , m_matcher(nullptr)
   , m_finder(m_cancellable)
@@ -366,8 +368,11 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    m_tokenKeys.push_back(RetrievalCache::MakeTokenKey(m_params, i));
+
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
@@ -440,6 +445,12 @@ void Geocoder::ClearCaches()
   m_cuisineFilter.ClearCaches();
   m_postcodePointsCache.Clear();
   m_postcodes.Clear();
+  m_retrievalCache.Clear();
+}
+
+void Geocoder::OnMapDeregistered(string const & countryName)
+{
+  m_retrievalCache.Remove(countryName);
 }
 
 void Geocoder::SetParamsForCategorialSearch(Params const & params)
@@ -448,6 +459,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
 
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
 }
@@ -652,7 +664,19 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  // Search index of the mwm is read only when some token is not in the cache.
+  optional<Retrieval> retrieval;
+  auto const retrieve = [&](size_t i, auto const & request) {
+    auto const & mwmId = m_context->GetId();
+    if (auto const * features = m_retrievalCache.Find(mwmId, m_tokenKeys[i]))
+      return Retrieval::ApplyEdits(*m_context, request, *features);
+
+    if (!retrieval)
+      retrieval.emplace(*m_context, m_cancellable);
+    auto const features = retrieval->RetrieveIndexFeatures(request);
+    m_retrievalCache.Add(mwmId, m_tokenKeys[i], features);
+    return Retrieval::ApplyEdits(*m_context, request, features);
+  };
 
   size_t const numTokens = m_params.GetNumTokens();
   ctx.m_tokens.assign(numTokens, BaseContext::TOKEN_TYPE_COUNT);
@@ -668,11 +692,11 @@ void Geocoder::InitBaseContext(BaseContext & ctx)
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      ctx.m_features[i] = retrieve(i, m_prefixTokenRequest);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      ctx.m_features[i] = retrieve(i, m_tokenRequests[i]);
     }
   }
 
@@ -17,6 +17,7 @@
 #include "search/mwm_context.hpp"
 #include "search/postcode_points.hpp"
 #include "search/query_params.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 #include "search/tracer.hpp"
@@ -129,6 +130,11 @@ public:
   void CacheWorldLocalities();
   void ClearCaches();
 
+  // Drops cached data of the mwm which is not available anymore.
+  void OnMapDeregistered(std::string const & countryName);
+
+  RetrievalCache::Stats GetRetrievalCacheStats() const { return m_retrievalCache.GetStats(); }
+
 private:
   enum class RectId
   {
@@ -356,6 +362,9 @@ private:
 
   PostcodePointsCache m_postcodePointsCache;
 
+  // Features matching query tokens in the search indices, shared by all queries.
+  RetrievalCache m_retrievalCache;
+
   // Postcodes features in the mwm that is currently being processed and World.mwm.
   Postcodes m_postcodes;
 
@@ -372,6 +381,8 @@ private:
   // Search query params prepared for retrieval.
   std::vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
+  // Keys of query tokens in |m_retrievalCache|.
+  std::vector<std::string> m_tokenKeys;
 
   ResultTracer m_resultTracer;
 
@@ -0,0 +1,106 @@
+#include "search/latency_histogram.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace search
+{
+using namespace std;
+
+void LatencyHistogram::Add(uint64_t ms)
+{
+  size_t const bucket = GetBucket(ms);
+
+  lock_guard<mutex> lock(m_mu);
+  ++m_buckets[bucket];
+  ++m_count;
+  m_sumMs += ms;
+  m_maxMs = max(m_maxMs, ms);
+}
+
+void LatencyHistogram::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_buckets.fill(0);
+  m_count = 0;
+  m_sumMs = 0;
+  m_maxMs = 0;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+{
+  Snapshot snapshot;
+
+  lock_guard<mutex> lock(m_mu);
+  if (m_count == 0)
+    return snapshot;
+
+  snapshot.m_count = m_count;
+  snapshot.m_p50Ms = GetPercentile(50.0);
+  snapshot.m_p90Ms = GetPercentile(90.0);
+  snapshot.m_p99Ms = GetPercentile(99.0);
+  snapshot.m_maxMs = m_maxMs;
+  snapshot.m_meanMs = static_cast<double>(m_sumMs) / static_cast<double>(m_count);
+  return snapshot;
+}
+
+// static
+size_t LatencyHistogram::GetBucket(uint64_t ms)
+{
+  if (ms < kNumExactBuckets)
+    return static_cast<size_t>(ms);
+
+  // |ms| is in [2^power, 2^(power + 1)).
+  auto const power = static_cast<size_t>(bits::FloorLog(ms));
+  auto const subBucket = static_cast<size_t>(ms >> (power - kNumSubBucketsLog)) - kNumSubBuckets;
+  size_t const bucket =
+      kNumExactBuckets + (power - kNumSubBucketsLog - 1) * kNumSubBuckets + subBucket;
+  return min(bucket, kNumBuckets - 1);
+}
+
+// static
+uint64_t LatencyHistogram::GetUpperBound(size_t bucket)
+{
+  CHECK_LESS(bucket, kNumBuckets, ());
+  if (bucket < kNumExactBuckets)
+    return bucket;
+
+  size_t const range = (bucket - kNumExactBuckets) / kNumSubBuckets;
+  size_t const subBucket = (bucket - kNumExactBuckets) % kNumSubBuckets;
+  size_t const power = range + kNumSubBucketsLog + 1;
+  return ((uint64_t{kNumSubBuckets + subBucket + 1}) << (power - kNumSubBucketsLog)) - 1;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percent) const
+{
+  ASSERT_GREATER(m_count, 0, ());
+  auto const rank = static_cast<uint64_t>(ceil(percent / 100.0 * static_cast<double>(m_count)));
+
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket)
+  {
+    seen += m_buckets[bucket];
+    if (seen < max<uint64_t>(rank, 1))
+      continue;
+    // The last bucket is unbounded.
+    return bucket + 1 == kNumBuckets ? m_maxMs : min(GetUpperBound(bucket), m_maxMs);
+  }
+  return m_maxMs;
+}
+
+string DebugPrint(LatencyHistogram::Snapshot const & snapshot)
+{
+  ostringstream os;
+  os << "LatencyHistogram::Snapshot [ count: " << snapshot.m_count
+     << ", mean: " << snapshot.m_meanMs << "ms"
+     << ", p50: " << snapshot.m_p50Ms << "ms"
+     << ", p90: " << snapshot.m_p90Ms << "ms"
+     << ", p99: " << snapshot.m_p99Ms << "ms"
+     << ", max: " << snapshot.m_maxMs << "ms ]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace search
+{
+// Histogram of query latencies in milliseconds with a bounded relative error of percentiles.
+// Latencies below kNumExactBuckets ms are counted exactly, every next power of two range
+// is split into kNumSubBuckets equal buckets, so a percentile is off by 12.5% at most.
+//
+// NOTE: this class is thread-safe.
+class LatencyHistogram
+{
+public:
+  struct Snapshot
+  {
+    uint64_t m_count = 0;
+    uint64_t m_p50Ms = 0;
+    uint64_t m_p90Ms = 0;
+    uint64_t m_p99Ms = 0;
+    uint64_t m_maxMs = 0;
+    double m_meanMs = 0.0;
+  };
+
+  void Add(uint64_t ms);
+  void Clear();
+
+  Snapshot GetSnapshot() const;
+
+private:
+  static size_t constexpr kNumSubBucketsLog = 3;
+  static size_t constexpr kNumSubBuckets = size_t{1} << kNumSubBucketsLog;
+  static size_t constexpr kNumExactBuckets = 2 * kNumSubBuckets;
+  // Latencies up to 2^32 ms are distinguished, larger ones go to the last bucket.
+  static size_t constexpr kNumBuckets = kNumExactBuckets + (32 - kNumSubBucketsLog - 1) * kNumSubBuckets;
+
+  static size_t GetBucket(uint64_t ms);
+  // Returns the largest latency which falls into |bucket|.
+  static uint64_t GetUpperBound(size_t bucket);
+
+  // Returns the |percent| percentile. |m_mu| must be taken.
+  uint64_t GetPercentile(double percent) const;
+
+  mutable std::mutex m_mu;
+  std::array<uint64_t, kNumBuckets> m_buckets = {};
+  uint64_t m_count = 0;
+  uint64_t m_sumMs = 0;
+  uint64_t m_maxMs = 0;
+};
+
+std::string DebugPrint(LatencyHistogram::Snapshot const & snapshot);
+}  // namespace search
@@ -1,5 +1,6 @@
 #include "search/lazy_centers_table.hpp"
 
+#include "indexer/mapped_sections.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "platform/mwm_traits.hpp"
@@ -18,27 +19,42 @@ void LazyCentersTable::EnsureTableLoaded()
   if (m_state != STATE_NOT_LOADED)
     return;
 
-  try
+  if (m_value.m_mapped)
   {
-    m_reader = m_value.m_cont.GetReader(CENTERS_FILE_TAG);
+    // The table is read in place from the mapped section.
+    m_mappedReader = m_value.m_mapped->CreateCentersReader();
+    if (!m_mappedReader)
+    {
+      LOG(LERROR, ("Unable to load", CENTERS_FILE_TAG));
+      m_state = STATE_FAILED;
+      return;
+    }
   }
-  catch (RootException const & ex)
+  else
   {
-    LOG(LERROR, ("Unable to load", CENTERS_FILE_TAG, ex.Msg()));
-    m_state = STATE_FAILED;
-    return;
+    try
+    {
+      m_reader = m_value.m_cont.GetReader(CENTERS_FILE_TAG);
+    }
+    catch (RootException const & ex)
+    {
+      LOG(LERROR, ("Unable to load", CENTERS_FILE_TAG, ex.Msg()));
+      m_state = STATE_FAILED;
+      return;
+    }
   }
+  Reader & reader = m_mappedReader ? *m_mappedReader : *m_reader.GetPtr();
 
   version::MwmTraits traits(m_value.GetMwmVersion());
   auto const format = traits.GetCentersTableFormat();
 
   if (format == version::MwmTraits::CentersTableFormat::PlainEliasFanoMap)
   {
-    m_table = CentersTable::LoadV0(*m_reader.GetPtr(), m_value.GetHeader().GetDefGeometryCodingParams());
+    m_table = CentersTable::LoadV0(reader, m_value.GetHeader().GetDefGeometryCodingParams());
   }
   else if (format == version::MwmTraits::CentersTableFormat::EliasFanoMapWithHeader)
   {
-    m_table = CentersTable::LoadV1(*m_reader.GetPtr());
+    m_table = CentersTable::LoadV1(reader);
   }
   else
   {
@@ -36,6 +36,8 @@ private:
   State m_state;
 
   FilesContainerR::TReader m_reader;
+  // Reader of the mapped section when |m_value| is read from the mapped file.
+  std::unique_ptr<Reader> m_mappedReader;
   std::unique_ptr<CentersTable> m_table;
 };
 }  // namespace search
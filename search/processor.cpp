@@ -940,6 +940,11 @@ void Processor::ClearCaches()
   m_viewport.MakeEmpty();
 }
 
+void Processor::OnMapDeregistered(platform::LocalCountryFile const & localFile)
+{
+  m_geocoder.OnMapDeregistered(localFile.GetCountryName());
+}
+
 template <class FnT>
 void Processor::EmitResultsFromMwms(std::vector<std::shared_ptr<MwmInfo>> const & infos, FnT const & fn)
 {
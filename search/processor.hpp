@@ -91,10 +91,14 @@ public:
   void InitRanker(Geocoder::Params const & geocoderParams, SearchParams const & searchParams);
 
   void ClearCaches();
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile);
   void CacheWorldLocalities();
   void LoadCitiesBoundaries();
   void LoadCountriesTree();
 
+  // May be called from any thread.
+  RetrievalCache::Stats GetRetrievalCacheStats() const { return m_geocoder.GetRetrievalCacheStats(); }
+
   void EnableIndexingOfBookmarksDescriptions(bool enable);
   void EnableIndexingOfBookmarkGroup(bookmarks::GroupId const & groupId, bool enable);
 
@@ -96,6 +96,8 @@ public:
     m_created = editor.GetFeaturesByStatus(id, FeatureStatus::Created);
   }
 
+  bool IsEmpty() const { return m_deleted.empty() && m_modified.empty() && m_created.empty(); }
+
   bool ModifiedOrDeleted(uint32_t featureIndex) const
   {
     return binary_search(m_deleted.begin(), m_deleted.end(), featureIndex) ||
@@ -269,6 +271,56 @@ Retrieval::ExtendedFeatures RetrieveAddressFeaturesImpl(Retrieval::TrieRoot<Valu
   return SortFeaturesAndBuildResult(std::move(features), std::move(exactlyMatchedFeatures));
 }
 
+template <typename Value, typename DFA>
+Retrieval::ExtendedFeatures RetrieveIndexFeaturesImpl(Retrieval::TrieRoot<Value> const & root,
+                                                      MwmContext const & /* context */,
+                                                      base::Cancellable const & cancellable,
+                                                      SearchTrieRequest<DFA> const & request)
+{
+  vector<uint64_t> features;
+  vector<uint64_t> exactlyMatchedFeatures;
+  FeaturesCollector collector(cancellable, features, exactlyMatchedFeatures);
+
+  MatchFeaturesInTrie(
+      request, root, [](Value const & /* value */) { return true; } /* filter */, collector);
+
+  return SortFeaturesAndBuildResult(std::move(features), std::move(exactlyMatchedFeatures));
+}
+
+// Does the same with |indexFeatures| as RetrieveAddressFeaturesImpl() does with the features
+// from the search index: drops modified and deleted features and matches modified and created ones.
+template <typename DFA>
+Retrieval::ExtendedFeatures ApplyEditsImpl(MwmContext const & context,
+                                           SearchTrieRequest<DFA> const & request,
+                                           Retrieval::ExtendedFeatures const & indexFeatures)
+{
+  EditedFeaturesHolder holder(context.GetId());
+  if (holder.IsEmpty())
+    return indexFeatures;
+
+  vector<uint64_t> features;
+  vector<uint64_t> exactlyMatchedFeatures;
+  indexFeatures.ForEach([&](uint32_t featureId, bool exactMatch) {
+    if (holder.ModifiedOrDeleted(featureId))
+      return;
+    features.push_back(featureId);
+    if (exactMatch)
+      exactlyMatchedFeatures.push_back(featureId);
+  });
+
+  holder.ForEachModifiedOrCreated([&](EditableMapObject const & emo, uint64_t index) {
+    auto const matched = MatchFeatureByNameAndType(emo, request);
+    if (matched.first)
+    {
+      features.emplace_back(index);
+      if (matched.second)
+        exactlyMatchedFeatures.emplace_back(index);
+    }
+  });
+
+  return SortFeaturesAndBuildResult(std::move(features), std::move(exactlyMatchedFeatures));
+}
+
 template <typename Value>
 Retrieval::ExtendedFeatures RetrievePostcodeFeaturesImpl(Retrieval::TrieRoot<Value> const & root,
                                                          MwmContext const & context,
@@ -329,6 +381,16 @@ struct RetrieveAddressFeaturesAdaptor
   }
 };
 
+template <typename T>
+struct RetrieveIndexFeaturesAdaptor
+{
+  template <typename... Args>
+  Retrieval::ExtendedFeatures operator()(Args &&... args)
+  {
+    return RetrieveIndexFeaturesImpl<T>(std::forward<Args>(args)...);
+  }
+};
+
 template <typename T>
 struct RetrievePostcodeFeaturesAdaptor
 {
@@ -399,6 +461,34 @@ Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
 
+Retrieval::ExtendedFeatures Retrieval::RetrieveIndexFeatures(
+    SearchTrieRequest<LevenshteinDFA> const & request) const
+{
+  return Retrieve<RetrieveIndexFeaturesAdaptor>(request);
+}
+
+Retrieval::ExtendedFeatures Retrieval::RetrieveIndexFeatures(
+    SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> const & request) const
+{
+  return Retrieve<RetrieveIndexFeaturesAdaptor>(request);
+}
+
+// static
+Retrieval::ExtendedFeatures Retrieval::ApplyEdits(MwmContext const & context,
+                                                  SearchTrieRequest<LevenshteinDFA> const & request,
+                                                  ExtendedFeatures const & indexFeatures)
+{
+  return ApplyEditsImpl(context, request, indexFeatures);
+}
+
+// static
+Retrieval::ExtendedFeatures Retrieval::ApplyEdits(
+    MwmContext const & context, SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> const & request,
+    ExtendedFeatures const & indexFeatures)
+{
+  return ApplyEditsImpl(context, request, indexFeatures);
+}
+
 Retrieval::Features Retrieval::RetrievePostcodeFeatures(TokenSlice const & slice) const
 {
   return Retrieve<RetrievePostcodeFeaturesAdaptor>(slice).m_features;
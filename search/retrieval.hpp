@@ -101,6 +101,26 @@ public:
   ExtendedFeatures RetrieveAddressFeatures(
       SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request) const;
 
+  // Following functions retrieve features matching to |request| from the search index only,
+  // ignoring the changes made in the editor. The result depends on the mwm and |request| only,
+  // so it may be cached across queries (see RetrievalCache).
+  ExtendedFeatures RetrieveIndexFeatures(
+      SearchTrieRequest<strings::LevenshteinDFA> const & request) const;
+
+  ExtendedFeatures RetrieveIndexFeatures(
+      SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request) const;
+
+  // Following functions apply the changes made in the editor to |indexFeatures| retrieved by
+  // RetrieveIndexFeatures(|request|). The result is the same as of RetrieveAddressFeatures(|request|).
+  static ExtendedFeatures ApplyEdits(MwmContext const & context,
+                                     SearchTrieRequest<strings::LevenshteinDFA> const & request,
+                                     ExtendedFeatures const & indexFeatures);
+
+  static ExtendedFeatures ApplyEdits(
+      MwmContext const & context,
+      SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request,
+      ExtendedFeatures const & indexFeatures);
+
   // Retrieves all postcodes matching to |slice| from the search index.
   Features RetrievePostcodeFeatures(TokenSlice const & slice) const;
 
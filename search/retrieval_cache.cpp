@@ -0,0 +1,123 @@
+#include "search/retrieval_cache.hpp"
+
+#include "search/query_params.hpp"
+
+#include "base/assert.hpp"
+#include "base/string_utils.hpp"
+
+#include <sstream>
+
+namespace search
+{
+using namespace std;
+
+namespace
+{
+size_t CalcMemoryBytes(RetrievalCache::Features const & features)
+{
+  return static_cast<size_t>(features.m_features.GetMemoryBytes() +
+                             features.m_exactMatchingFeatures.GetMemoryBytes());
+}
+}  // namespace
+
+RetrievalCache::RetrievalCache(size_t maxMemoryBytes) : m_maxMemoryBytes(maxMemoryBytes) {}
+
+// static
+string RetrievalCache::MakeTokenKey(QueryParams const & params, size_t i)
+{
+  // Separators can't occur in normalized tokens.
+  ostringstream os;
+  params.GetToken(i).ForOriginalAndSynonyms(
+      [&os](strings::UniString const & s) { os << strings::ToUtf8(s) << '\n'; });
+  os << '\t';
+  for (auto const index : params.GetTypeIndices(i))
+    os << index << ' ';
+  os << '\t';
+  for (auto const lang : params.GetLangs())
+    os << static_cast<int>(lang) << ' ';
+  os << '\t' << (params.IsPrefixToken(i) ? 'p' : 'f');
+  return os.str();
+}
+
+RetrievalCache::Features const * RetrievalCache::Find(MwmSet::MwmId const & id,
+                                                      string const & tokenKey)
+{
+  auto const it = m_index.find(Key(id, tokenKey));
+  if (it == m_index.end())
+  {
+    ++m_misses;
+    return nullptr;
+  }
+
+  ++m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return &it->second->m_features;
+}
+
+void RetrievalCache::Add(MwmSet::MwmId const & id, string const & tokenKey,
+                         Features const & features)
+{
+  Key key(id, tokenKey);
+  if (auto const it = m_index.find(key); it != m_index.end())
+    Erase(it->second);
+
+  size_t const memoryBytes = CalcMemoryBytes(features);
+  // Don't flush the whole cache for a single huge entry.
+  if (memoryBytes > m_maxMemoryBytes / 2)
+    return;
+
+  while (!m_entries.empty() && m_memoryBytes + memoryBytes > m_maxMemoryBytes)
+  {
+    Erase(prev(m_entries.end()));
+    ++m_evictions;
+  }
+
+  m_entries.push_front({key, features, memoryBytes});
+  m_index.emplace(std::move(key), m_entries.begin());
+  m_memoryBytes += memoryBytes;
+}
+
+void RetrievalCache::Remove(string const & countryName)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const & id = it->m_key.first;
+    auto const next = std::next(it);
+    if (!id.IsAlive() || id.GetInfo()->GetCountryName() == countryName)
+      Erase(it);
+    it = next;
+  }
+}
+
+void RetrievalCache::Clear()
+{
+  m_entries.clear();
+  m_index.clear();
+  m_memoryBytes = 0;
+}
+
+RetrievalCache::Stats RetrievalCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  return stats;
+}
+
+void RetrievalCache::Erase(Entries::iterator it)
+{
+  ASSERT_GREATER_OR_EQUAL(m_memoryBytes, it->m_memoryBytes, ());
+  m_memoryBytes -= it->m_memoryBytes;
+  m_index.erase(it->m_key);
+  m_entries.erase(it);
+}
+
+string DebugPrint(RetrievalCache::Stats const & stats)
+{
+  ostringstream os;
+  os << "RetrievalCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+     << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "search/retrieval.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace search
+{
+class QueryParams;
+
+// Cross-query LRU cache of the features retrieved from search indices of mwms. Entries are
+// keyed by an mwm and a query token together with everything the search index request for
+// the token is built from (synonyms, categories, languages and the prefix flag), so a popular
+// token like "street" or "cafe" is looked up in the search index of an mwm only once.
+// Values don't include the changes made in the editor (see Retrieval::RetrieveIndexFeatures()),
+// so entries never become stale while the mwm is registered.
+//
+// *NOTE* This class is not thread-safe, except GetStats().
+class RetrievalCache
+{
+public:
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  using Features = Retrieval::ExtendedFeatures;
+
+  explicit RetrievalCache(size_t maxMemoryBytes);
+
+  // Returns a key of the |i|-th token of |params| which is unique within an mwm.
+  static std::string MakeTokenKey(QueryParams const & params, size_t i);
+
+  // Returns nullptr when there is no entry. The pointer is valid until the next call of
+  // a non-const method.
+  Features const * Find(MwmSet::MwmId const & id, std::string const & tokenKey);
+  void Add(MwmSet::MwmId const & id, std::string const & tokenKey, Features const & features);
+
+  // Removes all the entries of the country, called when its mwm is deregistered.
+  void Remove(std::string const & countryName);
+  void Clear();
+
+  size_t GetNumEntries() const { return m_entries.size(); }
+  size_t GetMemoryBytes() const { return m_memoryBytes; }
+  Stats GetStats() const;
+
+private:
+  using Key = std::pair<MwmSet::MwmId, std::string>;
+
+  struct Entry
+  {
+    Key m_key;
+    Features m_features;
+    size_t m_memoryBytes = 0;
+  };
+
+  using Entries = std::list<Entry>;
+
+  void Erase(Entries::iterator it);
+
+  size_t const m_maxMemoryBytes;
+  size_t m_memoryBytes = 0;
+
+  // Most recently used entries go first.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+
+  // Statistics may be read by other threads.
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+};
+
+std::string DebugPrint(RetrievalCache::Stats const & stats);
+}  // namespace search
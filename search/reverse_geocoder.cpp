@@ -17,10 +17,13 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <functional>
+#include <future>
 #include <limits>
 
 namespace search
@@ -33,6 +36,10 @@ size_t constexpr kSimilarityThresholdPercent = 10;
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Points of GetNearbyAddresses() are sorted by cells of this size and processed by chunks,
+/// which share read features.
+double constexpr kBatchCellSizeM = 200.0;
+size_t constexpr kBatchChunkSize = 4096;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets =
@@ -185,17 +192,6 @@ void ReverseGeocoder::GetNearbyStreets(FeatureType & ft, vector<Street> & street
   GetNearbyStreets(ft.GetID().m_mwmId, feature::GetCenter(ft), streets);
 }
 
-void ReverseGeocoder::GetNearbyStreetsWaysOnly(MwmSet::MwmId const & id, m2::PointD const & center,
-                                               vector<Street> & streets) const
-{
-  MwmSet::MwmHandle mwmHandle = m_dataSource.GetMwmHandleById(id);
-  if (mwmHandle.IsAlive())
-  {
-    search::MwmContext context(std::move(mwmHandle));
-    GetNearbyStreets(context, center, false /* includeSquaresAndSuburbs */, streets);
-  }
-}
-
 string ReverseGeocoder::GetFeatureStreetName(FeatureType & ft) const
 {
   Address addr;
@@ -254,6 +250,85 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, double maxDist
   }
 }
 
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points, double maxDistanceM,
+                                         size_t threadsCount, vector<Address> & addrs) const
+{
+  CHECK_GREATER(threadsCount, 0, ());
+
+  addrs.assign(points.size(), {});
+
+  // Sort points by cells, so neighbouring points, which share buildings and streets,
+  // get into the same chunk.
+  double const cellSize = mercator::MetersToMercator(kBatchCellSizeM);
+  vector<pair<m2::PointI, size_t>> order;
+  order.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    m2::PointI const cell(static_cast<int>(floor(points[i].x / cellSize)),
+                          static_cast<int>(floor(points[i].y / cellSize)));
+    order.emplace_back(cell, i);
+  }
+  sort(order.begin(), order.end());
+
+  auto const processChunk = [&](size_t begin, size_t end)
+  {
+    BatchState state(m_dataSource);
+    for (size_t i = begin; i < end; ++i)
+    {
+      size_t const index = order[i].second;
+      GetNearbyAddress(state, points[index], maxDistanceM, addrs[index]);
+    }
+  };
+
+  if (threadsCount == 1)
+  {
+    for (size_t begin = 0; begin < order.size(); begin += kBatchChunkSize)
+      processChunk(begin, min(begin + kBatchChunkSize, order.size()));
+    return;
+  }
+
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  vector<future<void>> results;
+  for (size_t begin = 0; begin < order.size(); begin += kBatchChunkSize)
+    results.push_back(pool.Submit(processChunk, begin, min(begin + kBatchChunkSize, order.size())));
+
+  for (auto & result : results)
+    result.get();
+}
+
+void ReverseGeocoder::GetNearbyAddress(BatchState & state, m2::PointD const & center,
+                                       double maxDistanceM, Address & addr) const
+{
+  vector<Building> buildings;
+  GetNearbyBuildings(state, center, maxDistanceM, buildings);
+
+  size_t triesCount = 0;
+
+  for (auto const & b : buildings)
+  {
+    // Streets of buildings don't depend on the point, so they are matched once.
+    auto it = state.m_streets.find(b.m_id);
+    if (it == state.m_streets.end())
+    {
+      Address bldAddr;
+      optional<Street> street;
+      if (GetNearbyAddress(state.m_table, b, false /* ignoreEdits */, bldAddr))
+        street = std::move(bldAddr.m_street);
+      it = state.m_streets.emplace(b.m_id, std::move(street)).first;
+    }
+
+    if (it->second)
+    {
+      addr.m_building = b;
+      addr.m_street = *it->second;
+      break;
+    }
+
+    if (++triesCount == kMaxNumTriesToApproxAddress)
+      break;
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType & ft, Address & addr) const
 {
   std::string const & hn = GetHouseNumber(ft);
@@ -292,7 +367,8 @@ bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
   {
     vector<Street> streets;
     // Get streets without squares and suburbs for backward compatibility with data.
-    GetNearbyStreetsWaysOnly(bld.m_id.m_mwmId, bld.m_center, streets);
+    if (auto * context = table.GetContext(bld.m_id.m_mwmId))
+      GetNearbyStreets(*context, bld.m_center, false /* includeSquaresAndSuburbs */, streets);
     if (res->m_streetId < streets.size())
     {
       addr.m_building = bld;
@@ -344,6 +420,39 @@ void ReverseGeocoder::GetNearbyBuildings(m2::PointD const & center, double radiu
   sort(buildings.begin(), buildings.end(), base::LessBy(&Building::m_distanceMeters));
 }
 
+void ReverseGeocoder::GetNearbyBuildings(BatchState & state, m2::PointD const & center,
+                                         double radius, vector<Building> & buildings) const
+{
+  auto const addBuilding = [&](FeatureID const & id)
+  {
+    auto it = state.m_buildings.find(id);
+    if (it == state.m_buildings.end())
+    {
+      auto & guard = state.m_guards[id.m_mwmId];
+      if (!guard)
+        guard = make_unique<FeaturesLoaderGuard>(m_dataSource, id.m_mwmId);
+
+      auto ft = guard->GetFeatureByIndex(id.m_index);
+      if (ft && GetHouseNumber(*ft).empty())
+        ft.reset();
+      it = state.m_buildings.emplace(id, std::move(ft)).first;
+    }
+
+    if (!it->second)
+      return;
+
+    auto & ft = *it->second;
+    auto const distance = feature::GetMinDistanceMeters(ft, center);
+    if (distance <= radius)
+      buildings.push_back(FromFeatureImpl(ft, GetHouseNumber(ft), distance));
+  };
+
+  auto const stop = [&]() { return buildings.size() >= kMaxNumTriesToApproxAddress; };
+
+  m_dataSource.ForClosestFeatureIDsToPoint(addBuilding, stop, center, radius, kQueryScale);
+  sort(buildings.begin(), buildings.end(), base::LessBy(&Building::m_distanceMeters));
+}
+
 // static
 ReverseGeocoder::RegionAddress ReverseGeocoder::GetNearbyRegionAddress(
     m2::PointD const & center, storage::CountryInfoGetter const & infoGetter,
@@ -395,6 +504,14 @@ ReverseGeocoder::Building ReverseGeocoder::FromFeature(FeatureType & ft, double
   return FromFeatureImpl(ft, ft.GetHouseNumber(), distMeters);
 }
 
+ReverseGeocoder::HouseTable::HouseTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
+
+ReverseGeocoder::HouseTable::~HouseTable() = default;
+
+ReverseGeocoder::BatchState::BatchState(DataSource const & dataSource) : m_table(dataSource) {}
+
+ReverseGeocoder::BatchState::~BatchState() = default;
+
 std::optional<HouseToStreetTable::Result> ReverseGeocoder::HouseTable::Get(FeatureID const & fid)
 {
   if (feature::FakeFeatureIds::IsEditorCreatedFeature(fid.m_index))
@@ -418,6 +535,21 @@ std::optional<HouseToStreetTable::Result> ReverseGeocoder::HouseTable::Get(Featu
   return value->m_house2street->Get(fid.m_index);
 }
 
+MwmContext * ReverseGeocoder::HouseTable::GetContext(MwmSet::MwmId const & id)
+{
+  if (m_context && m_context->GetId() == id)
+    return m_context.get();
+
+  auto handle = m_dataSource.GetMwmHandleById(id);
+  if (!handle.IsAlive())
+  {
+    m_context.reset();
+    return nullptr;
+  }
+  m_context = make_unique<MwmContext>(std::move(handle));
+  return m_context.get();
+}
+
 string ReverseGeocoder::Address::FormatAddress() const
 {
   // Check whether we can format address according to the query type
@@ -7,12 +7,15 @@
 
 #include "coding/string_utf8_multilang.hpp"
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class FeatureType;
+class FeaturesLoaderGuard;
 class DataSource;
 
 namespace storage
@@ -138,6 +141,12 @@ public:
   /// @return The nearest exact address where building is at most |maxDistanceM| far from |center|,
   /// has house number and valid street match.
   void GetNearbyAddress(m2::PointD const & center, double maxDistanceM, Address & addr) const;
+  /// Batch version of GetNearbyAddress() for a lot of points, e.g. for GPS tracks.
+  /// @param addrs (out) addresses in the order of |points|.
+  /// Points are processed in chunks of neighbouring ones by |threadsCount| threads,
+  /// so mwms, house to street tables and streets of buildings are loaded once for many points.
+  void GetNearbyAddresses(std::vector<m2::PointD> const & points, double maxDistanceM,
+                          size_t threadsCount, std::vector<Address> & addrs) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType & ft, Address & addr) const;
@@ -151,29 +160,50 @@ public:
                                         RegionInfoGetter const & nameGetter) const;
 
 private:
-  /// Helper class to incapsulate house 2 street table reloading.
+  /// Helper class to incapsulate house 2 street table and mwm context reloading.
   class HouseTable
   {
   public:
-    explicit HouseTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
+    explicit HouseTable(DataSource const & dataSource);
+    ~HouseTable();
+
     std::optional<HouseToStreetTable::Result> Get(FeatureID const & fid);
+    /// @return nullptr if the mwm is not alive.
+    MwmContext * GetContext(MwmSet::MwmId const & id);
 
   private:
     DataSource const & m_dataSource;
     MwmSet::MwmHandle m_handle;
+    std::unique_ptr<MwmContext> m_context;
   };
 
-  /// Old data compatible method to retrieve nearby streets.
-  void GetNearbyStreetsWaysOnly(MwmSet::MwmId const & id, m2::PointD const & center,
-                                std::vector<Street> & streets) const;
+  /// Features and streets, which are shared by neighbouring points in GetNearbyAddresses().
+  struct BatchState
+  {
+    explicit BatchState(DataSource const & dataSource);
+    ~BatchState();
+
+    HouseTable m_table;
+    std::map<MwmSet::MwmId, std::unique_ptr<FeaturesLoaderGuard>> m_guards;
+    /// Read buildings with house numbers, nullptr for the other features.
+    std::unordered_map<FeatureID, std::unique_ptr<FeatureType>> m_buildings;
+    /// Matched streets of buildings, nullopt when the street is not found.
+    std::unordered_map<FeatureID, std::optional<Street>> m_streets;
+  };
 
   /// Ignores changes from editor if |ignoreEdits| is true.
   bool GetNearbyAddress(HouseTable & table, Building const & bld, bool ignoreEdits,
                         Address & addr) const;
 
+  void GetNearbyAddress(BatchState & state, m2::PointD const & center, double maxDistanceM,
+                        Address & addr) const;
+
   /// @return Sorted by distance houses vector with valid house number.
   void GetNearbyBuildings(m2::PointD const & center, double maxDistanceM,
                           std::vector<Building> & buildings) const;
+  /// Same as above, but reads only features which are not in |state| yet.
+  void GetNearbyBuildings(BatchState & state, m2::PointD const & center, double maxDistanceM,
+                          std::vector<Building> & buildings) const;
 
   static Building FromFeature(FeatureType & ft, double distMeters);
 };
@@ -0,0 +1,267 @@
+// Times coding::CompressedBitVector intersections and unions on the bit vectors the geocoder
+// actually works with: features retrieved from the search index of an mwm by query tokens and
+// features retrieved from the geometry index by rects. The results are compared with
+// the straightforward one bit group (or one position) at a time implementations.
+
+#include "search/search_quality/helpers.hpp"
+
+#include "search/feature_offset_match.hpp"
+#include "search/mwm_context.hpp"
+#include "search/retrieval.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/scales.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/string_utf8_multilang.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/dfa_helpers.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+using namespace search::search_quality;
+using namespace search;
+using namespace std;
+
+DEFINE_string(data_path, "", "Path to data directory (resources dir)");
+DEFINE_string(mwm_path, "", "Path to the mwm file, a large city works best");
+DEFINE_string(queries_path, "", "Path to the file with queries, one per line");
+DEFINE_int32(rects, 8, "Number of rects per side of the mwm grid to retrieve geometry features");
+DEFINE_int32(runs, 5, "Number of runs of every benchmark");
+
+namespace
+{
+using coding::CompressedBitVector;
+using coding::CompressedBitVectorBuilder;
+using coding::DenseCBV;
+using coding::SparseCBV;
+
+using CBVPtr = unique_ptr<CompressedBitVector>;
+
+CBVPtr ToCompressedBitVector(CBV const & cbv)
+{
+  vector<uint64_t> bits;
+  cbv.ForEach([&bits](uint64_t bit) { bits.push_back(bit); });
+  return CompressedBitVectorBuilder::FromBitPositions(std::move(bits));
+}
+
+// Straightforward implementations the library ones are compared with ------------------------------
+CBVPtr ReferenceIntersect(CompressedBitVector const & lhs, CompressedBitVector const & rhs)
+{
+  using Strategy = CompressedBitVector::StorageStrategy;
+  if (lhs.GetStorageStrategy() == Strategy::Dense && rhs.GetStorageStrategy() == Strategy::Dense)
+  {
+    auto const & a = static_cast<DenseCBV const &>(lhs);
+    auto const & b = static_cast<DenseCBV const &>(rhs);
+    vector<uint64_t> groups(min(a.NumBitGroups(), b.NumBitGroups()));
+    for (size_t i = 0; i < groups.size(); ++i)
+      groups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    return CompressedBitVectorBuilder::FromBitGroups(std::move(groups));
+  }
+
+  if (lhs.GetStorageStrategy() == Strategy::Sparse && rhs.GetStorageStrategy() == Strategy::Sparse)
+  {
+    auto const & a = static_cast<SparseCBV const &>(lhs);
+    auto const & b = static_cast<SparseCBV const &>(rhs);
+    vector<uint64_t> positions;
+    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(positions));
+    return make_unique<SparseCBV>(std::move(positions));
+  }
+
+  bool const lhsIsSparse = lhs.GetStorageStrategy() == Strategy::Sparse;
+  auto const & dense = static_cast<DenseCBV const &>(lhsIsSparse ? rhs : lhs);
+  auto const & sparse = static_cast<SparseCBV const &>(lhsIsSparse ? lhs : rhs);
+  vector<uint64_t> positions;
+  for (auto it = sparse.Begin(); it != sparse.End(); ++it)
+  {
+    if (dense.GetBit(*it))
+      positions.push_back(*it);
+  }
+  return make_unique<SparseCBV>(std::move(positions));
+}
+
+CBVPtr ReferenceUnion(CompressedBitVector const & lhs, CompressedBitVector const & rhs)
+{
+  using Strategy = CompressedBitVector::StorageStrategy;
+  if (lhs.GetStorageStrategy() == Strategy::Dense && rhs.GetStorageStrategy() == Strategy::Dense)
+  {
+    auto const & a = static_cast<DenseCBV const &>(lhs);
+    auto const & b = static_cast<DenseCBV const &>(rhs);
+    vector<uint64_t> groups(max(a.NumBitGroups(), b.NumBitGroups()));
+    for (size_t i = 0; i < groups.size(); ++i)
+      groups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
+    return CompressedBitVectorBuilder::FromBitGroups(std::move(groups));
+  }
+
+  vector<uint64_t> a;
+  vector<uint64_t> b;
+  coding::CompressedBitVectorEnumerator::ForEach(lhs, [&a](uint64_t bit) { a.push_back(bit); });
+  coding::CompressedBitVectorEnumerator::ForEach(rhs, [&b](uint64_t bit) { b.push_back(bit); });
+  vector<uint64_t> positions;
+  set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(positions));
+  return CompressedBitVectorBuilder::FromBitPositions(std::move(positions));
+}
+
+// Benchmarks --------------------------------------------------------------------------------------
+using Pairs = vector<pair<CompressedBitVector const *, CompressedBitVector const *>>;
+
+template <typename Op>
+double Time(Pairs const & pairs, Op && op, uint64_t & checksum)
+{
+  double best = numeric_limits<double>::max();
+  for (int run = 0; run < FLAGS_runs; ++run)
+  {
+    checksum = 0;
+    base::Timer timer;
+    for (auto const & [a, b] : pairs)
+      checksum += op(*a, *b)->PopCount();
+    best = min(best, timer.ElapsedSeconds());
+  }
+  return best;
+}
+
+template <typename Op, typename ReferenceOp>
+void Benchmark(string const & name, Pairs const & pairs, Op && op, ReferenceOp && referenceOp)
+{
+  if (pairs.empty())
+    return;
+
+  uint64_t checksum = 0;
+  uint64_t referenceChecksum = 0;
+  double const seconds = Time(pairs, op, checksum);
+  double const referenceSeconds = Time(pairs, referenceOp, referenceChecksum);
+  CHECK_EQUAL(checksum, referenceChecksum, (name));
+
+  cout << setw(28) << left << name << setw(8) << right << pairs.size() << " pairs"
+       << fixed << setprecision(3) << setw(10) << referenceSeconds * 1000 << "ms"
+       << setw(10) << seconds * 1000 << "ms" << setw(8) << setprecision(2)
+       << referenceSeconds / max(seconds, 1e-9) << "x" << endl;
+}
+
+string GetStrategyName(CompressedBitVector const & cbv)
+{
+  return cbv.GetStorageStrategy() == CompressedBitVector::StorageStrategy::Dense ? "dense"
+                                                                                 : "sparse";
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  gflags::SetUsageMessage("Compressed bit vector operations benchmark.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_mwm_path.empty() || FLAGS_queries_path.empty())
+  {
+    gflags::ShowUsageWithFlagsRestrict(argv[0], "cbv_benchmark_tool");
+    return -1;
+  }
+
+  if (!FLAGS_data_path.empty())
+    GetPlatform().SetResourceDir(FLAGS_data_path);
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  auto const [mwmId, regResult] =
+      dataSource.RegisterMap(platform::LocalCountryFile::MakeTemporary(FLAGS_mwm_path));
+  CHECK_EQUAL(regResult, MwmSet::RegResult::Success, (FLAGS_mwm_path));
+
+  MwmContext context(dataSource.GetMwmHandleById(mwmId));
+  base::Cancellable const cancellable;
+  Retrieval retrieval(context, cancellable);
+
+  vector<string> queries;
+  ReadStringsFromFile(FLAGS_queries_path, queries);
+
+  vector<int8_t> langs;
+  for (int8_t lang = 0; lang < StringUtf8Multilang::kMaxSupportedLanguages; ++lang)
+    langs.push_back(lang);
+
+  // Features of every query token, grouped by queries.
+  vector<vector<CBVPtr>> tokenFeatures;
+  for (auto const & query : queries)
+  {
+    vector<CBVPtr> features;
+    for (auto const & token : NormalizeAndTokenizeString(query))
+    {
+      SearchTrieRequest<strings::UniStringDFA> request;
+      request.m_names.emplace_back(token);
+      request.SetLangs(langs);
+      auto cbv = ToCompressedBitVector(retrieval.RetrieveAddressFeatures(request).m_features);
+      if (cbv->PopCount() != 0)
+        features.push_back(std::move(cbv));
+    }
+    tokenFeatures.push_back(std::move(features));
+  }
+
+  vector<CBVPtr> rectFeatures;
+  auto const bounds = context.GetInfo()->m_bordersRect;
+  double const width = bounds.SizeX() / FLAGS_rects;
+  double const height = bounds.SizeY() / FLAGS_rects;
+  for (int i = 0; i < FLAGS_rects; ++i)
+  {
+    for (int j = 0; j < FLAGS_rects; ++j)
+    {
+      m2::RectD const rect(bounds.minX() + i * width, bounds.minY() + j * height,
+                           bounds.minX() + (i + 1) * width, bounds.minY() + (j + 1) * height);
+      rectFeatures.push_back(ToCompressedBitVector(
+          retrieval.RetrieveGeometryFeatures(rect, scales::GetUpperScale())));
+    }
+  }
+
+  // Pairs are grouped by storage strategies of the operands.
+  map<string, Pairs> pairs;
+  auto const addPair = [&pairs](string const & prefix, CompressedBitVector const & a,
+                                CompressedBitVector const & b) {
+    auto strategies = make_pair(GetStrategyName(a), GetStrategyName(b));
+    if (strategies.first > strategies.second)
+      swap(strategies.first, strategies.second);
+    pairs[prefix + " " + strategies.first + "/" + strategies.second].emplace_back(&a, &b);
+  };
+
+  size_t numTokenFeatures = 0;
+  for (auto const & features : tokenFeatures)
+  {
+    numTokenFeatures += features.size();
+    for (size_t i = 0; i < features.size(); ++i)
+    {
+      for (size_t j = i + 1; j < features.size(); ++j)
+        addPair("tokens", *features[i], *features[j]);
+      for (auto const & rect : rectFeatures)
+        addPair("token-rect", *features[i], *rect);
+    }
+  }
+
+  LOG(LINFO, ("Retrieved", numTokenFeatures, "token and", rectFeatures.size(),
+              "rect bit vectors from", context.GetName()));
+
+  cout << setw(28) << left << "Intersect" << setw(14) << right << "" << setw(12) << "reference"
+       << setw(12) << "library" << endl;
+  for (auto const & [name, ps] : pairs)
+    Benchmark(name, ps, &CompressedBitVector::Intersect, &ReferenceIntersect);
+
+  cout << endl << "Union" << endl;
+  for (auto const & [name, ps] : pairs)
+    Benchmark(name, ps, &CompressedBitVector::Union, &ReferenceUnion);
+  return 0;
+}
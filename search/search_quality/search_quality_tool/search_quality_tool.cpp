@@ -58,6 +58,9 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_bool(parallel, false,
+            "Post all the queries to the engine at once and report the throughput and latency "
+            "percentiles. Use together with --num_threads");
 
 string const kDefaultQueriesPathSuffix =
     "/../search/search_quality/search_quality_tool/queries.txt";
@@ -324,10 +327,20 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
     csv << endl;
   }
 
+  base::Timer timer;
+  if (FLAGS_parallel)
+  {
+    for (auto & request : requests)
+      request->Start();
+    for (auto & request : requests)
+      request->Wait();
+  }
+
   vector<double> responseTimes(queries.size());
   for (size_t i = 0; i < queries.size(); ++i)
   {
-    requests[i]->Run();
+    if (!FLAGS_parallel)
+      requests[i]->Run();
     auto rt = duration_cast<milliseconds>(requests[i]->ResponseTime()).count();
     responseTimes[i] = static_cast<double>(rt) / 1000;
     PrintTopResults(MakePrefixFree(queries[i]), requests[i]->Results(), top, responseTimes[i]);
@@ -353,6 +366,27 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
   cout << "Maximum response time: " << maxTime << "s" << endl;
   cout << "Average response time: " << averageTime << "s"
        << " (std. dev. " << stdDevTime << "s)" << endl;
+
+  if (FLAGS_parallel)
+  {
+    double const elapsedSeconds = timer.ElapsedSeconds();
+    auto const stats = engine.GetStats();
+    // Unlike response times above, latencies include the time spent in the engine queue.
+    cout << "Total time: " << elapsedSeconds << "s"
+         << " (" << static_cast<double>(queries.size()) / max(elapsedSeconds, 1e-9)
+         << " queries/s with " << engine.GetNumThreads() << " threads)" << endl;
+    cout << "Latency p50: " << stats.m_latency.m_p50Ms << "ms"
+         << ", p90: " << stats.m_latency.m_p90Ms << "ms"
+         << ", p99: " << stats.m_latency.m_p99Ms << "ms"
+         << ", max: " << stats.m_latency.m_maxMs << "ms" << endl;
+  }
+
+  auto const stats = engine.GetStats();
+  auto const lookups = stats.m_retrievalCacheHits + stats.m_retrievalCacheMisses;
+  cout << "Retrieval cache hits: " << stats.m_retrievalCacheHits << " of " << lookups << " ("
+       << 100.0 * static_cast<double>(stats.m_retrievalCacheHits) /
+              static_cast<double>(max(lookups, uint64_t{1}))
+       << "%)" << endl;
 }
 
 int main(int argc, char * argv[])
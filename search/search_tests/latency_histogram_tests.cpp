@@ -0,0 +1,101 @@
+#include "testing/testing.hpp"
+
+#include "search/latency_histogram.hpp"
+
+#include "base/thread_pool_computational.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace latency_histogram_tests
+{
+using namespace search;
+using namespace std;
+
+UNIT_TEST(LatencyHistogram_Empty)
+{
+  LatencyHistogram histogram;
+  auto const snapshot = histogram.GetSnapshot();
+  TEST_EQUAL(snapshot.m_count, 0, ());
+  TEST_EQUAL(snapshot.m_p50Ms, 0, ());
+  TEST_EQUAL(snapshot.m_p99Ms, 0, ());
+  TEST_EQUAL(snapshot.m_maxMs, 0, ());
+}
+
+UNIT_TEST(LatencyHistogram_Exact)
+{
+  LatencyHistogram histogram;
+  for (uint64_t ms = 1; ms <= 10; ++ms)
+    histogram.Add(ms);
+
+  auto const snapshot = histogram.GetSnapshot();
+  TEST_EQUAL(snapshot.m_count, 10, ());
+  TEST_EQUAL(snapshot.m_p50Ms, 5, ());
+  TEST_EQUAL(snapshot.m_p90Ms, 9, ());
+  TEST_EQUAL(snapshot.m_p99Ms, 10, ());
+  TEST_EQUAL(snapshot.m_maxMs, 10, ());
+  TEST_ALMOST_EQUAL_ABS(snapshot.m_meanMs, 5.5, 1e-9, ());
+
+  histogram.Clear();
+  TEST_EQUAL(histogram.GetSnapshot().m_count, 0, ());
+}
+
+UNIT_TEST(LatencyHistogram_RelativeError)
+{
+  mt19937 rng(1 /* seed */);
+  uniform_int_distribution<uint64_t> distribution(0, 100000);
+
+  LatencyHistogram histogram;
+  vector<uint64_t> latencies(10000);
+  for (auto & ms : latencies)
+  {
+    ms = distribution(rng);
+    histogram.Add(ms);
+  }
+  sort(latencies.begin(), latencies.end());
+
+  auto const snapshot = histogram.GetSnapshot();
+  auto const check = [&](uint64_t actual, double percent) {
+    auto const expected = latencies[static_cast<size_t>(percent / 100.0 * latencies.size()) - 1];
+    TEST_GREATER_OR_EQUAL(actual, expected, (percent));
+    TEST_LESS_OR_EQUAL(actual, expected + expected / 8, (percent));
+  };
+  check(snapshot.m_p50Ms, 50.0);
+  check(snapshot.m_p90Ms, 90.0);
+  check(snapshot.m_p99Ms, 99.0);
+  TEST_EQUAL(snapshot.m_maxMs, latencies.back(), ());
+}
+
+UNIT_TEST(LatencyHistogram_Huge)
+{
+  LatencyHistogram histogram;
+  histogram.Add(numeric_limits<uint64_t>::max());
+  auto const snapshot = histogram.GetSnapshot();
+  TEST_EQUAL(snapshot.m_p50Ms, numeric_limits<uint64_t>::max(), ());
+}
+
+UNIT_TEST(LatencyHistogram_Concurrent)
+{
+  size_t constexpr kThreads = 4;
+  size_t constexpr kPerThread = 10000;
+
+  LatencyHistogram histogram;
+  base::thread_pool::computational::ThreadPool pool(kThreads);
+  vector<future<void>> results;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    results.push_back(pool.Submit([&histogram]() {
+      for (size_t j = 0; j < kPerThread; ++j)
+        histogram.Add(j % 100);
+    }));
+  }
+  for (auto & result : results)
+    result.wait();
+
+  TEST_EQUAL(histogram.GetSnapshot().m_count, kThreads * kPerThread, ());
+}
+}  // namespace latency_histogram_tests
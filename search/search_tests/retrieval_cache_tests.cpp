@@ -0,0 +1,128 @@
+#include "testing/testing.hpp"
+
+#include "search/cbv.hpp"
+#include "search/query_params.hpp"
+#include "search/retrieval_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace retrieval_cache_tests
+{
+using namespace search;
+using namespace std;
+
+using Features = RetrievalCache::Features;
+
+// Sparse bit vectors of |n| features take 2 * 8 * |n| bytes.
+Features MakeFeatures(uint64_t first, size_t n)
+{
+  vector<uint64_t> positions;
+  for (size_t i = 0; i < n; ++i)
+    positions.push_back(first + 1000 * i);
+  return Features(CBV(coding::CompressedBitVectorBuilder::FromBitPositions(positions)),
+                  CBV(coding::CompressedBitVectorBuilder::FromBitPositions(positions)));
+}
+
+UNIT_TEST(RetrievalCache_Smoke)
+{
+  MwmSet::MwmId const id(make_shared<MwmInfo>());
+  RetrievalCache cache(1000 /* maxMemoryBytes */);
+
+  TEST(!cache.Find(id, "cafe"), ());
+  cache.Add(id, "cafe", MakeFeatures(10 /* first */, 5 /* n */));
+
+  auto const * features = cache.Find(id, "cafe");
+  TEST(features, ());
+  TEST(features->m_features.HasBit(10), ());
+  TEST(features->m_features.HasBit(4010), ());
+  TEST_EQUAL(features->m_features.PopCount(), 5, ());
+
+  TEST(!cache.Find(MwmSet::MwmId(make_shared<MwmInfo>()), "cafe"), ());
+  TEST(!cache.Find(id, "bar"), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetMemoryBytes(), 0, ());
+  TEST(!cache.Find(id, "cafe"), ());
+}
+
+UNIT_TEST(RetrievalCache_Eviction)
+{
+  MwmSet::MwmId const id(make_shared<MwmInfo>());
+  RetrievalCache cache(200 /* maxMemoryBytes */);
+
+  cache.Add(id, "a", MakeFeatures(0 /* first */, 5 /* n */));
+  cache.Add(id, "b", MakeFeatures(1 /* first */, 5 /* n */));
+  TEST_EQUAL(cache.GetMemoryBytes(), 160, ());
+
+  // "a" becomes the most recently used entry, so "b" is evicted.
+  TEST(cache.Find(id, "a"), ());
+  cache.Add(id, "c", MakeFeatures(2 /* first */, 5 /* n */));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetMemoryBytes(), 160, ());
+  TEST(cache.Find(id, "a"), ());
+  TEST(!cache.Find(id, "b"), ());
+  TEST(cache.Find(id, "c"), ());
+  TEST_EQUAL(cache.GetStats().m_evictions, 1, ());
+
+  // Entries larger than a half of the cache are not added.
+  cache.Add(id, "d", MakeFeatures(3 /* first */, 7 /* n */));
+  TEST(!cache.Find(id, "d"), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  // Re-adding replaces the entry.
+  cache.Add(id, "a", MakeFeatures(0 /* first */, 2 /* n */));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetMemoryBytes(), 112, ());
+}
+
+UNIT_TEST(RetrievalCache_RemoveDeregistered)
+{
+  // Default MwmInfo has the deregistered status.
+  MwmSet::MwmId const id(make_shared<MwmInfo>());
+  RetrievalCache cache(1000 /* maxMemoryBytes */);
+
+  cache.Add(id, "a", MakeFeatures(0 /* first */, 5 /* n */));
+  cache.Add(id, "b", MakeFeatures(1 /* first */, 5 /* n */));
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  cache.Remove("Wonderland");
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetMemoryBytes(), 0, ());
+}
+
+UNIT_TEST(RetrievalCache_TokenKey)
+{
+  vector<strings::UniString> const tokens = {strings::MakeUniString("cafe"),
+                                             strings::MakeUniString("cafe")};
+
+  QueryParams params;
+  params.Init("cafe cafe", tokens, true /* isLastPrefix */);
+
+  // Same token as a full token and as a prefix must have different keys.
+  TEST_NOT_EQUAL(RetrievalCache::MakeTokenKey(params, 0), RetrievalCache::MakeTokenKey(params, 1),
+                 ());
+
+  QueryParams other;
+  other.Init("cafe cafe", tokens, false /* isLastPrefix */);
+  TEST_EQUAL(RetrievalCache::MakeTokenKey(params, 0), RetrievalCache::MakeTokenKey(other, 1), ());
+
+  other.GetTypeIndices(1).push_back(1);
+  TEST_NOT_EQUAL(RetrievalCache::MakeTokenKey(params, 0), RetrievalCache::MakeTokenKey(other, 1),
+                 ());
+}
+}  // namespace retrieval_cache_tests
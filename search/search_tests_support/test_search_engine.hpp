@@ -29,6 +29,9 @@ public:
 
   std::weak_ptr<ProcessorHandle> Search(SearchParams const & params);
 
+  size_t GetNumThreads() const { return m_engine.GetNumThreads(); }
+  Engine::Stats GetStats() const { return m_engine.GetStats(); }
+
   storage::CountryInfoGetter & GetCountryInfoGetter() { return *m_infoGetter; }
 
 private:
@@ -184,6 +184,7 @@ CPUDrawer::CPUDrawer(Params const & params)
                                         "fonts_whitelist.txt",
                                         "fonts_blacklist.txt",
                                         2 * 1024 * 1024, m_visualScale, false);
+  glyphParams.m_rasterCache = params.m_glyphRasterCache;
   m_renderer = make_unique<SoftwareRenderer>(glyphParams, params.m_resourcesPrefix);
 }
 
@@ -308,9 +309,9 @@ void CPUDrawer::DrawSearchArrow(double azimut)
   m_renderer->DrawPath(path, m);
 }
 
-void CPUDrawer::EndFrame(FrameImage & image)
+void CPUDrawer::EndFrame(FrameImage & image, bool encodePng)
 {
-  m_renderer->EndFrame(image);
+  m_renderer->EndFrame(image, encodePng);
   m_stylers.clear();
   m_areasGeometry.clear();
   m_pathGeometry.clear();
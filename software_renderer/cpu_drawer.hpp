@@ -18,6 +18,11 @@
 #include <memory>
 #include <string>
 
+namespace dp
+{
+class GlyphRasterCache;
+}  // namespace dp
+
 namespace software_renderer
 {
 class SoftwareRenderer;
@@ -34,6 +39,8 @@ public:
 
     std::string m_resourcesPrefix;
     double m_visualScale;
+    // Can be shared by several drawers.
+    std::shared_ptr<dp::GlyphRasterCache> m_glyphRasterCache;
   };
 
   CPUDrawer(Params const & params);
@@ -44,7 +51,7 @@ public:
   void DrawMyPosition(m2::PointD const & myPxPotision);
   void DrawSearchResult(m2::PointD const & pxPosition);
   void DrawSearchArrow(double azimut);
-  void EndFrame(FrameImage & image);
+  void EndFrame(FrameImage & image, bool encodePng = true);
 
   GlyphCache * GetGlyphCache() const;
 
@@ -18,10 +18,10 @@ struct FrameImage
 {
   // image data.
   // TopLeft-to-RightBottom order
-  // Format - png
+  // Format - png, or raw RGBA when requested
   std::vector<uint8_t> m_data;
   uint32_t m_width = 0;       // pixel width of image
   uint32_t m_height = 0;      // pixel height of image
-  uint32_t m_stride = 0;      // row stride in bytes
+  uint32_t m_stride = 0;      // row stride in bytes of RGBA pixels (of the decoded image for png)
 };
 }  // namespace software_renderer
@@ -2,6 +2,12 @@
 
 #include "software_renderer/glyph_cache_impl.hpp"
 
+#include "drape/glyph_raster_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include <sstream>
+
 namespace software_renderer
 {
 GlyphKey::GlyphKey(strings::UniChar symbolCode,
@@ -61,6 +67,17 @@ GlyphCache::GlyphCache(Params const & params) : m_impl(new GlyphCacheImpl(params
 {
 }
 
+// static
+std::string GlyphCache::GetRasterCacheFingerprint(double visualScale)
+{
+  Platform::FilesList fonts;
+  GetPlatform().GetFontNames(fonts);
+
+  std::ostringstream os;
+  os << "software " << visualScale;
+  return dp::GlyphRasterCache::MakeFingerprint(std::move(fonts), os.str());
+}
+
 void GlyphCache::addFonts(std::vector<std::string> const & fontNames)
 {
   m_impl->addFonts(fontNames);
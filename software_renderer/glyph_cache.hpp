@@ -9,6 +9,11 @@
 #include <utility>
 #include <vector>
 
+namespace dp
+{
+class GlyphRasterCache;
+}  // namespace dp
+
 namespace software_renderer
 {
 /// metrics of the single glyph
@@ -65,6 +70,8 @@ public:
     size_t m_maxSize;
     double m_visualScale;
     bool m_isDebugging;
+    /// Rendered bitmaps are taken from and stored to this cache when it's set.
+    std::shared_ptr<dp::GlyphRasterCache> m_rasterCache;
     Params(std::string const & blocksFile,
            std::string const & whiteListFile,
            std::string const & blackListFile,
@@ -76,6 +83,9 @@ public:
   GlyphCache();
   GlyphCache(Params const & params);
 
+  /// Returns the fingerprint of bitmaps which GlyphCache with |visualScale| puts to the raster cache.
+  static std::string GetRasterCacheFingerprint(double visualScale);
+
   void reset();
   void addFonts(std::vector<std::string> const & fontNames);
 
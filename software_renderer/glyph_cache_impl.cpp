@@ -1,5 +1,7 @@
 #include "software_renderer/glyph_cache_impl.hpp"
 
+#include "drape/glyph_raster_cache.hpp"
+
 #include "platform/platform.hpp"
 
 #include "coding/reader.hpp"
@@ -21,6 +23,15 @@
 
 namespace software_renderer
 {
+namespace
+{
+/// Bitmaps of software renderer in GlyphRasterCache are keyed by glyph indices and
+/// marked with these flags. Stroked bitmaps depend on the stroke radius.
+uint32_t constexpr kRasterCacheFlag = 1 << 0;
+uint32_t constexpr kRasterCacheStrokedFlag = 1 << 1;
+uint32_t constexpr kRasterCacheStrokeRadiusShift = 8;
+}  // namespace
+
 UnicodeBlock::UnicodeBlock(std::string const & name, strings::UniChar start, strings::UniChar end)
   : m_name(name), m_start(start), m_end(end)
 {}
@@ -222,6 +233,7 @@ void GlyphCacheImpl::addFont(char const * fileName)
     return;
 
   std::shared_ptr<Font> pFont(new Font(GetPlatform().GetReader(fileName)));
+  pFont->m_name = fileName;
 
   // Obtaining all glyphs, supported by this font. Call to FTCHECKRETURN functions may return
   // from routine, so add font to fonts array only in the end.
@@ -373,6 +385,8 @@ std::vector<std::shared_ptr<Font>> & GlyphCacheImpl::getFonts(strings::UniChar s
 GlyphCacheImpl::GlyphCacheImpl(GlyphCache::Params const & params)
 {
   m_isDebugging = params.m_isDebugging;
+  m_rasterCache = params.m_rasterCache;
+  m_strokeRadius = FT_Fixed(params.m_visualScale * 2 * 64);
 
   initBlocks(params.m_blocksFile);
   initFonts(params.m_whiteListFile, params.m_blackListFile);
@@ -392,7 +406,7 @@ GlyphCacheImpl::GlyphCacheImpl(GlyphCache::Params const & params)
 
     /// Initializing stroker
     FREETYPE_CHECK(FT_Stroker_New(m_lib, &m_stroker));
-    FT_Stroker_Set(m_stroker, FT_Fixed(params.m_visualScale * 2 * 64), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+    FT_Stroker_Set(m_stroker, m_strokeRadius, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
 
     FREETYPE_CHECK(FTC_CMapCache_New(m_manager, &m_charMapCache));
   }
@@ -527,6 +541,32 @@ std::shared_ptr<GlyphBitmap> const GlyphCacheImpl::getGlyphBitmap(GlyphKey const
 {
   std::pair<Font *, int> charIDX = getCharIDX(key);
 
+  bool const useRasterCache = m_rasterCache != nullptr && charIDX.first != nullptr;
+  dp::GlyphRasterCache::Key cacheKey;
+  if (useRasterCache)
+  {
+    cacheKey.m_font = charIDX.first->m_name;
+    cacheKey.m_glyphId = static_cast<uint32_t>(charIDX.second);
+    cacheKey.m_size = static_cast<uint32_t>(key.m_fontSize);
+    cacheKey.m_flags = kRasterCacheFlag;
+    if (key.m_isMask)
+    {
+      cacheKey.m_flags |= kRasterCacheStrokedFlag |
+                          static_cast<uint32_t>(m_strokeRadius) << kRasterCacheStrokeRadiusShift;
+    }
+
+    dp::GlyphRasterCache::Glyph cached;
+    if (m_rasterCache->Find(cacheKey, cached))
+    {
+      auto bitmap = std::make_shared<GlyphBitmap>();
+      bitmap->m_width = cached.m_width;
+      bitmap->m_height = cached.m_height;
+      bitmap->m_pitch = cached.m_pitch;
+      bitmap->m_data = std::move(cached.m_data);
+      return bitmap;
+    }
+  }
+
   FTC_ScalerRec fontScaler =
   {
     static_cast<FTC_FaceID>(charIDX.first),
@@ -582,6 +622,16 @@ std::shared_ptr<GlyphBitmap> const GlyphCacheImpl::getGlyphBitmap(GlyphKey const
 
   FTC_Node_Unref(node, m_manager);
 
+  if (useRasterCache)
+  {
+    dp::GlyphRasterCache::Glyph cached;
+    cached.m_width = bitmap->m_width;
+    cached.m_height = bitmap->m_height;
+    cached.m_pitch = bitmap->m_pitch;
+    cached.m_data = bitmap->m_data;
+    m_rasterCache->Add(cacheKey, cached);
+  }
+
   return std::shared_ptr<GlyphBitmap>(bitmap);
 }
 
@@ -24,6 +24,7 @@ struct Font
 {
   FT_Stream m_fontStream;
   ReaderPtr<Reader> m_fontReader;
+  std::string m_name;
 
   /// information about symbol ranges
   /// ...
@@ -81,6 +82,10 @@ struct GlyphCacheImpl
   typedef std::vector<std::shared_ptr<Font> > TFonts;
   TFonts m_fonts;
 
+  std::shared_ptr<dp::GlyphRasterCache> m_rasterCache;
+  /// stroke radius in 26.6 fixed point format
+  FT_Fixed m_strokeRadius;
+
   static FT_Error RequestFace(FTC_FaceID faceID, FT_Library library, FT_Pointer requestData, FT_Face * face);
 
   void initBlocks(std::string const & fileName);
@@ -566,19 +566,35 @@ void StbiWritePngFunc(void * context, void * data, int size)
 }
 } //  namespace
 
-void SoftwareRenderer::EndFrame(FrameImage & image)
+void EncodePng(uint8_t const * rgba, uint32_t width, uint32_t height, uint32_t stride,
+               FrameImage & image)
 {
-  ASSERT(m_frameWidth > 0 && m_frameHeight > 0, ());
+  uint8_t const kComponentsCount = 4;
+  image.m_stride = width * kComponentsCount;
+  image.m_width = width;
+  image.m_height = height;
+
+  stbi_write_png_to_func(&StbiWritePngFunc, &image, width, height, kComponentsCount, rgba,
+                         stride);
+}
 
-  image.m_stride = m_frameWidth;
-  image.m_width = m_frameWidth;
-  image.m_height = m_frameHeight;
+void SoftwareRenderer::EndFrame(FrameImage & image, bool encodePng)
+{
+  ASSERT(m_frameWidth > 0 && m_frameHeight > 0, ());
 
-  uint8_t const  kComponentsCount = 4;
   uint8_t const kBytesPerPixel = 4;
-  stbi_write_png_to_func(&StbiWritePngFunc, &image, m_frameWidth, m_frameHeight,
-                         kComponentsCount, m_frameBuffer.data(),
-                         m_frameWidth * kBytesPerPixel);
+  if (encodePng)
+  {
+    EncodePng(m_frameBuffer.data(), m_frameWidth, m_frameHeight, m_frameWidth * kBytesPerPixel,
+              image);
+  }
+  else
+  {
+    image.m_width = m_frameWidth;
+    image.m_height = m_frameHeight;
+    image.m_stride = m_frameWidth * kBytesPerPixel;
+    image.m_data.assign(m_frameBuffer.begin(), m_frameBuffer.end());
+  }
   m_frameWidth = 0;
   m_frameHeight = 0;
 }
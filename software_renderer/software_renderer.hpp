@@ -31,6 +31,10 @@ namespace software_renderer
 {
 class PathWrapper;
 
+// Encodes |height| rows of |width| RGBA pixels which start every |stride| bytes.
+void EncodePng(uint8_t const * rgba, uint32_t width, uint32_t height, uint32_t stride,
+               FrameImage & image);
+
 class SoftwareRenderer
 {
 public:
@@ -70,7 +74,8 @@ public:
                            strings::UniString const & text,
                            std::vector<m2::RectD> & rects);
 
-  void EndFrame(FrameImage & image);
+  // When |encodePng| is false, |image| gets raw RGBA pixels.
+  void EndFrame(FrameImage & image, bool encodePng = true);
   m2::RectD FrameRect() const;
 
   GlyphCache * GetGlyphCache() const { return m_glyphCache.get(); }
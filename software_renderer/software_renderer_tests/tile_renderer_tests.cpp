@@ -0,0 +1,123 @@
+#include "testing/testing.hpp"
+
+#include "software_renderer/cpu_drawer.hpp"
+#include "software_renderer/frame_image.hpp"
+#include "software_renderer/tile_renderer.hpp"
+
+#include "drape_frontend/visual_params.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "3party/stb_image/stb_image.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tile_renderer_tests
+{
+using namespace software_renderer;
+using namespace std;
+
+uint32_t constexpr kBytesPerPixel = 4;
+
+// Decodes |png| and checks its size, returns an empty vector on failure.
+vector<uint8_t> DecodePng(vector<uint8_t> const & png, uint32_t width, uint32_t height)
+{
+  int w = 0;
+  int h = 0;
+  int components = 0;
+  uint8_t * data = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h,
+                                         &components, kBytesPerPixel);
+  if (data == nullptr)
+    return {};
+  SCOPE_GUARD(freeData, [data]() { stbi_image_free(data); });
+
+  TEST_EQUAL(w, static_cast<int>(width), ());
+  TEST_EQUAL(h, static_cast<int>(height), ());
+  return vector<uint8_t>(data, data + width * height * kBytesPerPixel);
+}
+
+void TestFilled(vector<uint8_t> const & rgba, dp::Color const & color)
+{
+  TEST(!rgba.empty(), ());
+  TEST_EQUAL(rgba.size() % kBytesPerPixel, 0, ());
+  for (size_t i = 0; i < rgba.size(); i += kBytesPerPixel)
+  {
+    TEST_EQUAL(rgba[i], color.GetRed(), (i));
+    TEST_EQUAL(rgba[i + 1], color.GetGreen(), (i));
+    TEST_EQUAL(rgba[i + 2], color.GetBlue(), (i));
+    TEST_EQUAL(rgba[i + 3], color.GetAlpha(), (i));
+  }
+}
+
+UNIT_TEST(CPUDrawer_EndFrameModes)
+{
+  classificator::Load();
+
+  uint32_t constexpr kWidth = 16;
+  uint32_t constexpr kHeight = 8;
+  dp::Color const bgColor(0x10, 0x20, 0x30, 0xFF);
+
+  double const visualScale = 1.0;
+  CPUDrawer drawer(CPUDrawer::Params(df::VisualParams::GetResourcePostfix(visualScale),
+                                     visualScale));
+
+  FrameImage raw;
+  drawer.BeginFrame(kWidth, kHeight, bgColor);
+  drawer.Flush();
+  drawer.EndFrame(raw, false /* encodePng */);
+  TEST_EQUAL(raw.m_width, kWidth, ());
+  TEST_EQUAL(raw.m_height, kHeight, ());
+  TEST_EQUAL(raw.m_stride, kWidth * kBytesPerPixel, ());
+  TEST_EQUAL(raw.m_data.size(), raw.m_stride * kHeight, ());
+  TestFilled(raw.m_data, bgColor);
+
+  FrameImage png;
+  drawer.BeginFrame(kWidth, kHeight, bgColor);
+  drawer.Flush();
+  drawer.EndFrame(png, true /* encodePng */);
+  TEST_EQUAL(png.m_width, kWidth, ());
+  TEST_EQUAL(png.m_height, kHeight, ());
+  // The stride is in bytes in both modes.
+  TEST_EQUAL(png.m_stride, raw.m_stride, ());
+  TEST_EQUAL(DecodePng(png.m_data, kWidth, kHeight), raw.m_data, ());
+}
+
+UNIT_TEST(TileRenderer_Smoke)
+{
+  classificator::Load();
+
+  string const cacheDir = GetPlatform().WritablePathForFile("tile_renderer_tests");
+  Platform::RmDirRecursively(cacheDir);
+  SCOPE_GUARD(removeCache, [&cacheDir]() { Platform::RmDirRecursively(cacheDir); });
+
+  // Without mwms tiles are filled with the background color.
+  FrozenDataSource dataSource;
+
+  TileRenderer::Params params;
+  params.m_cacheDir = cacheDir;
+  params.m_tileSize = 16;
+  params.m_metatileSize = 2;
+  params.m_numDrawers = 2;
+  TileRenderer renderer(dataSource, params);
+
+  TEST(renderer.GetTile(TileKey(1, 2, 0)).empty(), ());
+
+  auto const tile = renderer.GetTile(TileKey(1, 1, 0));
+  auto const rgba = DecodePng(tile, params.m_tileSize, params.m_tileSize);
+  TEST_EQUAL(rgba.size(), params.m_tileSize * params.m_tileSize * kBytesPerPixel, ());
+  TEST_EQUAL(renderer.GetStats().m_numRenderedMetatiles, 1, ());
+  TEST(Platform::IsFileExistsByFullPath(renderer.GetTilePath(TileKey(1, 1, 0))), ());
+
+  // Other tiles of the metatile are served from the cache.
+  TEST(!renderer.GetTile(TileKey(1, 0, 1)).empty(), ());
+  TEST_EQUAL(renderer.GetStats().m_numRenderedMetatiles, 1, ());
+  TEST_EQUAL(renderer.GetStats().m_numCacheHits, 1, ());
+}
+}  // namespace tile_renderer_tests
@@ -0,0 +1,284 @@
+#include "software_renderer/tile_renderer.hpp"
+
+#include "software_renderer/feature_processor.hpp"
+#include "software_renderer/frame_image.hpp"
+#include "software_renderer/software_renderer.hpp"
+
+#include "drape_frontend/visual_params.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/drawing_rules.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace software_renderer
+{
+using namespace std;
+
+namespace
+{
+uint32_t constexpr kMaxZoom = 20;
+
+// Labels and symbols of features a bit out of a metatile may get into it.
+double constexpr kSelectionInflationPx = 24.0;
+}  // namespace
+
+// TileKey -----------------------------------------------------------------------------------------
+bool TileKey::operator<(TileKey const & rhs) const
+{
+  return tie(m_zoom, m_x, m_y) < tie(rhs.m_zoom, rhs.m_x, rhs.m_y);
+}
+
+bool TileKey::operator==(TileKey const & rhs) const
+{
+  return m_zoom == rhs.m_zoom && m_x == rhs.m_x && m_y == rhs.m_y;
+}
+
+bool TileKey::IsValid() const
+{
+  return m_zoom <= kMaxZoom && m_x < (1U << m_zoom) && m_y < (1U << m_zoom);
+}
+
+m2::RectD TileKey::GetRect() const
+{
+  ASSERT(IsValid(), (*this));
+  double const size = mercator::Bounds::kRangeX / (1U << m_zoom);
+  double const minX = mercator::Bounds::kMinX + m_x * size;
+  double const maxY = mercator::Bounds::kMaxY - m_y * size;
+  return m2::RectD(minX, maxY - size, minX + size, maxY);
+}
+
+string DebugPrint(TileKey const & key)
+{
+  ostringstream os;
+  os << key.m_zoom << "/" << key.m_x << "/" << key.m_y;
+  return os.str();
+}
+
+// TileRenderer ------------------------------------------------------------------------------------
+TileRenderer::TileRenderer(DataSource const & dataSource, Params const & params)
+  : m_dataSource(dataSource), m_params(params)
+{
+  CHECK(!m_params.m_cacheDir.empty(), ());
+  CHECK_GREATER(m_params.m_metatileSize, 0, ());
+  CHECK_GREATER(m_params.m_numDrawers, 0, ());
+
+  df::VisualParams::Init(m_params.m_visualScale, m_params.m_tileSize);
+  string const resPostfix = df::VisualParams::GetResourcePostfix(m_params.m_visualScale);
+  for (size_t i = 0; i < m_params.m_numDrawers; ++i)
+  {
+    CPUDrawer::Params drawerParams(resPostfix, m_params.m_visualScale);
+    drawerParams.m_glyphRasterCache = m_params.m_glyphRasterCache;
+    m_drawers.push_back(make_unique_dp<CPUDrawer>(drawerParams));
+  }
+}
+
+TileRenderer::~TileRenderer()
+{
+  lock_guard<mutex> lock(m_mu);
+  CHECK(m_metatiles.empty(), ("Tiles are being rendered."));
+}
+
+TileRenderer::Tile TileRenderer::GetTile(TileKey const & key)
+{
+  if (!key.IsValid())
+    return {};
+
+  Tile tile;
+  if (ReadFromCache(key, tile))
+  {
+    ++m_numCacheHits;
+    return tile;
+  }
+
+  uint32_t size = 0;
+  auto const metaKey = GetMetatileKey(key, size);
+
+  shared_ptr<Metatile> metatile;
+  bool render = false;
+  {
+    lock_guard<mutex> lock(m_mu);
+    auto & p = m_metatiles[metaKey];
+    if (!p)
+    {
+      p = make_shared<Metatile>();
+      p->m_key = metaKey;
+      p->m_size = size;
+      render = true;
+    }
+    metatile = p;
+  }
+
+  if (render)
+  {
+    SCOPE_GUARD(finish, [&]() {
+      lock_guard<mutex> lock(m_mu);
+      metatile->m_ready = true;
+      m_metatiles.erase(metaKey);
+      m_cv.notify_all();
+    });
+    Render(*metatile);
+  }
+  else
+  {
+    unique_lock<mutex> lock(m_mu);
+    m_cv.wait(lock, [&]() { return metatile->m_ready; });
+  }
+
+  // Tiles of a ready metatile are not changed anymore.
+  size_t const i = (key.m_y - metaKey.m_y) * size + (key.m_x - metaKey.m_x);
+  return i < metatile->m_tiles.size() ? metatile->m_tiles[i] : Tile();
+}
+
+TileRenderer::Stats TileRenderer::GetStats() const
+{
+  Stats stats;
+  stats.m_numRenderedMetatiles = m_numRenderedMetatiles;
+  stats.m_numCacheHits = m_numCacheHits;
+  return stats;
+}
+
+string TileRenderer::GetTilePath(TileKey const & key) const
+{
+  return base::JoinPath(m_params.m_cacheDir, strings::to_string(key.m_zoom),
+                        strings::to_string(key.m_x), strings::to_string(key.m_y) + ".png");
+}
+
+TileKey TileRenderer::GetMetatileKey(TileKey const & key, uint32_t & size) const
+{
+  size = min(m_params.m_metatileSize, 1U << key.m_zoom);
+  return TileKey(key.m_zoom, key.m_x / size * size, key.m_y / size * size);
+}
+
+bool TileRenderer::ReadFromCache(TileKey const & key, Tile & tile) const
+{
+  string const path = GetTilePath(key);
+  if (!Platform::IsFileExistsByFullPath(path))
+    return false;
+
+  try
+  {
+    tile = base::ReadFile(path);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read cached tile", path, e.Msg()));
+    return false;
+  }
+  return !tile.empty();
+}
+
+void TileRenderer::WriteToCache(TileKey const & key, Tile const & tile) const
+{
+  string const path = GetTilePath(key);
+  if (!Platform::MkDirRecursively(base::GetDirectory(path)))
+  {
+    LOG(LWARNING, ("Can't create directory for", path));
+    return;
+  }
+
+  // Readers never see partially written tiles.
+  base::WriteToTempAndRenameToFile(path, [&tile](string const & tmpPath) {
+    try
+    {
+      FileWriter writer(tmpPath);
+      writer.Write(tile.data(), tile.size());
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't write tile", tmpPath, e.Msg()));
+      return false;
+    }
+    return true;
+  });
+}
+
+drape_ptr<CPUDrawer> TileRenderer::TakeDrawer()
+{
+  unique_lock<mutex> lock(m_mu);
+  m_cv.wait(lock, [this]() { return !m_drawers.empty(); });
+  auto drawer = std::move(m_drawers.back());
+  m_drawers.pop_back();
+  return drawer;
+}
+
+void TileRenderer::ReturnDrawer(drape_ptr<CPUDrawer> && drawer)
+{
+  lock_guard<mutex> lock(m_mu);
+  m_drawers.push_back(std::move(drawer));
+  m_cv.notify_all();
+}
+
+void TileRenderer::Render(Metatile & metatile)
+{
+  auto const & key = metatile.m_key;
+  uint32_t const size = metatile.m_size;
+  uint32_t const tileSize = m_params.m_tileSize;
+  uint32_t const pxSize = size * tileSize;
+
+  m2::RectD glbRect = key.GetRect();
+  glbRect.Add(TileKey(key.m_zoom, key.m_x + size - 1, key.m_y + size - 1).GetRect());
+  ScreenBase const screen(m2::RectI(0, 0, pxSize, pxSize), m2::AnyRectD(glbRect));
+
+  int const drawScale =
+      df::GetDrawTileScale(key.GetRect(), tileSize, m_params.m_visualScale);
+
+  FrameImage image;
+  {
+    auto drawer = TakeDrawer();
+    SCOPE_GUARD(returnDrawer, [&]() { ReturnDrawer(std::move(drawer)); });
+
+    uint32_t const bgColor = drule::rules().GetBgColor(drawScale);
+    drawer->BeginFrame(pxSize, pxSize, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+
+    m2::RectD const renderRect(0, 0, pxSize, pxSize);
+    double const inflation = kSelectionInflationPx * m_params.m_visualScale;
+    m2::RectD clipRect;
+    screen.PtoG(m2::Inflate(renderRect, inflation, inflation), clipRect);
+
+    FeatureProcessor doDraw(make_ref(drawer), clipRect, screen, drawScale);
+    m_dataSource.ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); }, clipRect,
+                               min(scales::GetUpperScale(), drawScale));
+
+    drawer->Flush();
+    drawer->EndFrame(image, false /* encodePng */);
+  }
+
+  uint32_t const kBytesPerPixel = 4;
+  metatile.m_tiles.resize(size * size);
+  for (uint32_t row = 0; row < size; ++row)
+  {
+    for (uint32_t col = 0; col < size; ++col)
+    {
+      FrameImage png;
+      EncodePng(image.m_data.data() + row * tileSize * image.m_stride +
+                    col * tileSize * kBytesPerPixel,
+                tileSize, tileSize, image.m_stride, png);
+
+      auto & tile = metatile.m_tiles[row * size + col];
+      tile = std::move(png.m_data);
+      WriteToCache(TileKey(key.m_zoom, key.m_x + col, key.m_y + row), tile);
+    }
+  }
+
+  ++m_numRenderedMetatiles;
+}
+}  // namespace software_renderer
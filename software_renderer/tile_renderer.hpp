@@ -0,0 +1,126 @@
+#pragma once
+
+#include "software_renderer/cpu_drawer.hpp"
+
+#include "drape/pointers.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class DataSource;
+
+namespace software_renderer
+{
+// XYZ (slippy map) tile address, |m_y| goes from the north to the south.
+struct TileKey
+{
+  TileKey() = default;
+  TileKey(uint32_t zoom, uint32_t x, uint32_t y) : m_zoom(zoom), m_x(x), m_y(y) {}
+
+  bool operator<(TileKey const & rhs) const;
+  bool operator==(TileKey const & rhs) const;
+
+  bool IsValid() const;
+  m2::RectD GetRect() const;
+
+  uint32_t m_zoom = 0;
+  uint32_t m_x = 0;
+  uint32_t m_y = 0;
+};
+
+std::string DebugPrint(TileKey const & key);
+
+// Renders PNG tiles from mwms of a data source without GPU.
+// Tiles are rendered by metatiles (blocks of m_metatileSize x m_metatileSize tiles) which
+// are drawn as single images and sliced, so labels cross tile borders seamlessly and the features
+// are read once per metatile. All tiles of a rendered metatile are stored in the on-disk cache
+// and later requests of them are served from it.
+// Classificator and drawing rules must be loaded before.
+//
+// *NOTE* This class is thread-safe: GetTile() is meant to be called from many threads,
+// up to m_numDrawers metatiles are rendered simultaneously.
+class TileRenderer
+{
+public:
+  struct Params
+  {
+    // Directory of the tile cache, tiles are stored as |m_cacheDir|/z/x/y.png.
+    std::string m_cacheDir;
+    double m_visualScale = 1.0;
+    // Tile size in pixels.
+    uint32_t m_tileSize = 256;
+    // Number of tiles along a metatile side.
+    uint32_t m_metatileSize = 8;
+    // Number of CPUDrawer instances, i.e. the maximum number of metatiles rendered at once.
+    size_t m_numDrawers = 1;
+    // Glyph bitmaps cache shared by all drawers, may be null. Its file must not be used by drape,
+    // see dp::GlyphRasterCache.
+    std::shared_ptr<dp::GlyphRasterCache> m_glyphRasterCache;
+  };
+
+  struct Stats
+  {
+    uint64_t m_numRenderedMetatiles = 0;
+    uint64_t m_numCacheHits = 0;
+  };
+
+  using Tile = std::vector<uint8_t>;
+
+  TileRenderer(DataSource const & dataSource, Params const & params);
+  ~TileRenderer();
+
+  // Returns PNG data of the tile or an empty vector when |key| is invalid or the tile
+  // can't be rendered.
+  Tile GetTile(TileKey const & key);
+
+  Stats GetStats() const;
+
+  std::string GetTilePath(TileKey const & key) const;
+
+private:
+  struct Metatile
+  {
+    TileKey m_key;
+    uint32_t m_size = 0;
+    bool m_ready = false;
+    // Tiles in the row-major order.
+    std::vector<Tile> m_tiles;
+  };
+
+  TileKey GetMetatileKey(TileKey const & key, uint32_t & size) const;
+
+  bool ReadFromCache(TileKey const & key, Tile & tile) const;
+  void WriteToCache(TileKey const & key, Tile const & tile) const;
+
+  drape_ptr<CPUDrawer> TakeDrawer();
+  void ReturnDrawer(drape_ptr<CPUDrawer> && drawer);
+
+  void Render(Metatile & metatile);
+
+  DataSource const & m_dataSource;
+  Params const m_params;
+
+  std::mutex m_mu;
+  std::condition_variable m_cv;
+  // Drawers which are not used at the moment, guarded by |m_mu|.
+  std::vector<drape_ptr<CPUDrawer>> m_drawers;
+  // Metatiles which are being rendered, guarded by |m_mu|.
+  std::map<TileKey, std::shared_ptr<Metatile>> m_metatiles;
+
+  std::atomic<uint64_t> m_numRenderedMetatiles{0};
+  std::atomic<uint64_t> m_numCacheHits{0};
+
+  DISALLOW_COPY_AND_MOVE(TileRenderer);
+};
+}  // namespace software_renderer
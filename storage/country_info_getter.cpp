@@ -245,6 +245,32 @@ CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countr
   LoadCountryFile2CountryInfo(buffer, m_idToInfo);
 }
 
+void CountryInfoReader::LoadPointIndex(uint32_t gridSize)
+{
+  if (m_pointIndex)
+    return;
+
+  std::vector<std::vector<m2::RegionD>> regions(m_countries.size());
+  for (size_t id = 0; id < m_countries.size(); ++id)
+    LoadRegionsFromDisk(id, regions[id]);
+
+  m_pointIndex = std::make_unique<CountryPointIndex>(std::move(regions), gridSize);
+  LOG(LINFO, ("Country point index is built, countries:", m_pointIndex->GetNumCountries(),
+              "boundary cells:", m_pointIndex->GetNumBoundaryEntries()));
+
+  ClearCachesImpl();
+}
+
+CountryInfoReader::RegionId CountryInfoReader::FindFirstCountry(m2::PointD const & pt) const
+{
+  if (m_pointIndex)
+  {
+    auto const id = m_pointIndex->FindFirst(pt);
+    return id == CountryPointIndex::kInvalidId ? kInvalidId : id;
+  }
+  return CountryInfoGetter::FindFirstCountry(pt);
+}
+
 void CountryInfoReader::ClearCachesImpl() const
 {
   std::lock_guard<std::mutex> lock(m_cacheMutex);
@@ -257,6 +283,9 @@ template <typename Fn>
 std::invoke_result_t<Fn, std::vector<m2::RegionD>> CountryInfoReader::WithRegion(size_t id,
                                                                                  Fn && fn) const
 {
+  if (m_pointIndex)
+    return fn(m_pointIndex->GetRegions(id));
+
   std::lock_guard<std::mutex> lock(m_cacheMutex);
 
   bool isFound = false;
@@ -273,6 +302,9 @@ bool CountryInfoReader::BelongsToRegion(m2::PointD const & pt, size_t id) const
   if (!m_countries[id].m_rect.IsPointInside(pt))
     return false;
 
+  if (m_pointIndex)
+    return m_pointIndex->Contains(id, pt);
+
   auto contains = [&pt](std::vector<m2::RegionD> const & regions) {
     for (auto const & region : regions)
     {
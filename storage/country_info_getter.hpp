@@ -2,6 +2,7 @@
 
 #include "storage/country.hpp"
 #include "storage/country_decl.hpp"
+#include "storage/country_point_index.hpp"
 #include "storage/storage_defines.hpp"
 
 #include "platform/platform.hpp"
@@ -51,7 +52,7 @@ public:
 
 protected:
   // Returns identifier of the first country containing |pt| or |kInvalidId| if there is none.
-  RegionId FindFirstCountry(m2::PointD const & pt) const;
+  virtual RegionId FindFirstCountry(m2::PointD const & pt) const;
 
   // Returns true when |pt| belongs to the country identified by |id|.
   virtual bool BelongsToRegion(m2::PointD const & pt, size_t id) const = 0;
@@ -142,9 +143,19 @@ public:
   // Loads all regions for country number |id| from |m_reader|.
   void LoadRegionsFromDisk(size_t id, std::vector<m2::RegionD> & regions) const;
 
+  // Loads regions of all countries to memory and builds the index of them. After that
+  // point queries check polygons only near borders and no queries take the regions cache lock.
+  // It's meant for bulk processing as it takes a few dozens of megabytes.
+  // *NOTE* Must be called before the reader is shared between threads.
+  void LoadPointIndex(uint32_t gridSize = 1024);
+  bool HasPointIndex() const { return m_pointIndex != nullptr; }
+
 protected:
   CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR);
 
+  // CountryInfoGetterBase overrides:
+  RegionId FindFirstCountry(m2::PointD const & pt) const override;
+
   // CountryInfoGetter overrides:
   void ClearCachesImpl() const override;
   bool BelongsToRegion(m2::PointD const & pt, size_t id) const override;
@@ -157,6 +168,9 @@ protected:
   FilesContainerR m_reader;
   mutable base::Cache<uint32_t, std::vector<m2::RegionD>> m_cache;
   mutable std::mutex m_cacheMutex;
+
+  // When set, it's used instead of |m_cache|.
+  std::unique_ptr<CountryPointIndex> m_pointIndex;
 };
 
 // This class allows users to get info about very simply rectangular
@@ -0,0 +1,265 @@
+#include "storage/country_point_index.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace storage
+{
+using namespace std;
+
+namespace
+{
+// Cells are inflated by this value when borders are rasterized, so that points which
+// the polygon check treats as lying on a border never get into inner cells.
+double constexpr kCellMargin = 1e-6;
+
+// Liang-Barsky test of segment (|a|, |b|) against |rect|.
+bool IsSegmentIntersectRect(m2::PointD const & a, m2::PointD const & b, m2::RectD const & rect)
+{
+  double t0 = 0.0;
+  double t1 = 1.0;
+  double const dx = b.x - a.x;
+  double const dy = b.y - a.y;
+
+  auto const clip = [&t0, &t1](double p, double q) {
+    if (p == 0.0)
+      return q >= 0.0;
+    double const t = q / p;
+    if (p < 0.0)
+    {
+      if (t > t1)
+        return false;
+      t0 = max(t0, t);
+    }
+    else
+    {
+      if (t < t0)
+        return false;
+      t1 = min(t1, t);
+    }
+    return true;
+  };
+
+  return clip(-dx, a.x - rect.minX()) && clip(dx, rect.maxX() - a.x) &&
+         clip(-dy, a.y - rect.minY()) && clip(dy, rect.maxY() - a.y);
+}
+}  // namespace
+
+CountryPointIndex::CountryPointIndex(vector<vector<m2::RegionD>> && regions, uint32_t gridSize)
+  : m_regions(std::move(regions))
+  , m_gridSize(gridSize)
+  , m_bounds(mercator::Bounds::FullRect())
+  , m_cellSizeX(m_bounds.SizeX() / gridSize)
+  , m_cellSizeY(m_bounds.SizeY() / gridSize)
+{
+  CHECK_GREATER(gridSize, 0, ());
+  CHECK_LESS(m_regions.size(), kInsideBit, ());
+
+  vector<CellEntry> entries;
+  for (RegionId id = 0; id < m_regions.size(); ++id)
+    AddCountry(id, entries);
+
+  // Counting sort by cells keeps entries of a cell sorted by country id.
+  size_t const numCells = static_cast<size_t>(m_gridSize) * m_gridSize;
+  m_offsets.assign(numCells + 1, 0);
+  for (auto const & e : entries)
+    ++m_offsets[e.m_cell + 1];
+  for (size_t i = 0; i < numCells; ++i)
+    m_offsets[i + 1] += m_offsets[i];
+
+  m_entries.resize(entries.size());
+  vector<uint32_t> next(m_offsets.begin(), m_offsets.end() - 1);
+  for (auto const & e : entries)
+  {
+    m_entries[next[e.m_cell]++] = e.m_entry;
+    if ((e.m_entry & kInsideBit) == 0)
+      ++m_numBoundaryEntries;
+  }
+}
+
+CountryPointIndex::RegionId CountryPointIndex::FindFirst(m2::PointD const & pt) const
+{
+  uint32_t cell;
+  if (!GetCell(pt, cell))
+  {
+    for (RegionId id = 0; id < m_regions.size(); ++id)
+    {
+      if (ContainsImpl(id, pt))
+        return id;
+    }
+    return kInvalidId;
+  }
+
+  for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+  {
+    auto const entry = m_entries[i];
+    RegionId const id = entry & ~kInsideBit;
+    if ((entry & kInsideBit) != 0 || ContainsImpl(id, pt))
+      return id;
+  }
+  return kInvalidId;
+}
+
+bool CountryPointIndex::Contains(RegionId id, m2::PointD const & pt) const
+{
+  CHECK_LESS(id, m_regions.size(), ());
+
+  uint32_t cell;
+  if (!GetCell(pt, cell))
+    return ContainsImpl(id, pt);
+
+  auto const begin = m_entries.begin() + m_offsets[cell];
+  auto const end = m_entries.begin() + m_offsets[cell + 1];
+  auto const it = lower_bound(begin, end, id, [](uint32_t entry, RegionId id) {
+    return (entry & ~kInsideBit) < id;
+  });
+  if (it == end || (*it & ~kInsideBit) != id)
+    return false;
+  return (*it & kInsideBit) != 0 || ContainsImpl(id, pt);
+}
+
+vector<m2::RegionD> const & CountryPointIndex::GetRegions(RegionId id) const
+{
+  CHECK_LESS(id, m_regions.size(), ());
+  return m_regions[id];
+}
+
+bool CountryPointIndex::GetCell(m2::PointD const & pt, uint32_t & cell) const
+{
+  if (!m_bounds.IsPointInside(pt))
+    return false;
+
+  auto const toIndex = [this](double v) {
+    return min(static_cast<uint32_t>(max(v, 0.0)), m_gridSize - 1);
+  };
+  uint32_t const col = toIndex((pt.x - m_bounds.minX()) / m_cellSizeX);
+  uint32_t const row = toIndex((pt.y - m_bounds.minY()) / m_cellSizeY);
+  cell = row * m_gridSize + col;
+  return true;
+}
+
+m2::RectD CountryPointIndex::GetCellRect(uint32_t col, uint32_t row) const
+{
+  double const minX = m_bounds.minX() + col * m_cellSizeX;
+  double const minY = m_bounds.minY() + row * m_cellSizeY;
+  return m2::RectD(minX, minY, minX + m_cellSizeX, minY + m_cellSizeY);
+}
+
+void CountryPointIndex::AddCountry(RegionId id, vector<CellEntry> & entries) const
+{
+  auto const & regions = m_regions[id];
+
+  m2::RectD rect;
+  for (auto const & region : regions)
+    rect.Add(region.GetRect());
+  rect.Inflate(kCellMargin, kCellMargin);
+  if (!rect.IsIntersect(m_bounds))
+    return;
+
+  auto const toCol = [this](double x) {
+    auto const col = floor((x - m_bounds.minX()) / m_cellSizeX);
+    return static_cast<uint32_t>(base::Clamp(col, 0.0, static_cast<double>(m_gridSize - 1)));
+  };
+  auto const toRow = [this](double y) {
+    auto const row = floor((y - m_bounds.minY()) / m_cellSizeY);
+    return static_cast<uint32_t>(base::Clamp(row, 0.0, static_cast<double>(m_gridSize - 1)));
+  };
+
+  uint32_t const col0 = toCol(rect.minX());
+  uint32_t const col1 = toCol(rect.maxX());
+  uint32_t const row0 = toRow(rect.minY());
+  uint32_t const row1 = toRow(rect.maxY());
+  uint32_t const width = col1 - col0 + 1;
+  uint32_t const height = row1 - row0 + 1;
+
+  // Cells crossed by borders.
+  vector<bool> boundary(static_cast<size_t>(width) * height, false);
+  // Crossings of the horizontal lines through the row centers by borders: (x, region).
+  vector<vector<pair<double, size_t>>> crossings(height);
+
+  for (size_t r = 0; r < regions.size(); ++r)
+  {
+    auto const & points = regions[r].Data();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      auto const & a = points[i == 0 ? points.size() - 1 : i - 1];
+      auto const & b = points[i];
+
+      m2::RectD edgeRect(a, b);
+      edgeRect.Inflate(kCellMargin, kCellMargin);
+      uint32_t const edgeRow0 = toRow(edgeRect.minY());
+      uint32_t const edgeRow1 = toRow(edgeRect.maxY());
+      uint32_t const edgeCol0 = toCol(edgeRect.minX());
+      uint32_t const edgeCol1 = toCol(edgeRect.maxX());
+      for (uint32_t row = edgeRow0; row <= edgeRow1; ++row)
+      {
+        for (uint32_t col = edgeCol0; col <= edgeCol1; ++col)
+        {
+          auto cellRect = GetCellRect(col, row);
+          cellRect.Inflate(kCellMargin, kCellMargin);
+          if (IsSegmentIntersectRect(a, b, cellRect))
+            boundary[static_cast<size_t>(row - row0) * width + (col - col0)] = true;
+        }
+
+        double const y = GetCellRect(col0, row).Center().y;
+        if ((a.y > y) != (b.y > y))
+          crossings[row - row0].emplace_back(a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y), r);
+      }
+    }
+  }
+
+  auto const entry = base::asserted_cast<uint32_t>(id);
+  vector<bool> odd(regions.size());
+  for (uint32_t row = row0; row <= row1; ++row)
+  {
+    auto & xs = crossings[row - row0];
+    sort(xs.begin(), xs.end());
+
+    // Inner cells are classified with the ray casting from the left. A cell center
+    // is inside the country iff it's inside one of the regions.
+    fill(odd.begin(), odd.end(), false);
+    size_t numOdd = 0;
+    size_t next = 0;
+    for (uint32_t col = col0; col <= col1; ++col)
+    {
+      uint32_t const cell = row * m_gridSize + col;
+      if (boundary[static_cast<size_t>(row - row0) * width + (col - col0)])
+      {
+        entries.push_back({cell, entry});
+        continue;
+      }
+
+      double const x = GetCellRect(col, row).Center().x;
+      for (; next < xs.size() && xs[next].first < x; ++next)
+      {
+        auto const r = xs[next].second;
+        odd[r] = !odd[r];
+        if (odd[r])
+          ++numOdd;
+        else
+          --numOdd;
+      }
+
+      if (numOdd != 0)
+        entries.push_back({cell, entry | kInsideBit});
+    }
+  }
+}
+
+bool CountryPointIndex::ContainsImpl(RegionId id, m2::PointD const & pt) const
+{
+  for (auto const & region : m_regions[id])
+  {
+    if (region.Contains(pt))
+      return true;
+  }
+  return false;
+}
+}  // namespace storage
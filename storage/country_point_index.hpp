@@ -0,0 +1,73 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace storage
+{
+// Immutable uniform grid over the mercator bounds which answers point-in-country queries.
+// Every cell keeps the countries it intersects and marks the countries it lies inside of
+// entirely, so polygons are checked only for points in the cells crossed by country borders.
+// All polygons are kept in memory.
+//
+// *NOTE* This class is thread-safe.
+class CountryPointIndex
+{
+public:
+  using RegionId = size_t;
+
+  static RegionId constexpr kInvalidId = std::numeric_limits<RegionId>::max();
+
+  // |regions[id]| are polygons of the country |id|.
+  explicit CountryPointIndex(std::vector<std::vector<m2::RegionD>> && regions,
+                             uint32_t gridSize = 1024);
+
+  // Returns the smallest id of a country containing |pt| or kInvalidId if there is none.
+  RegionId FindFirst(m2::PointD const & pt) const;
+
+  // Returns true when |pt| belongs to the country |id|.
+  bool Contains(RegionId id, m2::PointD const & pt) const;
+
+  std::vector<m2::RegionD> const & GetRegions(RegionId id) const;
+
+  size_t GetNumCountries() const { return m_regions.size(); }
+  // Returns the number of (cell, country) pairs which need polygon checks.
+  size_t GetNumBoundaryEntries() const { return m_numBoundaryEntries; }
+
+private:
+  // Cell entry is a country id with this bit set when the cell is inside the country.
+  static uint32_t constexpr kInsideBit = 1U << 31;
+
+  struct CellEntry
+  {
+    uint32_t m_cell = 0;
+    uint32_t m_entry = 0;
+  };
+
+  // Returns false when |pt| is out of the grid.
+  bool GetCell(m2::PointD const & pt, uint32_t & cell) const;
+  m2::RectD GetCellRect(uint32_t col, uint32_t row) const;
+
+  void AddCountry(RegionId id, std::vector<CellEntry> & entries) const;
+  bool ContainsImpl(RegionId id, m2::PointD const & pt) const;
+
+  std::vector<std::vector<m2::RegionD>> m_regions;
+
+  uint32_t m_gridSize = 0;
+  m2::RectD m_bounds;
+  double m_cellSizeX = 0.0;
+  double m_cellSizeY = 0.0;
+
+  // Entries of cell i are |m_entries[m_offsets[i]]|, ..., |m_entries[m_offsets[i + 1] - 1]|
+  // sorted by country id.
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_entries;
+  size_t m_numBoundaryEntries = 0;
+};
+}  // namespace storage
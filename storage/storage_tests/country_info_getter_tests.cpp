@@ -20,10 +20,12 @@
 #include "base/stats.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -75,6 +77,33 @@ Cont Flatten(vector<Cont> const & cs)
     res.insert(res.end(), c.begin(), c.end());
   return res;
 }
+
+// Returns random points of all countries and points close to their borders.
+vector<m2::PointD> MakeTestPoints(CountryInfoReader const & reader, size_t numPoints)
+{
+  mt19937 rng(0);
+
+  vector<vector<m2::RegionD>> allRegions(reader.GetCountries().size());
+  for (size_t id = 0; id < allRegions.size(); ++id)
+    reader.LoadRegionsFromDisk(id, allRegions[id]);
+
+  vector<m2::PointD> points;
+  RandomPointGenerator pointGen(rng, Flatten(allRegions));
+  for (size_t i = 0; i < numPoints / 2; ++i)
+    points.push_back(pointGen());
+
+  uniform_real_distribution<double> shift(-1e-3, 1e-3);
+  for (size_t i = 0; i < numPoints / 2; ++i)
+  {
+    auto const & regions = allRegions[i % allRegions.size()];
+    if (regions.empty())
+      continue;
+    auto const & data = regions[i % regions.size()].Data();
+    auto const & p = data[(i * 7919) % data.size()];
+    points.emplace_back(p.x + shift(rng), p.y + shift(rng));
+  }
+  return points;
+}
 }  // namespace
 
 UNIT_TEST(CountryInfoGetter_GetByPoint_Smoke)
@@ -404,3 +433,60 @@ BENCHMARK_TEST(CountryInfoGetter_RegionsByRect)
                 avgTimeByCountry[longest]));
   }
 }
+
+UNIT_TEST(CountryInfoGetter_PointIndex)
+{
+  auto const reader = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(reader != nullptr, ());
+  auto const indexed = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(indexed != nullptr, ());
+  indexed->LoadPointIndex();
+  TEST(indexed->HasPointIndex(), ());
+
+  for (auto const & pt : MakeTestPoints(*reader, 20000 /* numPoints */))
+    TEST_EQUAL(indexed->GetRegionCountryId(pt), reader->GetRegionCountryId(pt), (pt));
+
+  // Minsk
+  CountryInfo info;
+  indexed->GetRegionInfo(mercator::FromLatLon(53.9022651, 27.5618818), info);
+  TEST_EQUAL(info.m_name, "Belarus, Minsk Region", ());
+}
+
+BENCHMARK_TEST(CountryInfoGetter_GetRegionCountryId_Threads)
+{
+  auto const reader = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(reader != nullptr, ());
+  auto const indexed = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(indexed != nullptr, ());
+
+  base::Timer timer;
+  indexed->LoadPointIndex();
+  LOG(LINFO, ("Point index is loaded in", timer.ElapsedSeconds(), "seconds"));
+
+  auto const points = MakeTestPoints(*reader, 200000 /* numPoints */);
+
+  auto const run = [&points](CountryInfoGetter const & getter, size_t numThreads) {
+    vector<thread> threads;
+    vector<size_t> found(numThreads);
+    base::Timer timer;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      threads.emplace_back([&, t]() {
+        for (size_t i = t; i < points.size(); i += numThreads)
+        {
+          if (!getter.GetRegionCountryId(points[i]).empty())
+            ++found[t];
+        }
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+    return static_cast<double>(points.size()) / max(timer.ElapsedSeconds(), 1e-9);
+  };
+
+  for (size_t const numThreads : {1, 2, 4, 8})
+  {
+    LOG(LINFO, ("Threads:", numThreads, "points/s with regions cache:", run(*reader, numThreads),
+                "with point index:", run(*indexed, numThreads)));
+  }
+}
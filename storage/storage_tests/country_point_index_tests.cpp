@@ -0,0 +1,135 @@
+#include "testing/testing.hpp"
+
+#include "storage/country_point_index.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace country_point_index_tests
+{
+using namespace storage;
+using namespace std;
+
+m2::RegionD MakeRegion(vector<m2::PointD> const & points)
+{
+  return m2::RegionD(points.begin(), points.end());
+}
+
+vector<vector<m2::RegionD>> MakeCountries()
+{
+  return {
+      // A square.
+      {MakeRegion({{0, 0}, {10, 0}, {10, 10}, {0, 10}})},
+      // A triangle overlapping the square.
+      {MakeRegion({{5, 5}, {20, 5}, {5, 20}})},
+      // Two distant islands.
+      {MakeRegion({{-50, -50}, {-40, -50}, {-40, -40}, {-50, -40}}),
+       MakeRegion({{100, 100}, {101, 100}, {101.5, 101}, {100, 101}})},
+      // A concave polygon.
+      {MakeRegion({{-100, 0}, {-60, 0}, {-60, 40}, {-70, 40}, {-70, 10}, {-90, 10}, {-90, 40},
+                   {-100, 40}})},
+  };
+}
+
+CountryPointIndex::RegionId FindFirstSlow(vector<vector<m2::RegionD>> const & countries,
+                                          m2::PointD const & pt)
+{
+  for (size_t id = 0; id < countries.size(); ++id)
+  {
+    for (auto const & region : countries[id])
+    {
+      if (region.Contains(pt))
+        return id;
+    }
+  }
+  return CountryPointIndex::kInvalidId;
+}
+
+void TestPoints(uint32_t gridSize, vector<m2::PointD> const & points)
+{
+  auto const countries = MakeCountries();
+  CountryPointIndex index(MakeCountries(), gridSize);
+  TEST_EQUAL(index.GetNumCountries(), countries.size(), ());
+
+  for (auto const & pt : points)
+  {
+    auto const expected = FindFirstSlow(countries, pt);
+    TEST_EQUAL(index.FindFirst(pt), expected, (gridSize, pt));
+    for (size_t id = 0; id < countries.size(); ++id)
+    {
+      bool contains = false;
+      for (auto const & region : countries[id])
+        contains = contains || region.Contains(pt);
+      TEST_EQUAL(index.Contains(id, pt), contains, (gridSize, id, pt));
+    }
+  }
+}
+
+UNIT_TEST(CountryPointIndex_Smoke)
+{
+  CountryPointIndex index(MakeCountries(), 64 /* gridSize */);
+
+  TEST_EQUAL(index.FindFirst({1, 1}), 0, ());
+  TEST_EQUAL(index.FindFirst({7, 7}), 0, ());
+  TEST_EQUAL(index.FindFirst({15, 6}), 1, ());
+  TEST_EQUAL(index.FindFirst({-45, -45}), 2, ());
+  TEST_EQUAL(index.FindFirst({100.5, 100.5}), 2, ());
+  TEST_EQUAL(index.FindFirst({-95, 30}), 3, ());
+  TEST_EQUAL(index.FindFirst({-80, 30}), CountryPointIndex::kInvalidId, ());
+  TEST_EQUAL(index.FindFirst({170, -170}), CountryPointIndex::kInvalidId, ());
+  // Out of the mercator bounds.
+  TEST_EQUAL(index.FindFirst({500, 500}), CountryPointIndex::kInvalidId, ());
+
+  TEST(index.Contains(1, {7, 7}), ());
+  TEST(!index.Contains(1, {1, 1}), ());
+  TEST_GREATER(index.GetNumBoundaryEntries(), 0, ());
+}
+
+UNIT_TEST(CountryPointIndex_RandomPoints)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-110.0, 110.0);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < 20000; ++i)
+    points.emplace_back(coord(rng), coord(rng));
+
+  for (uint32_t const gridSize : {1, 8, 64, 1024})
+    TestPoints(gridSize, points);
+}
+
+UNIT_TEST(CountryPointIndex_Borders)
+{
+  // Vertices, points on edges and points very close to them.
+  vector<m2::PointD> points;
+  for (auto const & regions : MakeCountries())
+  {
+    for (auto const & region : regions)
+    {
+      auto const & data = region.Data();
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        auto const & a = data[i];
+        auto const & b = data[(i + 1) % data.size()];
+        for (double const t : {0.0, 0.25, 0.5})
+        {
+          auto const pt = a + (b - a) * t;
+          for (double const d : {0.0, 1e-10, 1e-7, 1e-3})
+          {
+            points.emplace_back(pt.x + d, pt.y);
+            points.emplace_back(pt.x - d, pt.y);
+            points.emplace_back(pt.x, pt.y + d);
+            points.emplace_back(pt.x, pt.y - d);
+          }
+        }
+      }
+    }
+  }
+
+  for (uint32_t const gridSize : {8, 64, 1024})
+    TestPoints(gridSize, points);
+}
+}  // namespace country_point_index_tests
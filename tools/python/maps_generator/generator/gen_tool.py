@@ -37,6 +37,7 @@ class GenTool:
         "have_borders_for_whole_world": bool,
         "make_city_roads": bool,
         "make_coasts": bool,
+        "make_contraction_hierarchy": bool,
         "make_cross_mwm": bool,
         "make_routing_index": bool,
         "make_transit_cross_mwm": bool,
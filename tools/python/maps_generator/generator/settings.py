@@ -93,6 +93,9 @@ OSM_TOOLS_PATH = os.path.join(_WORK_PATH, "osmctools")
 # Generator tool section:
 USER_RESOURCE_PATH = os.path.join(OMIM_PATH, "data")
 NODE_STORAGE = "mem" if total_virtual_memory() / 10 ** 9 >= 64 else "map"
+# Contraction hierarchy section is used by routing servers only, so it's not
+# built for the public maps by default.
+NEED_CONTRACTION_HIERARCHY = False
 
 # Stages section:
 NEED_PLANET_UPDATE = False
@@ -211,6 +214,16 @@ def init(default_settings_path: AnyStr):
         "Generator tool", "USER_RESOURCE_PATH", USER_RESOURCE_PATH
     )
     NODE_STORAGE = cfg.get_opt("Generator tool", "NODE_STORAGE", NODE_STORAGE)
+    global NEED_CONTRACTION_HIERARCHY
+    NEED_CONTRACTION_HIERARCHY = bool(
+        int(
+            cfg.get_opt(
+                "Generator tool",
+                "NEED_CONTRACTION_HIERARCHY",
+                NEED_CONTRACTION_HIERARCHY,
+            )
+        )
+    )
 
     if not os.path.exists(USER_RESOURCE_PATH):
         from data_files import find_data_files
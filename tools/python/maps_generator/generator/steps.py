@@ -377,6 +377,7 @@ def step_routing(env: Env, country: AnyStr, **kwargs):
         cities_boundaries_data=env.paths.cities_boundaries_path,
         generate_maxspeed=True,
         make_city_roads=True,
+        make_contraction_hierarchy=settings.NEED_CONTRACTION_HIERARCHY,
         make_cross_mwm=True,
         disable_cross_mwm_progress=True,
         generate_cameras=True,
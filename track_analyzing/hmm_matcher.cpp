@@ -0,0 +1,478 @@
+#include "track_analyzing/hmm_matcher.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/measurement_utils.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Matching range in meters.
+double constexpr kMatchingRange = 20.0;
+// Standard deviation of gps errors in meters.
+double constexpr kGpsSigmaM = 10.0;
+// Difference between the route distance and the straight distance in meters which costs as much
+// as the gps error of |kGpsSigmaM| * sqrt(2).
+double constexpr kTransitionBetaM = 10.0;
+// Routes between neighbouring points are searched within
+// |kMaxRouteFactor| * straight distance + |kMaxRouteExtraM| meters.
+double constexpr kMaxRouteFactor = 2.0;
+double constexpr kMaxRouteExtraM = 100.0;
+// Routes are not longer than the distance which can be driven between the timestamps of
+// the points at the maximum speed plus |kMaxTimeRouteExtraM| meters for gps errors.
+double constexpr kMaxTimeRouteExtraM = 2.0 * kMatchingRange;
+// The route between points is not clear if there is no point for a longer time,
+// the track is split there.
+uint64_t constexpr kMaxTimeGapSec = 60;
+// Gps points of a standing car may move back a bit along the segment.
+double constexpr kBackwardToleranceM = 5.0;
+// Maximum number of points which are not matched while the best path is unclear.
+size_t constexpr kMaxUnmatchedSteps = 30;
+// The route cache is cleared when it has more segments.
+size_t constexpr kMaxReachesCount = 10000;
+
+double EmissionCost(double distance)
+{
+  double const x = distance / kGpsSigmaM;
+  return 0.5 * x * x;
+}
+
+double TransitionCost(double routeDistance, double straightDistance)
+{
+  return fabs(routeDistance - straightDistance) / kTransitionBetaM;
+}
+}  // namespace
+
+namespace track_analyzing
+{
+HmmMatcher::HmmMatcher(DataSource const & dataSource, IndexGraph & graph,
+                       VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
+  : m_dataSource(dataSource)
+  , m_graph(graph)
+  , m_vehicleModel(vehicleModel)
+  , m_mwmId(mwmId)
+  , m_maxSpeedMpS(measurement_utils::KmphToMps(vehicleModel.GetMaxWeightSpeed()))
+{
+}
+
+void HmmMatcher::AddPoint(DataPoint const & dataPoint, vector<MatchedTrack> & matchedTracks)
+{
+  ++m_pointsCount;
+
+  Step step;
+  step.m_dataPoint = dataPoint;
+  step.m_point = mercator::FromLatLon(dataPoint.m_latLon);
+  FillCandidates(step);
+  if (step.m_candidates.empty())
+  {
+    ++m_nonMatchedPointsCount;
+    return;
+  }
+
+  if (!m_steps.empty())
+  {
+    // Points with time going back are not linked.
+    uint64_t const prevTimestamp = m_steps.back().m_dataPoint.m_timestamp;
+    if (dataPoint.m_timestamp < prevTimestamp ||
+        dataPoint.m_timestamp - prevTimestamp > kMaxTimeGapSec || !Link(step))
+    {
+      Flush(matchedTracks);
+    }
+  }
+
+  if (m_steps.empty())
+  {
+    for (auto & candidate : step.m_candidates)
+      candidate.m_cost = EmissionCost(candidate.m_distance);
+  }
+
+  m_steps.push_back(move(step));
+  MatchConverged(matchedTracks);
+}
+
+void HmmMatcher::Flush(vector<MatchedTrack> & matchedTracks)
+{
+  if (!m_steps.empty())
+  {
+    auto const & candidates = m_steps.back().m_candidates;
+    auto const best = min_element(candidates.begin(), candidates.end(),
+                                  [](Candidate const & lhs, Candidate const & rhs) {
+                                    return lhs.m_cost < rhs.m_cost;
+                                  });
+    Match(m_steps.size() - 1, static_cast<size_t>(best - candidates.begin()), matchedTracks);
+  }
+
+  m_steps.clear();
+  m_isFrontMatched = false;
+  m_isTrackOpen = false;
+}
+
+void HmmMatcher::FillCandidates(Step & step) const
+{
+  auto & candidates = step.m_candidates;
+  auto const addCandidate = [&](uint32_t featureId, uint32_t segmentIdx, bool forward,
+                                double distance, double offset) {
+    Segment const segment(m_mwmId, featureId, segmentIdx, forward);
+    if (m_graph.GetAccessType(segment) != RoadAccess::Type::Yes)
+      return;
+
+    Candidate candidate;
+    candidate.m_segment = segment;
+    candidate.m_distance = distance;
+    candidate.m_offset = offset;
+    candidates.push_back(candidate);
+  };
+
+  m_dataSource.ForEachInRect(
+      [&](FeatureType & ft) {
+        if (!ft.GetID().IsValid())
+          return;
+
+        if (ft.GetID().m_mwmId.GetInfo()->GetType() != MwmInfo::COUNTRY)
+          return;
+
+        if (!m_vehicleModel.IsRoad(ft))
+          return;
+
+        ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+
+        bool const isOneWay = m_vehicleModel.IsOneWay(ft);
+        for (size_t segIdx = 0; segIdx + 1 < ft.GetPointsCount(); ++segIdx)
+        {
+          m2::PointD const begin = ft.GetPoint(segIdx);
+          m2::PointD const end = ft.GetPoint(segIdx + 1);
+          m2::PointD const projection =
+              m2::ParametrizedSegment<m2::PointD>(begin, end).ClosestPointTo(step.m_point);
+          double const distance = mercator::DistanceOnEarth(step.m_point, projection);
+          if (distance >= kMatchingRange)
+            continue;
+
+          auto const featureId = ft.GetID().m_index;
+          auto const idx = static_cast<uint32_t>(segIdx);
+          addCandidate(featureId, idx, true /* forward */, distance,
+                       mercator::DistanceOnEarth(begin, projection));
+          if (!isOneWay)
+          {
+            addCandidate(featureId, idx, false /* forward */, distance,
+                         mercator::DistanceOnEarth(end, projection));
+          }
+        }
+      },
+      mercator::RectByCenterXYAndSizeInMeters(step.m_point, kMatchingRange),
+      scales::GetUpperScale());
+
+  // A feature may be met several times.
+  sort(candidates.begin(), candidates.end(), [](Candidate const & lhs, Candidate const & rhs) {
+    return lhs.m_segment < rhs.m_segment;
+  });
+  candidates.erase(unique(candidates.begin(), candidates.end(),
+                          [](Candidate const & lhs, Candidate const & rhs) {
+                            return lhs.m_segment == rhs.m_segment;
+                          }),
+                   candidates.end());
+}
+
+double HmmMatcher::GetLength(Segment const & segment)
+{
+  auto const it = m_lengths.find(segment);
+  if (it != m_lengths.end())
+    return it->second;
+
+  double const length =
+      mercator::DistanceOnEarth(mercator::FromLatLon(m_graph.GetPoint(segment, false /* front */)),
+                                mercator::FromLatLon(m_graph.GetPoint(segment, true /* front */)));
+  m_lengths.emplace(segment, length);
+  return length;
+}
+
+HmmMatcher::Reach const & HmmMatcher::GetReach(Segment const & segment, double bound)
+{
+  auto it = m_reaches.find(segment);
+  if (it != m_reaches.end() && it->second.m_bound >= bound)
+    return it->second;
+
+  if (it == m_reaches.end())
+  {
+    if (m_reaches.size() >= kMaxReachesCount)
+    {
+      m_reaches.clear();
+      m_lengths.clear();
+    }
+    it = m_reaches.emplace(segment, Reach()).first;
+  }
+
+  // Dijkstra search from the end of |segment|. U-turns are not allowed.
+  Reach & reach = it->second;
+  reach.m_bound = bound;
+  reach.m_nodes.clear();
+
+  // Distance, segment and its previous segment.
+  using Item = tuple<double, Segment, Segment>;
+  priority_queue<Item, vector<Item>, greater<Item>> queue;
+  IndexGraph::SegmentEdgeListT edges;
+  auto const push = [&](Segment const & from, double distance) {
+    edges.clear();
+    m_graph.GetEdgeList(from, true /* isOutgoing */, true /* useRoutingOptions */, edges);
+    for (auto const & edge : edges)
+    {
+      Segment const & target = edge.GetTarget();
+      if (!from.IsInverse(target) && reach.m_nodes.count(target) == 0)
+        queue.emplace(distance, target, from);
+    }
+  };
+
+  push(segment, 0.0);
+  while (!queue.empty())
+  {
+    auto const [distance, current, parent] = queue.top();
+    queue.pop();
+    if (distance > bound)
+      break;
+
+    if (!reach.m_nodes.emplace(current, Reach::Node{distance, parent}).second)
+      continue;
+
+    push(current, distance + GetLength(current));
+  }
+
+  return reach;
+}
+
+double HmmMatcher::GetRouteDistance(Candidate const & from, Candidate const & to, double bound)
+{
+  if (from.m_segment == to.m_segment && to.m_offset + kBackwardToleranceM >= from.m_offset)
+  {
+    double const distance = max(to.m_offset - from.m_offset, 0.0);
+    return distance <= bound ? distance : -1.0;
+  }
+
+  // |bound| is enough for the reach since the route is not shorter than the part from the end
+  // of |from| to the start of |to|.
+  double const fromRest = max(GetLength(from.m_segment) - from.m_offset, 0.0);
+  auto const & nodes = GetReach(from.m_segment, bound).m_nodes;
+  auto const it = nodes.find(to.m_segment);
+  if (it == nodes.end())
+    return -1.0;
+
+  double const distance = fromRest + it->second.m_distance + to.m_offset;
+  return distance <= bound ? distance : -1.0;
+}
+
+void HmmMatcher::FillRoute(Candidate const & from, Candidate & to, double bound)
+{
+  to.m_route.clear();
+  if (from.m_segment == to.m_segment && to.m_offset + kBackwardToleranceM >= from.m_offset)
+    return;
+
+  double const fromRest = max(GetLength(from.m_segment) - from.m_offset, 0.0);
+  auto const & nodes = GetReach(from.m_segment, bound).m_nodes;
+  auto it = nodes.find(to.m_segment);
+  CHECK(it != nodes.end(), (from.m_segment, to.m_segment));
+  while (it->second.m_parent != from.m_segment)
+  {
+    it = nodes.find(it->second.m_parent);
+    CHECK(it != nodes.end(), (from.m_segment, to.m_segment));
+    to.m_route.emplace_back(it->first, fromRest + it->second.m_distance);
+  }
+  reverse(to.m_route.begin(), to.m_route.end());
+}
+
+bool HmmMatcher::Link(Step & step)
+{
+  CHECK(!m_steps.empty(), ());
+  auto & prev = m_steps.back();
+  CHECK_GREATER_OR_EQUAL(step.m_dataPoint.m_timestamp, prev.m_dataPoint.m_timestamp, ());
+  auto & prevCandidates = prev.m_candidates;
+  double const straightDistance = mercator::DistanceOnEarth(prev.m_point, step.m_point);
+  double const duration =
+      static_cast<double>(step.m_dataPoint.m_timestamp - prev.m_dataPoint.m_timestamp);
+  double const bound = min(straightDistance * kMaxRouteFactor + kMaxRouteExtraM,
+                           duration * m_maxSpeedMpS + kMaxTimeRouteExtraM);
+
+  auto & candidates = step.m_candidates;
+  for (auto & candidate : candidates)
+  {
+    candidate.m_cost = numeric_limits<double>::max();
+    for (size_t i = 0; i < prevCandidates.size(); ++i)
+    {
+      auto const & prevCandidate = prevCandidates[i];
+      double const routeDistance = GetRouteDistance(prevCandidate, candidate, bound);
+      if (routeDistance < 0.0)
+        continue;
+
+      double const cost = prevCandidate.m_cost + TransitionCost(routeDistance, straightDistance);
+      if (cost < candidate.m_cost)
+      {
+        candidate.m_cost = cost;
+        candidate.m_parent = i;
+        candidate.m_routeDistance = routeDistance;
+      }
+    }
+  }
+
+  auto const isUnreachable = [](Candidate const & candidate) {
+    return candidate.m_cost == numeric_limits<double>::max();
+  };
+  if (all_of(candidates.begin(), candidates.end(), isUnreachable))
+    return false;
+
+  candidates.erase(remove_if(candidates.begin(), candidates.end(), isUnreachable),
+                   candidates.end());
+
+  for (auto & candidate : candidates)
+    FillRoute(prevCandidates[candidate.m_parent], candidate, bound);
+
+  // Costs are kept small to not lose precision on long tracks.
+  double minCost = numeric_limits<double>::max();
+  for (auto & candidate : candidates)
+  {
+    candidate.m_cost += EmissionCost(candidate.m_distance);
+    minCost = min(minCost, candidate.m_cost);
+  }
+  for (auto & candidate : candidates)
+    candidate.m_cost -= minCost;
+
+  return true;
+}
+
+void HmmMatcher::Match(size_t stepIdx, size_t candidateIdx, vector<MatchedTrack> & matchedTracks)
+{
+  CHECK_LESS(stepIdx, m_steps.size(), ());
+  size_t const first = m_isFrontMatched ? 1 : 0;
+
+  vector<size_t> path(stepIdx + 1);
+  path[stepIdx] = candidateIdx;
+  for (size_t i = stepIdx; i > first; --i)
+    path[i - 1] = m_steps[i].m_candidates[path[i]].m_parent;
+
+  if (!m_isTrackOpen)
+  {
+    matchedTracks.emplace_back();
+    m_isTrackOpen = true;
+    ++m_tracksCount;
+  }
+
+  auto & matchedTrack = matchedTracks.back();
+  for (size_t i = first; i <= stepIdx; ++i)
+    AppendMatched(i, m_steps[i].m_candidates[path[i]], matchedTrack);
+
+  m_steps.erase(m_steps.begin(), m_steps.begin() + stepIdx);
+  m_isFrontMatched = true;
+
+  // Removes the candidates which are not descendants of the matched one.
+  auto & front = m_steps.front().m_candidates;
+  vector<size_t> newIndices(front.size(), numeric_limits<size_t>::max());
+  newIndices[candidateIdx] = 0;
+  front = {front[candidateIdx]};
+  for (size_t i = 1; i < m_steps.size(); ++i)
+  {
+    auto & candidates = m_steps[i].m_candidates;
+    vector<size_t> indices(candidates.size(), numeric_limits<size_t>::max());
+    size_t count = 0;
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      size_t const parent = newIndices[candidates[j].m_parent];
+      if (parent == numeric_limits<size_t>::max())
+        continue;
+
+      if (count != j)
+        candidates[count] = move(candidates[j]);
+      candidates[count].m_parent = parent;
+      indices[j] = count++;
+    }
+    CHECK_GREATER(count, 0, ());
+    candidates.resize(count);
+    newIndices = move(indices);
+  }
+}
+
+void HmmMatcher::AppendMatched(size_t stepIdx, Candidate const & candidate,
+                               MatchedTrack & matchedTrack) const
+{
+  auto const & dataPoint = m_steps[stepIdx].m_dataPoint;
+  if (!candidate.m_route.empty())
+  {
+    CHECK_GREATER(stepIdx, 0, ());
+    auto const & prevDataPoint = m_steps[stepIdx - 1].m_dataPoint;
+    double const duration = static_cast<double>(dataPoint.m_timestamp - prevDataPoint.m_timestamp);
+    for (auto const & [segment, distance] : candidate.m_route)
+    {
+      double const part =
+          candidate.m_routeDistance > 0.0 ? min(distance / candidate.m_routeDistance, 1.0) : 0.0;
+      DataPoint const routePoint(prevDataPoint.m_timestamp + static_cast<uint64_t>(duration * part),
+                                 m_graph.GetPoint(segment, false /* front */),
+                                 prevDataPoint.m_traffic);
+      matchedTrack.emplace_back(routePoint, segment);
+    }
+  }
+
+  matchedTrack.emplace_back(dataPoint, candidate.m_segment);
+}
+
+void HmmMatcher::MatchConverged(vector<MatchedTrack> & matchedTracks)
+{
+  CHECK(!m_steps.empty(), ());
+  size_t const first = m_isFrontMatched ? 1 : 0;
+  size_t const last = m_steps.size() - 1;
+
+  // Finds the last step which the best paths to all candidates of the last step go through
+  // the same candidate of.
+  vector<size_t> alive(m_steps[last].m_candidates.size());
+  for (size_t i = 0; i < alive.size(); ++i)
+    alive[i] = i;
+
+  for (size_t i = last; i + 1 > first; --i)
+  {
+    if (alive.size() == 1)
+    {
+      Match(i, alive.front(), matchedTracks);
+      return;
+    }
+
+    if (i == 0)
+      break;
+
+    vector<size_t> parents;
+    parents.reserve(alive.size());
+    for (size_t idx : alive)
+      parents.push_back(m_steps[i].m_candidates[idx].m_parent);
+    sort(parents.begin(), parents.end());
+    parents.erase(unique(parents.begin(), parents.end()), parents.end());
+    alive = move(parents);
+  }
+
+  if (last < first + kMaxUnmatchedSteps)
+    return;
+
+  // Matches the older half of the unmatched steps along the best path.
+  size_t best = 0;
+  auto const & candidates = m_steps[last].m_candidates;
+  for (size_t i = 1; i < candidates.size(); ++i)
+  {
+    if (candidates[i].m_cost < candidates[best].m_cost)
+      best = i;
+  }
+
+  size_t const stepIdx = last - kMaxUnmatchedSteps / 2;
+  for (size_t i = last; i > stepIdx; --i)
+    best = m_steps[i].m_candidates[best].m_parent;
+  Match(stepIdx, best, matchedTracks);
+}
+}  // namespace track_analyzing
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "track_analyzing/track.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+#include "routing_common/vehicle_model.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DataSource;
+
+namespace track_analyzing
+{
+// Matches tracks to road segments of an mwm with a hidden Markov model.
+// States of a point are road segments nearby. The emission cost of a state depends on the
+// distance from the point to the segment, the transition cost depends on the difference between
+// the route distance and the straight distance between neighbouring points. The best sequence
+// of segments is found by the Viterbi algorithm incrementally: points are matched as soon as
+// the best paths to all states of the last point go through the same state of the point,
+// so the matcher works for live tracks too.
+// Route distances are found by Dijkstra searches from the candidate segments which are limited
+// by the distance between points and by the distance which can be driven between their
+// timestamps. The searches are cached and reused by the next points.
+// The segments of the route between neighbouring points are added to the matched track too,
+// so neighbouring points of a matched track have the same or adjacent segments. They get the
+// time interpolated by the route distance.
+// A track is split into several matched tracks where no route between neighbouring points is
+// found, where the time between them is too long or goes back. Points without roads nearby are
+// skipped.
+class HmmMatcher final
+{
+public:
+  HmmMatcher(DataSource const & dataSource, routing::IndexGraph & graph,
+             routing::VehicleModelInterface const & vehicleModel, routing::NumMwmId mwmId);
+
+  // Adds the next point of a track. Points which are matched finally are appended to the last
+  // matched track of |matchedTracks| if they continue it, or to a new matched track.
+  // |GetPointsCount()| doesn't count the points which are added for the route segments.
+  // The same |matchedTracks| must be passed for all points of a track.
+  void AddPoint(DataPoint const & dataPoint, std::vector<MatchedTrack> & matchedTracks);
+  // Matches all the remaining points, the next point starts a new track.
+  void Flush(std::vector<MatchedTrack> & matchedTracks);
+
+  uint64_t GetTracksCount() const { return m_tracksCount; }
+  uint64_t GetPointsCount() const { return m_pointsCount; }
+  uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
+
+private:
+  // A segment of the route to a candidate and the route distance from the previous point to the
+  // segment start in meters.
+  using RouteSegment = std::pair<routing::Segment, double>;
+
+  struct Candidate
+  {
+    routing::Segment m_segment;
+    // Distance from the point to the segment in meters.
+    double m_distance = 0.0;
+    // Distance from the segment start to the projection of the point in meters.
+    double m_offset = 0.0;
+    // Cost of the best path to the candidate and the index of the previous candidate in it.
+    double m_cost = 0.0;
+    size_t m_parent = 0;
+    // Segments between the segment of the parent and |m_segment| on the route from the parent.
+    std::vector<RouteSegment> m_route;
+    // Route distance from the parent in meters.
+    double m_routeDistance = 0.0;
+  };
+
+  struct Step
+  {
+    DataPoint m_dataPoint;
+    m2::PointD m_point;
+    std::vector<Candidate> m_candidates;
+  };
+
+  // Route distances in meters from the end of a segment to the starts of the segments which are
+  // reachable from it within |m_bound| meters and the previous segments of the routes.
+  struct Reach
+  {
+    struct Node
+    {
+      double m_distance = 0.0;
+      routing::Segment m_parent;
+    };
+
+    double m_bound = 0.0;
+    std::unordered_map<routing::Segment, Node> m_nodes;
+  };
+
+  void FillCandidates(Step & step) const;
+  double GetLength(routing::Segment const & segment);
+  Reach const & GetReach(routing::Segment const & segment, double bound);
+  // Returns a negative value if there is no route from |from| to |to| within |bound| meters.
+  double GetRouteDistance(Candidate const & from, Candidate const & to, double bound);
+  // Fills |to.m_route| with the segments between |from| and |to| which are found by
+  // GetRouteDistance() with the same |bound|.
+  void FillRoute(Candidate const & from, Candidate & to, double bound);
+  // Links candidates of |step| to the candidates of the last step.
+  // Returns false if none of them is reachable.
+  bool Link(Step & step);
+  // Appends the points of |m_steps[stepIdx]| matched to |candidate| to |matchedTrack|:
+  // the points of the route from the previous step and the point of the step.
+  void AppendMatched(size_t stepIdx, Candidate const & candidate, MatchedTrack & matchedTrack) const;
+
+  // Matches the steps from the first not matched one to |m_steps[stepIdx]| which is matched to
+  // its candidate |candidateIdx|. The step becomes the first one, the candidates which don't
+  // continue the matched path are removed.
+  void Match(size_t stepIdx, size_t candidateIdx, std::vector<MatchedTrack> & matchedTracks);
+  // Matches the steps which can't change anymore. If too many steps are not matched,
+  // the older ones are matched along the best path.
+  void MatchConverged(std::vector<MatchedTrack> & matchedTracks);
+
+  DataSource const & m_dataSource;
+  routing::IndexGraph & m_graph;
+  routing::VehicleModelInterface const & m_vehicleModel;
+  routing::NumMwmId const m_mwmId;
+  double const m_maxSpeedMpS;
+
+  // Steps of the current track. If |m_isFrontMatched| the first step is matched already and has
+  // the only candidate.
+  std::deque<Step> m_steps;
+  bool m_isFrontMatched = false;
+  // True if the last matched track of the output is continued by |m_steps|.
+  bool m_isTrackOpen = false;
+
+  std::unordered_map<routing::Segment, double> m_lengths;
+  std::unordered_map<routing::Segment, Reach> m_reaches;
+
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+};
+}  // namespace track_analyzing
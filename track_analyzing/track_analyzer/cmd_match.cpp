@@ -23,6 +23,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <memory>
 #include <string>
@@ -35,8 +36,6 @@ using namespace track_analyzing;
 
 namespace
 {
-using Iter = typename vector<string>::iterator;
-
 void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
                  NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
 {
@@ -122,14 +121,17 @@ void CmdMatch(string const & logFile, string const & trackFile, string const & i
   stats.Log();
 }
 
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
+// Takes files from |files| one by one starting from |nextFile| until all of them are taken.
+// Archives differ in size a lot so files are not split into equal blocks between threads.
+void UnzipAndMatch(vector<string> & files, atomic<size_t> & nextFile, string const & trackExt,
+                   Stats & stats)
 {
   Storage storage;
   storage.RegisterAllLocalMaps();
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-  for (auto it = begin; it != end; ++it)
+  for (size_t i = nextFile++; i < files.size(); i = nextFile++)
   {
-    auto & file = *it;
+    auto & file = files[i];
     string data;
     try
     {
@@ -201,18 +203,13 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
   CHECK_GREATER(hardwareConcurrency, 0, ("No available threads."));
   LOG(LINFO, ("Number of available threads =", hardwareConcurrency));
   auto const threadsCount = min(size, hardwareConcurrency);
-  auto const blockSize = size / threadsCount;
+  atomic<size_t> nextFile(0);
   vector<thread> threads(threadsCount - 1);
   vector<Stats> stats(threadsCount);
-  auto begin = filesList.begin();
   for (size_t i = 0; i < threadsCount - 1; ++i)
-  {
-    auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, ref(stats[i]));
-    begin = end;
-  }
+    threads[i] = thread(UnzipAndMatch, ref(filesList), ref(nextFile), trackExt, ref(stats[i]));
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, ref(stats[threadsCount - 1]));
+  UnzipAndMatch(filesList, nextFile, trackExt, stats[threadsCount - 1]);
   for (auto & t : threads)
     t.join();
 
@@ -0,0 +1,314 @@
+#include "testing/testing.hpp"
+
+#include "track_analyzing/hmm_matcher.hpp"
+#include "track_analyzing/track.hpp"
+
+#include "routing/edge_estimator.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_loader.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/scales.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/measurement_utils.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hmm_matcher_tests
+{
+using namespace routing;
+using namespace std;
+using namespace track_analyzing;
+
+NumMwmId constexpr kMwmId = 0;
+
+class MatcherTest
+{
+public:
+  MatcherTest()
+  {
+    classificator::Load();
+    auto const regResult =
+        m_dataSource.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass"));
+    TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+    m_vehicleModel = CarModelFactory({}).GetVehicleModelForCountry("minsk-pass");
+    auto handle = m_dataSource.GetMwmHandleById(regResult.first);
+    m_graph = make_unique<IndexGraph>(
+        make_shared<Geometry>(
+            GeometryLoader::Create(handle, m_vehicleModel, false /* loadAltitudes */)),
+        EdgeEstimator::Create(VehicleType::Car, *m_vehicleModel, nullptr /* trafficStash */,
+                              nullptr /* dataSource */, nullptr /* numMvmIds */));
+    DeserializeIndexGraph(*handle.GetValue(), VehicleType::Car, *m_graph);
+    m_matcher = make_unique<HmmMatcher>(m_dataSource, *m_graph, *m_vehicleModel, kMwmId);
+  }
+
+  // Returns the two-way road with the most points near the center of Minsk.
+  uint32_t FindRoad(ms::LatLon const & center)
+  {
+    uint32_t road = 0;
+    size_t maxPointsCount = 0;
+    m_dataSource.ForEachInRect(
+        [&](FeatureType & ft) {
+          if (!m_vehicleModel->IsRoad(ft) || m_vehicleModel->IsOneWay(ft))
+            return;
+
+          ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+          if (ft.GetPointsCount() > maxPointsCount)
+          {
+            maxPointsCount = ft.GetPointsCount();
+            road = ft.GetID().m_index;
+          }
+        },
+        mercator::RectByCenterXYAndSizeInMeters(mercator::FromLatLon(center), 1000.0),
+        scales::GetUpperScale());
+    TEST_GREATER(maxPointsCount, 2, ());
+    return road;
+  }
+
+  // Makes points along |road| about every |stepM| meters with a zigzag noise, five seconds apart.
+  vector<DataPoint> MakeTrack(uint32_t road, double stepM, uint64_t timestamp = 0)
+  {
+    vector<ms::LatLon> points;
+    auto const & geometry = m_graph->GetRoadGeometry(road);
+    for (uint32_t i = 0; i < geometry.GetPointsCount(); ++i)
+      points.push_back(geometry.GetPoint(i));
+
+    vector<DataPoint> track;
+    for (size_t i = 0; i + 1 < points.size(); ++i)
+    {
+      auto const begin = mercator::FromLatLon(points[i]);
+      auto const end = mercator::FromLatLon(points[i + 1]);
+      auto const count = static_cast<size_t>(mercator::DistanceOnEarth(begin, end) / stepM) + 1;
+      for (size_t j = 0; j < count; ++j)
+      {
+        auto latLon = mercator::ToLatLon(begin + (end - begin) * (double(j) + 0.5) / double(count));
+        // About 4 meters to the both sides.
+        latLon.m_lat += track.size() % 2 == 0 ? 3.5e-5 : -3.5e-5;
+        track.emplace_back(timestamp, latLon, 0 /* traffic */);
+        timestamp += 5;
+      }
+    }
+    return track;
+  }
+
+  // Checks that neighbouring points of |matchedTrack| have the same or adjacent segments
+  // and their time doesn't go back.
+  void TestContinuous(MatchedTrack const & matchedTrack)
+  {
+    IndexGraph::SegmentEdgeListT edges;
+    for (size_t i = 1; i < matchedTrack.size(); ++i)
+    {
+      auto const & prev = matchedTrack[i - 1];
+      auto const & segment = matchedTrack[i].GetSegment();
+      TEST_LESS_OR_EQUAL(prev.GetDataPoint().m_timestamp,
+                         matchedTrack[i].GetDataPoint().m_timestamp, (i));
+      if (prev.GetSegment() == segment)
+        continue;
+
+      edges.clear();
+      m_graph->GetEdgeList(prev.GetSegment(), true /* isOutgoing */, true /* useRoutingOptions */,
+                           edges);
+      auto const isNext = [&](SegmentEdge const & edge) { return edge.GetTarget() == segment; };
+      TEST(any_of(edges.begin(), edges.end(), isNext), (i, prev.GetSegment(), segment));
+    }
+  }
+
+  // Checks that all the points of |track| are in |matchedTrack| in the same order.
+  void TestContains(MatchedTrack const & matchedTrack, vector<DataPoint> const & track)
+  {
+    size_t pointIdx = 0;
+    for (auto const & point : matchedTrack)
+    {
+      if (pointIdx < track.size() && point.GetDataPoint() == track[pointIdx])
+        ++pointIdx;
+    }
+    TEST_EQUAL(pointIdx, track.size(), ());
+  }
+
+  FrozenDataSource m_dataSource;
+  shared_ptr<VehicleModelInterface> m_vehicleModel;
+  unique_ptr<IndexGraph> m_graph;
+  unique_ptr<HmmMatcher> m_matcher;
+};
+
+UNIT_CLASS_TEST(MatcherTest, HmmMatcher_AlongRoad)
+{
+  uint32_t const road = FindRoad(ms::LatLon(53.89815, 27.54265));
+  auto const track = MakeTrack(road, 30.0 /* stepM */);
+
+  vector<MatchedTrack> matchedTracks;
+  base::Timer timer;
+  for (auto const & point : track)
+    m_matcher->AddPoint(point, matchedTracks);
+
+  // Points are matched before the end of the track.
+  TEST_EQUAL(matchedTracks.size(), 1, ());
+  TEST_GREATER(matchedTracks.front().size(), 0, ());
+  m_matcher->Flush(matchedTracks);
+  LOG(LINFO, ("Points:", track.size(), "matched in", timer.ElapsedSeconds(), "seconds"));
+
+  TEST_EQUAL(matchedTracks.size(), 1, ());
+  TEST_EQUAL(m_matcher->GetTracksCount(), 1, ());
+  TEST_EQUAL(m_matcher->GetPointsCount(), track.size(), ());
+  TEST_EQUAL(m_matcher->GetNonMatchedPointsCount(), 0, ());
+
+  auto const & matchedTrack = matchedTracks.front();
+  TestContains(matchedTrack, track);
+  TestContinuous(matchedTrack);
+  for (size_t i = 0; i < matchedTrack.size(); ++i)
+  {
+    auto const & segment = matchedTrack[i].GetSegment();
+    TEST_EQUAL(segment.GetFeatureId(), road, (i));
+    TEST(segment.IsForward(), (i));
+    if (i != 0)
+    {
+      TEST_LESS_OR_EQUAL(matchedTrack[i - 1].GetSegment().GetSegmentIdx(),
+                         segment.GetSegmentIdx(), ());
+    }
+  }
+}
+
+UNIT_CLASS_TEST(MatcherTest, HmmMatcher_SparseTrack)
+{
+  uint32_t const road = FindRoad(ms::LatLon(53.89815, 27.54265));
+  // Points are farther from each other than the segments are long.
+  auto const track = MakeTrack(road, 150.0 /* stepM */);
+
+  vector<MatchedTrack> matchedTracks;
+  for (auto const & point : track)
+    m_matcher->AddPoint(point, matchedTracks);
+  m_matcher->Flush(matchedTracks);
+
+  TEST_EQUAL(matchedTracks.size(), 1, ());
+  TEST_EQUAL(m_matcher->GetPointsCount(), track.size(), ());
+  auto const & matchedTrack = matchedTracks.front();
+  // The skipped segments are added with the points between the track points.
+  TEST_GREATER(matchedTrack.size(), track.size(), ());
+  TestContains(matchedTrack, track);
+  TestContinuous(matchedTrack);
+  for (auto const & point : matchedTrack)
+    TEST_EQUAL(point.GetSegment().GetFeatureId(), road, ());
+}
+
+UNIT_CLASS_TEST(MatcherTest, HmmMatcher_NoisyTrack)
+{
+  uint32_t const road = FindRoad(ms::LatLon(53.89815, 27.54265));
+  auto track = MakeTrack(road, 30.0 /* stepM */);
+  // Every fifth point is 15 meters aside, every seventh one is far from roads.
+  size_t outliersCount = 0;
+  for (size_t i = 1; i < track.size(); ++i)
+  {
+    if (i % 7 == 0)
+    {
+      track[i].m_latLon = ms::LatLon(0.0, 0.0);
+      ++outliersCount;
+    }
+    else if (i % 5 == 0)
+    {
+      track[i].m_latLon.m_lat += 1.35e-4;
+    }
+  }
+
+  vector<MatchedTrack> matchedTracks;
+  base::Timer timer;
+  for (auto const & point : track)
+    m_matcher->AddPoint(point, matchedTracks);
+  m_matcher->Flush(matchedTracks);
+  double const seconds = timer.ElapsedSeconds();
+
+  uint64_t const matchedCount = m_matcher->GetPointsCount() - m_matcher->GetNonMatchedPointsCount();
+  LOG(LINFO, ("Match rate:", double(matchedCount) / double(track.size()), "CPU per matched point:",
+              seconds * 1e6 / double(matchedCount), "us"));
+
+  // Noisy points don't split the track.
+  TEST_EQUAL(matchedTracks.size(), 1, ());
+  TEST_EQUAL(m_matcher->GetNonMatchedPointsCount(), outliersCount, ());
+  TestContinuous(matchedTracks.front());
+  for (auto const & point : matchedTracks.front())
+    TEST_EQUAL(point.GetSegment().GetFeatureId(), road, ());
+}
+
+UNIT_CLASS_TEST(MatcherTest, HmmMatcher_Time)
+{
+  uint32_t const road = FindRoad(ms::LatLon(53.89815, 27.54265));
+  auto const track = MakeTrack(road, 30.0 /* stepM */);
+  size_t const half = track.size() / 2;
+
+  // A long time without points splits the track.
+  vector<MatchedTrack> matchedTracks;
+  for (size_t i = 0; i < track.size(); ++i)
+  {
+    auto point = track[i];
+    if (i >= half)
+      point.m_timestamp += 1000;
+    m_matcher->AddPoint(point, matchedTracks);
+  }
+  m_matcher->Flush(matchedTracks);
+  TEST_EQUAL(matchedTracks.size(), 2, ());
+  TEST_EQUAL(matchedTracks[0].back().GetDataPoint().m_timestamp, track[half - 1].m_timestamp, ());
+
+  // Points with time going back are not linked.
+  matchedTracks.clear();
+  for (auto const & point : track)
+    m_matcher->AddPoint(point, matchedTracks);
+  for (size_t i = half; i < track.size(); ++i)
+    m_matcher->AddPoint(track[i], matchedTracks);
+  m_matcher->Flush(matchedTracks);
+  TEST_EQUAL(matchedTracks.size(), 2, ());
+  for (auto const & matchedTrack : matchedTracks)
+    TestContinuous(matchedTrack);
+}
+
+UNIT_CLASS_TEST(MatcherTest, HmmMatcher_Break)
+{
+  uint32_t const firstRoad = FindRoad(ms::LatLon(53.89815, 27.54265));
+  uint32_t const secondRoad = FindRoad(ms::LatLon(53.91, 27.58));
+  TEST_NOT_EQUAL(firstRoad, secondRoad, ());
+  auto const first = MakeTrack(firstRoad, 30.0 /* stepM */);
+  // The second track goes on five seconds after the first one.
+  auto const second =
+      MakeTrack(secondRoad, 30.0 /* stepM */, first.back().m_timestamp + 5 /* timestamp */);
+
+  // There is no route between the roads which can be driven in five seconds.
+  double const distanceM =
+      ms::DistanceOnEarth(first.back().m_latLon, second.front().m_latLon);
+  TEST_GREATER(distanceM, 5.0 * measurement_utils::KmphToMps(m_vehicleModel->GetMaxWeightSpeed()) +
+                              100.0 /* gps errors */, ());
+
+  vector<MatchedTrack> matchedTracks;
+  for (auto const & point : first)
+    m_matcher->AddPoint(point, matchedTracks);
+  // A point far from roads is skipped.
+  m_matcher->AddPoint(
+      DataPoint(first.back().m_timestamp /* timestamp */, ms::LatLon(0.0, 0.0), 0 /* traffic */),
+      matchedTracks);
+  for (auto const & point : second)
+    m_matcher->AddPoint(point, matchedTracks);
+  m_matcher->Flush(matchedTracks);
+
+  TEST_EQUAL(m_matcher->GetNonMatchedPointsCount(), 1, ());
+  TEST_EQUAL(matchedTracks.size(), 2, ());
+  TestContains(matchedTracks[0], first);
+  TestContains(matchedTracks[1], second);
+  for (auto const & point : matchedTracks[0])
+    TEST_EQUAL(point.GetSegment().GetFeatureId(), firstRoad, ());
+  for (auto const & point : matchedTracks[1])
+    TEST_EQUAL(point.GetSegment().GetFeatureId(), secondRoad, ());
+}
+}  // namespace hmm_matcher_tests